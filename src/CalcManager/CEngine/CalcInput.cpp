@@ -320,3 +320,30 @@ Rational CalcInput::ToRational(uint32_t radix, int32_t precision)
 
     return result;
 }
+
+void CalcInput::SaveSnapshot(SnapshotWriter& writer) const
+{
+    writer.WriteBool(m_hasExponent);
+    writer.WriteBool(m_hasDecimal);
+    writer.WriteUInt32(static_cast<uint32_t>(m_decPtIndex));
+    writer.WriteString(m_base.value);
+    writer.WriteBool(m_base.IsNegative());
+    writer.WriteString(m_exponent.value);
+    writer.WriteBool(m_exponent.IsNegative());
+}
+
+void CalcInput::RestoreSnapshot(SnapshotReader& reader)
+{
+    m_hasExponent = reader.ReadBool();
+    m_hasDecimal = reader.ReadBool();
+    m_decPtIndex = reader.ReadUInt32();
+    reader.ReadString(m_base.value);
+    m_base.IsNegative(reader.ReadBool());
+    reader.ReadString(m_exponent.value);
+    m_exponent.IsNegative(reader.ReadBool());
+
+    if (m_base.value.size() > MAX_STRLEN || m_exponent.value.size() > MAX_STRLEN || m_decPtIndex > m_base.value.size())
+    {
+        reader.Invalidate();
+    }
+}
@@ -1,9 +1,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <limits>
 #include "Header Files/CalcEngine.h"
 #include "Command.h"
 #include "ExpressionCommand.h"
+#include "winerror_cross_platform.h"
 
 constexpr int ASCII_0 = 48;
 
@@ -23,6 +25,116 @@ namespace
         auto startIter = v.begin() + index;
         v.erase(startIter, v.end());
     }
+
+    enum class SnapshotCommandKind : uint8_t
+    {
+        Null,
+        Unary,
+        Binary,
+        Operand,
+        Parentheses
+    };
+
+    void WriteCommandArgs(SnapshotWriter& writer, vector<int> const& args)
+    {
+        writer.WriteUInt32(static_cast<uint32_t>(args.size()));
+        for (int arg : args)
+        {
+            writer.WriteInt32(arg);
+        }
+    }
+
+    void ReadCommandArgs(SnapshotReader& reader, vector<int>& args)
+    {
+        args.resize(reader.ReadCount(numeric_limits<uint32_t>::max()));
+        for (int& arg : args)
+        {
+            arg = reader.ReadInt32();
+        }
+    }
+
+    // Writes each expression command with its kind first, and operands with their value
+    class SnapshotCommandVisitor : public ISerializeCommandVisitor
+    {
+    public:
+        SnapshotCommandVisitor(SnapshotWriter& writer)
+            : m_writer(writer)
+        {
+        }
+
+        void Visit(_In_ COpndCommand& opndCmd) override
+        {
+            m_writer.WriteUInt8(static_cast<uint8_t>(SnapshotCommandKind::Operand));
+            WriteCommandArgs(m_writer, *opndCmd.GetCommands());
+            m_writer.WriteBool(opndCmd.IsNegative());
+            m_writer.WriteBool(opndCmd.IsDecimalPresent());
+            m_writer.WriteBool(opndCmd.IsSciFmt());
+            m_writer.WriteBool(opndCmd.IsInitialized());
+            if (opndCmd.IsInitialized())
+            {
+                m_writer.WriteRational(opndCmd.GetValue());
+            }
+        }
+
+        void Visit(_In_ CUnaryCommand& unaryCmd) override
+        {
+            m_writer.WriteUInt8(static_cast<uint8_t>(SnapshotCommandKind::Unary));
+            WriteCommandArgs(m_writer, *unaryCmd.GetCommands());
+        }
+
+        void Visit(_In_ CBinaryCommand& binaryCmd) override
+        {
+            m_writer.WriteUInt8(static_cast<uint8_t>(SnapshotCommandKind::Binary));
+            m_writer.WriteInt32(binaryCmd.GetCommand());
+        }
+
+        void Visit(_In_ CParentheses& paraCmd) override
+        {
+            m_writer.WriteUInt8(static_cast<uint8_t>(SnapshotCommandKind::Parentheses));
+            m_writer.WriteInt32(paraCmd.GetCommand());
+        }
+
+    private:
+        SnapshotWriter& m_writer;
+    };
+
+    shared_ptr<IExpressionCommand> ReadCommand(SnapshotReader& reader)
+    {
+        switch (static_cast<SnapshotCommandKind>(reader.ReadUInt8()))
+        {
+        case SnapshotCommandKind::Null:
+            return nullptr;
+        case SnapshotCommandKind::Unary:
+        {
+            auto unaryCommand = make_shared<CUnaryCommand>(0);
+            ReadCommandArgs(reader, *unaryCommand->GetCommands());
+            return unaryCommand;
+        }
+        case SnapshotCommandKind::Binary:
+            return make_shared<CBinaryCommand>(reader.ReadInt32());
+        case SnapshotCommandKind::Operand:
+        {
+            auto args = make_shared<vector<int>>();
+            ReadCommandArgs(reader, *args);
+            bool fNegative = reader.ReadBool();
+            bool fDecimal = reader.ReadBool();
+            bool fSciFmt = reader.ReadBool();
+            auto operandCommand = make_shared<COpndCommand>(args, fNegative, fDecimal, fSciFmt);
+            if (reader.ReadBool())
+            {
+                Rational value;
+                reader.ReadRational(value);
+                operandCommand->Initialize(value);
+            }
+            return operandCommand;
+        }
+        case SnapshotCommandKind::Parentheses:
+            return make_shared<CParentheses>(reader.ReadInt32());
+        default:
+            reader.Invalidate();
+            return nullptr;
+        }
+    }
 }
 
 void CHistoryCollector::ReinitHistory()
@@ -448,8 +560,7 @@ void CHistoryCollector::UpdateHistoryExpression(uint32_t radix, int32_t precisio
                 const std::shared_ptr<COpndCommand>& opndCommand = std::static_pointer_cast<COpndCommand>(expCommand);
                 if (opndCommand != nullptr)
                 {
-                    token.first = opndCommand->GetString(radix, precision);
-                    opndCommand->SetCommands(GetOperandCommandsFromString(token.first));
+                    token.first = opndCommand->SetRadix(radix, precision, m_decimalSymbol);
                 }
             }
         }
@@ -463,44 +574,121 @@ void CHistoryCollector::SetDecimalSymbol(wchar_t decimalSymbol)
     m_decimalSymbol = decimalSymbol;
 }
 
-// Update the commands corresponding to the passed string Number
-std::shared_ptr<std::vector<int>> CHistoryCollector::GetOperandCommandsFromString(wstring_view numStr)
+void CHistoryCollector::SaveSnapshot(SnapshotWriter& writer) const
 {
-    std::shared_ptr<std::vector<int>> commands = std::make_shared<std::vector<int>>();
-    // Check for negate
-    bool fNegative = (numStr[0] == L'-');
+    writer.WriteInt32(m_iCurLineHistStart);
+    writer.WriteInt32(m_lastOpStartIndex);
+    writer.WriteInt32(m_lastBinOpStartIndex);
+    writer.WriteUInt32(static_cast<uint32_t>(m_curOperandIndex));
+    for (int i = 0; i < m_curOperandIndex; i++)
+    {
+        writer.WriteInt32(m_operandIndices[i]);
+    }
+    writer.WriteBool(m_bLastOpndBrace);
 
-    for (size_t i = (fNegative ? 1 : 0); i < numStr.length(); i++)
+    writer.WriteBool(m_spTokens != nullptr);
+    if (m_spTokens != nullptr)
     {
-        if (numStr[i] == m_decimalSymbol)
+        writer.WriteUInt32(static_cast<uint32_t>(m_spTokens->size()));
+        for (auto const& token : *m_spTokens)
         {
-            commands->push_back(IDC_PNT);
+            writer.WriteString(token.first);
+            writer.WriteInt32(token.second);
         }
-        else if (numStr[i] == L'e')
+    }
+
+    writer.WriteBool(m_spCommands != nullptr);
+    if (m_spCommands != nullptr)
+    {
+        SnapshotCommandVisitor commandVisitor(writer);
+        writer.WriteUInt32(static_cast<uint32_t>(m_spCommands->size()));
+        for (auto const& command : *m_spCommands)
         {
-            commands->push_back(IDC_EXP);
+            if (command == nullptr)
+            {
+                writer.WriteUInt8(static_cast<uint8_t>(SnapshotCommandKind::Null));
+            }
+            else
+            {
+                command->Accept(commandVisitor);
+            }
         }
-        else if (numStr[i] == L'-')
+    }
+}
+
+void CHistoryCollector::RestoreSnapshot(SnapshotReader& reader)
+{
+    m_iCurLineHistStart = reader.ReadInt32();
+    m_lastOpStartIndex = reader.ReadInt32();
+    m_lastBinOpStartIndex = reader.ReadInt32();
+    m_curOperandIndex = static_cast<int>(reader.ReadCount(m_operandIndices.size()));
+    for (int i = 0; i < m_curOperandIndex; i++)
+    {
+        m_operandIndices[i] = reader.ReadInt32();
+    }
+    m_bLastOpndBrace = reader.ReadBool();
+
+    // The token strings are read into the existing ones, so that their storage is reused
+    if (reader.ReadBool())
+    {
+        if (m_spTokens == nullptr)
         {
-            commands->push_back(IDC_SIGN);
+            m_spTokens = make_shared<vector<pair<wstring, int>>>();
         }
-        else if (numStr[i] == L'+')
+
+        m_spTokens->resize(reader.ReadCount(numeric_limits<uint32_t>::max()));
+        for (auto& token : *m_spTokens)
         {
-            // Ignore.
+            reader.ReadString(token.first);
+            token.second = reader.ReadInt32();
         }
-        // Number
-        else
+    }
+    else
+    {
+        m_spTokens = nullptr;
+    }
+
+    if (reader.ReadBool())
+    {
+        if (m_spCommands == nullptr)
         {
-            int num = static_cast<int>(numStr[i]) - ASCII_0;
-            num += IDC_0;
-            commands->push_back(num);
+            m_spCommands = make_shared<vector<shared_ptr<IExpressionCommand>>>();
+        }
+
+        m_spCommands->resize(reader.ReadCount(numeric_limits<uint32_t>::max()));
+        for (auto& command : *m_spCommands)
+        {
+            command = ReadCommand(reader);
         }
     }
+    else
+    {
+        m_spCommands = nullptr;
+    }
 
-    // If the number is negative, append a sign command at the end.
-    if (fNegative)
+    // Every token must refer to a command that exists
+    if (m_spTokens != nullptr)
+    {
+        int commandCount = m_spCommands != nullptr ? static_cast<int>(m_spCommands->size()) : 0;
+        for (auto const& token : *m_spTokens)
+        {
+            if (token.second < -1 || token.second >= commandCount)
+            {
+                reader.Invalidate();
+                break;
+            }
+        }
+    }
+    // The indices into the tokens are where tokens are inserted and truncated from, so each is -1 or at most their count
+    int tokenCount = m_spTokens != nullptr ? static_cast<int>(m_spTokens->size()) : 0;
+    auto isTokenIndex = [tokenCount](int index) { return index >= -1 && index <= tokenCount; };
+    bool areIndicesValid = isTokenIndex(m_iCurLineHistStart) && isTokenIndex(m_lastOpStartIndex) && isTokenIndex(m_lastBinOpStartIndex);
+    for (int i = 0; i < m_curOperandIndex; i++)
+    {
+        areIndicesValid = areIndicesValid && isTokenIndex(m_operandIndices[i]);
+    }
+    if (!areIndicesValid)
     {
-        commands->push_back(IDC_SIGN);
+        reader.Invalidate();
     }
-    return commands;
 }
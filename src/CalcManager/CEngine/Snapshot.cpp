@@ -0,0 +1,320 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstring>
+#include "Header Files/Snapshot.h"
+
+using namespace std;
+using namespace CalcEngine;
+
+namespace
+{
+    constexpr uint32_t HIGH_SURROGATE_FIRST = 0xD800;
+    constexpr uint32_t HIGH_SURROGATE_LAST = 0xDBFF;
+    constexpr uint32_t LOW_SURROGATE_FIRST = 0xDC00;
+    constexpr uint32_t LOW_SURROGATE_LAST = 0xDFFF;
+    constexpr uint32_t SUPPLEMENTARY_PLANE_FIRST = 0x10000;
+
+    // A number's mantissa always has at least one digit
+    constexpr size_t MIN_SERIALIZED_NUMBER_SIZE = 3 * sizeof(uint32_t) + sizeof(uint32_t);
+
+    void StoreUInt16(uint8_t* out, uint16_t value)
+    {
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+    }
+
+    void StoreUInt32(uint8_t* out, uint32_t value)
+    {
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+        out[2] = static_cast<uint8_t>(value >> 16);
+        out[3] = static_cast<uint8_t>(value >> 24);
+    }
+
+    uint16_t LoadUInt16(const uint8_t* in)
+    {
+        return static_cast<uint16_t>(in[0] | (in[1] << 8));
+    }
+
+    uint32_t LoadUInt32(const uint8_t* in)
+    {
+        return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) | (static_cast<uint32_t>(in[2]) << 16)
+               | (static_cast<uint32_t>(in[3]) << 24);
+    }
+}
+
+SnapshotWriter::SnapshotWriter(uint8_t* buffer, size_t capacity)
+    : m_buffer(buffer)
+    , m_capacity(buffer != nullptr ? capacity : 0)
+    , m_size(0)
+{
+}
+
+// Returns where the next count bytes go, or nullptr once they no longer fit in the buffer
+uint8_t* SnapshotWriter::Reserve(size_t count)
+{
+    uint8_t* out = (m_size + count <= m_capacity) ? m_buffer + m_size : nullptr;
+    m_size += count;
+    return out;
+}
+
+void SnapshotWriter::WriteUInt8(uint8_t value)
+{
+    if (uint8_t* out = Reserve(1))
+    {
+        *out = value;
+    }
+}
+
+void SnapshotWriter::WriteBool(bool value)
+{
+    WriteUInt8(value ? 1 : 0);
+}
+
+void SnapshotWriter::WriteUInt32(uint32_t value)
+{
+    if (uint8_t* out = Reserve(sizeof(uint32_t)))
+    {
+        StoreUInt32(out, value);
+    }
+}
+
+void SnapshotWriter::WriteInt32(int32_t value)
+{
+    WriteUInt32(static_cast<uint32_t>(value));
+}
+
+void SnapshotWriter::WriteUInt64(uint64_t value)
+{
+    WriteUInt32(static_cast<uint32_t>(value));
+    WriteUInt32(static_cast<uint32_t>(value >> 32));
+}
+
+void SnapshotWriter::WriteByteArray(const uint8_t* bytes, size_t count)
+{
+    WriteUInt32(static_cast<uint32_t>(count));
+    uint8_t* out = Reserve(count);
+    if (out != nullptr && count != 0)
+    {
+        memcpy(out, bytes, count);
+    }
+}
+
+void SnapshotWriter::WriteString(wstring_view value)
+{
+    size_t length = value.size();
+    if constexpr (sizeof(wchar_t) > sizeof(uint16_t))
+    {
+        for (wchar_t c : value)
+        {
+            if (static_cast<uint32_t>(c) >= SUPPLEMENTARY_PLANE_FIRST)
+            {
+                length++;
+            }
+        }
+    }
+
+    WriteUInt32(static_cast<uint32_t>(length));
+    uint8_t* out = Reserve(length * sizeof(uint16_t));
+    if (out == nullptr)
+    {
+        return;
+    }
+
+    for (wchar_t c : value)
+    {
+        uint32_t codePoint = static_cast<uint32_t>(c);
+        if (codePoint >= SUPPLEMENTARY_PLANE_FIRST)
+        {
+            codePoint -= SUPPLEMENTARY_PLANE_FIRST;
+            StoreUInt16(out, static_cast<uint16_t>(HIGH_SURROGATE_FIRST + (codePoint >> 10)));
+            StoreUInt16(out + sizeof(uint16_t), static_cast<uint16_t>(LOW_SURROGATE_FIRST + (codePoint & 0x3FF)));
+            out += 2 * sizeof(uint16_t);
+        }
+        else
+        {
+            StoreUInt16(out, static_cast<uint16_t>(codePoint));
+            out += sizeof(uint16_t);
+        }
+    }
+}
+
+// How a Number is written:
+//     Sign, Exp, Mantissa.size, Mantissa[0], ..., Mantissa[size - 1]
+// A Rational is its P followed by its Q.
+void SnapshotWriter::WriteNumber(Number const& value)
+{
+    auto const& mantissa = value.Mantissa();
+    WriteInt32(value.Sign());
+    WriteInt32(value.Exp());
+    WriteUInt32(static_cast<uint32_t>(mantissa.size()));
+
+    if (uint8_t* out = Reserve(mantissa.size() * sizeof(uint32_t)))
+    {
+        for (uint32_t digit : mantissa)
+        {
+            StoreUInt32(out, digit);
+            out += sizeof(uint32_t);
+        }
+    }
+}
+
+void SnapshotWriter::WriteRational(Rational const& value)
+{
+    WriteNumber(value.P());
+    WriteNumber(value.Q());
+}
+
+void SnapshotWriter::PatchUInt32(size_t offset, uint32_t value)
+{
+    if (offset + sizeof(uint32_t) <= m_capacity)
+    {
+        StoreUInt32(m_buffer + offset, value);
+    }
+}
+
+SnapshotReader::SnapshotReader(const uint8_t* data, size_t size)
+    : m_data(data)
+    , m_remaining(data != nullptr ? size : 0)
+    , m_isValid(true)
+{
+}
+
+void SnapshotReader::Invalidate()
+{
+    m_isValid = false;
+    m_remaining = 0;
+}
+
+const uint8_t* SnapshotReader::ReadBytes(size_t count)
+{
+    if (count > m_remaining)
+    {
+        Invalidate();
+        return nullptr;
+    }
+
+    const uint8_t* in = m_data;
+    m_data += count;
+    m_remaining -= count;
+    return in;
+}
+
+uint8_t SnapshotReader::ReadUInt8()
+{
+    const uint8_t* in = ReadBytes(1);
+    return in != nullptr ? *in : 0;
+}
+
+bool SnapshotReader::ReadBool()
+{
+    uint8_t value = ReadUInt8();
+    if (value > 1)
+    {
+        Invalidate();
+    }
+
+    return value == 1;
+}
+
+uint32_t SnapshotReader::ReadUInt32()
+{
+    const uint8_t* in = ReadBytes(sizeof(uint32_t));
+    return in != nullptr ? LoadUInt32(in) : 0;
+}
+
+int32_t SnapshotReader::ReadInt32()
+{
+    return static_cast<int32_t>(ReadUInt32());
+}
+
+uint64_t SnapshotReader::ReadUInt64()
+{
+    uint64_t low = ReadUInt32();
+    uint64_t high = ReadUInt32();
+    return low | (high << 32);
+}
+
+uint32_t SnapshotReader::ReadCount(size_t maxCount)
+{
+    // Every element takes at least one byte, so a count over what is left cannot be right either
+    uint32_t count = ReadUInt32();
+    if (count > maxCount || count > m_remaining)
+    {
+        Invalidate();
+        return 0;
+    }
+
+    return count;
+}
+
+void SnapshotReader::ReadString(wstring& value)
+{
+    value.clear();
+
+    uint32_t length = ReadUInt32();
+    if (length > m_remaining / sizeof(uint16_t))
+    {
+        Invalidate();
+        return;
+    }
+
+    const uint8_t* in = ReadBytes(length * sizeof(uint16_t));
+    const uint8_t* end = in + length * sizeof(uint16_t);
+    value.reserve(length);
+    while (in < end)
+    {
+        uint32_t unit = LoadUInt16(in);
+        in += sizeof(uint16_t);
+
+        if constexpr (sizeof(wchar_t) > sizeof(uint16_t))
+        {
+            if (unit >= HIGH_SURROGATE_FIRST && unit <= HIGH_SURROGATE_LAST && in < end)
+            {
+                uint32_t lowUnit = LoadUInt16(in);
+                if (lowUnit >= LOW_SURROGATE_FIRST && lowUnit <= LOW_SURROGATE_LAST)
+                {
+                    unit = SUPPLEMENTARY_PLANE_FIRST + ((unit - HIGH_SURROGATE_FIRST) << 10) + (lowUnit - LOW_SURROGATE_FIRST);
+                    in += sizeof(uint16_t);
+                }
+            }
+        }
+
+        value.push_back(static_cast<wchar_t>(unit));
+    }
+}
+
+void SnapshotReader::ReadNumber(Number& value)
+{
+    int32_t sign = ReadInt32();
+    int32_t exp = ReadInt32();
+    uint32_t size = ReadUInt32();
+    if ((sign != 1 && sign != -1) || size == 0 || size > m_remaining / sizeof(uint32_t))
+    {
+        Invalidate();
+        return;
+    }
+
+    const uint8_t* in = ReadBytes(size * sizeof(uint32_t));
+    value.m_sign = sign;
+    value.m_exp = exp;
+    value.m_mantissa.resize(size);
+    for (uint32_t& digit : value.m_mantissa)
+    {
+        digit = LoadUInt32(in);
+        in += sizeof(uint32_t);
+    }
+}
+
+void SnapshotReader::ReadRational(Rational& value)
+{
+    if (m_remaining < 2 * MIN_SERIALIZED_NUMBER_SIZE)
+    {
+        Invalidate();
+        return;
+    }
+
+    ReadNumber(value.m_p);
+    ReadNumber(value.m_q);
+}
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <cassert>
 #include "Header Files/CalcEngine.h"
 #include "CalculatorResource.h"
@@ -16,6 +17,9 @@ static constexpr int DEFAULT_MAX_DIGITS = 32;
 static constexpr int DEFAULT_PRECISION = 32;
 static constexpr int32_t DEFAULT_RADIX = 10;
 
+// Well over any precision the calculator uses, but low enough that a bad snapshot can't stall Ratpack
+static constexpr int32_t MAX_SNAPSHOT_PRECISION = 1000;
+
 static constexpr wchar_t DEFAULT_DEC_SEPARATOR = L'.';
 static constexpr wchar_t DEFAULT_GRP_SEPARATOR = L',';
 static constexpr wstring_view DEFAULT_GRP_STR = L"3;0";
@@ -26,6 +30,10 @@ static constexpr wstring_view DEFAULT_NUMBER_STR = L"0";
 
 unordered_map<wstring_view, wstring> CCalcEngine::s_engineStrings;
 
+array<Rational, NUM_WIDTH_LENGTH> CCalcEngine::s_chopNumbers;
+array<wstring, NUM_WIDTH_LENGTH> CCalcEngine::s_maxDecimalValueStrings;
+Rational CCalcEngine::s_maxTrigonometricNum;
+
 void CCalcEngine::LoadEngineStrings(CalculationManager::IResourceProvider& resourceProvider)
 {
     for (const auto& sid : g_sids)
@@ -50,6 +58,8 @@ void CCalcEngine::InitialOneTimeOnlySetup(CalculationManager::IResourceProvider&
     // we must now set up all the ratpak constants and our arrayed pointers
     // to these constants.
     ChangeBaseConstants(DEFAULT_RADIX, DEFAULT_MAX_DIGITS, DEFAULT_PRECISION);
+
+    InitChopNumbers();
 }
 
 //////////////////////////////////////////////////
@@ -66,6 +76,7 @@ CCalcEngine::CCalcEngine(
     : m_fPrecedence(fPrecedence)
     , m_fIntegerMode(fIntegerMode)
     , m_pCalcDisplay(pCalcDisplay)
+    , m_pCommandTracer(nullptr)
     , m_resourceProvider(pResourceProvider)
     , m_nOpCode(0)
     , m_nPrevOpCode(0)
@@ -88,6 +99,7 @@ CCalcEngine::CCalcEngine(
     , m_cIntDigitsSav(DEFAULT_MAX_DIGITS)
     , m_decGrouping()
     , m_numberString(DEFAULT_NUMBER_STR)
+    , m_lastDisplay{ 0, -1, 0, -1, (NUM_WIDTH)-1, false, false, false }
     , m_nTempCom(0)
     , m_openParenCount(0)
     , m_nOp()
@@ -99,12 +111,8 @@ CCalcEngine::CCalcEngine(
     , m_HistoryCollector(pCalcDisplay, pHistoryDisplay, DEFAULT_DEC_SEPARATOR)
     , m_groupSeparator(DEFAULT_GRP_SEPARATOR)
 {
-    InitChopNumbers();
-
     m_dwWordBitWidth = DwWordBitWidthFromeNumWidth(m_numwidth);
 
-    m_maxTrigonometricNum = RationalMath::Pow(10, 100);
-
     SetRadixTypeAndNumWidth(DEC_RADIX, m_numwidth);
     SettingsChanged();
     DisplayNum();
@@ -114,22 +122,29 @@ void CCalcEngine::InitChopNumbers()
 {
     // these rat numbers are set only once and then never change regardless of
     // base or precision changes
-    assert(m_chopNumbers.size() >= 4);
-    m_chopNumbers[0] = Rational{ rat_qword };
-    m_chopNumbers[1] = Rational{ rat_dword };
-    m_chopNumbers[2] = Rational{ rat_word };
-    m_chopNumbers[3] = Rational{ rat_byte };
+    if (!s_maxDecimalValueStrings[0].empty())
+    {
+        return;
+    }
+
+    assert(s_chopNumbers.size() >= 4);
+    s_chopNumbers[0] = Rational{ rat_qword };
+    s_chopNumbers[1] = Rational{ rat_dword };
+    s_chopNumbers[2] = Rational{ rat_word };
+    s_chopNumbers[3] = Rational{ rat_byte };
 
     // initialize the max dec number you can support for each of the supported bit lengths
     // this is basically max num in that width / 2 in integer
-    assert(m_chopNumbers.size() == m_maxDecimalValueStrings.size());
-    for (size_t i = 0; i < m_chopNumbers.size(); i++)
+    assert(s_chopNumbers.size() == s_maxDecimalValueStrings.size());
+    for (size_t i = 0; i < s_chopNumbers.size(); i++)
     {
-        auto maxVal = m_chopNumbers[i] / 2;
+        auto maxVal = s_chopNumbers[i] / 2;
         maxVal = RationalMath::Integer(maxVal);
 
-        m_maxDecimalValueStrings[i] = maxVal.ToString(10, FMT_FLOAT, m_precision);
+        s_maxDecimalValueStrings[i] = maxVal.ToString(10, FMT_FLOAT, DEFAULT_PRECISION);
     }
+
+    s_maxTrigonometricNum = RationalMath::Pow(10, 100);
 }
 
 // Gets the number in memory for UI to keep it persisted and set it again to a different instance
@@ -144,6 +159,190 @@ void CCalcEngine::PersistedMemObject(Rational const& memObject)
     m_memoryValue = make_unique<Rational>(memObject);
 }
 
+void CCalcEngine::SaveSnapshot(SnapshotWriter& writer) const
+{
+    writer.WriteInt32(m_nOpCode);
+    writer.WriteInt32(m_nPrevOpCode);
+    writer.WriteBool(m_bChangeOp);
+    writer.WriteBool(m_bRecord);
+    writer.WriteBool(m_bSetCalcState);
+    m_input.SaveSnapshot(writer);
+    writer.WriteUInt32(m_nFE);
+
+    writer.WriteBool(m_memoryValue != nullptr);
+    if (m_memoryValue != nullptr)
+    {
+        writer.WriteRational(*m_memoryValue);
+    }
+
+    writer.WriteRational(m_holdVal);
+    writer.WriteRational(m_currentVal);
+    writer.WriteRational(m_lastVal);
+    writer.WriteBool(m_bError);
+    writer.WriteBool(m_bInv);
+    writer.WriteBool(m_bNoPrevEqu);
+    writer.WriteUInt32(m_radix);
+    writer.WriteInt32(m_precision);
+    writer.WriteString(m_numberString);
+    writer.WriteInt32(m_nTempCom);
+
+    // Only the used part of the parenthesis and precedence stacks
+    writer.WriteUInt32(static_cast<uint32_t>(m_openParenCount));
+    for (size_t i = 0; i < m_openParenCount; i++)
+    {
+        writer.WriteRational(m_parenVals[i]);
+        writer.WriteInt32(m_nOp[i]);
+    }
+    writer.WriteUInt32(static_cast<uint32_t>(m_precedenceOpCount));
+    for (size_t i = 0; i < m_precedenceOpCount; i++)
+    {
+        writer.WriteRational(m_precedenceVals[i]);
+        writer.WriteInt32(m_nPrecOp[i]);
+    }
+
+    // Opening a parenthesis pushes a marker without setting its value, and "=" reads that value into m_lastVal, so the
+    // values left above the stack by earlier operations are kept too. Only the ones that are not zero are written.
+    uint32_t leftoverCount = 0;
+    for (size_t i = m_precedenceOpCount; i < MAXPRECDEPTH; i++)
+    {
+        leftoverCount += m_precedenceVals[i].P().IsZero() ? 0 : 1;
+    }
+    writer.WriteUInt32(leftoverCount);
+    for (size_t i = m_precedenceOpCount; i < MAXPRECDEPTH; i++)
+    {
+        if (!m_precedenceVals[i].P().IsZero())
+        {
+            writer.WriteUInt32(static_cast<uint32_t>(i));
+            writer.WriteRational(m_precedenceVals[i]);
+        }
+    }
+
+    writer.WriteInt32(m_nLastCom);
+    writer.WriteUInt32(m_angletype);
+    writer.WriteUInt32(m_numwidth);
+    writer.WriteUInt64(m_carryBit);
+    m_HistoryCollector.SaveSnapshot(writer);
+
+    // DisplayNum does nothing while the value and settings are the ones it last displayed
+    writer.WriteRational(m_lastDisplay.value);
+    writer.WriteInt32(m_lastDisplay.precision);
+    writer.WriteUInt32(m_lastDisplay.radix);
+    writer.WriteInt32(m_lastDisplay.nFE);
+    writer.WriteInt32(m_lastDisplay.numwidth);
+    writer.WriteBool(m_lastDisplay.fIntMath);
+    writer.WriteBool(m_lastDisplay.bRecord);
+    writer.WriteBool(m_lastDisplay.bUseSep);
+}
+
+void CCalcEngine::RestoreSnapshot(SnapshotReader& reader)
+{
+    m_nOpCode = reader.ReadInt32();
+    m_nPrevOpCode = reader.ReadInt32();
+    m_bChangeOp = reader.ReadBool();
+    m_bRecord = reader.ReadBool();
+    m_bSetCalcState = reader.ReadBool();
+    m_input.RestoreSnapshot(reader);
+    uint32_t numberFormat = reader.ReadUInt32();
+
+    if (reader.ReadBool())
+    {
+        if (m_memoryValue == nullptr)
+        {
+            m_memoryValue = make_unique<Rational>();
+        }
+        reader.ReadRational(*m_memoryValue);
+    }
+    else
+    {
+        m_memoryValue = nullptr;
+    }
+
+    reader.ReadRational(m_holdVal);
+    reader.ReadRational(m_currentVal);
+    reader.ReadRational(m_lastVal);
+    m_bError = reader.ReadBool();
+    m_bInv = reader.ReadBool();
+    m_bNoPrevEqu = reader.ReadBool();
+    uint32_t radix = reader.ReadUInt32();
+    int32_t precision = reader.ReadInt32();
+    reader.ReadString(m_numberString);
+    m_nTempCom = reader.ReadInt32();
+
+    m_openParenCount = reader.ReadCount(MAXPRECDEPTH);
+    for (size_t i = 0; i < m_openParenCount; i++)
+    {
+        reader.ReadRational(m_parenVals[i]);
+        m_nOp[i] = reader.ReadInt32();
+    }
+    m_precedenceOpCount = reader.ReadCount(MAXPRECDEPTH);
+    for (size_t i = 0; i < m_precedenceOpCount; i++)
+    {
+        reader.ReadRational(m_precedenceVals[i]);
+        m_nPrecOp[i] = reader.ReadInt32();
+    }
+
+    for (size_t i = m_precedenceOpCount; i < MAXPRECDEPTH; i++)
+    {
+        if (!m_precedenceVals[i].P().IsZero())
+        {
+            m_precedenceVals[i] = Rational{};
+        }
+    }
+    uint32_t leftoverCount = reader.ReadCount(MAXPRECDEPTH);
+    for (uint32_t i = 0; i < leftoverCount; i++)
+    {
+        uint32_t index = reader.ReadUInt32();
+        if (index < m_precedenceOpCount || index >= MAXPRECDEPTH)
+        {
+            reader.Invalidate();
+            break;
+        }
+        reader.ReadRational(m_precedenceVals[index]);
+    }
+
+    m_nLastCom = reader.ReadInt32();
+    uint32_t angleType = reader.ReadUInt32();
+    uint32_t numWidth = reader.ReadUInt32();
+    m_carryBit = reader.ReadUInt64();
+    m_HistoryCollector.RestoreSnapshot(reader);
+
+    // Only compared with the current state, so any values will do
+    reader.ReadRational(m_lastDisplay.value);
+    m_lastDisplay.precision = reader.ReadInt32();
+    m_lastDisplay.radix = reader.ReadUInt32();
+    m_lastDisplay.nFE = reader.ReadInt32();
+    m_lastDisplay.numwidth = static_cast<NUM_WIDTH>(reader.ReadInt32());
+    m_lastDisplay.fIntMath = reader.ReadBool();
+    m_lastDisplay.bRecord = reader.ReadBool();
+    m_lastDisplay.bUseSep = reader.ReadBool();
+
+    // The values below index arrays or drive Ratpack, so a snapshot that is out of range for them is rejected
+    if (numberFormat > FMT_ENGINEERING || (radix != 2 && radix != 8 && radix != 10 && radix != 16) || precision <= 0
+        || precision > MAX_SNAPSHOT_PRECISION || angleType > ANGLE_GRAD || numWidth > BYTE_WIDTH)
+    {
+        reader.Invalidate();
+    }
+
+    // Closing a parenthesis pops the precedence stack down to the marker that opening it pushed
+    if (static_cast<size_t>(count(m_nPrecOp.begin(), m_nPrecOp.begin() + m_precedenceOpCount, 0)) < m_openParenCount)
+    {
+        reader.Invalidate();
+    }
+
+    if (!reader.IsValid())
+    {
+        return;
+    }
+
+    m_nFE = static_cast<NUMOBJ_FMT>(numberFormat);
+    m_radix = radix;
+    m_precision = precision;
+    m_angletype = static_cast<ANGLE_TYPE>(angleType);
+    m_numwidth = static_cast<NUM_WIDTH>(numWidth);
+    m_dwWordBitWidth = DwWordBitWidthFromeNumWidth(m_numwidth);
+    BaseOrPrecisionChanged();
+}
+
 void CCalcEngine::SettingsChanged()
 {
     wchar_t lastDec = m_decimalSeparator;
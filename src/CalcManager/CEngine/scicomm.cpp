@@ -13,6 +13,9 @@
 * Author:
 \****************************************************************************/
 
+#include <chrono>
+#include <iomanip>
+#include <sstream>
 #include <string>
 #include "Header Files/CalcEngine.h"
 #include "Header Files/CalcUtils.h"
@@ -49,8 +52,64 @@ namespace
         }
         return rgbPrec[iPrec + 1];
     }
+
+    uint64_t GetTraceTime()
+    {
+        return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count());
+    }
 }
 
+// CommandTraceScope
+//
+// Tells the command tracer of the engine, if it has one, that a command starts, and that it ends when the scope does,
+// whichever way ProcessCommandWorker returns. The size of the operand is that of the number being entered, if there
+// is one, as that is what the command works on; it is counted rather than converted, so that tracing doesn't run
+// Ratpack before the command does.
+class CCalcEngine::CommandTraceScope
+{
+public:
+    CommandTraceScope(CCalcEngine& engine, OpCode wParam)
+        : m_pCommandTracer(engine.m_pCommandTracer)
+        , m_trace{}
+    {
+        if (m_pCommandTracer == nullptr)
+        {
+            return;
+        }
+
+        m_trace.opCode = static_cast<int>(wParam);
+        m_trace.radix = engine.m_radix;
+        m_trace.precision = engine.m_precision;
+        if (engine.m_bRecord)
+        {
+            m_trace.inputDigits = static_cast<uint32_t>(engine.m_input.GetDigitCount());
+        }
+        else
+        {
+            m_trace.numeratorDigits = static_cast<uint32_t>(engine.m_currentVal.P().Mantissa().size());
+            m_trace.denominatorDigits = static_cast<uint32_t>(engine.m_currentVal.Q().Mantissa().size());
+        }
+        m_trace.startTime = GetTraceTime();
+        m_pCommandTracer->OnCommandStarted(m_trace);
+    }
+
+    ~CommandTraceScope()
+    {
+        if (m_pCommandTracer != nullptr)
+        {
+            m_trace.elapsedTime = GetTraceTime() - m_trace.startTime;
+            m_pCommandTracer->OnCommandEnded(m_trace);
+        }
+    }
+
+    CommandTraceScope(CommandTraceScope const&) = delete;
+    CommandTraceScope& operator=(CommandTraceScope const&) = delete;
+
+private:
+    ICalcCommandTracer* const m_pCommandTracer;
+    CalcCommandTrace m_trace;
+};
+
 // HandleErrorCommand
 //
 // When it is discovered by the state machine that at this point the input is not valid (eg. "1+)"), we want to proceed as though this input never
@@ -104,6 +163,7 @@ void CCalcEngine::ProcessCommand(OpCode wParam)
 
 void CCalcEngine::ProcessCommandWorker(OpCode wParam)
 {
+    CommandTraceScope traceScope(*this, wParam);
     int nx, ni;
 
     // Save the last command.  Some commands are not saved in this manor, these
@@ -185,7 +245,7 @@ void CCalcEngine::ProcessCommandWorker(OpCode wParam)
             return;
         }
 
-        if (!m_input.TryAddDigit(iValue, m_radix, m_fIntegerMode, m_maxDecimalValueStrings[m_numwidth], m_dwWordBitWidth, m_cIntDigitsSav))
+        if (!m_input.TryAddDigit(iValue, m_radix, m_fIntegerMode, s_maxDecimalValueStrings[m_numwidth], m_dwWordBitWidth, m_cIntDigitsSav))
         {
             HandleErrorCommand(wParam);
             HandleMaxDigitsReached();
@@ -662,7 +722,7 @@ void CCalcEngine::ProcessCommandWorker(OpCode wParam)
     {
         if (m_bRecord)
         {
-            if (m_input.TryToggleSign(m_fIntegerMode, m_maxDecimalValueStrings[m_numwidth]))
+            if (m_input.TryToggleSign(m_fIntegerMode, s_maxDecimalValueStrings[m_numwidth]))
             {
                 DisplayNum();
             }
@@ -1056,7 +1116,7 @@ wstring_view CCalcEngine::OpCodeToBinaryString(int nOpCode, bool isIntegerMode)
 
 bool CCalcEngine::IsCurrentTooBigForTrig()
 {
-    return m_currentVal >= m_maxTrigonometricNum;
+    return m_currentVal >= s_maxTrigonometricNum;
 }
 
 int CCalcEngine::GetCurrentRadix()
@@ -1108,7 +1168,7 @@ wstring CCalcEngine::GetStringForDisplay(Rational const& rat, uint32_t radix)
             if ((radix == 10) && fMsb)
             {
                 // If high bit is set, then get the decimal number in negative 2's complement form.
-                tempRat = -((tempRat ^ m_chopNumbers[m_numwidth]) + 1);
+                tempRat = -((tempRat ^ s_chopNumbers[m_numwidth]) + 1);
             }
 
             result = tempRat.ToString(radix, m_nFE, m_precision);
@@ -14,7 +14,6 @@
 \****************************************************************************/
 
 #include <sstream>
-#include <regex>
 #include "Header Files/CalcEngine.h"
 
 using namespace std;
@@ -22,8 +21,6 @@ using namespace CalcEngine;
 
 constexpr int MAX_EXPONENT = 4;
 constexpr uint32_t MAX_GROUPING_SIZE = 16;
-constexpr wstring_view c_decPreSepStr = L"[+-]?(\\d*)[";
-constexpr wstring_view c_decPostSepStr = L"]?(\\d*)(?:e[+-]?(\\d*))?$";
 
 /****************************************************************************\
 * void DisplayNum(void)
@@ -33,23 +30,6 @@ constexpr wstring_view c_decPostSepStr = L"]?(\\d*)(?:e[+-]?(\\d*))?$";
 * Updates the following variables:
 *   m_currentVal, m_numberString
 \****************************************************************************/
-//
-// State of calc last time DisplayNum was called
-//
-typedef struct
-{
-    Rational value;
-    int32_t precision;
-    uint32_t radix;
-    int nFE;
-    NUM_WIDTH numwidth;
-    bool fIntMath;
-    bool bRecord;
-    bool bUseSep;
-} LASTDISP;
-
-static LASTDISP gldPrevious = { 0, -1, 0, -1, (NUM_WIDTH)-1, false, false, false };
-
 // Truncates if too big, makes it a non negative - the number in rat. Doesn't do anything if not in INT mode
 CalcEngine::Rational CCalcEngine::TruncateNumForIntMath(CalcEngine::Rational const& rat)
 {
@@ -67,10 +47,10 @@ CalcEngine::Rational CCalcEngine::TruncateNumForIntMath(CalcEngine::Rational con
     {
         // if negative make positive by doing a twos complement
         result = -(result)-1;
-        result ^= m_chopNumbers[m_numwidth];
+        result ^= s_chopNumbers[m_numwidth];
     }
 
-    result &= m_chopNumbers[m_numwidth];
+    result &= s_chopNumbers[m_numwidth];
 
     return result;
 }
@@ -84,17 +64,17 @@ void CCalcEngine::DisplayNum(void)
     //  something important has changed since the last time DisplayNum was
     //  called.
     //
-    if (m_bRecord || gldPrevious.value != m_currentVal || gldPrevious.precision != m_precision || gldPrevious.radix != m_radix || gldPrevious.nFE != (int)m_nFE
-        || gldPrevious.bUseSep != true || gldPrevious.numwidth != m_numwidth || gldPrevious.fIntMath != m_fIntegerMode || gldPrevious.bRecord != m_bRecord)
+    if (m_bRecord || m_lastDisplay.value != m_currentVal || m_lastDisplay.precision != m_precision || m_lastDisplay.radix != m_radix || m_lastDisplay.nFE != (int)m_nFE
+        || m_lastDisplay.bUseSep != true || m_lastDisplay.numwidth != m_numwidth || m_lastDisplay.fIntMath != m_fIntegerMode || m_lastDisplay.bRecord != m_bRecord)
     {
-        gldPrevious.precision = m_precision;
-        gldPrevious.radix = m_radix;
-        gldPrevious.nFE = (int)m_nFE;
-        gldPrevious.numwidth = m_numwidth;
+        m_lastDisplay.precision = m_precision;
+        m_lastDisplay.radix = m_radix;
+        m_lastDisplay.nFE = (int)m_nFE;
+        m_lastDisplay.numwidth = m_numwidth;
 
-        gldPrevious.fIntMath = m_fIntegerMode;
-        gldPrevious.bRecord = m_bRecord;
-        gldPrevious.bUseSep = true;
+        m_lastDisplay.fIntMath = m_fIntegerMode;
+        m_lastDisplay.bRecord = m_bRecord;
+        m_lastDisplay.bUseSep = true;
 
         if (m_bRecord)
         {
@@ -112,7 +92,7 @@ void CCalcEngine::DisplayNum(void)
         }
 
         // Displayed number can go through transformation. So copy it after transformation
-        gldPrevious.value = m_currentVal;
+        m_lastDisplay.value = m_currentVal;
 
         if ((m_radix == 10) && IsNumberInvalid(m_numberString, MAX_EXPONENT, m_precision, m_radix))
         {
@@ -140,26 +120,62 @@ int CCalcEngine::IsNumberInvalid(const wstring& numberString, int iMaxExp, int i
         // in case there's an exponent:
         //      its optionally followed by a + or -
         //      which is followed by zero or more digits
-        wregex rx(wstring{ c_decPreSepStr } + m_decimalSeparator + wstring{ c_decPostSepStr });
-        wsmatch matches;
-        if (regex_match(numberString, matches, rx))
+        //
+        // The string is scanned once, left to right. Each part is consumed greedily, which yields the same
+        // accept/reject result and the same part lengths as the equivalent (backtracking) regex.
+        auto itr = numberString.cbegin();
+        auto end = numberString.cend();
+        auto skipDigits = [&itr, &end]() {
+            auto start = itr;
+            while (itr != end && iswdigit(*itr))
+            {
+                itr++;
+            }
+            return start;
+        };
+
+        if (itr != end && (*itr == L'+' || *itr == L'-'))
+        {
+            itr++;
+        }
+
+        auto intBegin = skipDigits();
+        auto intEnd = itr;
+
+        if (itr != end && *itr == m_decimalSeparator)
+        {
+            itr++;
+        }
+
+        auto fracLength = distance(skipDigits(), itr);
+
+        ptrdiff_t expLength = 0;
+        if (itr != end && *itr == L'e')
+        {
+            itr++;
+            if (itr != end && (*itr == L'+' || *itr == L'-'))
+            {
+                itr++;
+            }
+
+            expLength = distance(skipDigits(), itr);
+        }
+
+        if (itr == end)
         {
             // Check that exponent isn't too long
-            if (matches.length(3) > iMaxExp)
+            if (expLength > iMaxExp)
             {
                 iError = IDS_ERR_INPUT_OVERFLOW;
             }
             else
             {
-                wstring exp = matches.str(1);
-                auto intItr = exp.begin();
-                auto intEnd = exp.end();
-                while (intItr != intEnd && *intItr == L'0')
+                while (intBegin != intEnd && *intBegin == L'0')
                 {
-                    intItr++;
+                    intBegin++;
                 }
 
-                auto iMantissa = distance(intItr, intEnd) + matches.length(2);
+                auto iMantissa = distance(intBegin, intEnd) + fracLength;
                 if (iMantissa > iMaxMantissa)
                 {
                     iError = IDS_ERR_INPUT_OVERFLOW;
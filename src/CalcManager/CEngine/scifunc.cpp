@@ -17,6 +17,7 @@
 /***                                                                    ***/
 /**************************************************************************/
 #include "Header Files/CalcEngine.h"
+#include "winerror_cross_platform.h"
 
 using namespace std;
 using namespace CalcEngine;
@@ -42,7 +43,7 @@ CalcEngine::Rational CCalcEngine::SciCalcFunctions(CalcEngine::Rational const& r
             }
             else
             {
-                result = rat ^ m_chopNumbers[m_numwidth];
+                result = rat ^ s_chopNumbers[m_numwidth];
             }
             break;
 
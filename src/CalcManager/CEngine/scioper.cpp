@@ -29,11 +29,11 @@ CalcEngine::Rational CCalcEngine::DoOperation(int operation, CalcEngine::Rationa
             break;
 
         case IDC_NAND:
-            result = (result & rhs) ^ m_chopNumbers[m_numwidth];
+            result = (result & rhs) ^ s_chopNumbers[m_numwidth];
             break;
 
         case IDC_NOR:
-            result = (result | rhs) ^ m_chopNumbers[m_numwidth];
+            result = (result | rhs) ^ s_chopNumbers[m_numwidth];
             break;
 
         case IDC_RSHF:
@@ -53,10 +53,10 @@ CalcEngine::Rational CCalcEngine::DoOperation(int operation, CalcEngine::Rationa
             {
                 result = Integer(result);
 
-                auto tempRat = m_chopNumbers[m_numwidth] >> holdVal;
+                auto tempRat = s_chopNumbers[m_numwidth] >> holdVal;
                 tempRat = Integer(tempRat);
 
-                result |= tempRat ^ m_chopNumbers[m_numwidth];
+                result |= tempRat ^ s_chopNumbers[m_numwidth];
             }
             break;
         }
@@ -105,7 +105,7 @@ CalcEngine::Rational CCalcEngine::DoOperation(int operation, CalcEngine::Rationa
 
                 if (fMsb)
                 {
-                    result = (rhs ^ m_chopNumbers[m_numwidth]) + 1;
+                    result = (rhs ^ s_chopNumbers[m_numwidth]) + 1;
 
                     iNumeratorSign = -1;
                 }
@@ -115,7 +115,7 @@ CalcEngine::Rational CCalcEngine::DoOperation(int operation, CalcEngine::Rationa
 
                 if (fMsb)
                 {
-                    temp = (temp ^ m_chopNumbers[m_numwidth]) + 1;
+                    temp = (temp ^ s_chopNumbers[m_numwidth]) + 1;
 
                     iDenominatorSign = -1;
                 }
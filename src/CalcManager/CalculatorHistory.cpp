@@ -41,21 +41,19 @@ unsigned int CalculatorHistory::AddToHistory(
     _In_ shared_ptr<vector<shared_ptr<IExpressionCommand>>> const& commands,
     wstring_view result)
 {
-    unsigned int addedIndex;
-    shared_ptr<HISTORYITEM> spHistoryItem = make_shared<HISTORYITEM>();
-
-    spHistoryItem->historyItemVector.spTokens = tokens;
-    spHistoryItem->historyItemVector.spCommands = commands;
-
     // to be changed when pszexp is back
     wstring generatedExpression = GetGeneratedExpression(*tokens);
     // Prefixing and suffixing the special Unicode markers to ensure that the expression
     // in the history doesn't get broken for RTL languages
-    spHistoryItem->historyItemVector.expression = L'\u202d' + generatedExpression + L'\u202c';
-    spHistoryItem->historyItemVector.result = wstring(result);
-    addedIndex = AddItem(spHistoryItem);
+    StoredHistoryItem storedItem{ CompactExpression(*tokens, *commands), L'\u202d' + generatedExpression + L'\u202c', wstring(result), {} };
+
+    if (m_historyItems.size() >= m_maxHistorySize)
+    {
+        m_historyItems.erase(m_historyItems.begin());
+    }
 
-    return addedIndex;
+    m_historyItems.push_back(move(storedItem));
+    return static_cast<unsigned>(m_historyItems.size() - 1);
 }
 
 unsigned int CalculatorHistory::AddItem(_In_ shared_ptr<HISTORYITEM> const& spHistoryItem)
@@ -65,7 +63,9 @@ unsigned int CalculatorHistory::AddItem(_In_ shared_ptr<HISTORYITEM> const& spHi
         m_historyItems.erase(m_historyItems.begin());
     }
 
-    m_historyItems.push_back(spHistoryItem);
+    auto const& historyItemVector = spHistoryItem->historyItemVector;
+    m_historyItems.push_back(
+        { CompactExpression(*historyItemVector.spTokens, *historyItemVector.spCommands), historyItemVector.expression, historyItemVector.result, {} });
     unsigned int lastIndex = static_cast<unsigned>(m_historyItems.size() - 1);
     return lastIndex;
 }
@@ -81,18 +81,67 @@ bool CalculatorHistory::RemoveItem(unsigned int uIdx)
     return true;
 }
 
-vector<shared_ptr<HISTORYITEM>> const& CalculatorHistory::GetHistory()
+vector<shared_ptr<HISTORYITEM>> CalculatorHistory::GetHistory()
 {
-    return m_historyItems;
+    vector<shared_ptr<HISTORYITEM>> historyItems;
+    historyItems.reserve(m_historyItems.size());
+    for (auto& storedItem : m_historyItems)
+    {
+        historyItems.push_back(GetItem(storedItem));
+    }
+
+    return historyItems;
 }
 
-shared_ptr<HISTORYITEM> const& CalculatorHistory::GetHistoryItem(unsigned int uIdx)
+shared_ptr<HISTORYITEM> CalculatorHistory::GetHistoryItem(unsigned int uIdx)
 {
     assert(uIdx >= 0 && uIdx < m_historyItems.size());
-    return m_historyItems.at(uIdx);
+    return GetItem(m_historyItems.at(uIdx));
 }
 
 void CalculatorHistory::ClearHistory()
 {
     m_historyItems.clear();
 }
+
+shared_ptr<HISTORYITEM> CalculatorHistory::GetItem(StoredHistoryItem& storedItem)
+{
+    shared_ptr<HISTORYITEM> spHistoryItem = storedItem.item.lock();
+    if (spHistoryItem == nullptr)
+    {
+        // Not make_shared, so that the item's memory is released once it's no longer used rather than when the
+        // weak_ptr to it is
+        spHistoryItem = shared_ptr<HISTORYITEM>(new HISTORYITEM());
+        spHistoryItem->historyItemVector.spTokens = storedItem.compactExpression.GetTokens();
+        spHistoryItem->historyItemVector.spCommands = storedItem.compactExpression.GetCommands();
+        spHistoryItem->historyItemVector.expression = storedItem.expression;
+        spHistoryItem->historyItemVector.result = storedItem.result;
+        storedItem.item = spHistoryItem;
+    }
+
+    return spHistoryItem;
+}
+
+void CalculatorHistory::SaveSnapshot(CalcEngine::SnapshotWriter& writer) const
+{
+    writer.WriteUInt32(static_cast<uint32_t>(m_historyItems.size()));
+    for (auto const& storedItem : m_historyItems)
+    {
+        storedItem.compactExpression.SaveSnapshot(writer);
+        writer.WriteString(storedItem.expression);
+        writer.WriteString(storedItem.result);
+    }
+}
+
+// The items are read into the existing ones, so that their storage is reused
+void CalculatorHistory::RestoreSnapshot(CalcEngine::SnapshotReader& reader)
+{
+    m_historyItems.resize(reader.ReadCount(m_maxHistorySize));
+    for (auto& storedItem : m_historyItems)
+    {
+        storedItem.compactExpression.RestoreSnapshot(reader);
+        reader.ReadString(storedItem.expression);
+        reader.ReadString(storedItem.result);
+        storedItem.item.reset();
+    }
+}
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include "CompactExpression.h"
 #include "ExpressionCommandInterface.h"
 #include "Header Files/IHistoryDisplay.h"
 
@@ -34,8 +35,8 @@ namespace CalculationManager
             _In_ std::shared_ptr<std::vector<std::pair<std::wstring, int>>> const& spTokens,
             _In_ std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> const& spCommands,
             std::wstring_view result);
-        std::vector<std::shared_ptr<HISTORYITEM>> const& GetHistory();
-        std::shared_ptr<HISTORYITEM> const& GetHistoryItem(unsigned int uIdx);
+        std::vector<std::shared_ptr<HISTORYITEM>> GetHistory();
+        std::shared_ptr<HISTORYITEM> GetHistoryItem(unsigned int uIdx);
         void ClearHistory();
         unsigned int AddItem(_In_ std::shared_ptr<HISTORYITEM> const& spHistoryItem);
         bool RemoveItem(unsigned int uIdx);
@@ -44,8 +45,24 @@ namespace CalculationManager
             return m_maxHistorySize;
         }
 
+        void SaveSnapshot(CalcEngine::SnapshotWriter& writer) const;
+        void RestoreSnapshot(CalcEngine::SnapshotReader& reader);
+
     private:
-        std::vector<std::shared_ptr<HISTORYITEM>> m_historyItems;
+        // Items are kept as CompactExpressions and only turned back into HISTORYITEMs when they are requested.
+        struct StoredHistoryItem
+        {
+            CompactExpression compactExpression;
+            std::wstring expression;
+            std::wstring result;
+
+            // The HISTORYITEM last returned for this item, which is returned again while it is still in use
+            std::weak_ptr<HISTORYITEM> item;
+        };
+
+        std::shared_ptr<HISTORYITEM> GetItem(StoredHistoryItem& storedItem);
+
+        std::vector<StoredHistoryItem> m_historyItems;
         const size_t m_maxHistorySize;
     };
 }
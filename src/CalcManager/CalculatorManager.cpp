@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include <climits> // for UCHAR_MAX
+#include <limits> // for std::numeric_limits
+#include <stdexcept> // for std::invalid_argument
 #include "Header Files/CalcEngine.h"
 #include "CalculatorManager.h"
 #include "CalculatorResource.h"
@@ -12,6 +14,30 @@ using namespace CalcEngine;
 static constexpr size_t MAX_HISTORY_ITEMS = 20;
 static constexpr size_t SERIALIZED_NUMBER_MINSIZE = 3;
 
+// A snapshot starts with SNAPSHOT_MAGIC, SNAPSHOT_VERSION and the size of the whole snapshot
+static constexpr uint32_t SNAPSHOT_MAGIC = 0x504E5343; // "CSNP"
+static constexpr uint32_t SNAPSHOT_VERSION = 1;
+static constexpr size_t SNAPSHOT_HEADER_SIZE = 3 * sizeof(uint32_t);
+
+static constexpr uint8_t SNAPSHOT_NO_HISTORY = 0;
+static constexpr uint8_t SNAPSHOT_STANDARD_HISTORY = 1;
+static constexpr uint8_t SNAPSHOT_SCIENTIFIC_HISTORY = 2;
+
+// The degree modes that CalculatorManager keeps, CommandNULL being the one of a calculator that was never in degrees
+static bool IsDegreeMode(int32_t command)
+{
+    switch (static_cast<CalculationManager::Command>(command))
+    {
+    case CalculationManager::Command::CommandNULL:
+    case CalculationManager::Command::CommandDEG:
+    case CalculationManager::Command::CommandRAD:
+    case CalculationManager::Command::CommandGRAD:
+        return true;
+    default:
+        return false;
+    }
+}
+
 #ifndef _MSC_VER
 #define __pragma(x)
 #endif
@@ -27,12 +53,14 @@ namespace CalculationManager
         , m_currentCalculatorEngine(nullptr)
         , m_resourceProvider(resourceProvider)
         , m_inHistoryItemLoadMode(false)
+        , m_commandTracer(nullptr)
         , m_persistedPrimaryValue()
         , m_isExponentialFormat(false)
         , m_currentDegreeMode(Command::CommandNULL)
         , m_savedDegreeMode(Command::CommandDEG)
         , m_pStdHistory(new CalculatorHistory(MAX_HISTORY_ITEMS))
         , m_pSciHistory(new CalculatorHistory(MAX_HISTORY_ITEMS))
+        , m_pHistory(nullptr)
     {
         CCalcEngine::InitialOneTimeOnlySetup(*m_resourceProvider);
     }
@@ -105,6 +133,21 @@ namespace CalculationManager
         m_displayCallback->SetMemorizedNumbers(memorizedNumbers);
     }
 
+    void CalculatorManager::InsertMemorizedNumber(unsigned int indexOfMemory, const wstring& memorizedNumber)
+    {
+        m_displayCallback->InsertMemorizedNumber(indexOfMemory, memorizedNumber);
+    }
+
+    void CalculatorManager::UpdateMemorizedNumber(unsigned int indexOfMemory, const wstring& memorizedNumber)
+    {
+        m_displayCallback->UpdateMemorizedNumber(indexOfMemory, memorizedNumber);
+    }
+
+    void CalculatorManager::RemoveMemorizedNumber(unsigned int indexOfMemory)
+    {
+        m_displayCallback->RemoveMemorizedNumber(indexOfMemory);
+    }
+
     /// <summary>
     /// Callback from the engine
     /// </summary>
@@ -156,6 +199,42 @@ namespace CalculationManager
         }
     }
 
+    /// <summary>
+    /// Create the calculator engine of a mode
+    /// </summary>
+    unique_ptr<CCalcEngine> CalculatorManager::CreateEngine(CalculatorMode mode)
+    {
+        unique_ptr<CCalcEngine> engine;
+        switch (mode)
+        {
+        case CalculatorMode::StandardMode:
+            engine = make_unique<CCalcEngine>(false /* Respect Order of Operations */, false /* Set to Integer Mode */, m_resourceProvider, this, m_pStdHistory);
+            break;
+        case CalculatorMode::ScientificMode:
+            engine = make_unique<CCalcEngine>(true /* Respect Order of Operations */, false /* Set to Integer Mode */, m_resourceProvider, this, m_pSciHistory);
+            break;
+        default:
+            engine = make_unique<CCalcEngine>(true /* Respect Order of Operations */, true /* Set to Integer Mode */, m_resourceProvider, this, nullptr);
+            break;
+        }
+
+        engine->SetCommandTracer(m_commandTracer);
+        return engine;
+    }
+
+    unique_ptr<CCalcEngine>& CalculatorManager::GetEngine(CalculatorMode mode)
+    {
+        switch (mode)
+        {
+        case CalculatorMode::StandardMode:
+            return m_standardCalculatorEngine;
+        case CalculatorMode::ScientificMode:
+            return m_scientificCalculatorEngine;
+        default:
+            return m_programmerCalculatorEngine;
+        }
+    }
+
     /// <summary>
     /// Change the current calculator engine to standard calculator engine.
     /// </summary>
@@ -163,8 +242,7 @@ namespace CalculationManager
     {
         if (!m_standardCalculatorEngine)
         {
-            m_standardCalculatorEngine =
-                make_unique<CCalcEngine>(false /* Respect Order of Operations */, false /* Set to Integer Mode */, m_resourceProvider, this, m_pStdHistory);
+            m_standardCalculatorEngine = CreateEngine(CalculatorMode::StandardMode);
         }
 
         m_currentCalculatorEngine = m_standardCalculatorEngine.get();
@@ -182,8 +260,7 @@ namespace CalculationManager
     {
         if (!m_scientificCalculatorEngine)
         {
-            m_scientificCalculatorEngine =
-                make_unique<CCalcEngine>(true /* Respect Order of Operations */, false /* Set to Integer Mode */, m_resourceProvider, this, m_pSciHistory);
+            m_scientificCalculatorEngine = CreateEngine(CalculatorMode::ScientificMode);
         }
 
         m_currentCalculatorEngine = m_scientificCalculatorEngine.get();
@@ -200,8 +277,7 @@ namespace CalculationManager
     {
         if (!m_programmerCalculatorEngine)
         {
-            m_programmerCalculatorEngine =
-                make_unique<CCalcEngine>(true /* Respect Order of Operations */, true /* Set to Integer Mode */, m_resourceProvider, this, nullptr);
+            m_programmerCalculatorEngine = CreateEngine(CalculatorMode::ProgrammerMode);
         }
 
         m_currentCalculatorEngine = m_programmerCalculatorEngine.get();
@@ -367,7 +443,7 @@ namespace CalculationManager
 
     /// <summary>
     /// Memorize the current displayed value
-    /// Notify the client with new the new memorize value vector
+    /// Notify the client with the inserted memory, and the removed one if the memory was full
     /// </summary>
     void CalculatorManager::MemorizeNumber()
     {
@@ -383,14 +459,15 @@ namespace CalculationManager
         auto memoryObjectPtr = m_currentCalculatorEngine->PersistedMemObject();
         if (memoryObjectPtr != nullptr)
         {
-            m_memorizedNumbers.insert(m_memorizedNumbers.begin(), *memoryObjectPtr);
+            m_memorizedNumbers.push_front({ *memoryObjectPtr, GetMemorizedNumberString(*memoryObjectPtr) });
+            m_displayCallback->InsertMemorizedNumber(0, m_memorizedNumbers.front().displayString);
         }
 
         if (m_memorizedNumbers.size() > m_maximumMemorySize)
         {
-            m_memorizedNumbers.resize(m_maximumMemorySize);
+            m_memorizedNumbers.pop_back();
+            m_displayCallback->RemoveMemorizedNumber(static_cast<unsigned int>(m_memorizedNumbers.size()));
         }
-        this->SetMemorizedNumbersString();
     }
 
     /// <summary>
@@ -415,7 +492,7 @@ namespace CalculationManager
     /// <summary>
     /// Do the addition to the selected memory
     /// It adds primary display value to the selected memory
-    /// Notify the client with new the new memorize value vector
+    /// Notify the client with the new value of the memory
     /// </summary>
     /// <param name="indexOfMemory">Index of the target memory</param>
     void CalculatorManager::MemorizedNumberAdd(_In_ unsigned int indexOfMemory)
@@ -437,8 +514,6 @@ namespace CalculationManager
             m_currentCalculatorEngine->ProcessCommand(IDC_MPLUS);
 
             this->MemorizedNumberChanged(indexOfMemory);
-
-            this->SetMemorizedNumbersString();
         }
 
         m_displayCallback->MemoryItemChanged(indexOfMemory);
@@ -456,7 +531,7 @@ namespace CalculationManager
     /// <summary>
     /// Do the subtraction to the selected memory
     /// It adds primary display value to the selected memory
-    /// Notify the client with new the new memorize value vector
+    /// Notify the client with the new value of the memory
     /// </summary>
     /// <param name="indexOfMemory">Index of the target memory</param>
     void CalculatorManager::MemorizedNumberSubtract(_In_ unsigned int indexOfMemory)
@@ -481,8 +556,6 @@ namespace CalculationManager
             m_currentCalculatorEngine->ProcessCommand(IDC_MMINUS);
 
             this->MemorizedNumberChanged(indexOfMemory);
-
-            this->SetMemorizedNumbersString();
         }
 
         m_displayCallback->MemoryItemChanged(indexOfMemory);
@@ -513,13 +586,14 @@ namespace CalculationManager
             return;
         }
 
-        auto memoryObject = m_memorizedNumbers.at(indexOfMemory);
+        auto memoryObject = m_memorizedNumbers.at(indexOfMemory).value;
         m_currentCalculatorEngine->PersistedMemObject(memoryObject);
     }
 
     /// <summary>
     /// Helper function that needs to be executed when memory is modified
     /// When memory is modified, destroy the old RAT and put the new RAT in vector
+    /// Notify the client if the string of the memory changed
     /// </summary>
     /// <param name="indexOfMemory">Index of the target memory</param>
     void CalculatorManager::MemorizedNumberChanged(_In_ unsigned int indexOfMemory)
@@ -532,10 +606,35 @@ namespace CalculationManager
         auto memoryObject = m_currentCalculatorEngine->PersistedMemObject();
         if (memoryObject != nullptr)
         {
-            m_memorizedNumbers.at(indexOfMemory) = *memoryObject;
+            MemorizedNumber& memorizedNumber = m_memorizedNumbers.at(indexOfMemory);
+            memorizedNumber.value = *memoryObject;
+
+            wstring displayString = GetMemorizedNumberString(memorizedNumber.value);
+            if (displayString != memorizedNumber.displayString)
+            {
+                memorizedNumber.displayString = move(displayString);
+                m_displayCallback->UpdateMemorizedNumber(indexOfMemory, memorizedNumber.displayString);
+            }
         }
     }
 
+    /// <summary>
+    /// Helper function that formats a memorized number for the current radix
+    /// </summary>
+    /// <param name="memorizedNumber">The memorized number to format</param>
+    wstring CalculatorManager::GetMemorizedNumberString(Rational const& memorizedNumber)
+    {
+        int radix = m_currentCalculatorEngine->GetCurrentRadix();
+        wstring stringValue = m_currentCalculatorEngine->GetStringForDisplay(memorizedNumber, radix);
+
+        if (!stringValue.empty())
+        {
+            stringValue = m_currentCalculatorEngine->GroupDigitsPerRadix(stringValue, radix);
+        }
+
+        return stringValue;
+    }
+
     void CalculatorManager::SaveMemoryCommand(_In_ MemoryCommand command, _In_ unsigned int indexOfMemory)
     {
         m_savedCommands.push_back(MEMORY_COMMAND_TO_UNSIGNED_CHAR(command));
@@ -546,17 +645,17 @@ namespace CalculationManager
         m_savedCommands.push_back(static_cast<unsigned char>(indexOfMemory));
     }
 
-    vector<shared_ptr<HISTORYITEM>> const& CalculatorManager::GetHistoryItems()
+    vector<shared_ptr<HISTORYITEM>> CalculatorManager::GetHistoryItems()
     {
         return m_pHistory->GetHistory();
     }
 
-    vector<shared_ptr<HISTORYITEM>> const& CalculatorManager::GetHistoryItems(_In_ CALCULATOR_MODE mode)
+    vector<shared_ptr<HISTORYITEM>> CalculatorManager::GetHistoryItems(_In_ CALCULATOR_MODE mode)
     {
         return (mode == CM_STD) ? m_pStdHistory->GetHistory() : m_pSciHistory->GetHistory();
     }
 
-    shared_ptr<HISTORYITEM> const& CalculatorManager::GetHistoryItem(_In_ unsigned int uIdx)
+    shared_ptr<HISTORYITEM> CalculatorManager::GetHistoryItem(_In_ unsigned int uIdx)
     {
         return m_pHistory->GetHistoryItem(uIdx);
     }
@@ -601,14 +700,13 @@ namespace CalculationManager
     void CalculatorManager::SetMemorizedNumbersString()
     {
         vector<wstring> resultVector;
-        for (auto const& memoryItem : m_memorizedNumbers)
+        for (auto& memoryItem : m_memorizedNumbers)
         {
-            int radix = m_currentCalculatorEngine->GetCurrentRadix();
-            wstring stringValue = m_currentCalculatorEngine->GetStringForDisplay(memoryItem, radix);
+            memoryItem.displayString = GetMemorizedNumberString(memoryItem.value);
 
-            if (!stringValue.empty())
+            if (!memoryItem.displayString.empty())
             {
-                resultVector.push_back(m_currentCalculatorEngine->GroupDigitsPerRadix(stringValue, radix));
+                resultVector.push_back(memoryItem.displayString);
             }
         }
         m_displayCallback->SetMemorizedNumbers(resultVector);
@@ -682,6 +780,216 @@ namespace CalculationManager
         m_inHistoryItemLoadMode = isHistoryItemLoadMode;
     }
 
+    /// <summary>
+    /// Write the state of the calculator to a buffer
+    /// How the state is saved (all values little-endian, see SnapshotWriter) :
+    ///     Header: SNAPSHOT_MAGIC, SNAPSHOT_VERSION, size of the snapshot
+    ///     Which history is current, load mode, exponential format, degree modes
+    ///     Persisted primary value, saved commands
+    ///     Memorized numbers, each with its display string
+    ///     Standard history, scientific history
+    ///     Number of engines, then each engine after its mode. The current engine, if any, is the last one.
+    /// </summary>
+    /// <param name="buffer">Buffer that receives the snapshot</param>
+    /// <param name="bufferSize">Size of the buffer</param>
+    size_t CalculatorManager::SaveSnapshot(_Out_ uint8_t* buffer, size_t bufferSize) const
+    {
+        SnapshotWriter writer(buffer, bufferSize);
+        writer.WriteUInt32(SNAPSHOT_MAGIC);
+        writer.WriteUInt32(SNAPSHOT_VERSION);
+        writer.WriteUInt32(0); // Size, written once known
+
+        uint8_t currentHistory = SNAPSHOT_NO_HISTORY;
+        if (m_pHistory == m_pStdHistory.get())
+        {
+            currentHistory = SNAPSHOT_STANDARD_HISTORY;
+        }
+        else if (m_pHistory == m_pSciHistory.get())
+        {
+            currentHistory = SNAPSHOT_SCIENTIFIC_HISTORY;
+        }
+
+        writer.WriteUInt8(currentHistory);
+        writer.WriteBool(m_inHistoryItemLoadMode);
+        writer.WriteBool(m_isExponentialFormat);
+        writer.WriteInt32(static_cast<int32_t>(m_currentDegreeMode));
+        writer.WriteInt32(static_cast<int32_t>(m_savedDegreeMode));
+        writer.WriteRational(m_persistedPrimaryValue);
+        writer.WriteByteArray(m_savedCommands.data(), m_savedCommands.size());
+
+        writer.WriteUInt32(static_cast<uint32_t>(m_memorizedNumbers.size()));
+        for (auto const& memorizedNumber : m_memorizedNumbers)
+        {
+            writer.WriteRational(memorizedNumber.value);
+            writer.WriteString(memorizedNumber.displayString);
+        }
+
+        m_pStdHistory->SaveSnapshot(writer);
+        m_pSciHistory->SaveSnapshot(writer);
+
+        // The current engine goes last, so that restoring it last leaves Ratpack set up for it
+        const pair<CalculatorMode, CCalcEngine*> engines[] = { { CalculatorMode::StandardMode, m_standardCalculatorEngine.get() },
+                                                               { CalculatorMode::ScientificMode, m_scientificCalculatorEngine.get() },
+                                                               { CalculatorMode::ProgrammerMode, m_programmerCalculatorEngine.get() } };
+        uint8_t engineCount = 0;
+        for (auto const& engine : engines)
+        {
+            engineCount += engine.second != nullptr ? 1 : 0;
+        }
+
+        writer.WriteUInt8(engineCount);
+        writer.WriteBool(m_currentCalculatorEngine != nullptr);
+        for (auto const& engine : engines)
+        {
+            if (engine.second != nullptr && engine.second != m_currentCalculatorEngine)
+            {
+                writer.WriteUInt8(static_cast<uint8_t>(engine.first));
+                engine.second->SaveSnapshot(writer);
+            }
+        }
+        for (auto const& engine : engines)
+        {
+            if (engine.second != nullptr && engine.second == m_currentCalculatorEngine)
+            {
+                writer.WriteUInt8(static_cast<uint8_t>(engine.first));
+                engine.second->SaveSnapshot(writer);
+            }
+        }
+
+        writer.PatchUInt32(2 * sizeof(uint32_t), static_cast<uint32_t>(writer.Size()));
+        return writer.Size();
+    }
+
+    /// <summary>
+    /// Replace the state of the calculator with a snapshot written by SaveSnapshot
+    /// Engines missing from the calculator are created, and the ones missing from the snapshot are destroyed.
+    /// Strings and numbers are read into the existing ones, so that their storage is reused.
+    /// </summary>
+    /// <param name="snapshot">The snapshot</param>
+    /// <param name="snapshotSize">Size of the snapshot</param>
+    bool CalculatorManager::RestoreSnapshot(_In_ const uint8_t* snapshot, size_t snapshotSize)
+    {
+        SnapshotReader header(snapshot, snapshotSize);
+        uint32_t magic = header.ReadUInt32();
+        uint32_t version = header.ReadUInt32();
+        uint32_t size = header.ReadUInt32();
+        if (!header.IsValid() || magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION || size < SNAPSHOT_HEADER_SIZE || size > snapshotSize)
+        {
+            return false;
+        }
+
+        SnapshotReader reader(snapshot + SNAPSHOT_HEADER_SIZE, size - SNAPSHOT_HEADER_SIZE);
+        uint8_t currentHistory = reader.ReadUInt8();
+        m_inHistoryItemLoadMode = reader.ReadBool();
+        m_isExponentialFormat = reader.ReadBool();
+        int32_t currentDegreeMode = reader.ReadInt32();
+        int32_t savedDegreeMode = reader.ReadInt32();
+        if (IsDegreeMode(currentDegreeMode) && IsDegreeMode(savedDegreeMode))
+        {
+            m_currentDegreeMode = static_cast<Command>(currentDegreeMode);
+            m_savedDegreeMode = static_cast<Command>(savedDegreeMode);
+        }
+        else
+        {
+            reader.Invalidate();
+        }
+        reader.ReadRational(m_persistedPrimaryValue);
+
+        uint32_t savedCommandCount = reader.ReadCount(numeric_limits<uint32_t>::max());
+        const uint8_t* savedCommands = reader.ReadBytes(savedCommandCount);
+        if (savedCommands != nullptr)
+        {
+            m_savedCommands.assign(savedCommands, savedCommands + savedCommandCount);
+        }
+
+        m_memorizedNumbers.resize(reader.ReadCount(m_maximumMemorySize));
+        for (auto& memorizedNumber : m_memorizedNumbers)
+        {
+            reader.ReadRational(memorizedNumber.value);
+            reader.ReadString(memorizedNumber.displayString);
+        }
+
+        m_pStdHistory->RestoreSnapshot(reader);
+        m_pSciHistory->RestoreSnapshot(reader);
+
+        switch (currentHistory)
+        {
+        case SNAPSHOT_NO_HISTORY:
+            m_pHistory = nullptr;
+            break;
+        case SNAPSHOT_STANDARD_HISTORY:
+            m_pHistory = m_pStdHistory.get();
+            break;
+        case SNAPSHOT_SCIENTIFIC_HISTORY:
+            m_pHistory = m_pSciHistory.get();
+            break;
+        default:
+            reader.Invalidate();
+        }
+
+        uint8_t engineCount = reader.ReadUInt8();
+        bool hasCurrentEngine = reader.ReadBool();
+        if (engineCount > 3 || (hasCurrentEngine && engineCount == 0))
+        {
+            reader.Invalidate();
+        }
+
+        bool isEngineRestored[3] = {};
+        CCalcEngine* lastEngine = nullptr;
+        for (uint8_t i = 0; i < engineCount && reader.IsValid(); i++)
+        {
+            uint8_t mode = reader.ReadUInt8();
+            if (mode > static_cast<uint8_t>(CalculatorMode::ProgrammerMode) || isEngineRestored[mode])
+            {
+                reader.Invalidate();
+                break;
+            }
+
+            auto& engine = GetEngine(static_cast<CalculatorMode>(mode));
+            if (!engine)
+            {
+                engine = CreateEngine(static_cast<CalculatorMode>(mode));
+            }
+
+            engine->RestoreSnapshot(reader);
+            isEngineRestored[mode] = true;
+            lastEngine = engine.get();
+        }
+
+        if (!reader.IsAtEnd())
+        {
+            reader.Invalidate();
+        }
+
+        if (!reader.IsValid())
+        {
+            // Start again from new engines and empty histories rather than from a partly restored state
+            m_standardCalculatorEngine.reset();
+            m_scientificCalculatorEngine.reset();
+            m_programmerCalculatorEngine.reset();
+            m_pStdHistory->ClearHistory();
+            m_pSciHistory->ClearHistory();
+            m_memorizedNumbers.clear();
+            m_isExponentialFormat = false;
+            m_inHistoryItemLoadMode = false;
+            m_currentDegreeMode = Command::CommandNULL;
+            m_savedDegreeMode = Command::CommandDEG;
+            Reset();
+            return false;
+        }
+
+        for (uint8_t mode = 0; mode < 3; mode++)
+        {
+            if (!isEngineRestored[mode])
+            {
+                GetEngine(static_cast<CalculatorMode>(mode)).reset();
+            }
+        }
+
+        m_currentCalculatorEngine = hasCurrentEngine ? lastEngine : nullptr;
+        return true;
+    }
+
     /// <summary>
     /// Serialize Rational to vector of long
     /// How Rational is serialized :
@@ -773,4 +1081,35 @@ namespace CalculationManager
 
         return Number{ sign, exp, mant };
     }
+
+    /// <summary>
+    /// Set the tracer that the engines call at the start and end of each command, including the engines created later
+    /// </summary>
+    /// <param name="commandTracer">The tracer, or nullptr to stop tracing</param>
+    void CalculatorManager::SetCommandTracer(_In_opt_ ICalcCommandTracer* commandTracer)
+    {
+        m_commandTracer = commandTracer;
+        for (auto engine : { m_standardCalculatorEngine.get(), m_scientificCalculatorEngine.get(), m_programmerCalculatorEngine.get() })
+        {
+            if (engine != nullptr)
+            {
+                engine->SetCommandTracer(m_commandTracer);
+            }
+        }
+    }
+
+    void CalculatorManager::EnableRatpackCounters(bool enable)
+    {
+        ::EnableRatpackCounters(enable);
+    }
+
+    RATPACK_COUNTERS CalculatorManager::GetRatpackCounters()
+    {
+        return ::GetRatpackCounters();
+    }
+
+    void CalculatorManager::ResetRatpackCounters()
+    {
+        ::ResetRatpackCounters();
+    }
 }
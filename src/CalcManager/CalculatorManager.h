@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <deque>
 #include "CalculatorHistory.h"
 #include "Header Files/CalcEngine.h"
 #include "Header Files/Rational.h"
@@ -52,8 +53,16 @@ namespace CalculationManager
         std::unique_ptr<CCalcEngine> m_programmerCalculatorEngine;
         IResourceProvider* const m_resourceProvider;
         bool m_inHistoryItemLoadMode;
+        ICalcCommandTracer* m_commandTracer;
 
-        std::vector<CalcEngine::Rational> m_memorizedNumbers;
+        // A memorized number and its string, as it was last sent to the display
+        struct MemorizedNumber
+        {
+            CalcEngine::Rational value;
+            std::wstring displayString;
+        };
+
+        std::deque<MemorizedNumber> m_memorizedNumbers;
         CalcEngine::Rational m_persistedPrimaryValue;
 
         bool m_isExponentialFormat;
@@ -73,8 +82,11 @@ namespace CalculationManager
 
         void MemorizedNumberSelect(_In_ unsigned int);
         void MemorizedNumberChanged(_In_ unsigned int);
+        std::wstring GetMemorizedNumberString(CalcEngine::Rational const& memorizedNumber);
 
         void LoadPersistedPrimaryValue();
+        std::unique_ptr<CCalcEngine> CreateEngine(CalculatorMode mode);
+        std::unique_ptr<CCalcEngine>& GetEngine(CalculatorMode mode);
 
         static std::vector<long> SerializeRational(CalcEngine::Rational const& rat);
         static CalcEngine::Rational DeSerializeRational(std::vector<long>::const_iterator itr);
@@ -94,6 +106,9 @@ namespace CalculationManager
             _Inout_ std::shared_ptr<std::vector<std::pair<std::wstring, int>>> const& tokens,
             _Inout_ std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> const& commands) override;
         void SetMemorizedNumbers(_In_ const std::vector<std::wstring>& memorizedNumbers) override;
+        void InsertMemorizedNumber(unsigned int indexOfMemory, const std::wstring& memorizedNumber) override;
+        void UpdateMemorizedNumber(unsigned int indexOfMemory, const std::wstring& memorizedNumber) override;
+        void RemoveMemorizedNumber(unsigned int indexOfMemory) override;
         void OnHistoryItemAdded(_In_ unsigned int addedItemIndex) override;
         void SetParenthesisNumber(_In_ unsigned int parenthesisCount) override;
         void OnNoRightParenAdded() override;
@@ -130,9 +145,9 @@ namespace CalculationManager
         void UpdateMaxIntDigits();
         wchar_t DecimalSeparator();
 
-        std::vector<std::shared_ptr<HISTORYITEM>> const& GetHistoryItems();
-        std::vector<std::shared_ptr<HISTORYITEM>> const& GetHistoryItems(_In_ CalculationManager::CALCULATOR_MODE mode);
-        std::shared_ptr<HISTORYITEM> const& GetHistoryItem(_In_ unsigned int uIdx);
+        std::vector<std::shared_ptr<HISTORYITEM>> GetHistoryItems();
+        std::vector<std::shared_ptr<HISTORYITEM>> GetHistoryItems(_In_ CalculationManager::CALCULATOR_MODE mode);
+        std::shared_ptr<HISTORYITEM> GetHistoryItem(_In_ unsigned int uIdx);
         bool RemoveHistoryItem(_In_ unsigned int uIdx);
         void ClearHistory();
         size_t MaxHistorySize() const
@@ -142,5 +157,26 @@ namespace CalculationManager
         CalculationManager::Command GetCurrentDegreeMode();
         void SetHistory(_In_ CALCULATOR_MODE eMode, _In_ std::vector<std::shared_ptr<HISTORYITEM>> const& history);
         void SetInHistoryItemLoadMode(_In_ bool isHistoryItemLoadMode);
+
+        // Writes the whole state of the calculator to the buffer: the engines with the expressions they are building,
+        // the memory, both histories and the saved commands. Returns the size of the snapshot. If that is more than
+        // bufferSize, the buffer holds no usable snapshot and the call should be repeated with a larger one.
+        size_t SaveSnapshot(_Out_ uint8_t* buffer, size_t bufferSize) const;
+
+        // Replaces the state of the calculator with the one in a snapshot. The display is not notified of the new
+        // state. Returns false if the snapshot is not valid; the calculator is then reset, unless the snapshot was
+        // rejected before anything was restored.
+        bool RestoreSnapshot(_In_ const uint8_t* snapshot, size_t snapshotSize);
+
+        // Sets the tracer that the engines call at the start and end of each command, e.g. a CommandTraceFile, or
+        // nullptr, the default, to stop tracing. The tracer must outlive the calculator or be unset first.
+        void SetCommandTracer(_In_opt_ ICalcCommandTracer* commandTracer);
+
+        // Counters of the work Ratpack does on the calling thread: allocations, multiplications and divisions by the
+        // size of their operands, and the terms of each series. They are off until enabled, and are reset before
+        // SendCommand and read after it to find the cost of one command.
+        static void EnableRatpackCounters(bool enable);
+        static RATPACK_COUNTERS GetRatpackCounters();
+        static void ResetRatpackCounters();
     };
 }
@@ -0,0 +1,337 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <limits>
+#include "CalculatorSessionStore.h"
+#include "Header Files/Snapshot.h"
+
+using namespace std;
+using namespace CalcEngine;
+using namespace CalculationManager;
+
+namespace
+{
+    // How the file is laid out:
+    //     SESSION_FILE_MAGIC, SESSION_FILE_VERSION, end of the records (uint64)
+    //     records, each one being: session id (uint64), capacity, size, then capacity bytes for the snapshot
+    // A removed record keeps its capacity and has REMOVED_RECORD_SIZE as its size, so that it can be used again.
+    // The file is grown ahead of the records, so it usually ends after them.
+    constexpr uint32_t SESSION_FILE_MAGIC = 0x53455343; // "CSES"
+    constexpr uint32_t SESSION_FILE_VERSION = 1;
+    constexpr uint64_t SESSION_FILE_HEADER_SIZE = 2 * sizeof(uint32_t) + sizeof(uint64_t);
+    constexpr uint64_t DATA_END_OFFSET = 2 * sizeof(uint32_t);
+    constexpr uint64_t RECORD_HEADER_SIZE = sizeof(uint64_t) + 2 * sizeof(uint32_t);
+    constexpr uint32_t REMOVED_RECORD_SIZE = numeric_limits<uint32_t>::max();
+    constexpr uint64_t RECORD_ALIGNMENT = 64;
+    constexpr uint64_t MIN_FILE_SIZE = 64 * 1024;
+
+    // A record leaves room for its snapshot to grow, as history and memory are added, before it has to move
+    uint64_t GetRecordCapacity(uint64_t size)
+    {
+        uint64_t capacity = (size + size / 4 + RECORD_ALIGNMENT - 1) / RECORD_ALIGNMENT * RECORD_ALIGNMENT;
+        return min<uint64_t>(capacity, REMOVED_RECORD_SIZE - 1);
+    }
+}
+
+CalculatorSessionStore::CalculatorSessionStore(_In_ ICalcDisplay* displayCallback, _In_ IResourceProvider* resourceProvider, size_t maxLiveSessions)
+    : m_displayCallback(displayCallback)
+    , m_resourceProvider(resourceProvider)
+    , m_maxLiveSessions(max<size_t>(maxLiveSessions, 1))
+    , m_dataEnd(0)
+{
+    CalculatorManager newCalculatorManager(m_displayCallback, m_resourceProvider);
+    m_newSessionSnapshot.resize(newCalculatorManager.SaveSnapshot(nullptr, 0));
+    newCalculatorManager.SaveSnapshot(m_newSessionSnapshot.data(), m_newSessionSnapshot.size());
+}
+
+CalculatorSessionStore::~CalculatorSessionStore()
+{
+    Close();
+}
+
+bool CalculatorSessionStore::Open(filesystem::path const& path)
+{
+    Close();
+    if (!m_file.Open(path))
+    {
+        return false;
+    }
+
+    if (m_file.Size() == 0)
+    {
+        if (!m_file.Resize(MIN_FILE_SIZE))
+        {
+            m_file.Close();
+            return false;
+        }
+
+        SnapshotWriter writer(m_file.Data(), SESSION_FILE_HEADER_SIZE);
+        writer.WriteUInt32(SESSION_FILE_MAGIC);
+        writer.WriteUInt32(SESSION_FILE_VERSION);
+        writer.WriteUInt64(SESSION_FILE_HEADER_SIZE);
+    }
+
+    if (!ReadIndex())
+    {
+        m_records.clear();
+        m_freeRecords.clear();
+        m_file.Close();
+        return false;
+    }
+
+    return true;
+}
+
+// Finds the records in the file
+bool CalculatorSessionStore::ReadIndex()
+{
+    uint64_t fileSize = m_file.Size();
+    if (fileSize < SESSION_FILE_HEADER_SIZE)
+    {
+        return false;
+    }
+
+    SnapshotReader reader(m_file.Data(), fileSize);
+    uint32_t magic = reader.ReadUInt32();
+    uint32_t version = reader.ReadUInt32();
+    m_dataEnd = reader.ReadUInt64();
+    if (magic != SESSION_FILE_MAGIC || version != SESSION_FILE_VERSION || m_dataEnd < SESSION_FILE_HEADER_SIZE || m_dataEnd > fileSize)
+    {
+        return false;
+    }
+
+    uint64_t offset = SESSION_FILE_HEADER_SIZE;
+    while (offset < m_dataEnd)
+    {
+        if (m_dataEnd - offset < RECORD_HEADER_SIZE)
+        {
+            return false;
+        }
+
+        uint64_t sessionId = reader.ReadUInt64();
+        uint32_t capacity = reader.ReadUInt32();
+        uint32_t size = reader.ReadUInt32();
+        if (capacity == 0 || capacity > m_dataEnd - offset - RECORD_HEADER_SIZE)
+        {
+            return false;
+        }
+
+        if (size == REMOVED_RECORD_SIZE)
+        {
+            m_freeRecords.emplace(capacity, offset);
+        }
+        else if (size > capacity || !m_records.emplace(sessionId, Record{ offset, capacity, size }).second)
+        {
+            return false;
+        }
+
+        reader.ReadBytes(capacity);
+        offset += RECORD_HEADER_SIZE + capacity;
+    }
+
+    return true;
+}
+
+void CalculatorSessionStore::Close()
+{
+    if (!m_file.IsOpen())
+    {
+        return;
+    }
+
+    Flush();
+    m_liveSessionIndex.clear();
+    m_liveSessions.clear();
+    m_records.clear();
+    m_freeRecords.clear();
+    m_file.Close();
+    m_dataEnd = 0;
+}
+
+CalculatorManager* CalculatorSessionStore::GetSession(uint64_t sessionId)
+{
+    if (m_file.Data() == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto liveSession = m_liveSessionIndex.find(sessionId);
+    if (liveSession != m_liveSessionIndex.end())
+    {
+        m_liveSessions.splice(m_liveSessions.begin(), m_liveSessions, liveSession->second);
+        return m_liveSessions.front().calculatorManager.get();
+    }
+
+    // Reuse the least recently used calculator, once its session is in the file, so that its engines are reused too
+    unique_ptr<CalculatorManager> calculatorManager;
+    bool isNewCalculatorManager = m_liveSessions.size() < m_maxLiveSessions;
+    if (isNewCalculatorManager)
+    {
+        calculatorManager = make_unique<CalculatorManager>(m_displayCallback, m_resourceProvider);
+    }
+    else
+    {
+        LiveSession& leastRecentlyUsed = m_liveSessions.back();
+        if (!SaveSession(leastRecentlyUsed.sessionId, *leastRecentlyUsed.calculatorManager))
+        {
+            return nullptr;
+        }
+
+        calculatorManager = move(leastRecentlyUsed.calculatorManager);
+        m_liveSessionIndex.erase(leastRecentlyUsed.sessionId);
+        m_liveSessions.pop_back();
+    }
+
+    // A snapshot that can't be restored leaves the calculator reset, which is also where a new session starts
+    auto record = m_records.find(sessionId);
+    if (record != m_records.end())
+    {
+        calculatorManager->RestoreSnapshot(m_file.Data() + record->second.offset + RECORD_HEADER_SIZE, record->second.size);
+    }
+    else if (!isNewCalculatorManager)
+    {
+        calculatorManager->RestoreSnapshot(m_newSessionSnapshot.data(), m_newSessionSnapshot.size());
+    }
+
+    m_liveSessions.push_front(LiveSession{ sessionId, move(calculatorManager) });
+    m_liveSessionIndex[sessionId] = m_liveSessions.begin();
+    return m_liveSessions.front().calculatorManager.get();
+}
+
+bool CalculatorSessionStore::RemoveSession(uint64_t sessionId)
+{
+    bool isRemoved = false;
+
+    auto liveSession = m_liveSessionIndex.find(sessionId);
+    if (liveSession != m_liveSessionIndex.end())
+    {
+        m_liveSessions.erase(liveSession->second);
+        m_liveSessionIndex.erase(liveSession);
+        isRemoved = true;
+    }
+
+    auto record = m_records.find(sessionId);
+    if (record != m_records.end())
+    {
+        FreeRecord(sessionId, record->second);
+        m_records.erase(record);
+        isRemoved = true;
+    }
+
+    return isRemoved;
+}
+
+bool CalculatorSessionStore::Flush()
+{
+    if (m_file.Data() == nullptr)
+    {
+        return false;
+    }
+
+    bool isSaved = true;
+    for (auto const& liveSession : m_liveSessions)
+    {
+        isSaved = SaveSession(liveSession.sessionId, *liveSession.calculatorManager) && isSaved;
+    }
+
+    return m_file.Flush() && isSaved;
+}
+
+size_t CalculatorSessionStore::GetSessionCount() const
+{
+    size_t sessionCount = m_records.size();
+    for (auto const& liveSession : m_liveSessions)
+    {
+        if (m_records.find(liveSession.sessionId) == m_records.end())
+        {
+            sessionCount++;
+        }
+    }
+
+    return sessionCount;
+}
+
+// Writes the snapshot straight into the file. It stays in its record while it fits there.
+bool CalculatorSessionStore::SaveSession(uint64_t sessionId, CalculatorManager const& calculatorManager)
+{
+    size_t size;
+    auto existingRecord = m_records.find(sessionId);
+    if (existingRecord != m_records.end())
+    {
+        Record& record = existingRecord->second;
+        size = calculatorManager.SaveSnapshot(m_file.Data() + record.offset + RECORD_HEADER_SIZE, record.capacity);
+        if (size <= record.capacity)
+        {
+            record.size = static_cast<uint32_t>(size);
+            WriteRecordHeader(sessionId, record);
+            return true;
+        }
+
+        // The record now holds part of the snapshot, so it is given up whatever happens next
+        FreeRecord(sessionId, record);
+        m_records.erase(existingRecord);
+    }
+    else
+    {
+        size = calculatorManager.SaveSnapshot(nullptr, 0);
+    }
+
+    Record record;
+    if (size >= REMOVED_RECORD_SIZE || !AllocateRecord(sessionId, static_cast<uint32_t>(size), record))
+    {
+        return false;
+    }
+
+    calculatorManager.SaveSnapshot(m_file.Data() + record.offset + RECORD_HEADER_SIZE, record.capacity);
+    record.size = static_cast<uint32_t>(size);
+    WriteRecordHeader(sessionId, record);
+    m_records.emplace(sessionId, record);
+    return true;
+}
+
+// Uses the smallest removed record that is large enough, or adds one at the end, growing the file if needed
+bool CalculatorSessionStore::AllocateRecord(uint64_t sessionId, uint32_t size, _Out_ Record& record)
+{
+    auto freeRecord = m_freeRecords.lower_bound(size);
+    if (freeRecord != m_freeRecords.end())
+    {
+        record = Record{ freeRecord->second, freeRecord->first, 0 };
+        m_freeRecords.erase(freeRecord);
+        WriteRecordHeader(sessionId, record);
+        return true;
+    }
+
+    uint64_t capacity = GetRecordCapacity(size);
+    uint64_t dataEnd = m_dataEnd + RECORD_HEADER_SIZE + capacity;
+    if (dataEnd > m_file.Size() && !m_file.Resize(max(dataEnd, 2 * m_file.Size())))
+    {
+        return false;
+    }
+
+    record = Record{ m_dataEnd, static_cast<uint32_t>(capacity), 0 };
+    WriteRecordHeader(sessionId, record);
+    m_dataEnd = dataEnd;
+    WriteDataEnd();
+    return true;
+}
+
+void CalculatorSessionStore::FreeRecord(uint64_t sessionId, Record const& record)
+{
+    WriteRecordHeader(sessionId, Record{ record.offset, record.capacity, REMOVED_RECORD_SIZE });
+    m_freeRecords.emplace(record.capacity, record.offset);
+}
+
+void CalculatorSessionStore::WriteRecordHeader(uint64_t sessionId, Record const& record)
+{
+    SnapshotWriter writer(m_file.Data() + record.offset, RECORD_HEADER_SIZE);
+    writer.WriteUInt64(sessionId);
+    writer.WriteUInt32(record.capacity);
+    writer.WriteUInt32(record.size);
+}
+
+void CalculatorSessionStore::WriteDataEnd()
+{
+    SnapshotWriter writer(m_file.Data() + DATA_END_OFFSET, sizeof(uint64_t));
+    writer.WriteUInt64(m_dataEnd);
+}
@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <filesystem>
+#include <list>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "CalculatorManager.h"
+#include "MappedFile.h"
+
+namespace CalculationManager
+{
+    // Keeps many calculator sessions in a memory-mapped file, as the snapshots that CalculatorManager::SaveSnapshot
+    // writes, and only a few of them as live CalculatorManagers. Getting a session that is not live restores it into
+    // the least recently used live CalculatorManager, whose own session is saved to the file first. An idle session
+    // therefore costs its snapshot bytes in the file, and only the live ones hold engines.
+    //
+    // All live sessions share the display and resource provider given to the store. A session that has never been
+    // saved starts as a new CalculatorManager would.
+    class CalculatorSessionStore
+    {
+    public:
+        CalculatorSessionStore(_In_ ICalcDisplay* displayCallback, _In_ IResourceProvider* resourceProvider, size_t maxLiveSessions);
+        ~CalculatorSessionStore();
+
+        // Opens the file that holds the sessions, creating it if it doesn't exist. Returns false if the file can't be
+        // mapped or isn't a session file.
+        bool Open(std::filesystem::path const& path);
+
+        // Saves the live sessions and closes the file.
+        void Close();
+
+        // Returns the calculator of the session, or nullptr if the store isn't open or a session couldn't be saved
+        // to make room for it. The pointer is valid until the next call to GetSession, RemoveSession or Close.
+        CalculatorManager* GetSession(uint64_t sessionId);
+
+        // Forgets the session. Returns false if there was no such session.
+        bool RemoveSession(uint64_t sessionId);
+
+        // Saves the live sessions and writes the file to the disk.
+        bool Flush();
+
+        size_t GetSessionCount() const;
+        size_t GetLiveSessionCount() const
+        {
+            return m_liveSessions.size();
+        }
+
+    private:
+        // Where the snapshot of a session is in the file
+        struct Record
+        {
+            uint64_t offset;
+            uint32_t capacity;
+            uint32_t size;
+        };
+
+        struct LiveSession
+        {
+            uint64_t sessionId;
+            std::unique_ptr<CalculatorManager> calculatorManager;
+        };
+
+        bool ReadIndex();
+        bool SaveSession(uint64_t sessionId, CalculatorManager const& calculatorManager);
+        bool AllocateRecord(uint64_t sessionId, uint32_t size, _Out_ Record& record);
+        void FreeRecord(uint64_t sessionId, Record const& record);
+        void WriteRecordHeader(uint64_t sessionId, Record const& record);
+        void WriteDataEnd();
+
+        ICalcDisplay* const m_displayCallback;
+        IResourceProvider* const m_resourceProvider;
+        const size_t m_maxLiveSessions;
+
+        MappedFile m_file;
+        uint64_t m_dataEnd;
+        std::unordered_map<uint64_t, Record> m_records;
+        std::multimap<uint32_t, uint64_t> m_freeRecords; // Capacity to offset
+
+        // The most recently used session is at the front
+        std::list<LiveSession> m_liveSessions;
+        std::unordered_map<uint64_t, std::list<LiveSession>::iterator> m_liveSessionIndex;
+
+        // The snapshot of a new CalculatorManager, which sessions without a record start from
+        std::vector<uint8_t> m_newSessionSnapshot;
+    };
+}
@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <chrono>
+#include "CommandTraceFile.h"
+#include "Header Files/Snapshot.h"
+
+using namespace std;
+using namespace CalcEngine;
+using namespace CalculationManager;
+
+namespace
+{
+    constexpr uint32_t COMMAND_TRACE_MAGIC = 0x43525443; // "CTRC"
+    constexpr uint32_t COMMAND_TRACE_VERSION = 1;
+    constexpr size_t COMMAND_TRACE_HEADER_SIZE = 3 * sizeof(uint32_t);
+    constexpr size_t RECORD_SIZE = 2 * sizeof(uint64_t) + 6 * sizeof(uint32_t);
+    constexpr size_t BUFFER_RECORD_COUNT = 1024;
+
+    // The clock of CalcCommandTrace::startTime
+    uint64_t GetTraceTime()
+    {
+        return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count());
+    }
+}
+
+CommandTraceFile::CommandTraceFile()
+    : m_openTime(0)
+    , m_minimumElapsedTime(0)
+    , m_recordCount(0)
+{
+    m_buffer.reserve(BUFFER_RECORD_COUNT * RECORD_SIZE);
+}
+
+CommandTraceFile::~CommandTraceFile()
+{
+    Close();
+}
+
+bool CommandTraceFile::Open(filesystem::path const& path, uint64_t minimumElapsedTime)
+{
+    Close();
+    m_file.open(path, ios::binary | ios::trunc);
+    if (!m_file.is_open())
+    {
+        return false;
+    }
+
+    m_openTime = GetTraceTime();
+    m_minimumElapsedTime = minimumElapsedTime;
+    m_recordCount = 0;
+
+    uint8_t header[COMMAND_TRACE_HEADER_SIZE];
+    SnapshotWriter writer(header, sizeof(header));
+    writer.WriteUInt32(COMMAND_TRACE_MAGIC);
+    writer.WriteUInt32(COMMAND_TRACE_VERSION);
+    writer.WriteUInt32(static_cast<uint32_t>(RECORD_SIZE));
+    m_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    if (!m_file)
+    {
+        m_file.close();
+        return false;
+    }
+
+    return true;
+}
+
+void CommandTraceFile::Close()
+{
+    if (m_file.is_open())
+    {
+        Flush();
+        m_file.close();
+    }
+    m_buffer.clear();
+}
+
+bool CommandTraceFile::Flush()
+{
+    if (!m_file.is_open())
+    {
+        return false;
+    }
+
+    m_file.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<streamsize>(m_buffer.size()));
+    m_file.flush();
+    m_buffer.clear();
+    return static_cast<bool>(m_file);
+}
+
+void CommandTraceFile::OnCommandEnded(_In_ CalcCommandTrace const& trace)
+{
+    if (!m_file.is_open() || trace.elapsedTime < m_minimumElapsedTime)
+    {
+        return;
+    }
+
+    if (m_buffer.size() + RECORD_SIZE > m_buffer.capacity())
+    {
+        Flush();
+    }
+
+    // The buffer has room for the record, so it doesn't allocate
+    size_t offset = m_buffer.size();
+    m_buffer.resize(offset + RECORD_SIZE);
+    SnapshotWriter writer(m_buffer.data() + offset, RECORD_SIZE);
+    writer.WriteUInt64(trace.startTime > m_openTime ? trace.startTime - m_openTime : 0);
+    writer.WriteUInt64(trace.elapsedTime);
+    writer.WriteInt32(trace.opCode);
+    writer.WriteUInt32(trace.radix);
+    writer.WriteInt32(trace.precision);
+    writer.WriteUInt32(trace.numeratorDigits);
+    writer.WriteUInt32(trace.denominatorDigits);
+    writer.WriteUInt32(trace.inputDigits);
+    m_recordCount++;
+}
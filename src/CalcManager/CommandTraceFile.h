@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include "Header Files/ICalcCommandTracer.h"
+
+namespace CalculationManager
+{
+    // Writes the commands that an engine processes to a file, as fixed size records, so that the slow ones can be found
+    // where a profiler can't be attached. Only the commands that took at least the minimum elapsed time are written, so
+    // that a trace of a long session can be kept to its slowest commands.
+    //
+    // The records are buffered, and written when the buffer is full, on Flush and on Close. The file is little endian:
+    //     COMMAND_TRACE_MAGIC, COMMAND_TRACE_VERSION, the size of a record (uint32)
+    //     records, each one being: start time (uint64), elapsed time (uint64), opcode (int32), radix (uint32),
+    //     precision (int32), numerator digits (uint32), denominator digits (uint32), input digits (uint32)
+    // where the times are in nanoseconds, and the start time is from when the file was opened.
+    class CommandTraceFile final : public ICalcCommandTracer
+    {
+    public:
+        CommandTraceFile();
+        ~CommandTraceFile();
+
+        // Creates the file, replacing the one at the path if there is one. Returns false if it can't be written.
+        bool Open(std::filesystem::path const& path, uint64_t minimumElapsedTime = 0);
+
+        // Writes the buffered records and closes the file.
+        void Close();
+
+        // Writes the buffered records to the file. Returns false if they couldn't be written.
+        bool Flush();
+
+        // The number of records written or buffered since the file was opened
+        uint64_t GetRecordCount() const
+        {
+            return m_recordCount;
+        }
+
+        // ICalcCommandTracer
+        void OnCommandEnded(_In_ CalcCommandTrace const& trace) override;
+
+    private:
+        std::ofstream m_file;
+        std::vector<uint8_t> m_buffer;
+        uint64_t m_openTime;
+        uint64_t m_minimumElapsedTime;
+        uint64_t m_recordCount;
+    };
+}
@@ -0,0 +1,230 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <limits>
+#include "CompactExpression.h"
+#include "ExpressionCommand.h"
+
+using namespace std;
+using namespace CalculationManager;
+
+CompactExpression::CompactExpression(vector<pair<wstring, int>> const& tokens, vector<shared_ptr<IExpressionCommand>> const& commands)
+{
+    size_t textLength = 0;
+    for (auto const& token : tokens)
+    {
+        textLength += token.first.size();
+    }
+
+    m_tokenText.reserve(textLength);
+    m_tokens.reserve(tokens.size());
+    for (auto const& token : tokens)
+    {
+        m_tokenText.append(token.first);
+        m_tokens.push_back({ static_cast<uint32_t>(m_tokenText.size()), token.second });
+    }
+
+    m_commands.reserve(commands.size());
+    for (auto const& expCommand : commands)
+    {
+        FlatCommand command{};
+        if (expCommand == nullptr)
+        {
+            command.kind = CommandKind::Null;
+            m_commands.push_back(command);
+            continue;
+        }
+
+        switch (expCommand->GetCommandType())
+        {
+        case CommandType::UnaryCommand:
+        {
+            auto const& args = static_pointer_cast<IUnaryCommand>(expCommand)->GetCommands();
+            m_commandArgs.insert(m_commandArgs.end(), args->begin(), args->end());
+            command.kind = CommandKind::Unary;
+            command.argsEnd = static_cast<uint32_t>(m_commandArgs.size());
+            break;
+        }
+        case CommandType::BinaryCommand:
+            command.kind = CommandKind::Binary;
+            command.command = static_pointer_cast<IBinaryCommand>(expCommand)->GetCommand();
+            break;
+        case CommandType::OperandCommand:
+        {
+            auto operand = static_pointer_cast<IOpndCommand>(expCommand);
+            auto const& args = operand->GetCommands();
+            m_commandArgs.insert(m_commandArgs.end(), args->begin(), args->end());
+            command.kind = CommandKind::Operand;
+            command.operandFlags = (operand->IsNegative() ? Negative : None) | (operand->IsDecimalPresent() ? Decimal : None)
+                                   | (operand->IsSciFmt() ? SciFmt : None);
+            command.argsEnd = static_cast<uint32_t>(m_commandArgs.size());
+            break;
+        }
+        case CommandType::Parentheses:
+            command.kind = CommandKind::Parentheses;
+            command.command = static_pointer_cast<IParenthesisCommand>(expCommand)->GetCommand();
+            break;
+        }
+
+        m_commands.push_back(command);
+    }
+
+    m_commandArgs.shrink_to_fit();
+}
+
+shared_ptr<vector<pair<wstring, int>>> CompactExpression::GetTokens() const
+{
+    auto tokens = make_shared<vector<pair<wstring, int>>>();
+    tokens->reserve(m_tokens.size());
+
+    uint32_t textBegin = 0;
+    for (auto const& token : m_tokens)
+    {
+        tokens->emplace_back(m_tokenText.substr(textBegin, token.textEnd - textBegin), token.commandIndex);
+        textBegin = token.textEnd;
+    }
+
+    return tokens;
+}
+
+shared_ptr<vector<shared_ptr<IExpressionCommand>>> CompactExpression::GetCommands() const
+{
+    auto commands = make_shared<vector<shared_ptr<IExpressionCommand>>>();
+    commands->reserve(m_commands.size());
+
+    uint32_t argsBegin = 0;
+    for (auto const& command : m_commands)
+    {
+        switch (command.kind)
+        {
+        case CommandKind::Null:
+            commands->push_back(nullptr);
+            break;
+        case CommandKind::Unary:
+        {
+            auto unaryCommand = make_shared<CUnaryCommand>(0);
+            unaryCommand->GetCommands()->assign(m_commandArgs.begin() + argsBegin, m_commandArgs.begin() + command.argsEnd);
+            commands->push_back(unaryCommand);
+            argsBegin = command.argsEnd;
+            break;
+        }
+        case CommandKind::Binary:
+            commands->push_back(make_shared<CBinaryCommand>(command.command));
+            break;
+        case CommandKind::Operand:
+            commands->push_back(make_shared<COpndCommand>(
+                make_shared<vector<int>>(m_commandArgs.begin() + argsBegin, m_commandArgs.begin() + command.argsEnd),
+                (command.operandFlags & Negative) != 0,
+                (command.operandFlags & Decimal) != 0,
+                (command.operandFlags & SciFmt) != 0));
+            argsBegin = command.argsEnd;
+            break;
+        case CommandKind::Parentheses:
+            commands->push_back(make_shared<CParentheses>(command.command));
+            break;
+        }
+    }
+
+    return commands;
+}
+
+void CompactExpression::SaveSnapshot(CalcEngine::SnapshotWriter& writer) const
+{
+    writer.WriteString(m_tokenText);
+
+    writer.WriteUInt32(static_cast<uint32_t>(m_tokens.size()));
+    for (auto const& token : m_tokens)
+    {
+        writer.WriteUInt32(token.textEnd);
+        writer.WriteInt32(token.commandIndex);
+    }
+
+    writer.WriteUInt32(static_cast<uint32_t>(m_commands.size()));
+    for (auto const& command : m_commands)
+    {
+        writer.WriteUInt8(static_cast<uint8_t>(command.kind));
+        writer.WriteUInt8(command.operandFlags);
+        if (command.kind == CommandKind::Unary || command.kind == CommandKind::Operand)
+        {
+            writer.WriteUInt32(command.argsEnd);
+        }
+        else
+        {
+            writer.WriteInt32(command.command);
+        }
+    }
+
+    writer.WriteUInt32(static_cast<uint32_t>(m_commandArgs.size()));
+    for (int32_t arg : m_commandArgs)
+    {
+        writer.WriteInt32(arg);
+    }
+}
+
+void CompactExpression::RestoreSnapshot(CalcEngine::SnapshotReader& reader)
+{
+    constexpr uint32_t maxCount = numeric_limits<uint32_t>::max();
+
+    reader.ReadString(m_tokenText);
+
+    m_tokens.resize(reader.ReadCount(maxCount));
+    for (auto& token : m_tokens)
+    {
+        token.textEnd = reader.ReadUInt32();
+        token.commandIndex = reader.ReadInt32();
+    }
+
+    m_commands.resize(reader.ReadCount(maxCount));
+    for (auto& command : m_commands)
+    {
+        command.kind = static_cast<CommandKind>(reader.ReadUInt8());
+        command.operandFlags = reader.ReadUInt8();
+        if (command.kind == CommandKind::Unary || command.kind == CommandKind::Operand)
+        {
+            command.argsEnd = reader.ReadUInt32();
+        }
+        else
+        {
+            command.command = reader.ReadInt32();
+        }
+    }
+
+    m_commandArgs.resize(reader.ReadCount(maxCount));
+    for (int32_t& arg : m_commandArgs)
+    {
+        arg = reader.ReadInt32();
+    }
+
+    // The offsets must stay within the text and the arguments, and never go backwards
+    uint32_t textEnd = 0;
+    for (auto const& token : m_tokens)
+    {
+        if (token.textEnd < textEnd || token.textEnd > m_tokenText.size() || token.commandIndex < -1
+            || token.commandIndex >= static_cast<int32_t>(m_commands.size()))
+        {
+            reader.Invalidate();
+            return;
+        }
+        textEnd = token.textEnd;
+    }
+
+    uint32_t argsEnd = 0;
+    for (auto const& command : m_commands)
+    {
+        if (command.kind > CommandKind::Parentheses)
+        {
+            reader.Invalidate();
+            return;
+        }
+
+        if (command.kind == CommandKind::Unary || command.kind == CommandKind::Operand)
+        {
+            if (command.argsEnd < argsEnd || command.argsEnd > m_commandArgs.size())
+            {
+                reader.Invalidate();
+                return;
+            }
+            argsEnd = command.argsEnd;
+        }
+    }
+}
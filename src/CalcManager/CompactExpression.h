@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ExpressionCommandInterface.h"
+#include "Header Files/Snapshot.h"
+
+namespace CalculationManager
+{
+    // A flat copy of an expression's tokens and commands. The token strings are stored back to back in one string,
+    // and the commands in one array, with the digits of every operand and unary command in a shared array of
+    // arguments. An expression takes four allocations however many tokens and commands it has. The shared_ptr based
+    // form the engine and the view model work with is rebuilt on demand.
+    class CompactExpression
+    {
+    public:
+        CompactExpression() = default;
+        CompactExpression(
+            std::vector<std::pair<std::wstring, int>> const& tokens,
+            std::vector<std::shared_ptr<IExpressionCommand>> const& commands);
+
+        std::shared_ptr<std::vector<std::pair<std::wstring, int>>> GetTokens() const;
+        std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> GetCommands() const;
+
+        void SaveSnapshot(CalcEngine::SnapshotWriter& writer) const;
+        void RestoreSnapshot(CalcEngine::SnapshotReader& reader);
+
+    private:
+        enum class CommandKind : uint8_t
+        {
+            Null,
+            Unary,
+            Binary,
+            Operand,
+            Parentheses
+        };
+
+        enum OperandFlags : uint8_t
+        {
+            None = 0,
+            Negative = 1,
+            Decimal = 2,
+            SciFmt = 4
+        };
+
+        struct Token
+        {
+            uint32_t textEnd;     // Offset one past the token's last character in m_tokenText
+            int32_t commandIndex; // Index of the token's command, or -1
+        };
+
+        struct FlatCommand
+        {
+            CommandKind kind;
+            uint8_t operandFlags; // OperandFlags, only for operand commands
+            union
+            {
+                int32_t command;   // Binary and parenthesis commands
+                uint32_t argsEnd;  // Unary and operand commands: offset one past their last argument in m_commandArgs
+            };
+        };
+
+        std::wstring m_tokenText;
+        std::vector<Token> m_tokens;
+        std::vector<FlatCommand> m_commands;
+        std::vector<int32_t> m_commandArgs;
+    };
+}
@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include "CurrencyRateMatrix.h"
+
+using namespace std;
+using namespace UnitConversionManager;
+
+namespace
+{
+    constexpr int RATE_MIN_DECIMALS = 4;
+    constexpr int RATE_MIN_SIGNIFICANT_DECIMALS = 4;
+    constexpr size_t NO_DISPLAY_RATE_SOURCE = SIZE_MAX;
+
+    // The scales for up to 22 decimals, which are all exact doubles. Taking them from here rather than from powl saves
+    // most of the time it takes to round a rate.
+    constexpr double POWERS_OF_TEN[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+}
+
+CurrencyRateMatrix::CurrencyRateMatrix()
+    : m_displayRateSource(NO_DISPLAY_RATE_SOURCE)
+{
+}
+
+void CurrencyRateMatrix::Build(const vector<double>& ratios)
+{
+    m_ratios = ratios;
+    ClearDisplayRates();
+}
+
+bool CurrencyRateMatrix::Update(const vector<double>& ratios, _Inout_ vector<size_t>& changedPositions)
+{
+    if (ratios.size() != m_ratios.size())
+    {
+        Build(ratios);
+        return false;
+    }
+
+    for (size_t position = 0; position < m_ratios.size(); position++)
+    {
+        if (ratios[position] != m_ratios[position])
+        {
+            m_ratios[position] = ratios[position];
+            changedPositions.push_back(position);
+
+            // Every rate from a changed source is stale, but of the others only the rate to it
+            if (position == m_displayRateSource)
+            {
+                ClearDisplayRates();
+            }
+            else if (m_displayRateSource != NO_DISPLAY_RATE_SOURCE)
+            {
+                m_displayRates[position] = NAN;
+            }
+        }
+    }
+
+    return true;
+}
+
+void CurrencyRateMatrix::Clear()
+{
+    m_ratios.clear();
+    ClearDisplayRates();
+}
+
+double CurrencyRateMatrix::GetDisplayRate(size_t from, size_t to)
+{
+    if (from != m_displayRateSource)
+    {
+        m_displayRates.assign(m_ratios.size(), NAN);
+        m_displayRateSource = from;
+    }
+
+    double& displayRate = m_displayRates[to];
+    if (isnan(displayRate))
+    {
+        displayRate = RoundRate(GetRate(from, to));
+    }
+    return displayRate;
+}
+
+void CurrencyRateMatrix::ClearDisplayRates()
+{
+    m_displayRates.clear();
+    m_displayRateSource = NO_DISPLAY_RATE_SOURCE;
+}
+
+double CurrencyRateMatrix::RoundRate(double rate)
+{
+    int decimals = RATE_MIN_DECIMALS;
+    if (rate > 0 && rate < 1)
+    {
+        decimals = max(RATE_MIN_DECIMALS, static_cast<int>(-log10(rate)) + RATE_MIN_SIGNIFICANT_DECIMALS);
+    }
+
+    const double scale = POWERS_OF_TEN[min(decimals, static_cast<int>(size(POWERS_OF_TEN)) - 1)];
+    return round(rate * scale) / scale;
+}
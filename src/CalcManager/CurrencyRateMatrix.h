@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "sal_cross_platform.h"
+
+namespace UnitConversionManager
+{
+    // The rates between every pair of currencies, from their ratios to the default currency, along with the rates rounded
+    // as the converter shows them. Currencies are identified by their position, so that looking up a pair is two indexes
+    // rather than a search. Only the ratios are kept, as a rate is a division, and only the rounded rates from the last
+    // source currency asked for are, as the converter shows the rates from one currency at a time.
+    class CurrencyRateMatrix
+    {
+    public:
+        CurrencyRateMatrix();
+
+        // ratios[i] is how many of currency i one of the default currency is worth, and must be above 0.
+        void Build(const std::vector<double>& ratios);
+
+        // Takes the ratios that changed, and adds their positions to changedPositions. Returns false, and builds the
+        // matrix again, if the number of currencies changed.
+        bool Update(const std::vector<double>& ratios, _Inout_ std::vector<size_t>& changedPositions);
+        void Clear();
+
+        size_t GetCount() const
+        {
+            return m_ratios.size();
+        }
+
+        // How many of the to currency one of the from currency is worth
+        double GetRate(size_t from, size_t to) const
+        {
+            return m_ratios[to] / m_ratios[from];
+        }
+        double GetDisplayRate(size_t from, size_t to);
+
+        // Rounds a rate to the decimals that show at least its first significant digits, e.g. 0.00000000342334 to
+        // 0.000000003423 and 0.000212 to 0.000212.
+        static double RoundRate(double rate);
+
+    private:
+        void ClearDisplayRates();
+
+        std::vector<double> m_ratios;
+        std::vector<double> m_displayRates; // From m_displayRateSource to each currency, NaN until asked for
+        size_t m_displayRateSource;
+    };
+}
@@ -0,0 +1,782 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include "CurrencyTable.h"
+#include "Header Files/Snapshot.h"
+
+using namespace std;
+using namespace CalcEngine;
+using namespace UnitConversionManager;
+
+namespace
+{
+    constexpr wstring_view RATIO_KEY = L"Rt";
+    constexpr wstring_view CURRENCY_CODE_KEY = L"An";
+
+    // The members of a metadata element, in the order of STATIC_DATA_FIELD_*
+    constexpr array<wstring_view, 5> STATIC_DATA_PROPERTIES = { L"CountryCode", L"CountryName", L"CurrencyCode", L"CurrencyName", L"CurrencySymbol" };
+    constexpr size_t STATIC_DATA_FIELD_COUNTRY_CODE = 0;
+    constexpr size_t STATIC_DATA_FIELD_COUNTRY_NAME = 1;
+    constexpr size_t STATIC_DATA_FIELD_CURRENCY_CODE = 2;
+    constexpr size_t STATIC_DATA_FIELD_CURRENCY_NAME = 3;
+    constexpr size_t STATIC_DATA_FIELD_CURRENCY_SYMBOL = 4;
+
+    // How a snapshot is laid out, all values being little-endian:
+    //     CURRENCY_SNAPSHOT_MAGIC, CURRENCY_SNAPSHOT_VERSION, size of the snapshot, number of currencies
+    //     a record per currency: the bits of its ratio (uint64), its packed code, then where each of its strings is, in
+    //         the order of CurrencyTextField
+    //     the packed code and the position of each currency, in the order of the codes
+    //     the strings, as SnapshotWriter writes them
+    constexpr uint32_t CURRENCY_SNAPSHOT_MAGIC = 0x52554343; // "CCUR"
+    constexpr uint32_t CURRENCY_SNAPSHOT_VERSION = 1;
+    constexpr size_t CURRENCY_SNAPSHOT_SIZE_OFFSET = 2 * sizeof(uint32_t);
+    constexpr size_t CURRENCY_SNAPSHOT_HEADER_SIZE = 4 * sizeof(uint32_t);
+    constexpr size_t CURRENCY_TEXT_FIELD_COUNT = 4;
+    constexpr size_t CURRENCY_RECORD_TEXT_OFFSET = sizeof(uint64_t) + sizeof(uint32_t);
+    constexpr size_t CURRENCY_RECORD_SIZE = CURRENCY_RECORD_TEXT_OFFSET + CURRENCY_TEXT_FIELD_COUNT * sizeof(uint32_t);
+    constexpr size_t CURRENCY_INDEX_ENTRY_SIZE = 2 * sizeof(uint32_t);
+
+    // Longer than any number the feeds hold, which are ratios written with at most 17 significant digits
+    constexpr size_t MAX_NUMBER_LENGTH = 64;
+
+    // Deeper than any value the feeds hold, and as deep as a skipped value can be
+    constexpr size_t MAX_SKIPPED_DEPTH = 64;
+
+    bool IsJsonWhitespace(wchar_t c)
+    {
+        return c == L' ' || c == L'\t' || c == L'\n' || c == L'\r';
+    }
+
+    bool IsJsonNumberCharacter(wchar_t c)
+    {
+        return (c >= L'0' && c <= L'9') || c == L'-' || c == L'+' || c == L'.' || c == L'e' || c == L'E';
+    }
+
+    bool IsJsonNumberOrLiteral(wchar_t c)
+    {
+        return (c >= L'0' && c <= L'9') || (c >= L'a' && c <= L'z') || (c >= L'A' && c <= L'Z') || c == L'-' || c == L'+' || c == L'.';
+    }
+
+    int GetHexDigitValue(wchar_t c)
+    {
+        if (c >= L'0' && c <= L'9')
+        {
+            return c - L'0';
+        }
+        if (c >= L'a' && c <= L'f')
+        {
+            return c - L'a' + 10;
+        }
+        if (c >= L'A' && c <= L'F')
+        {
+            return c - L'A' + 10;
+        }
+        return -1;
+    }
+
+    // Reads JSON values one at a time, straight from the text. Strings are appended to the caller's string, which
+    // keeps its storage from one value to the next.
+    class JsonReader
+    {
+    public:
+        explicit JsonReader(wstring_view json)
+            : m_json(json)
+            , m_position(0)
+        {
+        }
+
+        // Returns the next character that isn't whitespace, without reading it, or 0 at the end of the text
+        wchar_t Peek()
+        {
+            SkipWhitespace();
+            return m_position < m_json.size() ? m_json[m_position] : L'\0';
+        }
+
+        // Reads the next character if it is c
+        bool Consume(wchar_t c)
+        {
+            if (Peek() != c || c == L'\0')
+            {
+                return false;
+            }
+
+            m_position++;
+            return true;
+        }
+
+        bool IsAtEnd()
+        {
+            return Peek() == L'\0';
+        }
+
+        bool ReadString(wstring& value)
+        {
+            if (!Consume(L'"'))
+            {
+                return false;
+            }
+
+            while (m_position < m_json.size())
+            {
+                const size_t runEnd = FindQuoteOrBackslash();
+                if (runEnd == wstring_view::npos)
+                {
+                    return false;
+                }
+
+                value.append(m_json.data() + m_position, runEnd - m_position);
+                m_position = runEnd + 1;
+                if (m_json[runEnd] == L'"')
+                {
+                    return true;
+                }
+
+                if (!ReadEscape(value))
+                {
+                    return false;
+                }
+            }
+
+            return false;
+        }
+
+        bool ReadNumber(double& value)
+        {
+            SkipWhitespace();
+            char number[MAX_NUMBER_LENGTH];
+            size_t length = 0;
+            while (m_position < m_json.size() && length < MAX_NUMBER_LENGTH && IsJsonNumberCharacter(m_json[m_position]))
+            {
+                number[length++] = static_cast<char>(m_json[m_position++]);
+            }
+
+            const auto result = from_chars(number, number + length, value);
+            return length > 0 && result.ec == errc{} && result.ptr == number + length;
+        }
+
+        // Skips a value of any type. The values inside an array or object that is skipped are only checked for
+        // their strings being closed and the brackets matching, which can be nested up to MAX_SKIPPED_DEPTH deep.
+        bool SkipValue()
+        {
+            size_t depth = 0;
+            uint64_t objectBits = 0; // Whether each open bracket is a brace, the innermost in the lowest bit
+            do
+            {
+                const wchar_t c = Peek();
+                switch (c)
+                {
+                case L'"':
+                    if (!SkipString())
+                    {
+                        return false;
+                    }
+                    break;
+                case L'[':
+                case L'{':
+                    if (depth == MAX_SKIPPED_DEPTH)
+                    {
+                        return false;
+                    }
+                    depth++;
+                    objectBits = objectBits << 1 | (c == L'{' ? 1 : 0);
+                    m_position++;
+                    break;
+                case L']':
+                case L'}':
+                    if (depth == 0 || (objectBits & 1) != (c == L'}' ? 1u : 0u))
+                    {
+                        return false;
+                    }
+                    depth--;
+                    objectBits >>= 1;
+                    m_position++;
+                    break;
+                case L',':
+                case L':':
+                    if (depth == 0)
+                    {
+                        return false;
+                    }
+                    m_position++;
+                    break;
+                case L'\0':
+                    return false;
+                default:
+                {
+                    const size_t start = m_position;
+                    while (m_position < m_json.size() && IsJsonNumberOrLiteral(m_json[m_position]))
+                    {
+                        m_position++;
+                    }
+                    if (m_position == start)
+                    {
+                        return false;
+                    }
+                }
+                }
+            } while (depth > 0);
+
+            return true;
+        }
+
+    private:
+        void SkipWhitespace()
+        {
+            while (m_position < m_json.size() && IsJsonWhitespace(m_json[m_position]))
+            {
+                m_position++;
+            }
+        }
+
+        // Where the current run of plain characters in a string ends. find_first_of would look each character up in
+        // the set of characters, which is much slower.
+        size_t FindQuoteOrBackslash() const
+        {
+            for (size_t i = m_position; i < m_json.size(); i++)
+            {
+                if (m_json[i] == L'"' || m_json[i] == L'\\')
+                {
+                    return i;
+                }
+            }
+            return wstring_view::npos;
+        }
+
+        bool SkipString()
+        {
+            m_position++;
+            while (m_position < m_json.size())
+            {
+                const size_t runEnd = FindQuoteOrBackslash();
+                if (runEnd == wstring_view::npos)
+                {
+                    return false;
+                }
+
+                // The character after a backslash is skipped with it, which is enough to find the closing quote
+                m_position = runEnd + (m_json[runEnd] == L'"' ? 1 : 2);
+                if (m_json[runEnd] == L'"')
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        bool ReadHexCodeUnit(_Out_ uint32_t& codeUnit)
+        {
+            codeUnit = 0;
+            if (m_json.size() - m_position < 4)
+            {
+                return false;
+            }
+
+            for (size_t i = 0; i < 4; i++)
+            {
+                const int digit = GetHexDigitValue(m_json[m_position++]);
+                if (digit < 0)
+                {
+                    return false;
+                }
+                codeUnit = codeUnit * 16 + digit;
+            }
+
+            return true;
+        }
+
+        // Reads what follows a backslash
+        bool ReadEscape(wstring& value)
+        {
+            if (m_position >= m_json.size())
+            {
+                return false;
+            }
+
+            const wchar_t escape = m_json[m_position++];
+            switch (escape)
+            {
+            case L'"':
+            case L'\\':
+            case L'/':
+                value.push_back(escape);
+                return true;
+            case L'b':
+                value.push_back(L'\b');
+                return true;
+            case L'f':
+                value.push_back(L'\f');
+                return true;
+            case L'n':
+                value.push_back(L'\n');
+                return true;
+            case L'r':
+                value.push_back(L'\r');
+                return true;
+            case L't':
+                value.push_back(L'\t');
+                return true;
+            case L'u':
+                break;
+            default:
+                return false;
+            }
+
+            uint32_t codeUnit;
+            if (!ReadHexCodeUnit(codeUnit))
+            {
+                return false;
+            }
+
+            // JSON escapes the characters outside the BMP as UTF-16 surrogate pairs, which a 32-bit wchar_t holds as one
+            if constexpr (sizeof(wchar_t) == 4)
+            {
+                uint32_t lowSurrogate;
+                const size_t position = m_position;
+                if (codeUnit >= 0xD800 && codeUnit < 0xDC00 && m_json.substr(m_position, 2) == L"\\u")
+                {
+                    m_position += 2;
+                    if (ReadHexCodeUnit(lowSurrogate) && lowSurrogate >= 0xDC00 && lowSurrogate < 0xE000)
+                    {
+                        codeUnit = 0x10000 + ((codeUnit - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+                    }
+                    else
+                    {
+                        m_position = position;
+                    }
+                }
+            }
+
+            value.push_back(static_cast<wchar_t>(codeUnit));
+            return true;
+        }
+
+        const wstring_view m_json;
+        size_t m_position;
+    };
+
+    // Calls parseElement for each element of the array that is an object, with the reader at its opening brace, and
+    // skips the other elements. The array must be the whole text.
+    template <typename ParseElement>
+    bool ParseArray(JsonReader& reader, ParseElement parseElement)
+    {
+        if (!reader.Consume(L'['))
+        {
+            return false;
+        }
+
+        if (!reader.Consume(L']'))
+        {
+            do
+            {
+                if (!(reader.Peek() == L'{' ? parseElement() : reader.SkipValue()))
+                {
+                    return false;
+                }
+            } while (reader.Consume(L','));
+
+            if (!reader.Consume(L']'))
+            {
+                return false;
+            }
+        }
+
+        return reader.IsAtEnd();
+    }
+
+    // Calls parseMember with the name of each member of the object, with the reader at its value, which parseMember
+    // must read or skip
+    template <typename ParseMember>
+    bool ParseObject(JsonReader& reader, wstring& key, ParseMember parseMember)
+    {
+        if (!reader.Consume(L'{'))
+        {
+            return false;
+        }
+
+        if (reader.Consume(L'}'))
+        {
+            return true;
+        }
+
+        do
+        {
+            key.clear();
+            if (!reader.ReadString(key) || !reader.Consume(L':') || !parseMember(wstring_view(key)))
+            {
+                return false;
+            }
+        } while (reader.Consume(L','));
+
+        return reader.Consume(L'}');
+    }
+}
+
+uint32_t UnitConversionManager::PackCurrencyCode(wstring_view code)
+{
+    if (code.size() != 3)
+    {
+        return INVALID_CURRENCY_CODE;
+    }
+
+    uint32_t packedCode = 0;
+    for (wchar_t c : code)
+    {
+        if (c < L'A' || c > L'Z')
+        {
+            return INVALID_CURRENCY_CODE;
+        }
+        packedCode = packedCode * 26 + (c - L'A');
+    }
+
+    return packedCode;
+}
+
+wstring UnitConversionManager::UnpackCurrencyCode(uint32_t code)
+{
+    if (code >= CURRENCY_CODE_COUNT)
+    {
+        return wstring();
+    }
+
+    wstring unpackedCode(3, L'A');
+    for (size_t i = unpackedCode.size(); i > 0; i--)
+    {
+        unpackedCode[i - 1] = static_cast<wchar_t>(L'A' + code % 26);
+        code /= 26;
+    }
+
+    return unpackedCode;
+}
+
+CurrencyTable::CurrencyTable()
+    : m_indices(CURRENCY_CODE_COUNT, INVALID_CURRENCY_CODE)
+{
+}
+
+bool CurrencyTable::ParseStaticData(wstring_view json)
+{
+    JsonReader reader(json);
+    bool isParsed = ParseArray(reader, [this, &reader]() {
+        // The strings go straight to the end of the text, which is cut back if the currency doesn't keep them
+        const size_t textSize = m_text.size();
+        CurrencyText fields[STATIC_DATA_PROPERTIES.size()] = {};
+        bool isElementParsed = ParseObject(reader, m_key, [this, &reader, &fields](wstring_view key) {
+            for (size_t i = 0; i < STATIC_DATA_PROPERTIES.size(); i++)
+            {
+                if (key == STATIC_DATA_PROPERTIES[i] && reader.Peek() == L'"')
+                {
+                    const size_t offset = m_text.size();
+                    if (!reader.ReadString(m_text))
+                    {
+                        return false;
+                    }
+
+                    fields[i] = CurrencyText{ static_cast<uint32_t>(offset), static_cast<uint32_t>(m_text.size() - offset) };
+                    return true;
+                }
+            }
+
+            return reader.SkipValue();
+        });
+        if (!isElementParsed)
+        {
+            return false;
+        }
+
+        CurrencyTableEntry* entry = FindOrAdd(PackCurrencyCode(GetText(fields[STATIC_DATA_FIELD_CURRENCY_CODE])));
+        if (entry == nullptr || entry->hasStaticData)
+        {
+            m_text.resize(textSize);
+            return true;
+        }
+
+        entry->hasStaticData = true;
+        entry->countryCode = fields[STATIC_DATA_FIELD_COUNTRY_CODE];
+        entry->countryName = fields[STATIC_DATA_FIELD_COUNTRY_NAME];
+        entry->currencyName = fields[STATIC_DATA_FIELD_CURRENCY_NAME];
+        entry->currencySymbol = fields[STATIC_DATA_FIELD_CURRENCY_SYMBOL];
+        return true;
+    });
+
+    if (!isParsed)
+    {
+        Clear();
+    }
+    return isParsed;
+}
+
+bool CurrencyTable::ParseRatios(wstring_view json)
+{
+    JsonReader reader(json);
+    bool isParsed = ParseArray(reader, [this, &reader]() {
+        double ratio = 0;
+        uint32_t code = INVALID_CURRENCY_CODE;
+        bool isElementParsed = ParseObject(reader, m_key, [this, &reader, &ratio, &code](wstring_view key) {
+            if (key == RATIO_KEY)
+            {
+                return reader.ReadNumber(ratio);
+            }
+            if (key == CURRENCY_CODE_KEY && reader.Peek() == L'"')
+            {
+                m_value.clear();
+                if (!reader.ReadString(m_value))
+                {
+                    return false;
+                }
+
+                code = PackCurrencyCode(m_value);
+                return true;
+            }
+
+            return reader.SkipValue();
+        });
+        if (!isElementParsed)
+        {
+            return false;
+        }
+
+        CurrencyTableEntry* entry = FindOrAdd(code);
+        if (entry != nullptr && entry->ratio == 0)
+        {
+            entry->ratio = ratio;
+        }
+        return true;
+    });
+
+    if (!isParsed)
+    {
+        Clear();
+    }
+    return isParsed;
+}
+
+void CurrencyTable::Clear()
+{
+    for (const CurrencyTableEntry& entry : m_entries)
+    {
+        m_indices[entry.code] = INVALID_CURRENCY_CODE;
+    }
+
+    m_entries.clear();
+    m_text.clear();
+}
+
+void CurrencyTable::RemoveIncomplete()
+{
+    m_entries.erase(
+        remove_if(m_entries.begin(), m_entries.end(), [](const CurrencyTableEntry& entry) { return !entry.hasStaticData || !(entry.ratio > 0); }),
+        m_entries.end());
+    RebuildIndices();
+}
+
+void CurrencyTable::RebuildIndices()
+{
+    fill(m_indices.begin(), m_indices.end(), INVALID_CURRENCY_CODE);
+    for (size_t i = 0; i < m_entries.size(); i++)
+    {
+        m_indices[m_entries[i].code] = static_cast<uint32_t>(i);
+    }
+}
+
+size_t CurrencyTable::SaveSnapshot(_Out_ uint8_t* buffer, size_t bufferSize) const
+{
+    SnapshotWriter writer(buffer, bufferSize);
+    writer.WriteUInt32(CURRENCY_SNAPSHOT_MAGIC);
+    writer.WriteUInt32(CURRENCY_SNAPSHOT_VERSION);
+    writer.WriteUInt32(0);
+    writer.WriteUInt32(static_cast<uint32_t>(m_entries.size()));
+
+    // Where the strings are is patched in once they are written
+    for (const CurrencyTableEntry& entry : m_entries)
+    {
+        uint64_t ratioBits;
+        memcpy(&ratioBits, &entry.ratio, sizeof(ratioBits));
+        writer.WriteUInt64(ratioBits);
+        writer.WriteUInt32(entry.code);
+        for (size_t i = 0; i < CURRENCY_TEXT_FIELD_COUNT; i++)
+        {
+            writer.WriteUInt32(0);
+        }
+    }
+
+    // The index is already in the order of the codes
+    for (uint32_t code = 0; code < CURRENCY_CODE_COUNT; code++)
+    {
+        if (m_indices[code] != INVALID_CURRENCY_CODE)
+        {
+            writer.WriteUInt32(code);
+            writer.WriteUInt32(m_indices[code]);
+        }
+    }
+
+    for (size_t i = 0; i < m_entries.size(); i++)
+    {
+        const CurrencyText texts[CURRENCY_TEXT_FIELD_COUNT] = { m_entries[i].countryCode, m_entries[i].countryName, m_entries[i].currencyName,
+                                                                m_entries[i].currencySymbol };
+        for (size_t field = 0; field < CURRENCY_TEXT_FIELD_COUNT; field++)
+        {
+            writer.PatchUInt32(
+                CURRENCY_SNAPSHOT_HEADER_SIZE + i * CURRENCY_RECORD_SIZE + CURRENCY_RECORD_TEXT_OFFSET + field * sizeof(uint32_t),
+                static_cast<uint32_t>(writer.Size()));
+            writer.WriteString(GetText(texts[field]));
+        }
+    }
+
+    writer.PatchUInt32(CURRENCY_SNAPSHOT_SIZE_OFFSET, static_cast<uint32_t>(writer.Size()));
+    return writer.Size();
+}
+
+const CurrencyTableEntry* CurrencyTable::Find(uint32_t code) const
+{
+    if (code >= CURRENCY_CODE_COUNT || m_indices[code] == INVALID_CURRENCY_CODE)
+    {
+        return nullptr;
+    }
+
+    return &m_entries[m_indices[code]];
+}
+
+CurrencyTableEntry* CurrencyTable::FindOrAdd(uint32_t code)
+{
+    if (code >= CURRENCY_CODE_COUNT)
+    {
+        return nullptr;
+    }
+
+    if (m_indices[code] == INVALID_CURRENCY_CODE)
+    {
+        m_indices[code] = static_cast<uint32_t>(m_entries.size());
+        m_entries.push_back(CurrencyTableEntry{ code, 0, false, {}, {}, {}, {} });
+    }
+
+    return &m_entries[m_indices[code]];
+}
+
+CurrencyStaticData CurrencyTable::GetStaticData(const CurrencyTableEntry& entry) const
+{
+    return CurrencyStaticData{ wstring(GetText(entry.countryCode)),
+                               wstring(GetText(entry.countryName)),
+                               UnpackCurrencyCode(entry.code),
+                               wstring(GetText(entry.currencyName)),
+                               wstring(GetText(entry.currencySymbol)) };
+}
+
+CurrencyTableSnapshot::CurrencyTableSnapshot()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_count(0)
+{
+}
+
+bool CurrencyTableSnapshot::Open(_In_ const uint8_t* data, size_t size)
+{
+    Close();
+
+    SnapshotReader reader(data, size);
+    const uint32_t magic = reader.ReadUInt32();
+    const uint32_t version = reader.ReadUInt32();
+    const uint32_t snapshotSize = reader.ReadUInt32();
+    const uint32_t count = reader.ReadUInt32();
+    if (!reader.IsValid() || magic != CURRENCY_SNAPSHOT_MAGIC || version != CURRENCY_SNAPSHOT_VERSION || snapshotSize < CURRENCY_SNAPSHOT_HEADER_SIZE
+        || snapshotSize > size || count > (snapshotSize - CURRENCY_SNAPSHOT_HEADER_SIZE) / (CURRENCY_RECORD_SIZE + CURRENCY_INDEX_ENTRY_SIZE))
+    {
+        return false;
+    }
+
+    m_data = data;
+    m_size = snapshotSize;
+    m_count = count;
+    return true;
+}
+
+void CurrencyTableSnapshot::Close()
+{
+    m_data = nullptr;
+    m_size = 0;
+    m_count = 0;
+}
+
+const uint8_t* CurrencyTableSnapshot::GetRecord(size_t position) const
+{
+    return position < m_count ? m_data + CURRENCY_SNAPSHOT_HEADER_SIZE + position * CURRENCY_RECORD_SIZE : nullptr;
+}
+
+uint32_t CurrencyTableSnapshot::GetCode(size_t position) const
+{
+    SnapshotReader reader(GetRecord(position), CURRENCY_RECORD_SIZE);
+    reader.ReadBytes(sizeof(uint64_t));
+    const uint32_t code = reader.ReadUInt32();
+    return reader.IsValid() ? code : INVALID_CURRENCY_CODE;
+}
+
+double CurrencyTableSnapshot::GetRatio(size_t position) const
+{
+    SnapshotReader reader(GetRecord(position), CURRENCY_RECORD_SIZE);
+    const uint64_t ratioBits = reader.ReadUInt64();
+    double ratio = 0;
+    if (reader.IsValid())
+    {
+        memcpy(&ratio, &ratioBits, sizeof(ratio));
+    }
+    return ratio;
+}
+
+size_t CurrencyTableSnapshot::Find(uint32_t code) const
+{
+    const size_t indexOffset = CURRENCY_SNAPSHOT_HEADER_SIZE + m_count * CURRENCY_RECORD_SIZE;
+    size_t first = 0;
+    size_t last = m_count;
+    while (first < last)
+    {
+        const size_t middle = first + (last - first) / 2;
+        SnapshotReader reader(m_data + indexOffset + middle * CURRENCY_INDEX_ENTRY_SIZE, CURRENCY_INDEX_ENTRY_SIZE);
+        const uint32_t middleCode = reader.ReadUInt32();
+        if (middleCode == code)
+        {
+            return min<size_t>(reader.ReadUInt32(), m_count);
+        }
+
+        if (middleCode < code)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+
+    return m_count;
+}
+
+bool CurrencyTableSnapshot::ReadText(size_t position, CurrencyTextField field, wstring& value) const
+{
+    value.clear();
+    SnapshotReader record(GetRecord(position), CURRENCY_RECORD_SIZE);
+    record.ReadBytes(CURRENCY_RECORD_TEXT_OFFSET + static_cast<size_t>(field) * sizeof(uint32_t));
+    const uint32_t offset = record.ReadUInt32();
+    if (!record.IsValid() || offset >= m_size)
+    {
+        return false;
+    }
+
+    SnapshotReader reader(m_data + offset, m_size - offset);
+    reader.ReadString(value);
+    return reader.IsValid();
+}
+
+CurrencyStaticData CurrencyTableSnapshot::GetStaticData(size_t position) const
+{
+    CurrencyStaticData staticData{};
+    ReadText(position, CurrencyTextField::CountryCode, staticData.countryCode);
+    ReadText(position, CurrencyTextField::CountryName, staticData.countryName);
+    ReadText(position, CurrencyTextField::CurrencyName, staticData.currencyName);
+    ReadText(position, CurrencyTextField::CurrencySymbol, staticData.currencySymbol);
+    staticData.currencyCode = UnpackCurrencyCode(GetCode(position));
+    return staticData;
+}
@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "sal_cross_platform.h"
+#include "UnitConverter.h"
+
+namespace UnitConversionManager
+{
+    // The number of 3-letter currency codes, and so of packed codes
+    constexpr uint32_t CURRENCY_CODE_COUNT = 26 * 26 * 26;
+    constexpr uint32_t INVALID_CURRENCY_CODE = CURRENCY_CODE_COUNT;
+
+    // Packs an ISO 4217 code, 3 letters from A to Z, into a number below CURRENCY_CODE_COUNT, or returns
+    // INVALID_CURRENCY_CODE if it isn't one. Packed codes sort as the codes do.
+    uint32_t PackCurrencyCode(std::wstring_view code);
+    std::wstring UnpackCurrencyCode(uint32_t code);
+
+    // Where a string of a currency is in the text of its CurrencyTable
+    struct CurrencyText
+    {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    enum class CurrencyTextField
+    {
+        CountryCode,
+        CountryName,
+        CurrencyName,
+        CurrencySymbol
+    };
+
+    struct CurrencyTableEntry
+    {
+        uint32_t code; // Packed
+        double ratio;  // From the default currency, or 0 if the ratios feed hasn't given it
+        bool hasStaticData;
+        CurrencyText countryCode;
+        CurrencyText countryName;
+        CurrencyText currencyName;
+        CurrencyText currencySymbol;
+    };
+
+    // The currencies of the currency feeds, which are parsed in one pass, straight from the JSON text, without building
+    // a document first. Each currency is an entry that is found from its packed code through a dense index, and all of
+    // their strings share one buffer, so that filling the table makes no allocation per currency once it has grown.
+    //
+    // The metadata feed is an array of objects with the CountryCode, CountryName, CurrencyCode, CurrencyName and
+    // CurrencySymbol strings, and the ratios feed an array of objects with the ratio Rt and the currency code An. Other
+    // members are skipped, and so is an element that isn't an object or has no valid currency code. A currency that
+    // appears more than once keeps the first metadata and the first ratio other than 0 that it was given.
+    class CurrencyTable
+    {
+    public:
+        CurrencyTable();
+
+        // Adds the currencies of a metadata feed, and their metadata to those that are already in the table. Returns
+        // false, and clears the table, if the feed isn't a JSON array.
+        bool ParseStaticData(std::wstring_view json);
+
+        // Adds the currencies of a ratios feed, and their ratios to those that are already in the table. Returns false,
+        // and clears the table, if the feed isn't a JSON array, or an Rt isn't a number.
+        bool ParseRatios(std::wstring_view json);
+
+        void Clear();
+
+        // Removes the currencies that have no metadata, or no ratio above 0, which can't be converted.
+        void RemoveIncomplete();
+
+        // Sorts the entries with sortEntries(std::vector<CurrencyTableEntry>&), e.g. by their country names in the
+        // user's language, and finds them again.
+        template <typename SortEntries>
+        void Sort(SortEntries sortEntries)
+        {
+            sortEntries(m_entries);
+            RebuildIndices();
+        }
+
+        // Writes the table as CurrencyTableSnapshot reads it, in the order of its entries. Returns the size of the
+        // snapshot, and only writes it if that is not more than bufferSize.
+        size_t SaveSnapshot(_Out_ uint8_t* buffer, size_t bufferSize) const;
+
+        // Returns nullptr if the currency isn't in the table.
+        const CurrencyTableEntry* Find(uint32_t code) const;
+
+        // In the order that the currencies first appeared in the feeds
+        const std::vector<CurrencyTableEntry>& GetEntries() const
+        {
+            return m_entries;
+        }
+        std::wstring_view GetText(CurrencyText text) const
+        {
+            return std::wstring_view(m_text.data() + text.offset, text.length);
+        }
+
+        CurrencyStaticData GetStaticData(const CurrencyTableEntry& entry) const;
+
+    private:
+        CurrencyTableEntry* FindOrAdd(uint32_t code);
+        void RebuildIndices();
+
+        std::vector<CurrencyTableEntry> m_entries;
+        std::vector<uint32_t> m_indices; // From the packed code to the position in m_entries, or to INVALID_CURRENCY_CODE
+        std::wstring m_text;
+        std::wstring m_key;   // The name of the member being parsed
+        std::wstring m_value; // A currency code being parsed
+    };
+
+    // Reads the currencies that CurrencyTable::SaveSnapshot wrote, in place, e.g. from a mapped file. Opening it only
+    // checks its header, the ratios are read from the data as they are asked for, and only the strings that are asked
+    // for are decoded. The data must outlive the snapshot, or its next Open.
+    class CurrencyTableSnapshot
+    {
+    public:
+        CurrencyTableSnapshot();
+
+        // Returns false, and leaves the snapshot empty, if the data isn't a snapshot of this version.
+        bool Open(_In_ const uint8_t* data, size_t size);
+        void Close();
+
+        // The currencies are at positions 0 to GetCount() - 1, in the order of the table that was saved
+        size_t GetCount() const
+        {
+            return m_count;
+        }
+        uint32_t GetCode(size_t position) const;
+        double GetRatio(size_t position) const;
+
+        // Returns GetCount() if the currency isn't in the snapshot.
+        size_t Find(uint32_t code) const;
+
+        // Reads the string into value, which keeps its storage. Returns false, with value empty, if the string is not
+        // within the data.
+        bool ReadText(size_t position, CurrencyTextField field, std::wstring& value) const;
+        CurrencyStaticData GetStaticData(size_t position) const;
+
+    private:
+        const uint8_t* GetRecord(size_t position) const;
+
+        const uint8_t* m_data;
+        size_t m_size;
+        size_t m_count;
+    };
+}
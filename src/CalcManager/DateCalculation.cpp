@@ -0,0 +1,207 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "DateCalculation.h"
+
+using namespace std;
+using namespace CalcManager::DateCalculation;
+
+namespace
+{
+    constexpr int32_t DAYS_IN_WEEK = 7;
+    constexpr uint32_t DAYS_IN_MONTH[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+    bool IsLeapYear(int64_t year)
+    {
+        return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+    }
+
+    bool IsInRange(int64_t year)
+    {
+        return year >= MIN_YEAR && year <= MAX_YEAR;
+    }
+
+    // The months since January of year 0, which is what adding months changes
+    int64_t GetMonthIndex(const CivilDate& date)
+    {
+        return static_cast<int64_t>(date.year) * 12 + (date.month - 1);
+    }
+
+    int64_t FloorDivide(int64_t a, int64_t b)
+    {
+        return a / b - (a % b < 0 ? 1 : 0);
+    }
+
+    // The date a whole number of months from date, with the day clamped to the month, and the year left unchecked
+    CivilDate AddMonths(const CivilDate& date, int64_t months, _Out_ int64_t& year)
+    {
+        const int64_t monthIndex = GetMonthIndex(date) + months;
+        year = FloorDivide(monthIndex, 12);
+
+        CivilDate result;
+        result.year = static_cast<int32_t>(year);
+        result.month = static_cast<uint32_t>(monthIndex - year * 12) + 1;
+        result.day = date.day;
+        if (result.day > 28)
+        {
+            const uint32_t daysInMonth = result.month == 2 && IsLeapYear(year) ? 29 : DAYS_IN_MONTH[result.month - 1];
+            result.day = result.day < daysInMonth ? result.day : daysInMonth;
+        }
+        return result;
+    }
+
+    // Whether the earlier date plus months is still not after later, which is only a matter of their days once the
+    // month is the same
+    bool IsNotAfter(const CivilDate& earlier, int64_t months, const CivilDate& later)
+    {
+        int64_t year;
+        const CivilDate pivot = AddMonths(earlier, months, year);
+        return GetMonthIndex(pivot) < GetMonthIndex(later) || (GetMonthIndex(pivot) == GetMonthIndex(later) && pivot.day <= later.day);
+    }
+
+    bool TryAddDays(int32_t days, int64_t count, _Out_ int32_t& result)
+    {
+        const int64_t sum = static_cast<int64_t>(days) + count;
+        if (sum < DaysFromCivil({ MIN_YEAR, 1, 1 }) || sum > DaysFromCivil({ MAX_YEAR, 12, 31 }))
+        {
+            return false;
+        }
+
+        result = static_cast<int32_t>(sum);
+        return true;
+    }
+}
+
+namespace CalcManager::DateCalculation
+{
+    // The algorithm of Howard Hinnant's days_from_civil, which counts in eras of 400 years that start on March 1, so that
+    // the leap day is the last day of a year
+    int32_t DaysFromCivil(CivilDate date)
+    {
+        const int64_t year = static_cast<int64_t>(date.year) - (date.month <= 2 ? 1 : 0);
+        const int64_t era = FloorDivide(year, 400);
+        const int64_t yearOfEra = year - era * 400;
+        const int64_t dayOfYear = (153 * (date.month > 2 ? date.month - 3 : date.month + 9) + 2) / 5 + date.day - 1;
+        const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return static_cast<int32_t>(era * 146097 + dayOfEra - 719468);
+    }
+
+    CivilDate CivilFromDays(int32_t days)
+    {
+        const int64_t shifted = static_cast<int64_t>(days) + 719468;
+        const int64_t era = FloorDivide(shifted, 146097);
+        const int64_t dayOfEra = shifted - era * 146097;
+        const int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const int64_t monthFromMarch = (5 * dayOfYear + 2) / 153;
+
+        CivilDate date;
+        date.day = static_cast<uint32_t>(dayOfYear - (153 * monthFromMarch + 2) / 5 + 1);
+        date.month = static_cast<uint32_t>(monthFromMarch < 10 ? monthFromMarch + 3 : monthFromMarch - 9);
+        date.year = static_cast<int32_t>(yearOfEra + era * 400 + (date.month <= 2 ? 1 : 0));
+        return date;
+    }
+
+    uint32_t GetDaysInMonth(int32_t year, uint32_t month)
+    {
+        return month == 2 && IsLeapYear(year) ? 29 : DAYS_IN_MONTH[month - 1];
+    }
+
+    bool TryAddMonths(int32_t days, int64_t months, _Out_ int32_t& result)
+    {
+        int64_t year;
+        const CivilDate date = AddMonths(CivilFromDays(days), months, year);
+        if (!IsInRange(year))
+        {
+            return false;
+        }
+
+        result = DaysFromCivil(date);
+        return true;
+    }
+
+    bool TryAddDuration(int32_t days, const DateDuration& duration, _Out_ int32_t& result)
+    {
+        int32_t date = days;
+        if ((duration.years != 0 && !TryAddMonths(date, static_cast<int64_t>(duration.years) * 12, date))
+            || (duration.months != 0 && !TryAddMonths(date, duration.months, date)) || !TryAddDays(date, duration.days, date))
+        {
+            return false;
+        }
+
+        result = date;
+        return true;
+    }
+
+    bool TrySubtractDuration(int32_t days, const DateDuration& duration, _Out_ int32_t& result)
+    {
+        int32_t date = days;
+        if (!TryAddDays(date, -static_cast<int64_t>(duration.days), date)
+            || (duration.months != 0 && !TryAddMonths(date, -static_cast<int64_t>(duration.months), date))
+            || (duration.years != 0 && !TryAddMonths(date, -static_cast<int64_t>(duration.years) * 12, date)))
+        {
+            return false;
+        }
+
+        result = date;
+        return true;
+    }
+
+    // Each unit is found from the difference of the month indices, which is the answer or one too many, depending on the
+    // days of the months. Adding months to a date never makes it go back, so that one check is enough.
+    DateDuration GetDateDifference(int32_t date1, int32_t date2, uint32_t units)
+    {
+        const int32_t startDays = date1 < date2 ? date1 : date2;
+        const int32_t endDays = date1 < date2 ? date2 : date1;
+
+        DateDuration difference{};
+        int32_t pivotDays = startDays;
+        if ((units & (DATE_UNIT_YEAR | DATE_UNIT_MONTH)) != 0)
+        {
+            const CivilDate end = CivilFromDays(endDays);
+            CivilDate pivot = CivilFromDays(startDays);
+            if ((units & DATE_UNIT_YEAR) != 0)
+            {
+                int64_t years = end.year - pivot.year;
+                years -= IsNotAfter(pivot, years * 12, end) ? 0 : 1;
+
+                int64_t year;
+                pivot = AddMonths(pivot, years * 12, year);
+                difference.years = static_cast<int32_t>(years);
+            }
+            if ((units & DATE_UNIT_MONTH) != 0)
+            {
+                int64_t months = GetMonthIndex(end) - GetMonthIndex(pivot);
+                months -= IsNotAfter(pivot, months, end) ? 0 : 1;
+
+                int64_t year;
+                pivot = AddMonths(pivot, months, year);
+                difference.months = static_cast<int32_t>(months);
+            }
+            pivotDays = DaysFromCivil(pivot);
+        }
+
+        int32_t days = endDays - pivotDays;
+        if ((units & DATE_UNIT_WEEK) != 0)
+        {
+            difference.weeks = days / DAYS_IN_WEEK;
+            days -= difference.weeks * DAYS_IN_WEEK;
+        }
+
+        difference.days = days;
+        return difference;
+    }
+
+    void GetDateDifferences(
+        _In_ const int32_t* dates1,
+        _In_ const int32_t* dates2,
+        size_t count,
+        uint32_t units,
+        _Out_ DateDuration* differences)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            differences[i] = GetDateDifference(dates1[i], dates2[i], units);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "sal_cross_platform.h" // for SAL
+
+// Dates of the proleptic Gregorian calendar, as the number of days since 1970-01-01. They convert to and from years,
+// months and days with arithmetic alone, and so does every calculation here: none of them steps through the calendar.
+namespace CalcManager::DateCalculation
+{
+    struct CivilDate
+    {
+        int32_t year;
+        uint32_t month; // 1 to 12
+        uint32_t day;   // 1 to the number of days in the month
+    };
+
+    // The range of the Windows calendar, that results must be in
+    constexpr int32_t MIN_YEAR = 1;
+    constexpr int32_t MAX_YEAR = 9999;
+
+    // The units that a difference is given in, which can be combined. What is left after the larger units is always
+    // given in days.
+    constexpr uint32_t DATE_UNIT_YEAR = 0x01;
+    constexpr uint32_t DATE_UNIT_MONTH = 0x02;
+    constexpr uint32_t DATE_UNIT_WEEK = 0x04;
+    constexpr uint32_t DATE_UNIT_DAY = 0x08;
+
+    struct DateDuration
+    {
+        int32_t years;
+        int32_t months;
+        int32_t weeks;
+        int32_t days;
+    };
+
+    int32_t DaysFromCivil(CivilDate date);
+    CivilDate CivilFromDays(int32_t days);
+    uint32_t GetDaysInMonth(int32_t year, uint32_t month);
+
+    // Adds the months, a year being 12, keeping the day of the month unless the month is shorter, in which case the
+    // result is its last day: January 31 plus a month is February 28 or 29. Returns false if the result is not within
+    // MIN_YEAR and MAX_YEAR.
+    bool TryAddMonths(int32_t days, int64_t months, _Out_ int32_t& result);
+
+    // Adds the years, then the months, then the days of the duration, as the Windows calendar does, and the subtraction
+    // takes away the days first. The weeks of the duration are not used. Returns false if the result, or the date
+    // after any of the steps, is not within MIN_YEAR and MAX_YEAR.
+    bool TryAddDuration(int32_t days, const DateDuration& duration, _Out_ int32_t& result);
+    bool TrySubtractDuration(int32_t days, const DateDuration& duration, _Out_ int32_t& result);
+
+    // The difference between two dates, in either order, starting with the largest of the units: the most whole years
+    // that can be added to the earlier date without passing the later one, then the most whole months that can be added
+    // to that, and so on, as the pivot loops of the Windows date calculator found them.
+    DateDuration GetDateDifference(int32_t date1, int32_t date2, uint32_t units);
+
+    // The differences between count pairs of dates, in the same units
+    void GetDateDifferences(_In_ const int32_t* dates1, _In_ const int32_t* dates2, size_t count, uint32_t units, _Out_ DateDuration* differences);
+}
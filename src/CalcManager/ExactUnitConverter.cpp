@@ -0,0 +1,227 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include "ExactUnitConverter.h"
+#include "Header Files/RationalMath.h"
+
+using namespace std;
+using namespace CalcEngine;
+using namespace CalcEngine::RationalMath;
+using namespace UnitConversionManager;
+
+namespace
+{
+    // Ratpack's constants are set up by the first calculator engine, and the unit converter can be used before there
+    // is one. They are set up here as that engine would set them up, and never changed once an engine has.
+    constexpr uint32_t DEFAULT_RADIX = 10;
+    constexpr int32_t DEFAULT_PRECISION = 32;
+
+    // Enough BASEX digits for the 53 bits of a double
+    constexpr size_t DOUBLE_DIGIT_COUNT = 3;
+
+    void InitializeConstants()
+    {
+        if (num_one == nullptr)
+        {
+            ChangeConstants(DEFAULT_RADIX, DEFAULT_PRECISION);
+        }
+    }
+
+    uint64_t GetConversionKey(int fromUnitId, int toUnitId)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(fromUnitId)) << 32) | static_cast<uint32_t>(toUnitId);
+    }
+
+    bool TryParseDecimal(wstring_view text, _Out_ Rational& value)
+    {
+        bool isNegative = false;
+        if (!text.empty() && (text.front() == L'-' || text.front() == L'+'))
+        {
+            isNegative = text.front() == L'-';
+            text.remove_prefix(1);
+        }
+
+        // StringToNumber takes the exponent and its sign as part of the mantissa, and skips characters that aren't digits
+        if (text.empty() || text.find_first_of(L"+-") == 0 || text.find_first_not_of(L"0123456789.e+-") != wstring_view::npos)
+        {
+            return false;
+        }
+
+        PRAT rat = StringToRat(isNegative, text, false, L"", RATIONAL_BASE, RATIONAL_PRECISION);
+        if (rat == nullptr)
+        {
+            return false;
+        }
+
+        value = Rational{ rat };
+        destroyrat(rat);
+        return true;
+    }
+
+    // The most significant BASEX digits of n, and the power of 2 that they are to be multiplied by
+    double GetLeadingDigits(const Number& n, _Out_ int& exponent)
+    {
+        const vector<uint32_t>& mantissa = n.Mantissa();
+        const size_t count = min(mantissa.size(), DOUBLE_DIGIT_COUNT);
+        double digits = 0;
+        for (size_t i = mantissa.size(); i > mantissa.size() - count; i--)
+        {
+            digits = digits * BASEX + mantissa[i - 1];
+        }
+
+        exponent = (n.Exp() + static_cast<int>(mantissa.size() - count)) * static_cast<int>(BASEXPWR);
+        return digits;
+    }
+}
+
+ExactUnitConverter::ExactUnitConverter()
+{
+    InitializeConstants();
+}
+
+bool ExactUnitConverter::AddFactors(const unordered_map<int, ExactConversionFactor>& factors)
+{
+    bool isEveryFactorAdded = true;
+    for (const auto& factor : factors)
+    {
+        Conversion conversion{};
+        if (!TryParse(factor.second.ratio, conversion.ratio) || conversion.ratio.P().IsZero()
+            || !(factor.second.offset.empty() || TryParse(factor.second.offset, conversion.offset)))
+        {
+            isEveryFactorAdded = false;
+            continue;
+        }
+
+        conversion.hasOffset = !conversion.offset.P().IsZero();
+        m_factors[factor.first] = move(conversion);
+    }
+
+    // A pair may have been composed with a factor that has just been replaced
+    m_conversions.clear();
+    return isEveryFactorAdded;
+}
+
+void ExactUnitConverter::Clear()
+{
+    m_factors.clear();
+    m_conversions.clear();
+}
+
+bool ExactUnitConverter::HasFactor(int unitId) const
+{
+    return m_factors.find(unitId) != m_factors.end();
+}
+
+bool ExactUnitConverter::Convert(int fromUnitId, int toUnitId, const Rational& value, _Out_ Rational& result)
+{
+    const Conversion* conversion = GetConversion(fromUnitId, toUnitId);
+    if (conversion == nullptr)
+    {
+        return false;
+    }
+
+    result = value * conversion->ratio;
+    if (conversion->hasOffset)
+    {
+        result += conversion->offset;
+    }
+
+    return true;
+}
+
+// from = base in the from unit, to = base in the to unit, so
+// to = (from * fromRatio + fromOffset - toOffset) / toRatio = from * (fromRatio / toRatio) + (fromOffset - toOffset) / toRatio
+const ExactUnitConverter::Conversion* ExactUnitConverter::GetConversion(int fromUnitId, int toUnitId)
+{
+    const uint64_t key = GetConversionKey(fromUnitId, toUnitId);
+    auto conversion = m_conversions.find(key);
+    if (conversion != m_conversions.end())
+    {
+        return &conversion->second;
+    }
+
+    auto from = m_factors.find(fromUnitId);
+    auto to = m_factors.find(toUnitId);
+    if (from == m_factors.end() || to == m_factors.end())
+    {
+        return nullptr;
+    }
+
+    Conversion composed{};
+    composed.ratio = from->second.ratio / to->second.ratio;
+    if (from->second.hasOffset || to->second.hasOffset)
+    {
+        composed.offset = (from->second.offset - to->second.offset) / to->second.ratio;
+    }
+    composed.hasOffset = !composed.offset.P().IsZero();
+
+    return &m_conversions.emplace(key, move(composed)).first->second;
+}
+
+bool ExactUnitConverter::TryParse(wstring_view text, _Out_ Rational& value)
+{
+    InitializeConstants();
+    const size_t fractionBar = text.find(L'/');
+    if (fractionBar == wstring_view::npos)
+    {
+        return TryParseDecimal(text, value);
+    }
+
+    Rational numerator;
+    Rational denominator;
+    if (!TryParseDecimal(text.substr(0, fractionBar), numerator) || !TryParseDecimal(text.substr(fractionBar + 1), denominator)
+        || denominator.P().IsZero())
+    {
+        return false;
+    }
+
+    value = numerator / denominator;
+    return true;
+}
+
+wstring ExactUnitConverter::ToFixedString(const Rational& value, int decimals)
+{
+    InitializeConstants();
+    Rational scaled = Abs(value);
+    for (int i = 0; i < decimals; i++)
+    {
+        scaled *= 10;
+    }
+    scaled += Rational{ 1 } / 2;
+
+    // The remainder is exact, where Integer flattens the rational at the full precision first, which is far slower
+    scaled -= scaled % 1;
+
+    // The integer is written out in full as long as it has fewer digits than the precision
+    wstring digits = scaled.ToString(RATIONAL_BASE, FMT_FLOAT, RATIONAL_PRECISION);
+    if (digits.size() <= static_cast<size_t>(decimals))
+    {
+        digits.insert(0, decimals + 1 - digits.size(), L'0');
+    }
+    if (decimals > 0)
+    {
+        digits.insert(digits.size() - decimals, 1, L'.');
+    }
+    if (value.P().Sign() < 0 && !value.P().IsZero())
+    {
+        digits.insert(0, 1, L'-');
+    }
+
+    return digits;
+}
+
+double ExactUnitConverter::ToDouble(const Rational& value)
+{
+    if (value.P().IsZero())
+    {
+        return 0;
+    }
+
+    int pExponent;
+    int qExponent;
+    const double p = GetLeadingDigits(value.P(), pExponent);
+    const double q = GetLeadingDigits(value.Q(), qExponent);
+    return value.P().Sign() * value.Q().Sign() * ldexp(p / q, pExponent - qExponent);
+}
@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "Header Files/Rational.h"
+#include "UnitConverter.h"
+
+namespace UnitConversionManager
+{
+    // Converts between units through CalcEngine::Rational, with the exact factors that a data loader gives, so that a
+    // conversion is only rounded when its result is shown. The ratio and offset from one unit to another are composed
+    // from the factors of the two units the first time that the pair is converted, after which a conversion is one
+    // multiply, and an add if the units don't share their offset. Ratpack's constants are set up, if no calculator engine
+    // has set them up yet, by the constructor and by the static functions that need them.
+    class ExactUnitConverter
+    {
+    public:
+        ExactUnitConverter();
+
+        // Adds the factors of units, by unit id. A factor that can't be parsed, or whose ratio is 0, is left out, and its
+        // unit can't be converted exactly. Returns false if any factor was left out.
+        bool AddFactors(const std::unordered_map<int, ExactConversionFactor>& factors);
+        void Clear();
+        bool HasFactor(int unitId) const;
+
+        // Returns false, without changing result, if either unit has no factor.
+        bool Convert(int fromUnitId, int toUnitId, const CalcEngine::Rational& value, _Out_ CalcEngine::Rational& result);
+
+        // Parses a decimal literal, such as "-0.3048" or "1e-9", or a fraction of two of them, such as "400/121".
+        static bool TryParse(std::wstring_view text, _Out_ CalcEngine::Rational& value);
+
+        // Writes value with decimals digits after the decimal point, as RoundSignificantDigits writes a double, rounding
+        // the exact value half away from zero.
+        static std::wstring ToFixedString(const CalcEngine::Rational& value, int decimals);
+
+        // The nearest double to value, within a couple of units in the last place.
+        static double ToDouble(const CalcEngine::Rational& value);
+
+    private:
+        // base = value * ratio + offset, or from one unit to another once they are composed
+        struct Conversion
+        {
+            CalcEngine::Rational ratio;
+            CalcEngine::Rational offset;
+            bool hasOffset;
+        };
+
+        const Conversion* GetConversion(int fromUnitId, int toUnitId);
+
+        std::unordered_map<int, Conversion> m_factors;
+        std::unordered_map<uint64_t, Conversion> m_conversions; // From the pair of unit ids
+    };
+}
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <string>
 #include "Header Files/CCommand.h"
 #include "ExpressionCommand.h"
@@ -11,6 +12,10 @@ using namespace CalcEngine;
 constexpr wchar_t chNegate = L'-';
 constexpr wchar_t chExp = L'e';
 constexpr wchar_t chPlus = L'+';
+constexpr int ASCII_0 = 48;
+
+// One rendering for each of hex, decimal, octal and binary
+constexpr size_t maxRadixRenderings = 4;
 
 CParentheses::CParentheses(_In_ int command)
     : m_command(command)
@@ -112,6 +117,7 @@ void COpndCommand::Initialize(Rational const& rat)
 {
     m_value = rat;
     m_fInitialized = true;
+    m_renderings.clear();
 }
 
 const shared_ptr<vector<int>>& COpndCommand::GetCommands() const
@@ -122,10 +128,14 @@ const shared_ptr<vector<int>>& COpndCommand::GetCommands() const
 void COpndCommand::SetCommands(shared_ptr<vector<int>> const& commands)
 {
     m_commands = commands;
+    m_renderings.clear();
 }
 
 void COpndCommand::AppendCommand(int command)
 {
+    // The commands may be shared with a cached rendering, which must not change with them
+    m_renderings.clear();
+
     if (m_fSciFmt)
     {
         ClearAllAndAppendCommand(static_cast<CalculationManager::Command>(command));
@@ -155,6 +165,8 @@ void COpndCommand::ToggleSign()
 
 void COpndCommand::RemoveFromEnd()
 {
+    m_renderings.clear();
+
     if (m_fSciFmt)
     {
         ClearAllAndAppendCommand(CalculationManager::Command::Command0);
@@ -273,6 +285,16 @@ const wstring& COpndCommand::GetToken(wchar_t decimalSymbol)
     return m_token;
 }
 
+bool COpndCommand::IsInitialized() const
+{
+    return m_fInitialized;
+}
+
+Rational const& COpndCommand::GetValue() const
+{
+    return m_value;
+}
+
 wstring COpndCommand::GetString(uint32_t radix, int32_t precision)
 {
     if (m_fInitialized)
@@ -283,6 +305,71 @@ wstring COpndCommand::GetString(uint32_t radix, int32_t precision)
     return wstring{};
 }
 
+const wstring& COpndCommand::SetRadix(uint32_t radix, int32_t precision, wchar_t decimalSymbol)
+{
+    auto rendering = find_if(m_renderings.begin(), m_renderings.end(), [&](RadixRendering const& r) {
+        return r.radix == radix && r.precision == precision && r.decimalSymbol == decimalSymbol;
+    });
+
+    if (rendering == m_renderings.end())
+    {
+        if (m_renderings.size() == maxRadixRenderings)
+        {
+            m_renderings.clear();
+        }
+
+        wstring value = GetString(radix, precision);
+        auto commands = GetCommandsFromString(value, decimalSymbol);
+        m_renderings.push_back({ radix, precision, decimalSymbol, move(value), move(commands) });
+        rendering = m_renderings.end() - 1;
+    }
+
+    m_commands = rendering->commands;
+    return rendering->value;
+}
+
+// Returns the commands that enter the given number string
+shared_ptr<vector<int>> COpndCommand::GetCommandsFromString(wstring_view numStr, wchar_t decimalSymbol)
+{
+    shared_ptr<vector<int>> commands = make_shared<vector<int>>();
+    // Check for negate
+    bool fNegative = (!numStr.empty() && numStr[0] == chNegate);
+
+    for (size_t i = (fNegative ? 1 : 0); i < numStr.length(); i++)
+    {
+        if (numStr[i] == decimalSymbol)
+        {
+            commands->push_back(IDC_PNT);
+        }
+        else if (numStr[i] == chExp)
+        {
+            commands->push_back(IDC_EXP);
+        }
+        else if (numStr[i] == chNegate)
+        {
+            commands->push_back(IDC_SIGN);
+        }
+        else if (numStr[i] == chPlus)
+        {
+            // Ignore.
+        }
+        // Number
+        else
+        {
+            int num = static_cast<int>(numStr[i]) - ASCII_0;
+            num += IDC_0;
+            commands->push_back(num);
+        }
+    }
+
+    // If the number is negative, append a sign command at the end.
+    if (fNegative)
+    {
+        commands->push_back(IDC_SIGN);
+    }
+    return commands;
+}
+
 void COpndCommand::Accept(_In_ ISerializeCommandVisitor& commandVisitor)
 {
     commandVisitor.Visit(*this);
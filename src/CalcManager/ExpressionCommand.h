@@ -64,8 +64,24 @@ public:
     CalculationManager::CommandType GetCommandType() const override;
     void Accept(_In_ ISerializeCommandVisitor& commandVisitor) override;
     std::wstring GetString(uint32_t radix, int32_t precision);
+    bool IsInitialized() const;
+    CalcEngine::Rational const& GetValue() const;
+
+    // Returns the value formatted in the given radix and replaces the commands with the ones that enter that string.
+    // Both are kept for each radix the operand has been shown in, so switching back to a radix doesn't convert the
+    // value again.
+    const std::wstring& SetRadix(uint32_t radix, int32_t precision, wchar_t decimalSymbol);
 
 private:
+    struct RadixRendering
+    {
+        uint32_t radix;
+        int32_t precision;
+        wchar_t decimalSymbol;
+        std::wstring value;
+        std::shared_ptr<std::vector<int>> commands;
+    };
+
     std::shared_ptr<std::vector<int>> m_commands;
     bool m_fNegative;
     bool m_fSciFmt;
@@ -73,7 +89,9 @@ private:
     bool m_fInitialized;
     std::wstring m_token;
     CalcEngine::Rational m_value;
+    std::vector<RadixRendering> m_renderings;
     void ClearAllAndAppendCommand(CalculationManager::Command command);
+    static std::shared_ptr<std::vector<int>> GetCommandsFromString(std::wstring_view numStr, wchar_t decimalSymbol);
 };
 
 class ISerializeCommandVisitor
@@ -4,8 +4,10 @@
 #pragma once
 
 #include <memory> // for std::shared_ptr
+#include <string>
 #include <vector>
 #include "Command.h"
+#include "sal_cross_platform.h" // for SAL
 
 class ISerializeCommandVisitor;
 
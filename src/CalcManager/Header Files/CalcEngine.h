@@ -23,6 +23,7 @@
 #include "History.h" // for History Collector
 #include "CalcInput.h"
 #include "CalcUtils.h"
+#include "ICalcCommandTracer.h"
 #include "ICalcDisplay.h"
 #include "Rational.h"
 #include "RationalMath.h"
@@ -90,6 +91,19 @@ public:
     void UpdateMaxIntDigits();
     wchar_t DecimalSeparator() const;
 
+    // Calls the tracer at the start and end of each command, until it is set to nullptr. Commands aren't timed while
+    // there is no tracer.
+    void SetCommandTracer(__in_opt ICalcCommandTracer* pCommandTracer)
+    {
+        m_pCommandTracer = pCommandTracer;
+    }
+
+    // Saves the state of the calculation, so that an engine of the same kind can carry it on. The settings that come
+    // from the resource provider are not part of the snapshot. Like a radix change, restoring updates Ratpack's
+    // constants for the radix and precision of the engine; the display is not updated.
+    void SaveSnapshot(CalcEngine::SnapshotWriter& writer) const;
+    void RestoreSnapshot(CalcEngine::SnapshotReader& reader);
+
     // Static methods for the instance
     static void
     InitialOneTimeOnlySetup(CalculationManager::IResourceProvider& resourceProvider); // Once per load time to call to initialize all shared global variables
@@ -113,6 +127,7 @@ private:
     bool m_fPrecedence;
     bool m_fIntegerMode; /* This is true if engine is explicitly called to be in integer mode. All bases are restricted to be in integers only */
     ICalcDisplay* m_pCalcDisplay;
+    ICalcCommandTracer* m_pCommandTracer;
     CalculationManager::IResourceProvider* const m_resourceProvider;
     int m_nOpCode;     /* ID value of operation.                       */
     int m_nPrevOpCode; // opcode which computed the number in m_currentVal. 0 if it is already bracketed or plain number or
@@ -122,7 +137,6 @@ private:
     bool m_bSetCalcState;          // Flag for setting the engine result state
     CalcEngine::CalcInput m_input; // Global calc input object for decimal strings
     eNUMOBJ_FMT m_nFE;             /* Scientific notation conversion flag.       */
-    CalcEngine::Rational m_maxTrigonometricNum;
     std::unique_ptr<CalcEngine::Rational> m_memoryValue; // Current memory value.
 
     CalcEngine::Rational m_holdVal; // For holding the second operand in repetitive calculations ( pressing "=" continuously)
@@ -142,6 +156,21 @@ private:
 
     std::wstring m_numberString;
 
+    // State of the engine the last time DisplayNum updated the display. Each engine keeps its own, so that it doesn't
+    // skip updating m_numberString because another engine has displayed the same value.
+    struct LastDisplay
+    {
+        CalcEngine::Rational value;
+        int32_t precision;
+        uint32_t radix;
+        int nFE;
+        NUM_WIDTH numwidth;
+        bool fIntMath;
+        bool bRecord;
+        bool bUseSep;
+    };
+    LastDisplay m_lastDisplay;
+
     int m_nTempCom;                          /* Holding place for the last command.          */
     size_t m_openParenCount;                 // Number of open parentheses.
     std::array<int, MAXPRECDEPTH> m_nOp;     /* Holding array for parenthesis operations.    */
@@ -159,13 +188,17 @@ private:
 
     CHistoryCollector m_HistoryCollector; // Accumulator of each line of history as various commands are processed
 
-    std::array<CalcEngine::Rational, NUM_WIDTH_LENGTH> m_chopNumbers;      // word size enforcement
-    std::array<std::wstring, NUM_WIDTH_LENGTH> m_maxDecimalValueStrings;   // maximum values represented by a given word width based off m_chopNumbers
+    // These never change, so they are computed once and shared across all instances
+    static std::array<CalcEngine::Rational, NUM_WIDTH_LENGTH> s_chopNumbers;    // word size enforcement
+    static std::array<std::wstring, NUM_WIDTH_LENGTH> s_maxDecimalValueStrings; // maximum values represented by a given word width based off s_chopNumbers
+    static CalcEngine::Rational s_maxTrigonometricNum;
     static std::unordered_map<std::wstring_view, std::wstring> s_engineStrings; // the string table shared across all instances
     wchar_t m_decimalSeparator;
     wchar_t m_groupSeparator;
 
 private:
+    class CommandTraceScope;
+
     void ProcessCommandWorker(OpCode wParam);
     void ResolveHighestPrecedenceOperation();
     void HandleErrorCommand(OpCode idc);
@@ -187,7 +220,7 @@ private:
     bool TryToggleBit(CalcEngine::Rational& rat, uint32_t wbitno);
     void CheckAndAddLastBinOpToHistory(bool addToHistory = true);
 
-    void InitChopNumbers();
+    static void InitChopNumbers();
 
     static void LoadEngineStrings(CalculationManager::IResourceProvider& resourceProvider);
     static int IdStrFromCmdId(int id)
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Rational.h"
+#include "Snapshot.h"
 
 // Space to hold enough digits for a quadword binary number (64) plus digit separator strings for that number (20)
 constexpr int MAX_STRLEN = 84;
@@ -25,7 +26,7 @@ namespace CalcEngine
             return value.empty();
         }
 
-        bool IsNegative()
+        bool IsNegative() const
         {
             return m_isNegative;
         }
@@ -67,9 +68,18 @@ namespace CalcEngine
         void Backspace();
         void SetDecimalSymbol(wchar_t decSymbol);
         bool IsEmpty();
+        // The digits of the mantissa and of the exponent, without converting the input
+        size_t GetDigitCount() const
+        {
+            return m_base.value.size() - (m_hasDecimal ? 1 : 0) + m_exponent.value.size();
+        }
         std::wstring ToString(uint32_t radix);
         Rational ToRational(uint32_t radix, int32_t precision);
 
+        // The decimal symbol comes from the settings and is not part of the snapshot.
+        void SaveSnapshot(SnapshotWriter& writer) const;
+        void RestoreSnapshot(SnapshotReader& reader);
+
     private:
         bool m_hasExponent;
         bool m_hasDecimal;
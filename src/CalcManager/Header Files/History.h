@@ -7,6 +7,7 @@
 #include "ICalcDisplay.h"
 #include "IHistoryDisplay.h"
 #include "Rational.h"
+#include "Snapshot.h"
 
 // maximum depth you can get by precedence. It is just an array's size limit.
 static constexpr size_t MAXPRECDEPTH = 25;
@@ -37,6 +38,10 @@ public:
     void UpdateHistoryExpression(uint32_t radix, int32_t precision);
     void SetDecimalSymbol(wchar_t decimalSymbol);
 
+    // Saves the expression being built, including the values of its operands. The display is not updated on restore.
+    void SaveSnapshot(CalcEngine::SnapshotWriter& writer) const;
+    void RestoreSnapshot(CalcEngine::SnapshotReader& reader);
+
 private:
     std::shared_ptr<IHistoryDisplay> m_pHistoryDisplay;
     ICalcDisplay* m_pCalcDisplay;
@@ -60,5 +65,4 @@ private:
     void TruncateEquationSzFromIch(int ich);
     void SetExpressionDisplay();
     void InsertSzInEquationSz(std::wstring_view str, int icommandIndex, int ich);
-    std::shared_ptr<std::vector<int>> GetOperandCommandsFromString(std::wstring_view numStr);
 };
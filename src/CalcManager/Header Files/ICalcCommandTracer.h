@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include "../sal_cross_platform.h" // for SAL
+
+// A command that CCalcEngine processed: what it was given, and how long it took.
+struct CalcCommandTrace
+{
+    int opCode;
+    uint32_t radix;
+    int32_t precision;
+    uint32_t numeratorDigits;   // Digits in the mantissa of the numerator of the current value, when the command started
+    uint32_t denominatorDigits; // and of its denominator; both are zero while a number is being entered
+    uint32_t inputDigits;       // Digits of the number being entered, in the radix, or zero if there is none
+    uint64_t startTime;         // Nanoseconds, of std::chrono::steady_clock
+    uint64_t elapsedTime;       // Nanoseconds; zero when the command starts
+};
+
+// Callback interface to be implemented by the clients of CCalcEngine if they want to time the commands it processes.
+// Both methods are called on the thread that processes the command; a command that others are given to, like the
+// closing parentheses that = adds, starts and ends within it. They must not throw.
+class ICalcCommandTracer
+{
+public:
+    virtual ~ICalcCommandTracer(){};
+    virtual void OnCommandStarted(_In_ CalcCommandTrace const& /*trace*/)
+    {
+    }
+    virtual void OnCommandEnded(_In_ CalcCommandTrace const& /*trace*/)
+    {
+    }
+};
@@ -20,6 +20,10 @@ public:
     virtual void BinaryOperatorReceived() = 0;
     virtual void OnHistoryItemAdded(_In_ unsigned int addedItemIndex) = 0;
     virtual void SetMemorizedNumbers(const std::vector<std::wstring>& memorizedNumbers) = 0;
+    // Changes to a single memorized number, so that the whole list doesn't need to be sent again.
+    virtual void InsertMemorizedNumber(unsigned int indexOfMemory, const std::wstring& memorizedNumber) = 0;
+    virtual void UpdateMemorizedNumber(unsigned int indexOfMemory, const std::wstring& memorizedNumber) = 0;
+    virtual void RemoveMemorizedNumber(unsigned int indexOfMemory) = 0;
     virtual void MemoryItemChanged(unsigned int indexOfMemory) = 0;
     virtual void InputChanged() = 0;
 };
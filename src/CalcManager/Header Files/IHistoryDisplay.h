@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <string_view>
 #include "../ExpressionCommandInterface.h"
 
 // Callback interface to be implemented by the clients of CCalcEngine if they require equation history
@@ -24,6 +24,9 @@ namespace CalcEngine
         bool IsZero() const;
 
     private:
+        // Reads snapshots into the existing mantissa, to reuse its storage
+        friend class SnapshotReader;
+
         int32_t m_sign;
         int32_t m_exp;
         std::vector<uint32_t> m_mantissa;
@@ -68,6 +68,8 @@ namespace CalcEngine
         uint64_t ToUInt64_t() const;
 
     private:
+        friend class SnapshotReader;
+
         Number m_p;
         Number m_q;
     };
@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "Rational.h"
+
+namespace CalcEngine
+{
+    // Writes the binary form of a calculator snapshot. Values are stored little-endian whatever the platform, strings
+    // as UTF-16 and arrays after their length. The writer never allocates: once the caller's buffer is full it only
+    // counts the bytes that it would have written, so that the caller can find the size it needs.
+    class SnapshotWriter
+    {
+    public:
+        SnapshotWriter(uint8_t* buffer, size_t capacity);
+
+        void WriteUInt8(uint8_t value);
+        void WriteBool(bool value);
+        void WriteUInt32(uint32_t value);
+        void WriteInt32(int32_t value);
+        void WriteUInt64(uint64_t value);
+        void WriteByteArray(const uint8_t* bytes, size_t count); // The count, then the bytes
+        void WriteString(std::wstring_view value);
+        void WriteRational(Rational const& value);
+
+        // Overwrites a value that was written earlier, e.g. a length that was not known yet.
+        void PatchUInt32(size_t offset, uint32_t value);
+
+        size_t Size() const
+        {
+            return m_size;
+        }
+        bool IsComplete() const
+        {
+            return m_size <= m_capacity;
+        }
+
+    private:
+        uint8_t* Reserve(size_t count);
+        void WriteNumber(Number const& value);
+
+        uint8_t* const m_buffer;
+        const size_t m_capacity;
+        size_t m_size;
+    };
+
+    // Reads what a SnapshotWriter wrote. A read past the end of the data, or a value that a Read method or the caller
+    // finds out of range, marks the reader as invalid; every read after that returns zero or an empty value. Strings
+    // and rationals are read into existing objects, so that their storage is reused.
+    class SnapshotReader
+    {
+    public:
+        SnapshotReader(const uint8_t* data, size_t size);
+
+        uint8_t ReadUInt8();
+        bool ReadBool();
+        uint32_t ReadUInt32();
+        int32_t ReadInt32();
+        uint64_t ReadUInt64();
+        void ReadString(std::wstring& value);
+        void ReadRational(Rational& value);
+
+        // Reads the length of an array, which must not be over maxCount.
+        uint32_t ReadCount(size_t maxCount);
+
+        // Returns a pointer to the next count bytes and skips them, or nullptr if there are not enough left.
+        const uint8_t* ReadBytes(size_t count);
+
+        void Invalidate();
+        bool IsValid() const
+        {
+            return m_isValid;
+        }
+        bool IsAtEnd() const
+        {
+            return m_remaining == 0;
+        }
+
+    private:
+        void ReadNumber(Number& value);
+
+        const uint8_t* m_data;
+        size_t m_remaining;
+        bool m_isValid;
+    };
+}
@@ -0,0 +1,226 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace CalculationManager;
+
+#if defined(_WIN32)
+
+// The *FromApp functions are the ones that are available to Store apps as well as to desktop apps
+
+MappedFile::MappedFile()
+    : m_file(INVALID_HANDLE_VALUE)
+    , m_mapping(nullptr)
+    , m_data(nullptr)
+    , m_size(0)
+{
+}
+
+bool MappedFile::Open(filesystem::path const& path)
+{
+    Close();
+
+    m_file = CreateFile2(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, OPEN_ALWAYS, nullptr);
+    LARGE_INTEGER size;
+    if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &size))
+    {
+        Close();
+        return false;
+    }
+
+    m_size = static_cast<uint64_t>(size.QuadPart);
+    return m_size == 0 || Map();
+}
+
+void MappedFile::Close()
+{
+    Unmap();
+    if (m_file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+    }
+    m_size = 0;
+}
+
+bool MappedFile::IsOpen() const
+{
+    return m_file != INVALID_HANDLE_VALUE;
+}
+
+// A writable mapping that is larger than the file grows the file
+bool MappedFile::Map()
+{
+    m_mapping = CreateFileMappingFromApp(m_file, nullptr, PAGE_READWRITE, m_size, nullptr);
+    if (m_mapping != nullptr)
+    {
+        m_data = static_cast<uint8_t*>(MapViewOfFileFromApp(m_mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, static_cast<SIZE_T>(m_size)));
+    }
+
+    if (m_data == nullptr)
+    {
+        Unmap();
+        return false;
+    }
+
+    return true;
+}
+
+void MappedFile::Unmap()
+{
+    if (m_data != nullptr)
+    {
+        UnmapViewOfFile(m_data);
+        m_data = nullptr;
+    }
+    if (m_mapping != nullptr)
+    {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+}
+
+bool MappedFile::Resize(uint64_t size)
+{
+    if (!IsOpen())
+    {
+        return false;
+    }
+    if (size <= m_size)
+    {
+        return m_data != nullptr;
+    }
+
+    Unmap();
+    uint64_t oldSize = m_size;
+    m_size = size;
+    if (!Map())
+    {
+        // Keep the old data mapped
+        m_size = oldSize;
+        if (m_size != 0)
+        {
+            Map();
+        }
+        return false;
+    }
+
+    return true;
+}
+
+bool MappedFile::Flush()
+{
+    return m_data == nullptr || (FlushViewOfFile(m_data, 0) && FlushFileBuffers(m_file));
+}
+
+#else
+
+MappedFile::MappedFile()
+    : m_file(-1)
+    , m_data(nullptr)
+    , m_size(0)
+{
+}
+
+bool MappedFile::Open(filesystem::path const& path)
+{
+    Close();
+
+    // Sessions can hold anything the user typed, so only the user can read the file
+    m_file = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    struct stat status;
+    if (m_file == -1 || fstat(m_file, &status) != 0)
+    {
+        Close();
+        return false;
+    }
+
+    m_size = static_cast<uint64_t>(status.st_size);
+    return m_size == 0 || Map();
+}
+
+void MappedFile::Close()
+{
+    Unmap();
+    if (m_file != -1)
+    {
+        close(m_file);
+        m_file = -1;
+    }
+    m_size = 0;
+}
+
+bool MappedFile::IsOpen() const
+{
+    return m_file != -1;
+}
+
+bool MappedFile::Map()
+{
+    void* data = mmap(nullptr, static_cast<size_t>(m_size), PROT_READ | PROT_WRITE, MAP_SHARED, m_file, 0);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    m_data = static_cast<uint8_t*>(data);
+    return true;
+}
+
+void MappedFile::Unmap()
+{
+    if (m_data != nullptr)
+    {
+        munmap(m_data, static_cast<size_t>(m_size));
+        m_data = nullptr;
+    }
+}
+
+bool MappedFile::Resize(uint64_t size)
+{
+    if (!IsOpen())
+    {
+        return false;
+    }
+    if (size <= m_size)
+    {
+        return m_data != nullptr;
+    }
+
+    Unmap();
+    if (ftruncate(m_file, static_cast<off_t>(size)) != 0)
+    {
+        // The file keeps its old size, so map that again
+        if (m_size != 0)
+        {
+            Map();
+        }
+        return false;
+    }
+
+    m_size = size;
+    return Map();
+}
+
+bool MappedFile::Flush()
+{
+    return m_data == nullptr || msync(m_data, static_cast<size_t>(m_size), MS_SYNC) == 0;
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+namespace CalculationManager
+{
+    // A file that is mapped into memory for reading and writing. The whole file is mapped, and growing it maps it
+    // again, so pointers into the data are only valid until the next call to Resize.
+    class MappedFile
+    {
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        MappedFile(MappedFile const&) = delete;
+        MappedFile& operator=(MappedFile const&) = delete;
+
+        // Opens the file, creating it if it doesn't exist, and maps it. An empty file is not mapped until it is resized.
+        bool Open(std::filesystem::path const& path);
+        void Close();
+
+        // Grows the file to size bytes. The file never shrinks.
+        bool Resize(uint64_t size);
+
+        // Writes the changed pages to the disk.
+        bool Flush();
+
+        bool IsOpen() const;
+        uint8_t* Data() const
+        {
+            return m_data;
+        }
+        uint64_t Size() const
+        {
+            return m_size;
+        }
+
+    private:
+        bool Map();
+        void Unmap();
+
+#if defined(_WIN32)
+        void* m_file;
+        void* m_mapping;
+#else
+        int m_file;
+#endif
+        uint8_t* m_data;
+        uint64_t m_size;
+    };
+}
@@ -1,8 +1,39 @@
-#include "pch.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <sstream>
 #include "NumberFormattingUtils.h"
 
 using namespace std;
 
+namespace
+{
+    // Enough for any double with up to 150 decimals, as only a double of more than 150 digits needs more
+    constexpr size_t FORMAT_BUFFER_SIZE = 512;
+
+    // A stream formats with this precision when it is given a negative one, as printf does
+    constexpr int DEFAULT_STREAM_PRECISION = 6;
+
+    size_t CopyFormattedNumber(const char* first, const char* last, _Out_ wchar_t* buffer, size_t bufferSize)
+    {
+        const size_t length = static_cast<size_t>(last - first);
+        if (length <= bufferSize)
+        {
+            copy(first, last, buffer);
+        }
+        return length;
+    }
+
+    size_t CopyFormattedNumber(const wstring& number, _Out_ wchar_t* buffer, size_t bufferSize)
+    {
+        if (number.size() <= bufferSize)
+        {
+            copy(number.begin(), number.end(), buffer);
+        }
+        return number.size();
+    }
+}
+
 namespace CalcManager::NumberFormattingUtils
 {
     /// <summary>
@@ -11,37 +42,41 @@ namespace CalcManager::NumberFormattingUtils
     /// <param name="number">number to trim</param>
     void TrimTrailingZeros(_Inout_ wstring& number)
     {
-        if (number.find(L'.') == wstring::npos)
-        {
-            return;
-        }
+        number.resize(GetLengthWithoutTrailingZeros(number));
+    }
 
-        for (auto iter = number.end() - 1;; iter--)
+    /// <summary>
+    /// Gets the length that TrimTrailingZeros would trim the number to, for a number that isn't in a wstring
+    /// </summary>
+    /// <param name="number">number to measure</param>
+    size_t GetLengthWithoutTrailingZeros(wstring_view number)
+    {
+        if (number.find(L'.') == wstring_view::npos)
         {
-            if (*iter != L'0')
-            {
-                number.erase(iter + 1, number.end());
-                break;
-            }
+            return number.size();
         }
-        if (number.back() == L'.')
+
+        // The decimal point is not a zero, so there is always one to stop at
+        size_t length = number.find_last_not_of(L'0') + 1;
+        if (number[length - 1] == L'.')
         {
-            number.pop_back();
+            length--;
         }
+        return length;
     }
 
     /// <summary>
     /// Get number of digits (whole number part + decimal part)</summary>
     /// <param name="value">the number</param>
-    unsigned int GetNumberDigits(wstring value)
+    unsigned int GetNumberDigits(wstring_view value)
     {
-        TrimTrailingZeros(value);
+        value = value.substr(0, GetLengthWithoutTrailingZeros(value));
         unsigned int numberSignificantDigits = static_cast<unsigned int>(value.size());
-        if (value.find(L'.') != wstring::npos)
+        if (value.find(L'.') != wstring_view::npos)
         {
             --numberSignificantDigits;
         }
-        if (value.find(L'-') != wstring::npos)
+        if (value.find(L'-') != wstring_view::npos)
         {
             --numberSignificantDigits;
         }
@@ -80,4 +115,37 @@ namespace CalcManager::NumberFormattingUtils
         out << scientific << number;
         return out.str();
     }
+
+    /// <summary>
+    /// Rounds the given double to the given number of digits after the decimal point, into the buffer
+    /// </summary>
+    /// <param name="value">input double</param>
+    /// <param name="numberSignificantDigits">number of digits after the decimal point</param>
+    /// <param name="buffer">receives the rounded number, if it fits</param>
+    /// <param name="bufferSize">size of the buffer, in characters</param>
+    size_t RoundSignificantDigits(double value, int numberSignificantDigits, _Out_ wchar_t* buffer, size_t bufferSize)
+    {
+        char digits[FORMAT_BUFFER_SIZE];
+        const int precision = numberSignificantDigits < 0 ? DEFAULT_STREAM_PRECISION : numberSignificantDigits;
+        auto result = to_chars(begin(digits), end(digits), value, chars_format::fixed, precision);
+        if (result.ec != errc{})
+        {
+            return CopyFormattedNumber(RoundSignificantDigits(value, numberSignificantDigits), buffer, bufferSize);
+        }
+
+        return CopyFormattedNumber(digits, result.ptr, buffer, bufferSize);
+    }
+
+    /// <summary>
+    ///  Convert a Number to Scientific Notation, into the buffer
+    /// </summary>
+    /// <param name="number">number to convert</param>
+    /// <param name="buffer">receives the converted number, if it fits</param>
+    /// <param name="bufferSize">size of the buffer, in characters</param>
+    size_t ToScientificNumber(double number, _Out_ wchar_t* buffer, size_t bufferSize)
+    {
+        char digits[FORMAT_BUFFER_SIZE];
+        auto result = to_chars(begin(digits), end(digits), number, chars_format::scientific, DEFAULT_STREAM_PRECISION);
+        return CopyFormattedNumber(digits, result.ptr, buffer, bufferSize);
+    }
 }
@@ -4,12 +4,21 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include "sal_cross_platform.h" // for SAL
 
 namespace CalcManager::NumberFormattingUtils
 {
     void TrimTrailingZeros(_Inout_ std::wstring& input);
-    unsigned int GetNumberDigits(std::wstring value);
+    size_t GetLengthWithoutTrailingZeros(std::wstring_view number);
+    unsigned int GetNumberDigits(std::wstring_view value);
     unsigned int GetNumberDigitsWholeNumberPart(double value);
     std::wstring RoundSignificantDigits(double value, int numberSignificantDigits);
     std::wstring ToScientificNumber(double number);
+
+    // These write the same characters as the functions above into the caller's buffer, without a stream or an
+    // allocation, and without a terminating null. They return the number of characters, and only write them if that is
+    // no more than bufferSize.
+    size_t RoundSignificantDigits(double value, int numberSignificantDigits, _Out_ wchar_t* buffer, size_t bufferSize);
+    size_t ToScientificNumber(double number, _Out_ wchar_t* buffer, size_t bufferSize);
 }
@@ -0,0 +1,338 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <iterator>
+#include "CalculatorManager.h"
+#include "PasteCommandStream.h"
+
+using namespace std;
+using namespace CalculationManager;
+
+namespace
+{
+    constexpr size_t c_readBufferSize = 4096;
+
+    // Spaces, digit grouping, quotes, currency symbols and bidi marks, see CopyPasteManager::RemoveUnwantedCharsFromString
+    constexpr wchar_t c_unwantedChars[] = { L' ', L',', L'"', 165, 164, 8373, 36, 8353, 8361, 8362, 8358, 8377, 163, 8364, 8234, 8235, 8236, 8237 };
+
+    bool IsUnwantedChar(wchar_t c)
+    {
+        return find(begin(c_unwantedChars), end(c_unwantedChars), c) != end(c_unwantedChars);
+    }
+
+    // Returns CommandNULL for characters that don't map to a command in the given grammar,
+    // see StandardCalculatorViewModel::MapCharacterToButtonId
+    Command MapCharacterToCommand(wchar_t c, PasteGrammar grammar)
+    {
+        if (c >= L'0' && c <= L'9')
+        {
+            return static_cast<Command>(static_cast<int>(Command::Command0) + (c - L'0'));
+        }
+
+        switch (c)
+        {
+        case L'*':
+            return Command::CommandMUL;
+        case L'+':
+            return Command::CommandADD;
+        case L'-':
+            return Command::CommandSUB;
+        case L'/':
+            return Command::CommandDIV;
+        case L'^':
+            return grammar == PasteGrammar::Scientific ? Command::CommandPWR : Command::CommandNULL;
+        case L'%':
+            return (grammar == PasteGrammar::Scientific || grammar == PasteGrammar::Programmer) ? Command::CommandMOD : Command::CommandNULL;
+        case L'=':
+            return Command::CommandEQU;
+        case L'(':
+            return Command::CommandOPENP;
+        case L')':
+            return Command::CommandCLOSEP;
+        case L'.':
+            return Command::CommandPNT;
+        case L'a':
+        case L'A':
+            return Command::CommandA;
+        case L'b':
+        case L'B':
+            return Command::CommandB;
+        case L'c':
+        case L'C':
+            return Command::CommandC;
+        case L'd':
+        case L'D':
+            return Command::CommandD;
+        case L'e':
+        case L'E':
+            // Only allow scientific notation outside of programmer mode
+            return grammar == PasteGrammar::Programmer ? Command::CommandE : Command::CommandEXP;
+        case L'f':
+        case L'F':
+            return Command::CommandF;
+        }
+
+        return Command::CommandNULL;
+    }
+
+    bool IsDigitCommand(Command command)
+    {
+        return command >= Command::Command0 && command <= Command::Command9;
+    }
+}
+
+PasteCommandStream::PasteCommandStream(CalculatorManager& calculatorManager, PasteGrammar grammar, RADIX_TYPE radix, const PasteOperandLimits& limits)
+    : m_calculatorManager(calculatorManager)
+    , m_grammar(grammar)
+    , m_radix(radix)
+    , m_limits(limits)
+    , m_isValid(true)
+    , m_isFinished(false)
+    , m_splitter(grammar, MaxExponentLength)
+    , m_hasSentCommand(false)
+    , m_isFirstLegalChar(true)
+    , m_isPreviousOperator(false)
+    , m_sendNegate(false)
+    , m_isAfterExponent(false)
+{
+    m_operand.reserve(MaxBufferedOperandLength);
+    m_sanitizedOperand.reserve(MaxBufferedOperandLength);
+}
+
+bool PasteCommandStream::Write(wstring_view chunk)
+{
+    for (size_t i = 0; i < chunk.size() && m_isValid && !m_isFinished; i++)
+    {
+        ProcessCharacter(chunk[i]);
+    }
+
+    return m_isValid;
+}
+
+bool PasteCommandStream::Finish()
+{
+    if (!m_isValid || m_isFinished)
+    {
+        return m_isValid;
+    }
+
+    m_isFinished = true;
+
+    // A trailing = evaluates the expression once it has been pasted
+    wstring_view operand = m_operand;
+    bool sendEquals = !operand.empty() && operand.back() == L'=';
+    if (sendEquals)
+    {
+        operand.remove_suffix(1);
+    }
+
+    if (!ValidateOperand(operand))
+    {
+        return false;
+    }
+
+    SendOperand(operand);
+    if (sendEquals)
+    {
+        SendCharacter(L'=');
+    }
+
+    m_operand.clear();
+    return true;
+}
+
+bool PasteCommandStream::Paste(wistream& input)
+{
+    wchar_t buffer[c_readBufferSize];
+    while (m_isValid && input)
+    {
+        input.read(buffer, c_readBufferSize);
+        Write(wstring_view(buffer, static_cast<size_t>(input.gcount())));
+    }
+
+    return Finish();
+}
+
+void PasteCommandStream::ProcessCharacter(wchar_t c)
+{
+    if (IsUnwantedChar(c))
+    {
+        return;
+    }
+
+    switch (m_splitter.Next(c))
+    {
+    case OperandSplitResult::Operator:
+        if (ValidateOperand(m_operand))
+        {
+            SendOperand(m_operand);
+            SendCharacter(c);
+            m_operand.clear();
+        }
+        break;
+
+    case OperandSplitResult::ExponentTooLong:
+        Invalidate();
+        break;
+
+    case OperandSplitResult::Operand:
+        if (m_operand.size() == MaxBufferedOperandLength)
+        {
+            Invalidate();
+            break;
+        }
+
+        m_operand.push_back(c);
+        break;
+    }
+}
+
+bool PasteCommandStream::ValidateOperand(wstring_view operand)
+{
+    if (!PasteExpressionParser::IsValidOperand(operand, m_grammar, m_radix))
+    {
+        Invalidate();
+        return false;
+    }
+
+    PasteExpressionParser::SanitizeOperand(operand, m_sanitizedOperand);
+    if (!PasteExpressionParser::IsOperandWithinLimits(m_sanitizedOperand, m_grammar, m_radix, m_limits))
+    {
+        Invalidate();
+    }
+
+    return m_isValid;
+}
+
+void PasteCommandStream::SendOperand(wstring_view operand)
+{
+    for (wchar_t c : operand)
+    {
+        SendCharacter(c);
+    }
+}
+
+void PasteCommandStream::Invalidate()
+{
+    m_isValid = false;
+    m_calculatorManager.DisplayPasteError();
+}
+
+// Sends the command for a single character of a validated operand or operator, following the same rules as
+// StandardCalculatorViewModel::OnPaste
+void PasteCommandStream::SendCharacter(wchar_t c)
+{
+    // Handle exponent sign (...e+... or ...e-...)
+    if (m_isAfterExponent)
+    {
+        m_isAfterExponent = false;
+        if (c == L'-')
+        {
+            SendCommand(Command::CommandSIGN);
+            return;
+        }
+
+        if (c == L'+')
+        {
+            return;
+        }
+    }
+
+    Command command = MapCharacterToCommand(c, m_grammar);
+    if (command == Command::CommandNULL)
+    {
+        return;
+    }
+
+    bool sendCommand = true;
+    bool canSendNegate = IsDigitCommand(command);
+
+    if (m_isFirstLegalChar || m_isPreviousOperator)
+    {
+        m_isFirstLegalChar = false;
+        m_isPreviousOperator = false;
+
+        // If the character is a - sign, send negate after sending the next legal character.
+        // Send nothing now, or it will be ignored. A + sign prefix is dropped.
+        if (command == Command::CommandSUB)
+        {
+            m_sendNegate = true;
+            sendCommand = false;
+        }
+        else if (command == Command::CommandADD)
+        {
+            sendCommand = false;
+        }
+    }
+
+    switch (command)
+    {
+    // Opening parenthesis starts a new expression and pushes negation state onto the stack
+    case Command::CommandOPENP:
+        m_negateStack.push_back(m_sendNegate);
+        m_sendNegate = false;
+        break;
+
+    // Closing parenthesis pops the negation state off the stack and sends it down to the calc engine
+    case Command::CommandCLOSEP:
+        if (!m_negateStack.empty())
+        {
+            m_sendNegate = m_negateStack.back();
+            m_negateStack.pop_back();
+            canSendNegate = true;
+        }
+        else
+        {
+            // Don't send a closing parenthesis if a matching opening parenthesis hasn't been sent already
+            sendCommand = false;
+        }
+        break;
+
+    case Command::CommandADD:
+    case Command::CommandSUB:
+    case Command::CommandMUL:
+    case Command::CommandDIV:
+        m_isPreviousOperator = true;
+        break;
+
+    default:
+        break;
+    }
+
+    if (sendCommand)
+    {
+        SendCommand(command);
+
+        // The CalcEngine state machine won't allow the negate command to be sent before any
+        // other digits, so instead a flag is set and the command is sent after the first appropriate
+        // command.
+        if (m_sendNegate)
+        {
+            if (canSendNegate)
+            {
+                SendCommand(Command::CommandSIGN);
+            }
+
+            // Can't send negate on a leading zero, so wait until the appropriate time to send it.
+            if (command != Command::Command0 && command != Command::CommandPNT)
+            {
+                m_sendNegate = false;
+            }
+        }
+    }
+
+    m_isAfterExponent = (command == Command::CommandEXP);
+}
+
+void PasteCommandStream::SendCommand(Command command)
+{
+    // Clear the current entry once, before the first command of the paste
+    if (!m_hasSentCommand)
+    {
+        m_hasSentCommand = true;
+        m_calculatorManager.SendCommand(Command::CommandCENTR);
+    }
+
+    m_calculatorManager.SendCommand(command);
+}
@@ -0,0 +1,73 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Command.h"
+#include "PasteExpressionParser.h"
+
+namespace CalculationManager
+{
+    class CalculatorManager;
+
+    // Feeds a pasted expression to a CalculatorManager while it is being read, instead of validating the whole text
+    // first. Operands are validated with PasteExpressionParser as soon as the operator that ends them arrives, and are
+    // then sent to the engine together with that operator. Only the operand being read is buffered, so memory does not
+    // grow with the size of the paste, and the first invalid operand stops the paste. An operand is invalid if it doesn't
+    // match the grammar or is beyond the limits of the mode, which the caller gives as CopyPasteManager does.
+    class PasteCommandStream
+    {
+    public:
+        // No valid operand is longer than the whole paste that CopyPasteManager accepts
+        static constexpr size_t MaxBufferedOperandLength = 512;
+        static constexpr size_t MaxExponentLength = 4;
+
+        PasteCommandStream(CalculatorManager& calculatorManager, PasteGrammar grammar, RADIX_TYPE radix, const PasteOperandLimits& limits);
+
+        // Processes the next part of the expression. Returns false once an invalid operand has been found; the
+        // engine is then put in the error state and any further input is ignored.
+        bool Write(std::wstring_view chunk);
+
+        // Validates and sends the last operand. Returns true if the whole expression was valid.
+        bool Finish();
+
+        // Writes everything the stream produces, then calls Finish.
+        bool Paste(std::wistream& input);
+
+        bool IsValid() const
+        {
+            return m_isValid;
+        }
+
+    private:
+        void ProcessCharacter(wchar_t c);
+        bool ValidateOperand(std::wstring_view operand);
+        void SendOperand(std::wstring_view operand);
+        void Invalidate();
+        void SendCharacter(wchar_t c);
+        void SendCommand(Command command);
+
+        CalculatorManager& m_calculatorManager;
+        const PasteGrammar m_grammar;
+        const RADIX_TYPE m_radix;
+        const PasteOperandLimits m_limits;
+        bool m_isValid;
+        bool m_isFinished;
+
+        PasteOperandSplitter m_splitter;
+        std::wstring m_operand;
+        std::wstring m_sanitizedOperand;
+
+        // Command generation state
+        bool m_hasSentCommand;
+        bool m_isFirstLegalChar;
+        bool m_isPreviousOperator;
+        bool m_sendNegate;
+        bool m_isAfterExponent;
+        std::vector<bool> m_negateStack;
+    };
+}
@@ -0,0 +1,636 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <array>
+#include <cwctype>
+#include <stdexcept>
+#include "PasteExpressionParser.h"
+
+using namespace std;
+using namespace CalculationManager;
+
+namespace
+{
+    constexpr wstring_view c_validBasicCharacterSet = L"0123456789+-.e";
+    constexpr wstring_view c_validStandardCharacterSet = L"0123456789+-.e*/";
+    constexpr wstring_view c_validScientificCharacterSet = L"0123456789+-.e*/()^%";
+    constexpr wstring_view c_validProgrammerCharacterSet = L"0123456789+-.e*/()%abcdfABCDEF";
+
+    // The operand patterns below used to be expressed as regular expressions. They are kept here, next to the
+    // functions that implement them, for reference:
+    //
+    //   whitespace      [\s\x85]*
+    //   signedDecFloat  [-+]?(?:\d+(\.\d*)?|\.\d+)
+    //   eNotation       (?:e[+-]?\d+)?
+    //   lParens         whitespace [(]* whitespace
+    //   lParensSigned   whitespace ([-+]?[(])* whitespace
+    //   rParens         whitespace [)]* whitespace
+    //   uIntSuffixes    [uU]?[lL]{0,2}
+    //
+    // Each part is followed by a character that cannot continue it, so consuming every part greedily never needs
+    // to backtrack and the whole operand is checked in a single pass.
+
+    bool IsWhitespace(wchar_t c)
+    {
+        return iswspace(c) || c == L'\x85';
+    }
+
+    bool IsSign(wchar_t c)
+    {
+        return c == L'+' || c == L'-';
+    }
+
+    bool IsDecDigit(wchar_t c)
+    {
+        return c >= L'0' && c <= L'9';
+    }
+
+    bool IsHexDigit(wchar_t c)
+    {
+        return IsDecDigit(c) || (c >= L'a' && c <= L'f') || (c >= L'A' && c <= L'F');
+    }
+
+    bool IsOctDigit(wchar_t c)
+    {
+        return c >= L'0' && c <= L'7';
+    }
+
+    bool IsBinDigit(wchar_t c)
+    {
+        return c == L'0' || c == L'1';
+    }
+
+    bool IsDigitSeparator(wchar_t c)
+    {
+        // Digit separators ` (WinDbg/MASM), ' (C++), and _ (C# and other languages)
+        return c == L'_' || c == L'\'' || c == L'`';
+    }
+
+    template <typename Predicate>
+    bool ConsumeIf(wstring_view& text, Predicate predicate)
+    {
+        if (!text.empty() && predicate(text.front()))
+        {
+            text.remove_prefix(1);
+            return true;
+        }
+
+        return false;
+    }
+
+    bool ConsumeIf(wstring_view& text, wchar_t c)
+    {
+        return ConsumeIf(text, [c](wchar_t current) { return current == c; });
+    }
+
+    template <typename Predicate>
+    size_t ConsumeWhile(wstring_view& text, Predicate predicate)
+    {
+        size_t count = 0;
+        while (ConsumeIf(text, predicate))
+        {
+            count++;
+        }
+
+        return count;
+    }
+
+    // Consumes a two character radix prefix such as 0x, where the second character is one of the given
+    // characters.
+    void ConsumeRadixPrefix(wstring_view& text, wstring_view prefixChars)
+    {
+        if (text.size() >= 2 && text[0] == L'0' && prefixChars.find(text[1]) != wstring_view::npos)
+        {
+            text.remove_prefix(2);
+        }
+    }
+
+    bool ConsumeSignedDecFloat(wstring_view& text)
+    {
+        ConsumeIf(text, IsSign);
+
+        if (ConsumeWhile(text, IsDecDigit) > 0)
+        {
+            if (ConsumeIf(text, L'.'))
+            {
+                ConsumeWhile(text, IsDecDigit);
+            }
+
+            return true;
+        }
+
+        return ConsumeIf(text, L'.') && ConsumeWhile(text, IsDecDigit) > 0;
+    }
+
+    bool ConsumeOptionalENotation(wstring_view& text)
+    {
+        if (!ConsumeIf(text, L'e'))
+        {
+            return true;
+        }
+
+        ConsumeIf(text, IsSign);
+        return ConsumeWhile(text, IsDecDigit) > 0;
+    }
+
+    template <typename Predicate>
+    bool ConsumeProgrammerDigits(wstring_view& text, Predicate isDigit)
+    {
+        if (ConsumeWhile(text, isDigit) == 0)
+        {
+            return false;
+        }
+
+        while (text.size() >= 2 && IsDigitSeparator(text[0]) && isDigit(text[1]))
+        {
+            text.remove_prefix(1);
+            ConsumeWhile(text, isDigit);
+        }
+
+        return true;
+    }
+
+    void ConsumeLongSuffix(wstring_view& text)
+    {
+        for (int i = 0; i < 2 && ConsumeIf(text, [](wchar_t c) { return c == L'l' || c == L'L'; }); i++)
+        {
+        }
+    }
+
+    void ConsumeUIntSuffixes(wstring_view& text)
+    {
+        ConsumeIf(text, [](wchar_t c) { return c == L'u' || c == L'U'; });
+        ConsumeLongSuffix(text);
+    }
+
+    bool IsEndOfOperand(wstring_view text)
+    {
+        ConsumeWhile(text, IsWhitespace);
+        ConsumeWhile(text, [](wchar_t c) { return c == L')'; });
+        ConsumeWhile(text, IsWhitespace);
+        return text.empty();
+    }
+
+    bool IsValidStandardOperand(wstring_view text)
+    {
+        ConsumeWhile(text, IsWhitespace);
+        if (!ConsumeSignedDecFloat(text) || !ConsumeOptionalENotation(text))
+        {
+            return false;
+        }
+
+        ConsumeWhile(text, IsWhitespace);
+        return text.empty();
+    }
+
+    bool IsValidScientificOperand(wstring_view text)
+    {
+        ConsumeWhile(text, IsWhitespace);
+
+        // A lone, optionally signed, operand is accepted so that e.g. the "-" of "-(1)" is valid on its own.
+        wstring_view signOnly = text;
+        ConsumeIf(signOnly, IsSign);
+        if (signOnly.empty())
+        {
+            return true;
+        }
+
+        while (true)
+        {
+            if (text.size() >= 2 && IsSign(text[0]) && text[1] == L'(')
+            {
+                text.remove_prefix(2);
+            }
+            else if (!ConsumeIf(text, L'('))
+            {
+                break;
+            }
+        }
+
+        ConsumeWhile(text, IsWhitespace);
+        return ConsumeSignedDecFloat(text) && ConsumeOptionalENotation(text) && IsEndOfOperand(text);
+    }
+
+    bool IsValidConverterOperand(wstring_view text)
+    {
+        ConsumeWhile(text, IsWhitespace);
+        if (!ConsumeSignedDecFloat(text))
+        {
+            return false;
+        }
+
+        ConsumeWhile(text, IsWhitespace);
+        return text.empty();
+    }
+
+    bool IsValidProgrammerOperand(wstring_view text, RADIX_TYPE radix)
+    {
+        ConsumeWhile(text, IsWhitespace);
+        ConsumeWhile(text, [](wchar_t c) { return c == L'('; });
+        ConsumeWhile(text, IsWhitespace);
+
+        // Most radixes accept two operand forms; the operand is valid if either of them matches.
+        wstring_view first = text;
+        wstring_view second = text;
+        switch (radix)
+        {
+        case HEX_RADIX:
+            // Hex numbers like 5F, 4A0C, 0xa9, 0xFFull, 47CDh
+            ConsumeRadixPrefix(first, L"xX");
+            if (ConsumeProgrammerDigits(first, IsHexDigit))
+            {
+                ConsumeUIntSuffixes(first);
+                if (IsEndOfOperand(first))
+                {
+                    return true;
+                }
+            }
+
+            if (ConsumeProgrammerDigits(second, IsHexDigit))
+            {
+                ConsumeIf(second, [](wchar_t c) { return c == L'h' || c == L'H'; });
+                return IsEndOfOperand(second);
+            }
+
+            return false;
+
+        case DEC_RADIX:
+            // Decimal numbers like -145, 145, 0n145, 123ull etc
+            ConsumeIf(first, IsSign);
+            if (ConsumeProgrammerDigits(first, IsDecDigit))
+            {
+                ConsumeLongSuffix(first);
+                if (IsEndOfOperand(first))
+                {
+                    return true;
+                }
+            }
+
+            ConsumeRadixPrefix(second, L"nN");
+            if (ConsumeProgrammerDigits(second, IsDecDigit))
+            {
+                ConsumeUIntSuffixes(second);
+                return IsEndOfOperand(second);
+            }
+
+            return false;
+
+        case OCT_RADIX:
+            // Octal numbers like 06, 010, 0t77, 0o77, 077ull etc
+            ConsumeRadixPrefix(first, L"otOT");
+            if (ConsumeProgrammerDigits(first, IsOctDigit))
+            {
+                ConsumeUIntSuffixes(first);
+                return IsEndOfOperand(first);
+            }
+
+            return false;
+
+        case BIN_RADIX:
+            // Binary numbers like 011010110, 0010110, 10101001, 1001b, 0b1001, 0y1001, 0b1001ull
+            ConsumeRadixPrefix(first, L"byBY");
+            if (ConsumeProgrammerDigits(first, IsBinDigit))
+            {
+                ConsumeUIntSuffixes(first);
+                if (IsEndOfOperand(first))
+                {
+                    return true;
+                }
+            }
+
+            if (ConsumeProgrammerDigits(second, IsBinDigit))
+            {
+                ConsumeIf(second, [](wchar_t c) { return c == L'b' || c == L'B'; });
+                return IsEndOfOperand(second);
+            }
+
+            return false;
+        }
+
+        return false;
+    }
+
+    wstring_view GetValidCharacterSet(PasteGrammar grammar)
+    {
+        switch (grammar)
+        {
+        case PasteGrammar::Standard:
+            return c_validStandardCharacterSet;
+        case PasteGrammar::Scientific:
+            return c_validScientificCharacterSet;
+        case PasteGrammar::Programmer:
+            return c_validProgrammerCharacterSet;
+        default:
+            return c_validBasicCharacterSet;
+        }
+    }
+
+    // The characters CopyPasteManager::SanitizeOperand removes
+    constexpr wstring_view c_sanitizedCharacterSet = L"'_`()-+";
+
+    // The unsigned integer suffixes of every radix, longest first so that the whole suffix is found
+    constexpr array<wstring_view, 5> c_uintSuffixes = { L"ULL", L"UL", L"LL", L"U", L"L" };
+
+    bool EqualsIgnoreCase(wstring_view text, wstring_view upper)
+    {
+        return equal(text.begin(), text.end(), upper.begin(), upper.end(), [](wchar_t c, wchar_t u) { return static_cast<wchar_t>(towupper(c)) == u; });
+    }
+
+    // See CopyPasteManager::StandardScientificOperandLength
+    size_t GetStandardScientificOperandLength(wstring_view operand)
+    {
+        if (operand.find(L'.') != wstring_view::npos && operand.size() >= 2)
+        {
+            return operand.size() - ((operand[0] == L'0' && operand[1] == L'.') ? 2 : 1);
+        }
+
+        return operand.size();
+    }
+
+    // See CopyPasteManager::ProgrammerOperandLength
+    size_t GetProgrammerOperandLength(wstring_view operand, RADIX_TYPE radix)
+    {
+        wstring_view prefixes[2] = {};
+        wstring_view radixSuffix;
+        switch (radix)
+        {
+        case BIN_RADIX:
+            prefixes[0] = L"0B";
+            prefixes[1] = L"0Y";
+            radixSuffix = L"B";
+            break;
+        case DEC_RADIX:
+            prefixes[0] = L"-";
+            prefixes[1] = L"0N";
+            break;
+        case OCT_RADIX:
+            prefixes[0] = L"0T";
+            prefixes[1] = L"0O";
+            break;
+        case HEX_RADIX:
+            prefixes[0] = L"0X";
+            radixSuffix = L"H";
+            break;
+        default:
+            return 0;
+        }
+
+        // A suffix is removed first, so that "0b" is the digit 0 rather than a prefix with no digits
+        size_t length = operand.size();
+        auto removeSuffix = [&](wstring_view suffix) {
+            if (!suffix.empty() && length >= suffix.size() && EqualsIgnoreCase(operand.substr(operand.size() - suffix.size()), suffix))
+            {
+                length -= suffix.size();
+                return true;
+            }
+            return false;
+        };
+        if (!removeSuffix(radixSuffix))
+        {
+            any_of(c_uintSuffixes.begin(), c_uintSuffixes.end(), removeSuffix);
+        }
+
+        for (wstring_view prefix : prefixes)
+        {
+            if (!prefix.empty() && length >= prefix.size() && EqualsIgnoreCase(operand.substr(0, prefix.size()), prefix))
+            {
+                length -= prefix.size();
+                break;
+            }
+        }
+
+        return length;
+    }
+
+    // See CopyPasteManager::TryOperandToULL
+    bool TryGetOperandValue(const wstring& operand, RADIX_TYPE radix, uint64_t& value)
+    {
+        value = 0;
+        if (operand.empty() || operand[0] == L'-')
+        {
+            return false;
+        }
+
+        int base;
+        switch (radix)
+        {
+        case HEX_RADIX:
+            base = 16;
+            break;
+        case OCT_RADIX:
+            base = 8;
+            break;
+        case BIN_RADIX:
+            base = 2;
+            break;
+        default:
+            base = 10;
+            break;
+        }
+
+        try
+        {
+            value = stoull(operand, nullptr, base);
+            return true;
+        }
+        catch (const invalid_argument&)
+        {
+        }
+        catch (const out_of_range&)
+        {
+        }
+
+        return false;
+    }
+}
+
+PasteOperandSplitter::PasteOperandSplitter(PasteGrammar grammar, size_t maxExponentLength)
+    : m_grammar(grammar)
+    , m_validCharacterSet(GetValidCharacterSet(grammar))
+    , m_maxExponentLength(maxExponentLength)
+    , m_expLength(0)
+    , m_previousChar(L'\0')
+    , m_isFirstChar(true)
+    , m_startExpCounting(false)
+    , m_startOfExpression(true)
+    , m_isPreviousOpenParen(false)
+    , m_isPreviousOperator(false)
+{
+}
+
+bool PasteOperandSplitter::IsValidCharacter(wchar_t c) const
+{
+    return m_validCharacterSet.find(c) != wstring_view::npos;
+}
+
+OperandSplitResult PasteOperandSplitter::Next(wchar_t currentChar)
+{
+    bool isFirstChar = m_isFirstChar;
+    wchar_t previousChar = m_previousChar;
+    m_isFirstChar = false;
+    m_previousChar = currentChar;
+
+    // if the current character is not a valid one don't process it
+    if (!IsValidCharacter(currentChar))
+    {
+        return OperandSplitResult::Operand;
+    }
+
+    if (IsDecDigit(currentChar))
+    {
+        if (m_startExpCounting)
+        {
+            m_expLength++;
+
+            // to disallow pasting of 1e+12345 as 1e+1234, max exponent that can be pasted is 9999.
+            if (m_expLength > m_maxExponentLength)
+            {
+                return OperandSplitResult::ExponentTooLong;
+            }
+        }
+        m_isPreviousOperator = false;
+    }
+    else if (currentChar == L'e')
+    {
+        if (m_grammar != PasteGrammar::Programmer)
+        {
+            m_startExpCounting = true;
+        }
+        m_isPreviousOperator = false;
+    }
+    else if (IsSign(currentChar) || currentChar == L'*' || currentChar == L'/' || currentChar == L'^' || currentChar == L'%')
+    {
+        if (IsSign(currentChar))
+        {
+            // don't break the expression into operands if the encountered character corresponds to sign command(+-)
+            if (m_isPreviousOpenParen || m_startOfExpression || m_isPreviousOperator
+                || ((m_grammar != PasteGrammar::Programmer) && !(!isFirstChar && previousChar != L'e')))
+            {
+                m_isPreviousOperator = false;
+                return OperandSplitResult::Operand;
+            }
+        }
+
+        m_startExpCounting = false;
+        m_expLength = 0;
+        m_isPreviousOperator = true;
+        m_isPreviousOpenParen = false;
+        m_startOfExpression = false;
+        return OperandSplitResult::Operator;
+    }
+    else
+    {
+        m_isPreviousOperator = false;
+    }
+
+    m_isPreviousOpenParen = (currentChar == L'(');
+    m_startOfExpression = false;
+    return OperandSplitResult::Operand;
+}
+
+namespace CalculationManager::PasteExpressionParser
+{
+    ExtractOperandsResult ExtractOperands(
+        wstring_view expression,
+        PasteGrammar grammar,
+        size_t maxOperandCount,
+        size_t maxExponentLength,
+        vector<wstring_view>& operands)
+    {
+        operands.clear();
+
+        PasteOperandSplitter splitter(grammar, maxExponentLength);
+        size_t lastIndex = 0;
+        bool haveOperator = false;
+        for (size_t i = 0; i < expression.size(); i++)
+        {
+            if (splitter.IsValidCharacter(expression[i]) && operands.size() >= maxOperandCount)
+            {
+                operands.clear();
+                return ExtractOperandsResult::TooManyOperands;
+            }
+
+            switch (splitter.Next(expression[i]))
+            {
+            case OperandSplitResult::Operator:
+                haveOperator = true;
+                operands.push_back(expression.substr(lastIndex, i - lastIndex));
+                lastIndex = i + 1;
+                break;
+            case OperandSplitResult::ExponentTooLong:
+                operands.clear();
+                return ExtractOperandsResult::ExponentTooLong;
+            case OperandSplitResult::Operand:
+                break;
+            }
+        }
+
+        if (!haveOperator)
+        {
+            operands.clear();
+            operands.push_back(expression);
+        }
+        else
+        {
+            operands.push_back(expression.substr(lastIndex));
+        }
+
+        return ExtractOperandsResult::Success;
+    }
+
+    bool IsValidOperand(wstring_view operand, PasteGrammar grammar, RADIX_TYPE radix)
+    {
+        switch (grammar)
+        {
+        case PasteGrammar::Standard:
+            return IsValidStandardOperand(operand);
+        case PasteGrammar::Scientific:
+            return IsValidScientificOperand(operand);
+        case PasteGrammar::Programmer:
+            return IsValidProgrammerOperand(operand, radix);
+        case PasteGrammar::Converter:
+            return IsValidConverterOperand(operand);
+        }
+
+        return false;
+    }
+
+    void SanitizeOperand(wstring_view operand, wstring& result)
+    {
+        result.clear();
+        for (wchar_t c : operand)
+        {
+            if (c_sanitizedCharacterSet.find(c) == wstring_view::npos)
+            {
+                result.push_back(c);
+            }
+        }
+    }
+
+    bool IsOperandWithinLimits(const wstring& sanitizedOperand, PasteGrammar grammar, RADIX_TYPE radix, const PasteOperandLimits& limits)
+    {
+        size_t length;
+        switch (grammar)
+        {
+        case PasteGrammar::Standard:
+        case PasteGrammar::Scientific:
+            length = GetStandardScientificOperandLength(sanitizedOperand);
+            break;
+        case PasteGrammar::Programmer:
+            length = GetProgrammerOperandLength(sanitizedOperand, radix);
+            break;
+        default:
+            length = sanitizedOperand.size();
+            break;
+        }
+
+        if (length > limits.maxLength)
+        {
+            return false;
+        }
+
+        uint64_t value;
+        return limits.maxValue == 0 || (TryGetOperandValue(sanitizedOperand, radix, value) && value <= limits.maxValue);
+    }
+}
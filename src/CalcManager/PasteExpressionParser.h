@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Header Files/RadixType.h"
+
+namespace CalculationManager
+{
+    // The grammar a pasted expression is checked against. Each calculator mode accepts a different set of
+    // characters and operand shapes; every unit converter category shares the Converter grammar.
+    enum class PasteGrammar
+    {
+        Standard,
+        Scientific,
+        Programmer,
+        Converter
+    };
+
+    enum class ExtractOperandsResult
+    {
+        Success,
+        TooManyOperands,
+        ExponentTooLong
+    };
+
+    enum class OperandSplitResult
+    {
+        Operand,  // The character belongs to the current operand
+        Operator, // The character is a binary operator that ends the current operand
+        ExponentTooLong
+    };
+
+    // The most an operand of a mode may hold, as CopyPasteManager::GetMaxOperandLengthAndValue gives them. A max value
+    // of 0 leaves the value unchecked.
+    struct PasteOperandLimits
+    {
+        size_t maxLength;
+        uint64_t maxValue;
+    };
+
+    // Splits an expression into operands one character at a time. A character that is not valid for the grammar is
+    // kept as part of the current operand, so that validating the operand rejects it.
+    class PasteOperandSplitter
+    {
+    public:
+        PasteOperandSplitter(PasteGrammar grammar, size_t maxExponentLength);
+
+        bool IsValidCharacter(wchar_t c) const;
+        OperandSplitResult Next(wchar_t c);
+
+    private:
+        const PasteGrammar m_grammar;
+        const std::wstring_view m_validCharacterSet;
+        const size_t m_maxExponentLength;
+        size_t m_expLength;
+        wchar_t m_previousChar;
+        bool m_isFirstChar;
+        bool m_startExpCounting;
+        bool m_startOfExpression;
+        bool m_isPreviousOpenParen;
+        bool m_isPreviousOperator;
+    };
+
+    // Tokenizes and validates pasted expressions without std::regex. Every function runs in time linear in the
+    // length of its input and does not allocate beyond the returned operand list.
+    namespace PasteExpressionParser
+    {
+        // Splits the expression into operands at binary operators. The returned views point into the given
+        // expression. On failure the operand list is cleared.
+        ExtractOperandsResult ExtractOperands(
+            std::wstring_view expression,
+            PasteGrammar grammar,
+            size_t maxOperandCount,
+            size_t maxExponentLength,
+            std::vector<std::wstring_view>& operands);
+
+        // Returns true if the operand matches one of the operand patterns of the grammar. The radix is only
+        // used by the Programmer grammar.
+        bool IsValidOperand(std::wstring_view operand, PasteGrammar grammar, RADIX_TYPE radix);
+
+        // Removes the signs, parentheses and digit separators that an operand's length and value leave out, as
+        // CopyPasteManager::SanitizeOperand does. result keeps its storage, so this doesn't allocate once it is long enough.
+        void SanitizeOperand(std::wstring_view operand, std::wstring& result);
+
+        // Returns true if a valid operand, once sanitized, is within the limits, as CopyPasteManager::ExpressionRegExMatch
+        // checks it. The length leaves out the leading "0." of a decimal, or the radix prefix and suffix of the
+        // Programmer grammar. The value is read in the radix, and an operand that can't be read is not within them.
+        bool IsOperandWithinLimits(const std::wstring& sanitizedOperand, PasteGrammar grammar, RADIX_TYPE radix, const PasteOperandLimits& limits);
+    }
+}
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cstdint> // for int32_t, uint32_t
+
 // CalcErr.h
 //
 // Defines the error codes thrown by ratpak and caught by Calculator
@@ -96,6 +96,8 @@ void _mulnumx(PNUMBER* pa, PNUMBER b)
     int32_t icdigit = 0;  // Index of digit being calculated in final result.
 
     a = *pa;
+    RATPACK_COUNT(multiplications[SizeClass(std::max(a->cdigit, b->cdigit))], 1);
+    RATPACK_COUNT(digitProducts, static_cast<uint64_t>(a->cdigit) * b->cdigit);
 
     ibdigit = a->cdigit + b->cdigit - 1;
     createnum(c, ibdigit + 1);
@@ -270,6 +272,7 @@ void _divnumx(PNUMBER* pa, PNUMBER b, int32_t precision)
                                            // to shoot for in the divide.
 
     a = *pa;
+    RATPACK_COUNT(divisions[SizeClass(std::max(a->cdigit, b->cdigit))], 1);
     if (thismax < a->cdigit)
     {
         // a has more digits than precision specified, bump up digits to shoot
@@ -205,6 +205,8 @@ PNUMBER _createnum(_In_ uint32_t size)
         {
             throw(CALC_E_OUTOFMEMORY);
         }
+        RATPACK_COUNT(numberAllocations, 1);
+        RATPACK_COUNT(numberBytes, cbAlloc);
     }
     else
     {
@@ -238,6 +240,7 @@ PRAT _createrat(void)
     {
         throw(CALC_E_OUTOFMEMORY);
     }
+    RATPACK_COUNT(ratAllocations, 1);
     prat->pp = nullptr;
     prat->pq = nullptr;
     return (prat);
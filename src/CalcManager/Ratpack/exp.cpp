@@ -52,6 +52,7 @@ void _exprat(_Inout_ PRAT* px, int32_t precision)
 
     do
     {
+        RATPACK_COUNT(seriesTerms[SERIES_EXP], 1);
         NEXTTERM(*px, INC(n2) DIVNUM(n2), precision);
     } while (!SMALL_ENOUGH_RAT(thisterm, precision));
 
@@ -143,6 +144,7 @@ void _lograt(PRAT* px, int32_t precision)
 
     do
     {
+        RATPACK_COUNT(seriesTerms[SERIES_LOG], 1);
         NEXTTERM(*px, MULNUM(n2) INC(n2) DIVNUM(n2), precision);
         TRIMTOP(*px, precision);
     } while (!SMALL_ENOUGH_RAT(thisterm, precision));
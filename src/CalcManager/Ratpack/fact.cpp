@@ -138,6 +138,7 @@ void _gamma(PRAT* pn, uint32_t radix, int32_t precision)
     // Loop until precision is reached, or asked to halt.
     while (!zerrat(term) && rat_gt(term, err, precision))
     {
+        RATPACK_COUNT(seriesTerms[SERIES_GAMMA], 1);
         addrat(pn, rat_two, precision);
 
         // WARNING: mixing numbers and  rationals here.
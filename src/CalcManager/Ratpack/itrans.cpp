@@ -71,6 +71,7 @@ void _asinrat(PRAT* px, int32_t precision)
 
     do
     {
+        RATPACK_COUNT(seriesTerms[SERIES_ASIN], 1);
         NEXTTERM(xx, MULNUM(n2) MULNUM(n2) INC(n2) DIVNUM(n2) INC(n2) DIVNUM(n2), precision);
     } while (!SMALL_ENOUGH_RAT(thisterm, precision));
     DESTROYTAYLOR();
@@ -184,6 +185,7 @@ void _acosrat(PRAT* px, int32_t precision)
 
     do
     {
+        RATPACK_COUNT(seriesTerms[SERIES_ACOS], 1);
         NEXTTERM(xx, MULNUM(n2) MULNUM(n2) INC(n2) DIVNUM(n2) INC(n2) DIVNUM(n2), precision);
     } while (!SMALL_ENOUGH_RAT(thisterm, precision));
 
@@ -270,6 +272,7 @@ void _atanrat(PRAT* px, int32_t precision)
 
     do
     {
+        RATPACK_COUNT(seriesTerms[SERIES_ATAN], 1);
         NEXTTERM(xx, MULNUM(n2) INC(n2) INC(n2) DIVNUM(n2), precision);
     } while (!SMALL_ENOUGH_RAT(thisterm, precision));
 
@@ -77,6 +77,7 @@ void asinhrat(_Inout_ PRAT* px, uint32_t radix, int32_t precision)
 
         do
         {
+            RATPACK_COUNT(seriesTerms[SERIES_ASINH], 1);
             NEXTTERM(xx, MULNUM(n2) MULNUM(n2) INC(n2) DIVNUM(n2) INC(n2) DIVNUM(n2), precision);
         } while (!SMALL_ENOUGH_RAT(thisterm, precision));
 
@@ -228,6 +228,8 @@ void _mulnum(PNUMBER* pa, PNUMBER b, uint32_t radix)
     int32_t icdigit = 0;  // Index of digit being calculated in final result.
 
     a = *pa;
+    RATPACK_COUNT(multiplications[SizeClass(std::max(a->cdigit, b->cdigit))], 1);
+    RATPACK_COUNT(digitProducts, static_cast<uint64_t>(a->cdigit) * b->cdigit);
     ibdigit = a->cdigit + b->cdigit - 1;
     createnum(c, ibdigit + 1);
     c->cdigit = ibdigit;
@@ -382,6 +384,7 @@ void divnum(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint32_t radix, int32_t precisi
 void _divnum(PNUMBER* pa, PNUMBER b, uint32_t radix, int32_t precision)
 {
     PNUMBER a = *pa;
+    RATPACK_COUNT(divisions[SizeClass(std::max(a->cdigit, b->cdigit))], 1);
     int32_t thismax = precision + 2;
     if (thismax < a->cdigit)
     {
@@ -325,6 +325,72 @@ extern bool g_ftrueinfinite; // set to true to allow infinite precision
 
 extern int32_t g_ratio; // Internally calculated ratio of internal radix
 
+//-----------------------------------------------------------------------------
+//
+//   Counters of the work done by the math package on the current thread, to
+//   find out what an operation cost. They are only kept once they are turned
+//   on with EnableRatpackCounters, so that they cost one test of a thread
+//   local flag otherwise.
+//
+//-----------------------------------------------------------------------------
+
+// Multiplications and divisions are counted by the number of digits, in the
+// radix they are done in, of their larger operand.
+enum eRATPACK_SIZE_CLASS
+{
+    SIZE_CLASS_SMALL,  // Up to 2 digits, e.g. 64 bit integers in BASEX
+    SIZE_CLASS_MEDIUM, // Up to 8 digits
+    SIZE_CLASS_LARGE,  // Up to 32 digits
+    SIZE_CLASS_HUGE,   // More than 32 digits
+    SIZE_CLASS_COUNT
+};
+
+// The series that are summed until their terms are too small to matter.
+enum eRATPACK_SERIES
+{
+    SERIES_EXP,
+    SERIES_LOG,
+    SERIES_SIN,
+    SERIES_COS,
+    SERIES_SINH,
+    SERIES_COSH,
+    SERIES_ASIN,
+    SERIES_ACOS,
+    SERIES_ATAN,
+    SERIES_ASINH,
+    SERIES_GAMMA,
+    SERIES_COUNT
+};
+
+typedef struct _ratpack_counters
+{
+    uint64_t numberAllocations;                 // Calls to _createnum
+    uint64_t numberBytes;                       // The bytes that they allocated
+    uint64_t ratAllocations;                    // Calls to _createrat
+    uint64_t multiplications[SIZE_CLASS_COUNT]; // Calls to _mulnum and _mulnumx
+    uint64_t digitProducts;                     // Products of one digit by another that they made
+    uint64_t divisions[SIZE_CLASS_COUNT];       // Calls to _divnum and _divnumx
+    uint64_t truncations;                       // Calls to trimit that dropped digits
+    uint64_t seriesTerms[SERIES_COUNT];         // Terms that were added to each series
+} RATPACK_COUNTERS;
+
+extern thread_local bool g_fcounting;                   // Whether the counters of this thread are kept
+extern thread_local RATPACK_COUNTERS g_ratpackcounters; // The counters of this thread
+
+#define RATPACK_COUNT(field, n)                                                                                                                                \
+    do                                                                                                                                                         \
+    {                                                                                                                                                          \
+        if (g_fcounting)                                                                                                                                       \
+        {                                                                                                                                                      \
+            g_ratpackcounters.field += (n);                                                                                                                    \
+        }                                                                                                                                                      \
+    } while (0)
+
+inline int SizeClass(int32_t cdigit)
+{
+    return cdigit <= 2 ? SIZE_CLASS_SMALL : cdigit <= 8 ? SIZE_CLASS_MEDIUM : cdigit <= 32 ? SIZE_CLASS_LARGE : SIZE_CLASS_HUGE;
+}
+
 //-----------------------------------------------------------------------------
 //
 //   External functions defined in the math package.
@@ -337,6 +403,11 @@ extern void SetDecimalSeparator(wchar_t decimalSeparator);
 // Call whenever either radix or precision changes, is smarter about recalculating constants.
 extern void ChangeConstants(uint32_t radix, int32_t precision);
 
+// Turns the counters of the current thread on or off, and reads or zeroes them.
+extern void EnableRatpackCounters(bool enable);
+extern RATPACK_COUNTERS GetRatpackCounters();
+extern void ResetRatpackCounters();
+
 extern bool equnum(_In_ PNUMBER a, _In_ PNUMBER b);  // returns true of a == b
 extern bool lessnum(_In_ PNUMBER a, _In_ PNUMBER b); // returns true of a < b
 extern bool zernum(_In_ PNUMBER a);                  // returns true of a == 0
@@ -75,6 +75,9 @@ bool g_ftrueinfinite = false; // Set to true if you don't want
                               // chopping internally
                               // precision used internally
 
+thread_local bool g_fcounting = false;
+thread_local RATPACK_COUNTERS g_ratpackcounters = {};
+
 PNUMBER num_one = nullptr;
 PNUMBER num_two = nullptr;
 PNUMBER num_five = nullptr;
@@ -117,6 +120,35 @@ PRAT rat_min_fact = nullptr;
 PRAT rat_min_i32 = nullptr; // min signed i32
 PRAT rat_max_i32 = nullptr; // max signed i32
 
+// The radix and precision that the constants were last read from the table for. Nothing changes the constants after
+// that, so reading them again for the same radix and precision is skipped.
+static uint32_t g_tableConstantsRadix = 0;
+static int32_t g_tableConstantsPrecision = 0;
+
+//----------------------------------------------------------------------------
+//
+//  FUNCTION: EnableRatpackCounters, GetRatpackCounters, ResetRatpackCounters
+//
+//  DESCRIPTION: Turn the counters of the current thread on or off, and read
+//  or zero them. The counters keep their values while they are off.
+//
+//----------------------------------------------------------------------------
+
+void EnableRatpackCounters(bool enable)
+{
+    g_fcounting = enable;
+}
+
+RATPACK_COUNTERS GetRatpackCounters()
+{
+    return g_ratpackcounters;
+}
+
+void ResetRatpackCounters()
+{
+    g_ratpackcounters = {};
+}
+
 //----------------------------------------------------------------------------
 //
 //  FUNCTION: ChangeConstants
@@ -132,6 +164,11 @@ PRAT rat_max_i32 = nullptr; // max signed i32
 
 void ChangeConstants(uint32_t radix, int32_t precision)
 {
+    if (radix == g_tableConstantsRadix && precision == g_tableConstantsPrecision)
+    {
+        return;
+    }
+
     // ratio is set to the number of digits in the current radix, you can get
     // in the internal BASEX radix, this is important for length calculations
     // in translating from radix to BASEX and back.
@@ -150,6 +187,7 @@ void ChangeConstants(uint32_t radix, int32_t precision)
     // Check to see what we have to recalculate and what we don't
     if (cbitsofprecision < (g_ratio * static_cast<int32_t>(radix) * precision))
     {
+        g_tableConstantsRadix = 0;
         g_ftrueinfinite = false;
 
         INIT_AND_DUMP_RAW_NUM_IF_NULL(num_one, 1L);
@@ -282,6 +320,9 @@ void ChangeConstants(uint32_t radix, int32_t precision)
         ratpowi32(&rat_smallest, -precision, precision);
         DUPRAT(rat_negsmallest, rat_smallest);
         rat_negsmallest->pp->sign = -1;
+
+        g_tableConstantsRadix = radix;
+        g_tableConstantsPrecision = precision;
     }
 }
 
@@ -687,6 +728,7 @@ void trimit(_Inout_ PRAT* px, int32_t precision)
         trim = g_ratio * (min((pp->cdigit + pp->exp), (pq->cdigit + pq->exp)) - 1) - precision;
         if (trim > g_ratio)
         {
+            RATPACK_COUNT(truncations, 1);
             trim /= g_ratio;
 
             if (trim <= pp->exp)
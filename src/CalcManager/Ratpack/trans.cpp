@@ -76,6 +76,7 @@ void _sinrat(PRAT* px, int32_t precision)
 
     do
     {
+        RATPACK_COUNT(seriesTerms[SERIES_SIN], 1);
         NEXTTERM(xx, INC(n2) DIVNUM(n2) INC(n2) DIVNUM(n2), precision);
     } while (!SMALL_ENOUGH_RAT(thisterm, precision));
 
@@ -173,6 +174,7 @@ void _cosrat(PRAT* px, uint32_t radix, int32_t precision)
 
     do
     {
+        RATPACK_COUNT(seriesTerms[SERIES_COS], 1);
         NEXTTERM(xx, INC(n2) DIVNUM(n2) INC(n2) DIVNUM(n2), precision);
     } while (!SMALL_ENOUGH_RAT(thisterm, precision));
 
@@ -82,6 +82,7 @@ void _sinhrat(PRAT* px, int32_t precision)
 
     do
     {
+        RATPACK_COUNT(seriesTerms[SERIES_SINH], 1);
         NEXTTERM(xx, INC(n2) DIVNUM(n2) INC(n2) DIVNUM(n2), precision);
     } while (!SMALL_ENOUGH_RAT(thisterm, precision));
 
@@ -163,6 +164,7 @@ void _coshrat(PRAT* px, uint32_t radix, int32_t precision)
 
     do
     {
+        RATPACK_COUNT(seriesTerms[SERIES_COSH], 1);
         NEXTTERM(xx, INC(n2) DIVNUM(n2) INC(n2) DIVNUM(n2), precision);
     } while (!SMALL_ENOUGH_RAT(thisterm, precision));
 
@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "UnitConversionKernel.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define UNIT_CONVERSION_AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+using namespace UnitConversionManager;
+
+namespace
+{
+#if defined(UNIT_CONVERSION_AVX2)
+    bool IsAvx2Supported()
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+        {
+            return false;
+        }
+
+        // The operating system must also save the AVX registers on context switches
+        __cpuid(info, 1);
+        const int osxsaveAndAvx = (1 << 27) | (1 << 28);
+        if ((info[2] & osxsaveAndAvx) != osxsaveAndAvx || (_xgetbv(0) & 0x6) != 0x6)
+        {
+            return false;
+        }
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    // No fused multiply-add, which would round differently from UnitConverter::Convert
+    TARGET_AVX2 void ConvertValuesAvx2(const ConversionData& conversionData, const double* values, double* results, size_t count)
+    {
+        const __m256d ratio = _mm256_set1_pd(conversionData.ratio);
+        const __m256d offset = _mm256_set1_pd(conversionData.offset);
+        size_t i = 0;
+        if (conversionData.offsetFirst)
+        {
+            for (; i + 4 <= count; i += 4)
+            {
+                __m256d value = _mm256_loadu_pd(values + i);
+                _mm256_storeu_pd(results + i, _mm256_mul_pd(_mm256_add_pd(value, offset), ratio));
+            }
+        }
+        else
+        {
+            for (; i + 4 <= count; i += 4)
+            {
+                __m256d value = _mm256_loadu_pd(values + i);
+                _mm256_storeu_pd(results + i, _mm256_add_pd(_mm256_mul_pd(value, ratio), offset));
+            }
+        }
+
+        ConvertValuesScalar(conversionData, values + i, results + i, count - i);
+    }
+#endif
+}
+
+void UnitConversionManager::ConvertValuesScalar(const ConversionData& conversionData, _In_ const double* values, _Out_ double* results, size_t count)
+{
+    const double ratio = conversionData.ratio;
+    const double offset = conversionData.offset;
+    if (conversionData.offsetFirst)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            results[i] = (values[i] + offset) * ratio;
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            results[i] = (values[i] * ratio) + offset;
+        }
+    }
+}
+
+void UnitConversionManager::ConvertValues(const ConversionData& conversionData, _In_ const double* values, _Out_ double* results, size_t count)
+{
+#if defined(UNIT_CONVERSION_AVX2)
+    static const bool isAvx2Supported = IsAvx2Supported();
+    if (isAvx2Supported)
+    {
+        ConvertValuesAvx2(conversionData, values, results, count);
+        return;
+    }
+#endif
+
+    ConvertValuesScalar(conversionData, values, results, count);
+}
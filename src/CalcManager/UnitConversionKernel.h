@@ -0,0 +1,18 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include "UnitConverter.h"
+
+namespace UnitConversionManager
+{
+    // Converts count values with the same arithmetic as UnitConverter::Convert, so that every result is identical to
+    // converting the value on its own. values and results may be the same array, but must not otherwise overlap.
+    // Uses AVX2 when the processor supports it.
+    void ConvertValues(const ConversionData& conversionData, _In_ const double* values, _Out_ double* results, size_t count);
+
+    // The portable version of ConvertValues, one value at a time.
+    void ConvertValuesScalar(const ConversionData& conversionData, _In_ const double* values, _Out_ double* results, size_t count);
+}
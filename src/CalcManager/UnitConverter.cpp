@@ -2,14 +2,19 @@
 // Licensed under the MIT License.
 
 #include <cassert>
+#include <charconv>
 #include <cmath>
 #include <sstream>
 #include <algorithm> // for std::sort
 #include "Command.h"
+#include "ExactUnitConverter.h"
 #include "UnitConverter.h"
+#include "UnitConversionKernel.h"
 #include "NumberFormattingUtils.h"
+#include "Header Files/Snapshot.h"
 
 using namespace std;
+using namespace CalcEngine;
 using namespace UnitConversionManager;
 using namespace CalcManager::NumberFormattingUtils;
 
@@ -27,9 +32,80 @@ static constexpr wchar_t RIGHTESCAPECHAR = L'}';
 static const double OPTIMALDECIMALALLOWED = pow(10, -1 * (OPTIMALDIGITSALLOWED - 1));
 static const double MINIMUMDECIMALALLOWED = pow(10, -1 * (MAXIMUMDIGITSALLOWED - 1));
 
+// A suggested value is shown as zero, with the 2 decimals of values under 100, below this
+static constexpr double SUGGESTEDVALUEZEROLIMIT = 0.005;
+
+// Enough for the numbers the converter shows in full, which have at most 15 digits before the decimal point and 15
+// after it, and for any number in scientific notation
+static constexpr size_t FORMATTEDNUMBERBUFFERSIZE = 64;
+
+// The binary user preferences are USERPREFERENCESMAGIC, USERPREFERENCESVERSION, the id of the category, then the id,
+// isConversionSource and isConversionTarget of the from unit and of the to unit
+static constexpr uint32_t USERPREFERENCESMAGIC = 0x50464E55; // "UNFP"
+static constexpr uint32_t USERPREFERENCESVERSION = 1;
+
 unordered_map<wchar_t, wstring> quoteConversions;
 unordered_map<wstring, wchar_t> unquoteConversions;
 
+namespace
+{
+    // Orders suggested values by absolute magnitude, breaking ties by choosing the positive value
+    bool IsBetterSuggestion(const SuggestedValueIntermediate& first, const SuggestedValueIntermediate& second)
+    {
+        if (abs(first.magnitude) == abs(second.magnitude))
+        {
+            return first.magnitude > second.magnitude;
+        }
+        else
+        {
+            return abs(first.magnitude) < abs(second.magnitude);
+        }
+    }
+
+    // Fewer decimals are shown the larger the value is
+    int GetSuggestedValueDecimals(double value)
+    {
+        if (abs(value) < 100)
+        {
+            return 2;
+        }
+        else if (abs(value) < 1000)
+        {
+            return 1;
+        }
+        return 0;
+    }
+
+    bool IsSuggestedValueShownAsZero(double value)
+    {
+        return abs(value) < SUGGESTEDVALUEZEROLIMIT;
+    }
+
+    // Rounds the value as RoundSignificantDigits does and trims the trailing zeros, into result. As result keeps its
+    // storage, this doesn't allocate once it is long enough.
+    void FormatRoundedValue(double value, int decimals, _Inout_ wstring& result)
+    {
+        wchar_t buffer[FORMATTEDNUMBERBUFFERSIZE];
+        const size_t length = RoundSignificantDigits(value, decimals, buffer, size(buffer));
+        if (length <= size(buffer))
+        {
+            result.assign(buffer, GetLengthWithoutTrailingZeros(wstring_view(buffer, length)));
+        }
+        else
+        {
+            result = RoundSignificantDigits(value, decimals);
+            TrimTrailingZeros(result);
+        }
+    }
+
+    wstring FormatSuggestedValue(double value)
+    {
+        wstring formatted;
+        FormatRoundedValue(value, GetSuggestedValueDecimals(value), formatted);
+        return formatted;
+    }
+}
+
 /// <summary>
 /// Constructor, sets up all the variables and requires a configLoader
 /// </summary>
@@ -45,6 +121,10 @@ UnitConverter::UnitConverter(_In_ const shared_ptr<IConverterDataLoader>& dataLo
 /// <param name="dataLoader">An instance of the IConverterDataLoader interface which we use to read in category/unit names and conversion data</param>
 /// <param name="currencyDataLoader">An instance of the IConverterDataLoader interface, specialized for loading currency data from an internet service</param>
 UnitConverter::UnitConverter(_In_ const shared_ptr<IConverterDataLoader>& dataLoader, _In_ const shared_ptr<IConverterDataLoader>& currencyDataLoader)
+    : m_exactConverter(make_unique<ExactUnitConverter>())
+    , m_isExactMode(false)
+    , m_fromType(EMPTY_UNIT)
+    , m_toType(EMPTY_UNIT)
 {
     m_dataLoader = dataLoader;
     m_currencyDataLoader = currencyDataLoader;
@@ -69,6 +149,8 @@ UnitConverter::UnitConverter(_In_ const shared_ptr<IConverterDataLoader>& dataLo
     ResetCategoriesAndRatios();
 }
 
+UnitConverter::~UnitConverter() = default;
+
 void UnitConverter::Initialize()
 {
     m_dataLoader->LoadData();
@@ -304,6 +386,89 @@ wstring UnitConverter::SaveUserPreferences()
     return test;
 }
 
+/// <summary>
+/// Serializes the ids of the Category and Associated Units in the converter to the buffer, if it is large enough
+/// </summary>
+/// <param name="buffer">buffer for the preferences</param>
+/// <param name="bufferSize">size of the buffer</param>
+size_t UnitConverter::SaveUserPreferences(_Out_ uint8_t* buffer, size_t bufferSize) const
+{
+    SnapshotWriter writer(buffer, bufferSize);
+    writer.WriteUInt32(USERPREFERENCESMAGIC);
+    writer.WriteUInt32(USERPREFERENCESVERSION);
+    writer.WriteInt32(m_currentCategory.id);
+    for (const Unit* unit : { &m_fromType, &m_toType })
+    {
+        writer.WriteInt32(unit->id);
+        writer.WriteBool(unit->isConversionSource);
+        writer.WriteBool(unit->isConversionTarget);
+    }
+    return writer.Size();
+}
+
+/// <summary>
+/// De-Serializes the binary preferences, taking the names of the category and units from the loaded ones
+/// </summary>
+/// <param name="userPreferences">the preferences written by the binary SaveUserPreferences</param>
+/// <param name="size">size of the preferences</param>
+bool UnitConverter::RestoreUserPreferences(_In_ const uint8_t* userPreferences, size_t size)
+{
+    SnapshotReader reader(userPreferences, size);
+    const uint32_t magic = reader.ReadUInt32();
+    const uint32_t version = reader.ReadUInt32();
+    const int32_t categoryId = reader.ReadInt32();
+    Unit savedUnits[2];
+    for (Unit& unit : savedUnits)
+    {
+        unit.id = reader.ReadInt32();
+        unit.isConversionSource = reader.ReadBool();
+        unit.isConversionTarget = reader.ReadBool();
+    }
+    if (!reader.IsValid() || magic != USERPREFERENCESMAGIC || version != USERPREFERENCESVERSION)
+    {
+        return false;
+    }
+
+    auto category = find_if(m_categories.begin(), m_categories.end(), [categoryId](const Category& c) { return c.id == categoryId; });
+    if (category == m_categories.end())
+    {
+        return false;
+    }
+
+    auto itr = m_categoryToUnits.find(*category);
+    if (itr == m_categoryToUnits.end())
+    {
+        return false;
+    }
+
+    // The units of a category are in its conversion table in the same order, so the position of a unit in the table
+    // usually finds it in the category without a search
+    const vector<Unit>& curUnits = itr->second;
+    auto findUnit = [this, &curUnits](int unitId) {
+        auto unitIndex = m_unitIndices.find(unitId);
+        if (unitIndex != m_unitIndices.end() && unitIndex->second.second < curUnits.size() && curUnits[unitIndex->second.second].id == unitId)
+        {
+            return curUnits.begin() + unitIndex->second.second;
+        }
+        return find_if(curUnits.begin(), curUnits.end(), [unitId](const Unit& u) { return u.id == unitId; });
+    };
+
+    m_currentCategory = *category;
+    Unit* const types[] = { &m_fromType, &m_toType };
+    for (size_t i = 0; i < 2; i++)
+    {
+        auto unit = findUnit(savedUnits[i].id);
+        if (unit != curUnits.end())
+        {
+            *types[i] = *unit;
+            types[i]->isConversionSource = savedUnits[i].isConversionSource;
+            types[i]->isConversionTarget = savedUnits[i].isConversionTarget;
+        }
+    }
+
+    return true;
+}
+
 /// <summary>
 /// Sanitizes the input string, escape quoting any symbols we rely on for our delimiters, and returns the sanitized string.
 /// </summary>
@@ -575,7 +740,7 @@ shared_ptr<ICurrencyConverterDataLoader> UnitConverter::GetCurrencyConverterData
 /// </summary>
 /// <param name="value">double input value to convert</param>
 /// <param name="ratio">double conversion ratio to use</param>
-double UnitConverter::Convert(double value, ConversionData conversionData)
+double UnitConverter::Convert(double value, const ConversionData& conversionData)
 {
     if (conversionData.offsetFirst)
     {
@@ -587,6 +752,40 @@ double UnitConverter::Convert(double value, ConversionData conversionData)
     }
 }
 
+/// <summary>
+/// Converts a batch of values from one unit type to another
+/// </summary>
+/// <param name="fromUnitId">id of the unit type of the values</param>
+/// <param name="toUnitId">id of the unit type to convert to</param>
+/// <param name="values">the values to convert</param>
+/// <param name="results">receives the converted values</param>
+/// <param name="count">number of values</param>
+bool UnitConverter::ConvertValues(int fromUnitId, int toUnitId, _In_ const double* values, _Out_ double* results, size_t count) const
+{
+    const ConversionData* conversionData = GetConversionData(fromUnitId, toUnitId);
+    if (conversionData == nullptr)
+    {
+        return false;
+    }
+
+    UnitConversionManager::ConvertValues(*conversionData, values, results, count);
+    return true;
+}
+
+/// <summary>
+/// Turns exact mode on or off. The display is converted again on the next calculation.
+/// </summary>
+/// <param name="isExactMode">whether conversions go through the exact factors of the units</param>
+void UnitConverter::SetExactMode(bool isExactMode)
+{
+    m_isExactMode = isExactMode;
+}
+
+bool UnitConverter::IsExactMode() const
+{
+    return m_isExactMode;
+}
+
 /// <summary>
 /// Calculates the suggested values for the current display value and returns them as a vector
 /// </summary>
@@ -598,104 +797,56 @@ vector<tuple<wstring, Unit>> UnitConverter::CalculateSuggested()
     }
 
     vector<tuple<wstring, Unit>> returnVector;
-    vector<SuggestedValueIntermediate> intermediateVector;
-    vector<SuggestedValueIntermediate> intermediateWhimsicalVector;
-    unordered_map<Unit, ConversionData, UnitHash> ratios = m_ratioMap[m_fromType];
-    // Calculate converted values for every other unit type in this category, along with their magnitude
-    for (const auto& cur : ratios)
-    {
-        if (cur.first != m_fromType && cur.first != m_toType)
-        {
-            double convertedValue = Convert(stod(m_currentDisplay), cur.second);
-            SuggestedValueIntermediate newEntry;
-            newEntry.magnitude = log10(convertedValue);
-            newEntry.value = convertedValue;
-            newEntry.type = cur.first;
-            if (newEntry.type.isWhimsical == false)
-                intermediateVector.push_back(newEntry);
-            else
-                intermediateWhimsicalVector.push_back(newEntry);
-        }
+    auto fromIndex = m_unitIndices.find(m_fromType.id);
+    if (fromIndex == m_unitIndices.end())
+    {
+        return returnVector;
     }
 
-    // Sort the resulting list by absolute magnitude, breaking ties by choosing the positive value
-    sort(intermediateVector.begin(), intermediateVector.end(), [](SuggestedValueIntermediate first, SuggestedValueIntermediate second) {
-        if (abs(first.magnitude) == abs(second.magnitude))
-        {
-            return first.magnitude > second.magnitude;
-        }
-        else
-        {
-            return abs(first.magnitude) < abs(second.magnitude);
-        }
-    });
+    const CategoryConversionTable& table = m_conversionTables[fromIndex->second.first];
+    const size_t rowIndex = table.GetIndex(fromIndex->second.second, 0);
+    const double currentValue = stod(m_currentDisplay);
 
-    // Now that the list is sorted, iterate over it and populate the return vector with properly rounded and formatted return strings
-    for (const auto& entry : intermediateVector)
+    // Calculate converted values for every other unit type in this category, along with their magnitude. Only the
+    // best whimsical value is suggested, so it is picked as they are calculated, among those that aren't shown as zero.
+    vector<SuggestedValueIntermediate> intermediateVector;
+    intermediateVector.reserve(table.units.size());
+    SuggestedValueIntermediate bestWhimsical{};
+    bool hasWhimsical = false;
+    for (size_t i = 0; i < table.units.size(); i++)
     {
-        wstring roundedString;
-        if (abs(entry.value) < 100)
-        {
-            roundedString = RoundSignificantDigits(entry.value, 2);
-        }
-        else if (abs(entry.value) < 1000)
-        {
-            roundedString = RoundSignificantDigits(entry.value, 1);
-        }
-        else
-        {
-            roundedString = RoundSignificantDigits(entry.value, 0);
-        }
-        if (stod(roundedString) != 0.0 || m_currentCategory.supportsNegative)
+        const Unit& cur = table.units[i];
+        if (table.hasConversionData[rowIndex + i] && cur != m_fromType && cur != m_toType)
         {
-            TrimTrailingZeros(roundedString);
-            returnVector.push_back(make_tuple(roundedString, entry.type));
+            double convertedValue = Convert(currentValue, table.conversionData[rowIndex + i]);
+            SuggestedValueIntermediate newEntry{ log10(convertedValue), convertedValue, i };
+            if (!cur.isWhimsical)
+            {
+                intermediateVector.push_back(newEntry);
+            }
+            else if (!IsSuggestedValueShownAsZero(convertedValue) && (!hasWhimsical || IsBetterSuggestion(newEntry, bestWhimsical)))
+            {
+                bestWhimsical = newEntry;
+                hasWhimsical = true;
+            }
         }
     }
 
-    // The Whimsicals are determined differently
-    // Sort the resulting list by absolute magnitude, breaking ties by choosing the positive value
-    sort(intermediateWhimsicalVector.begin(), intermediateWhimsicalVector.end(), [](SuggestedValueIntermediate first, SuggestedValueIntermediate second) {
-        if (abs(first.magnitude) == abs(second.magnitude))
-        {
-            return first.magnitude > second.magnitude;
-        }
-        else
-        {
-            return abs(first.magnitude) < abs(second.magnitude);
-        }
-    });
+    // Every other suggestion is kept, in order, and the view shows as many as fit
+    sort(intermediateVector.begin(), intermediateVector.end(), IsBetterSuggestion);
 
-    // Now that the list is sorted, iterate over it and populate the return vector with properly rounded and formatted return strings
-    vector<tuple<wstring, Unit>> whimsicalReturnVector;
-
-    for (const auto& entry : intermediateWhimsicalVector)
+    returnVector.reserve(intermediateVector.size() + 1);
+    for (const auto& entry : intermediateVector)
     {
-        wstring roundedString;
-        if (abs(entry.value) < 100)
-        {
-            roundedString = RoundSignificantDigits(entry.value, 2);
-        }
-        else if (abs(entry.value) < 1000)
-        {
-            roundedString = RoundSignificantDigits(entry.value, 1);
-        }
-        else
+        if (!IsSuggestedValueShownAsZero(entry.value) || m_currentCategory.supportsNegative)
         {
-            roundedString = RoundSignificantDigits(entry.value, 0);
-        }
-
-        // How to work out which is the best whimsical value to add to the vector?
-        if (stod(roundedString) != 0.0)
-        {
-            TrimTrailingZeros(roundedString);
-            whimsicalReturnVector.push_back(make_tuple(roundedString, entry.type));
+            returnVector.emplace_back(FormatSuggestedValue(entry.value), table.units[entry.unitIndex]);
         }
     }
-    // Pickup the 'best' whimsical value - currently the first one
-    if (whimsicalReturnVector.size() != 0)
+
+    if (hasWhimsical)
     {
-        returnVector.push_back(whimsicalReturnVector.at(0));
+        returnVector.emplace_back(FormatSuggestedValue(bestWhimsical.value), table.units[bestWhimsical.unitIndex]);
     }
 
     return returnVector;
@@ -718,7 +869,9 @@ void UnitConverter::ResetCategoriesAndRatios()
     m_currentCategory = m_categories[0];
 
     m_categoryToUnits.clear();
-    m_ratioMap.clear();
+    m_conversionTables.clear();
+    m_unitIndices.clear();
+    m_exactConverter->Clear();
     bool readyCategoryFound = false;
     for (const Category& category : m_categories)
     {
@@ -738,10 +891,8 @@ void UnitConverter::ResetCategoriesAndRatios()
         // we just want to make sure we don't let an unready category be the default.
         if (!units.empty())
         {
-            for (Unit u : units)
-            {
-                m_ratioMap[u] = activeDataLoader->LoadOrderedRatios(u);
-            }
+            AddConversionTable(units, *activeDataLoader);
+            m_exactConverter->AddFactors(activeDataLoader->LoadExactConversionFactors(category));
 
             if (!readyCategoryFound)
             {
@@ -754,6 +905,113 @@ void UnitConverter::ResetCategoriesAndRatios()
     InitializeSelectedUnits();
 }
 
+/// <summary>
+/// Applies the currency ratios that changed since the currencies were loaded, leaving the other categories and the
+/// selected units as they are, and recalculates only if the ratio between the selected units changed
+/// </summary>
+/// <returns>false if the currency data loader can't tell what changed, in which case nothing is recalculated and the
+/// categories are to be loaded again with ResetCategoriesAndRatios</returns>
+bool UnitConverter::UpdateCurrencyRatios()
+{
+    if (m_currencyDataLoader == nullptr)
+    {
+        return false;
+    }
+
+    bool isSelectionChanged = false;
+    for (const Category& category : m_categories)
+    {
+        if (!m_currencyDataLoader->SupportsCategory(category))
+        {
+            continue;
+        }
+
+        auto units = m_categoryToUnits.find(category);
+        if (units == m_categoryToUnits.end() || units->second.empty())
+        {
+            return false;
+        }
+
+        CategoryConversionTable& table = m_conversionTables[m_unitIndices[units->second.front().id].first];
+        vector<size_t> changedUnits;
+        if (!m_currencyDataLoader->UpdateConversionTable(table, changedUnits))
+        {
+            return false;
+        }
+
+        if (category == m_currentCategory)
+        {
+            isSelectionChanged = any_of(changedUnits.begin(), changedUnits.end(), [this, &table](size_t unitIndex) {
+                return table.units[unitIndex] == m_fromType || table.units[unitIndex] == m_toType;
+            });
+        }
+    }
+
+    if (isSelectionChanged)
+    {
+        Calculate();
+        UpdateCurrencySymbols();
+    }
+
+    return true;
+}
+
+/// <summary>
+/// Loads the ratios between every pair of units of a category into a new conversion table
+/// </summary>
+/// <param name="units">the units of the category, in order</param>
+/// <param name="dataLoader">the data loader of the category</param>
+void UnitConverter::AddConversionTable(const vector<Unit>& units, IConverterDataLoader& dataLoader)
+{
+    const size_t tableIndex = m_conversionTables.size();
+    CategoryConversionTable& table = m_conversionTables.emplace_back();
+    table.units = units;
+    table.conversionData.assign(units.size() * units.size(), ConversionData(1.0, 0.0, false));
+    table.hasConversionData.assign(units.size() * units.size(), false);
+
+    for (size_t fromIndex = 0; fromIndex < units.size(); fromIndex++)
+    {
+        m_unitIndices[units[fromIndex].id] = make_pair(tableIndex, fromIndex);
+    }
+
+    if (dataLoader.LoadConversionTable(table))
+    {
+        return;
+    }
+
+    for (size_t fromIndex = 0; fromIndex < units.size(); fromIndex++)
+    {
+        unordered_map<Unit, ConversionData, UnitHash> ratios = dataLoader.LoadOrderedRatios(units[fromIndex]);
+        for (size_t toIndex = 0; toIndex < units.size(); toIndex++)
+        {
+            auto ratio = ratios.find(units[toIndex]);
+            if (ratio != ratios.end())
+            {
+                table.conversionData[table.GetIndex(fromIndex, toIndex)] = ratio->second;
+                table.hasConversionData[table.GetIndex(fromIndex, toIndex)] = true;
+            }
+        }
+    }
+}
+
+/// <summary>
+/// Gets the conversion data from one unit to another, or nullptr if the units are not in the same category or the data
+/// loader gave no ratio for them
+/// </summary>
+const ConversionData* UnitConverter::GetConversionData(int fromUnitId, int toUnitId) const
+{
+    auto fromIndex = m_unitIndices.find(fromUnitId);
+    auto toIndex = m_unitIndices.find(toUnitId);
+    if (fromIndex == m_unitIndices.end() || toIndex == m_unitIndices.end() || fromIndex->second.first != toIndex->second.first)
+    {
+        return nullptr;
+    }
+
+    const CategoryConversionTable& table = m_conversionTables[fromIndex->second.first];
+    const size_t index = table.GetIndex(fromIndex->second.second, toIndex->second.second);
+    return table.hasConversionData[index] ? &table.conversionData[index] : nullptr;
+}
+
 /// <summary>
 /// Sets the active data loader based on the input category.
 /// </summary>
@@ -860,8 +1118,8 @@ void UnitConverter::Calculate()
         return;
     }
 
-    unordered_map<Unit, ConversionData, UnitHash> conversionTable = m_ratioMap[m_fromType];
-    if (AnyUnitIsEmpty() || (conversionTable[m_toType].ratio == 1.0 && conversionTable[m_toType].offset == 0.0))
+    const ConversionData* conversionData = GetConversionData(m_fromType.id, m_toType.id);
+    if (conversionData == nullptr || (conversionData->ratio == 1.0 && conversionData->offset == 0.0))
     {
         m_returnDisplay = m_currentDisplay;
         m_returnHasDecimal = m_currentHasDecimal;
@@ -870,21 +1128,37 @@ void UnitConverter::Calculate()
     else
     {
         double currentValue = stod(m_currentDisplay);
-        double returnValue = Convert(currentValue, conversionTable[m_toType]);
+        double returnValue = Convert(currentValue, *conversionData);
+
+        // The exact result is shown as the double one would be, only rounded from the exact value
+        Rational exactReturnValue;
+        bool isExact = TryCalculateExact(exactReturnValue);
+        if (isExact)
+        {
+            returnValue = ExactUnitConverter::ToDouble(exactReturnValue);
+        }
 
         auto isCurrencyConverter = m_currencyDataLoader != nullptr && m_currencyDataLoader->SupportsCategory(this->m_currentCategory);
         if (isCurrencyConverter)
         {
             // We don't need to trim the value when it's a currency.
-            m_returnDisplay = RoundSignificantDigits(returnValue, MAXIMUMDIGITSALLOWED);
-            TrimTrailingZeros(m_returnDisplay);
+            if (isExact)
+            {
+                m_returnDisplay = ExactUnitConverter::ToFixedString(exactReturnValue, MAXIMUMDIGITSALLOWED);
+                TrimTrailingZeros(m_returnDisplay);
+            }
+            else
+            {
+                FormatRoundedValue(returnValue, MAXIMUMDIGITSALLOWED, m_returnDisplay);
+            }
         }
         else
         {
             int numPreDecimal = GetNumberDigitsWholeNumberPart(returnValue);
             if (numPreDecimal > MAXIMUMDIGITSALLOWED || (returnValue != 0 && abs(returnValue) < MINIMUMDECIMALALLOWED))
             {
-                m_returnDisplay = ToScientificNumber(returnValue);
+                wchar_t buffer[FORMATTEDNUMBERBUFFERSIZE];
+                m_returnDisplay.assign(buffer, ToScientificNumber(returnValue, buffer, size(buffer)));
             }
             else
             {
@@ -901,8 +1175,15 @@ void UnitConverter::Calculate()
                     precision = max(0, max(OPTIMALDIGITSALLOWED, min(MAXIMUMDIGITSALLOWED, currentNumberSignificantDigits)) - numPreDecimal);
                 }
 
-                m_returnDisplay = RoundSignificantDigits(returnValue, precision);
-                TrimTrailingZeros(m_returnDisplay);
+                if (isExact)
+                {
+                    m_returnDisplay = ExactUnitConverter::ToFixedString(exactReturnValue, precision);
+                    TrimTrailingZeros(m_returnDisplay);
+                }
+                else
+                {
+                    FormatRoundedValue(returnValue, precision, m_returnDisplay);
+                }
             }
             m_returnHasDecimal = (m_returnDisplay.find(L'.') != wstring::npos);
         }
@@ -910,6 +1191,30 @@ void UnitConverter::Calculate()
     UpdateViewModel();
 }
 
+/// <summary>
+/// Converts the value on the display through the exact factors of the units, if exact mode is on and the data loader
+/// gave factors for both units
+/// </summary>
+/// <param name="result">the converted value, which is only set when this returns true</param>
+bool UnitConverter::TryCalculateExact(_Out_ Rational& result)
+{
+    if (!m_isExactMode)
+    {
+        return false;
+    }
+
+    try
+    {
+        Rational currentValue;
+        return ExactUnitConverter::TryParse(m_currentDisplay, currentValue) && m_exactConverter->Convert(m_fromType.id, m_toType.id, currentValue, result);
+    }
+    catch (uint32_t)
+    {
+        // Ratpack ran out of precision or memory, so the double result is shown
+        return false;
+    }
+}
+
 void UnitConverter::UpdateCurrencySymbols()
 {
     if (m_currencyDataLoader != nullptr && m_vmCurrencyCallback != nullptr)
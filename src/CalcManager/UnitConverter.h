@@ -3,15 +3,22 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <unordered_map>
 #include <future>
 #include "sal_cross_platform.h"  // for SAL
 #include <memory> // for std::shared_ptr
 
+namespace CalcEngine
+{
+    class Rational;
+}
+
 namespace UnitConversionManager
 {
     enum class Command;
+    class ExactUnitConverter;
 
     struct Unit
     {
@@ -130,7 +137,7 @@ namespace UnitConversionManager
     {
         double magnitude;
         double value;
-        Unit type;
+        size_t unitIndex; // Position of the unit in its CategoryConversionTable
     };
 
     struct ConversionData
@@ -154,6 +161,29 @@ namespace UnitConversionManager
         bool offsetFirst;
     };
 
+    // The conversion data between every pair of units in one category, built once when the ratios are loaded. Units are
+    // identified by their position in the category, so that looking up a ratio neither hashes nor copies a Unit.
+    struct CategoryConversionTable
+    {
+        std::vector<Unit> units;
+        std::vector<ConversionData> conversionData; // One row per source unit, each with a column per target unit
+        std::vector<bool> hasConversionData;        // Whether the data loader gave a ratio for the pair
+
+        size_t GetIndex(size_t fromIndex, size_t toIndex) const
+        {
+            return fromIndex * units.size() + toIndex;
+        }
+    };
+
+    // The conversion of a unit to the base unit of its category, written out exactly: base = value * ratio + offset. Each
+    // number is a decimal literal, such as "0.3048" or "1e-9", or a fraction of two of them, such as "400/121". An
+    // empty offset is 0.
+    struct ExactConversionFactor
+    {
+        std::wstring ratio;
+        std::wstring offset;
+    };
+
     struct CurrencyStaticData
     {
         std::wstring countryCode;
@@ -199,6 +229,29 @@ namespace UnitConversionManager
         virtual std::vector<Unit> LoadOrderedUnits(const Category& c) = 0;
         virtual std::unordered_map<Unit, ConversionData, UnitHash> LoadOrderedRatios(const Unit& u) = 0;
         virtual bool SupportsCategory(const Category& target) = 0;
+
+        // The exact factors of the units of the category, by unit id, which the converter uses in exact mode. The units
+        // of a data loader that doesn't give them are only converted with doubles.
+        virtual std::unordered_map<int, ExactConversionFactor> LoadExactConversionFactors(const Category& /*c*/)
+        {
+            return {};
+        }
+
+        // Fills in the conversion data between every pair of the table's units at once, for a data loader that keeps
+        // its ratios in a form that makes that cheaper than a LoadOrderedRatios map per unit. The data of the table is
+        // already sized for its units. Returns false to have the converter call LoadOrderedRatios instead.
+        virtual bool LoadConversionTable(_Inout_ CategoryConversionTable& /*table*/)
+        {
+            return false;
+        }
+
+        // Updates the conversion data of a table that was loaded before with only the ratios that changed since, and adds
+        // the positions in the table of the units whose ratios changed to changedUnits. Returns false if the data loader
+        // can't tell what changed, e.g. because its units did, in which case the table must be loaded again.
+        virtual bool UpdateConversionTable(_Inout_ CategoryConversionTable& /*table*/, _Inout_ std::vector<size_t>& /*changedUnits*/)
+        {
+            return false;
+        }
     };
 
     class ICurrencyConverterDataLoader
@@ -239,12 +292,15 @@ namespace UnitConversionManager
         virtual void SwitchActive(const std::wstring& newValue) = 0;
         virtual std::wstring SaveUserPreferences() = 0;
         virtual void RestoreUserPreferences(_In_ const std::wstring& userPreferences) = 0;
+        virtual size_t SaveUserPreferences(_Out_ uint8_t* buffer, size_t bufferSize) const = 0;
+        virtual bool RestoreUserPreferences(_In_ const uint8_t* userPreferences, size_t size) = 0;
         virtual void SendCommand(Command command) = 0;
         virtual void SetViewModelCallback(_In_ const std::shared_ptr<IUnitConverterVMCallback>& newCallback) = 0;
         virtual void SetViewModelCurrencyCallback(_In_ const std::shared_ptr<IViewModelCurrencyCallback>& newCallback) = 0;
         virtual std::future<std::pair<bool, std::wstring>> RefreshCurrencyRatios() = 0;
         virtual void Calculate() = 0;
         virtual void ResetCategoriesAndRatios() = 0;
+        virtual bool UpdateCurrencyRatios() = 0;
     };
 
     class UnitConverter : public IUnitConverter, public std::enable_shared_from_this<UnitConverter>
@@ -252,6 +308,7 @@ namespace UnitConversionManager
     public:
         UnitConverter(_In_ const std::shared_ptr<IConverterDataLoader>& dataLoader);
         UnitConverter(_In_ const std::shared_ptr<IConverterDataLoader>& dataLoader, _In_ const std::shared_ptr<IConverterDataLoader>& currencyDataLoader);
+        ~UnitConverter();
 
         // IUnitConverter
         void Initialize() override;
@@ -262,21 +319,48 @@ namespace UnitConversionManager
         void SwitchActive(const std::wstring& newValue) override;
         std::wstring SaveUserPreferences() override;
         void RestoreUserPreferences(const std::wstring& userPreference) override;
+
+        // The binary form of the user preferences, which holds the ids of the category and units but not their names:
+        // those are the ones the data loader gives when the preferences are restored. Returns the size of the preferences, and only
+        // writes them if that is not more than bufferSize.
+        size_t SaveUserPreferences(_Out_ uint8_t* buffer, size_t bufferSize) const override;
+
+        // Restores what the binary SaveUserPreferences wrote, reading the ids in place. A unit that is no longer in the
+        // category is left as it was. Returns false, and changes nothing, if the preferences are not valid or their
+        // category is not loaded.
+        bool RestoreUserPreferences(_In_ const uint8_t* userPreferences, size_t size) override;
+
         void SendCommand(Command command) override;
         void SetViewModelCallback(_In_ const std::shared_ptr<IUnitConverterVMCallback>& newCallback) override;
         void SetViewModelCurrencyCallback(_In_ const std::shared_ptr<IViewModelCurrencyCallback>& newCallback) override;
         std::future<std::pair<bool, std::wstring>> RefreshCurrencyRatios() override;
         void Calculate() override;
         void ResetCategoriesAndRatios() override;
+        bool UpdateCurrencyRatios() override;
         // IUnitConverter
 
+        // Converts count values from one unit to another, as Calculate converts the value on the display. values and
+        // results may be the same array. Returns false, without writing the results, if the units are not in the same
+        // category or there is no ratio between them.
+        bool ConvertValues(int fromUnitId, int toUnitId, _In_ const double* values, _Out_ double* results, size_t count) const;
+
+        // Converts one value, as Calculate converts the value on the display
+        static double Convert(double value, const ConversionData& conversionData);
+
+        // In exact mode, the value on the display is converted through the exact factors of the units, when the data
+        // loader gives them for both, and only the result is rounded. Takes effect from the next calculation.
+        void SetExactMode(bool isExactMode);
+        bool IsExactMode() const;
+
         static std::vector<std::wstring> StringToVector(const std::wstring& w, const wchar_t* delimiter, bool addRemainder = false);
         static std::wstring Quote(const std::wstring& s);
         static std::wstring Unquote(const std::wstring& s);
 
     private:
         bool CheckLoad();
-        double Convert(double value, ConversionData conversionData);
+        bool TryCalculateExact(_Out_ CalcEngine::Rational& result);
+        void AddConversionTable(const std::vector<Unit>& units, IConverterDataLoader& dataLoader);
+        const ConversionData* GetConversionData(int fromUnitId, int toUnitId) const;
         std::vector<std::tuple<std::wstring, Unit>> CalculateSuggested();
         void ClearValues();
         void InitializeSelectedUnits();
@@ -297,7 +381,10 @@ namespace UnitConversionManager
         std::shared_ptr<IViewModelCurrencyCallback> m_vmCurrencyCallback;
         std::vector<Category> m_categories;
         CategoryToUnitVectorMap m_categoryToUnits;
-        UnitToUnitToConversionDataMap m_ratioMap;
+        std::vector<CategoryConversionTable> m_conversionTables;
+        std::unordered_map<int, std::pair<size_t, size_t>> m_unitIndices; // Unit id to its table and position in the table
+        std::unique_ptr<ExactUnitConverter> m_exactConverter;
+        bool m_isExactMode;
         Category m_currentCategory;
         Unit m_fromType;
         Unit m_toType;
@@ -11,12 +11,15 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <charconv>
+#include <filesystem>
 #include <intsafe.h>
 #include <list>
 #include <future>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 #include <winerror.h>
@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include "AllocationCounter.h"
+
+using namespace std;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    // Every allocation is prefixed with its size, padded to keep the returned pointer suitably aligned.
+    constexpr size_t c_headerSize = alignof(max_align_t);
+
+    atomic<int64_t> s_liveAllocations{ 0 };
+    atomic<int64_t> s_liveBytes{ 0 };
+    atomic<uint64_t> s_totalAllocations{ 0 };
+}
+
+HeapSnapshot CalcManagerBenchmarks::GetHeapSnapshot()
+{
+    return { s_liveAllocations.load(), s_liveBytes.load(), s_totalAllocations.load() };
+}
+
+void* operator new(size_t size)
+{
+    void* block = malloc(size + c_headerSize);
+    if (block == nullptr)
+    {
+        throw bad_alloc();
+    }
+
+    *static_cast<size_t*>(block) = size;
+    s_liveAllocations++;
+    s_liveBytes += static_cast<int64_t>(size);
+    s_totalAllocations++;
+    return static_cast<char*>(block) + c_headerSize;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer == nullptr)
+    {
+        return;
+    }
+
+    void* block = static_cast<char*>(pointer) - c_headerSize;
+    s_liveAllocations--;
+    s_liveBytes -= static_cast<int64_t>(*static_cast<size_t*>(block));
+    free(block);
+}
+
+void operator delete(void* pointer, size_t /*size*/) noexcept
+{
+    operator delete(pointer);
+}
@@ -0,0 +1,21 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+
+// Counts the heap memory held by the benchmark process. The CalcManagerBenchmarks executable replaces the global
+// operator new and operator delete to keep these counts, so the difference between two snapshots is the memory a
+// piece of code allocated and did not free.
+namespace CalcManagerBenchmarks
+{
+    struct HeapSnapshot
+    {
+        int64_t liveAllocations;
+        int64_t liveBytes;
+        uint64_t totalAllocations;
+    };
+
+    HeapSnapshot GetHeapSnapshot();
+}
@@ -0,0 +1,305 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include "Benchmark.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    struct RegisteredBenchmark
+    {
+        const char* name;
+        BenchmarkFunction function;
+    };
+
+    vector<RegisteredBenchmark>& GetRegisteredBenchmarks()
+    {
+        static vector<RegisteredBenchmark> s_benchmarks;
+        return s_benchmarks;
+    }
+
+    enum class OutputFormat
+    {
+        Tsv,
+        Json
+    };
+
+    struct Options
+    {
+        string_view filter;
+        double minTimeSeconds = 0.2;
+        OutputFormat format = OutputFormat::Tsv;
+    };
+
+    void PrintUsage(const char* program)
+    {
+        printf(
+            "Usage: %s [--filter=<substring>] [--min-time=<seconds>] [--format=tsv|json] [--list]\n"
+            "\n"
+            "Runs every registered benchmark whose name contains the filter and prints one result per line.\n"
+            "tsv:  name, iterations, ns/iteration, items/s, bytes/s, then name=value counters.\n"
+            "json: one JSON object per benchmark.\n",
+            program);
+    }
+
+    bool TryParseArgument(string_view argument, string_view name, string_view& value)
+    {
+        if (argument.substr(0, name.size()) != name)
+        {
+            return false;
+        }
+
+        value = argument.substr(name.size());
+        return true;
+    }
+
+    void PrintResult(OutputFormat format, const char* name, BenchmarkState const& state)
+    {
+        double seconds = duration<double>(state.Elapsed()).count();
+        double nsPerIteration = duration<double, nano>(state.Elapsed()).count() / static_cast<double>(state.Iterations());
+        double itemsPerSecond = seconds > 0 ? state.ItemsProcessed() / seconds : 0;
+        double bytesPerSecond = seconds > 0 ? state.BytesProcessed() / seconds : 0;
+
+        if (format == OutputFormat::Json)
+        {
+            printf(
+                "{\"name\":\"%s\",\"iterations\":%llu,\"ns_per_iteration\":%.3f,\"items_per_second\":%.3f,\"bytes_per_second\":%.3f",
+                name,
+                static_cast<unsigned long long>(state.Iterations()),
+                nsPerIteration,
+                itemsPerSecond,
+                bytesPerSecond);
+            for (auto const& counter : state.Counters())
+            {
+                printf(",\"%s\":%.3f", counter.first.c_str(), counter.second);
+            }
+            if (!state.Label().empty())
+            {
+                printf(",\"label\":\"%s\"", state.Label().c_str());
+            }
+            printf("}\n");
+        }
+        else
+        {
+            printf(
+                "%s\t%llu\t%.3f\t%.3f\t%.3f",
+                name,
+                static_cast<unsigned long long>(state.Iterations()),
+                nsPerIteration,
+                itemsPerSecond,
+                bytesPerSecond);
+            for (auto const& counter : state.Counters())
+            {
+                printf("\t%s=%.3f", counter.first.c_str(), counter.second);
+            }
+            if (!state.Label().empty())
+            {
+                printf("\tlabel=%s", state.Label().c_str());
+            }
+            printf("\n");
+        }
+
+        fflush(stdout);
+    }
+
+    // Runs the benchmark with a growing number of iterations until one run takes at least the minimum time.
+    void RunBenchmark(RegisteredBenchmark const& benchmark, Options const& options)
+    {
+        uint64_t iterations = 1;
+        while (true)
+        {
+            BenchmarkState state(iterations);
+            benchmark.function(state);
+
+            double seconds = duration<double>(state.Elapsed()).count();
+            if (seconds >= options.minTimeSeconds || iterations >= (1ull << 40))
+            {
+                PrintResult(options.format, benchmark.name, state);
+                return;
+            }
+
+            // Aim slightly past the minimum time so the final run rarely falls short of it.
+            double multiplier = seconds > 0 ? (options.minTimeSeconds * 1.4) / seconds : 100;
+            multiplier = min(max(multiplier, 2.0), 100.0);
+            iterations = static_cast<uint64_t>(iterations * multiplier);
+        }
+    }
+}
+
+namespace CalcManagerBenchmarks
+{
+    BenchmarkState::BenchmarkState(uint64_t iterations)
+        : m_iterations(iterations)
+        , m_remaining(iterations)
+        , m_started(false)
+        , m_running(false)
+        , m_elapsed(0)
+        , m_itemsProcessed(0)
+        , m_bytesProcessed(0)
+    {
+    }
+
+    bool BenchmarkState::KeepRunning()
+    {
+        if (!m_started)
+        {
+            m_started = true;
+            ResumeTiming();
+        }
+
+        if (m_remaining == 0)
+        {
+            PauseTiming();
+            return false;
+        }
+
+        m_remaining--;
+        return true;
+    }
+
+    void BenchmarkState::PauseTiming()
+    {
+        if (m_running)
+        {
+            m_elapsed += duration_cast<nanoseconds>(steady_clock::now() - m_start);
+            m_running = false;
+        }
+    }
+
+    void BenchmarkState::ResumeTiming()
+    {
+        if (!m_running)
+        {
+            m_running = true;
+            m_start = steady_clock::now();
+        }
+    }
+
+    uint64_t BenchmarkState::Iterations() const
+    {
+        return m_iterations;
+    }
+
+    nanoseconds BenchmarkState::Elapsed() const
+    {
+        return m_elapsed;
+    }
+
+    void BenchmarkState::SetItemsProcessed(uint64_t items)
+    {
+        m_itemsProcessed = items;
+    }
+
+    void BenchmarkState::SetBytesProcessed(uint64_t bytes)
+    {
+        m_bytesProcessed = bytes;
+    }
+
+    uint64_t BenchmarkState::ItemsProcessed() const
+    {
+        return m_itemsProcessed;
+    }
+
+    uint64_t BenchmarkState::BytesProcessed() const
+    {
+        return m_bytesProcessed;
+    }
+
+    void BenchmarkState::SetCounter(string name, double value)
+    {
+        for (auto& counter : m_counters)
+        {
+            if (counter.first == name)
+            {
+                counter.second = value;
+                return;
+            }
+        }
+
+        m_counters.emplace_back(move(name), value);
+    }
+
+    vector<pair<string, double>> const& BenchmarkState::Counters() const
+    {
+        return m_counters;
+    }
+
+    void BenchmarkState::SetLabel(string label)
+    {
+        m_label = move(label);
+    }
+
+    string const& BenchmarkState::Label() const
+    {
+        return m_label;
+    }
+
+    BenchmarkRegistration::BenchmarkRegistration(const char* name, BenchmarkFunction function)
+    {
+        GetRegisteredBenchmarks().push_back({ name, function });
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    bool listOnly = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string_view argument = argv[i];
+        string_view value;
+        if (TryParseArgument(argument, "--filter=", value))
+        {
+            options.filter = value;
+        }
+        else if (TryParseArgument(argument, "--min-time=", value))
+        {
+            options.minTimeSeconds = atof(string(value).c_str());
+        }
+        else if (TryParseArgument(argument, "--format=", value) && (value == "tsv" || value == "json"))
+        {
+            options.format = (value == "json") ? OutputFormat::Json : OutputFormat::Tsv;
+        }
+        else if (argument == "--list")
+        {
+            listOnly = true;
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return argument == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (!listOnly && options.format == OutputFormat::Tsv)
+    {
+        printf("name\titerations\tns_per_iteration\titems_per_second\tbytes_per_second\tcounters\n");
+    }
+
+    for (auto const& benchmark : GetRegisteredBenchmarks())
+    {
+        if (string_view(benchmark.name).find(options.filter) == string_view::npos)
+        {
+            continue;
+        }
+
+        if (listOnly)
+        {
+            printf("%s\n", benchmark.name);
+        }
+        else
+        {
+            RunBenchmark(benchmark, options);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
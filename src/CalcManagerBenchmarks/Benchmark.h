@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// A minimal benchmark harness for CalcManager. Benchmarks register themselves with CALC_BENCHMARK and are run by
+// the CalcManagerBenchmarks executable, which prints one line per benchmark in a machine-readable format.
+namespace CalcManagerBenchmarks
+{
+    class BenchmarkState
+    {
+    public:
+        explicit BenchmarkState(uint64_t iterations);
+
+        // Returns true while the benchmark body should run another iteration. The timer starts on the first call
+        // and stops when the last iteration is done.
+        bool KeepRunning();
+
+        // Excludes the work done between PauseTiming and ResumeTiming from the measurement.
+        void PauseTiming();
+        void ResumeTiming();
+
+        uint64_t Iterations() const;
+        std::chrono::nanoseconds Elapsed() const;
+
+        // Throughput reported as items/s and bytes/s. Both are totals over all iterations.
+        void SetItemsProcessed(uint64_t items);
+        void SetBytesProcessed(uint64_t bytes);
+        uint64_t ItemsProcessed() const;
+        uint64_t BytesProcessed() const;
+
+        // Free-form values reported next to the timing, e.g. latency percentiles or allocation counts.
+        void SetCounter(std::string name, double value);
+        std::vector<std::pair<std::string, double>> const& Counters() const;
+
+        void SetLabel(std::string label);
+        std::string const& Label() const;
+
+    private:
+        uint64_t m_iterations;
+        uint64_t m_remaining;
+        bool m_started;
+        bool m_running;
+        std::chrono::steady_clock::time_point m_start;
+        std::chrono::nanoseconds m_elapsed;
+        uint64_t m_itemsProcessed;
+        uint64_t m_bytesProcessed;
+        std::vector<std::pair<std::string, double>> m_counters;
+        std::string m_label;
+    };
+
+    using BenchmarkFunction = void (*)(BenchmarkState&);
+
+    class BenchmarkRegistration
+    {
+    public:
+        BenchmarkRegistration(const char* name, BenchmarkFunction function);
+    };
+
+    // Prevents the compiler from optimizing away a value computed only for the benchmark.
+    template <typename T>
+    void DoNotOptimize(T const& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static const void* volatile sink;
+        sink = &value;
+#endif
+    }
+}
+
+#define CALC_BENCHMARK(name)                                                                                                                                   \
+    static void name(CalcManagerBenchmarks::BenchmarkState& state);                                                                                            \
+    static CalcManagerBenchmarks::BenchmarkRegistration name##Registration(#name, name);                                                                       \
+    static void name(CalcManagerBenchmarks::BenchmarkState& state)
@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "AllocationCounter.h"
+#include "Benchmark.h"
+#include "CalculatorManagerStubs.h"
+#include "Command.h"
+
+using namespace std;
+using namespace CalculationManager;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    // Enters "12.5 + sqr(3) * (4 - 5) = " and variations of it, one history item per equation.
+    void EnterEquation(CalculatorManager& calculatorManager, unsigned int seed)
+    {
+        const Command commands[] = { Command::Command1, static_cast<Command>(static_cast<int>(Command::Command0) + seed % 10),
+                                     Command::CommandPNT, Command::Command5, Command::CommandADD, Command::Command3,
+                                     Command::CommandSQR, Command::CommandMUL, Command::CommandOPENP, Command::Command4,
+                                     Command::CommandSUB, Command::Command5, Command::CommandCLOSEP, Command::CommandEQU };
+        for (Command command : commands)
+        {
+            calculatorManager.SendCommand(command);
+        }
+    }
+}
+
+// Measures the heap memory and the number of allocations held by one history item while the history is full.
+CALC_BENCHMARK(HistoryItemMemory_MaxHistorySize)
+{
+    NullCalcDisplay display;
+    EnglishResourceProvider resourceProvider;
+    CalculatorManager calculatorManager(&display, &resourceProvider);
+    calculatorManager.SetScientificMode();
+    const size_t itemCount = calculatorManager.MaxHistorySize();
+
+    HeapSnapshot empty{};
+    HeapSnapshot full{};
+    while (state.KeepRunning())
+    {
+        calculatorManager.ClearHistory();
+        empty = GetHeapSnapshot();
+        for (unsigned int i = 0; i < itemCount; i++)
+        {
+            EnterEquation(calculatorManager, i);
+        }
+
+        full = GetHeapSnapshot();
+    }
+
+    state.SetItemsProcessed(state.Iterations() * itemCount);
+    state.SetCounter("bytes_per_item", static_cast<double>(full.liveBytes - empty.liveBytes) / itemCount);
+    state.SetCounter("allocations_per_item", static_cast<double>(full.liveAllocations - empty.liveAllocations) / itemCount);
+}
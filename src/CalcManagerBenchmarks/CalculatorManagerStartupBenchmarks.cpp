@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <memory>
+#include "AllocationCounter.h"
+#include "Benchmark.h"
+#include "CalculatorManagerStubs.h"
+
+using namespace std;
+using namespace CalculationManager;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    // Creates a CalculatorManager, lets setUp create its engines, and measures the time, which includes destroying it,
+    // and the heap memory that the CalculatorManager holds once it is set up.
+    template <typename SetUp>
+    void MeasureStartup(BenchmarkState& state, SetUp setUp)
+    {
+        NullCalcDisplay display;
+        EnglishResourceProvider resourceProvider;
+
+        // The first CalculatorManager also sets up what the process shares, which is not measured
+        CalculatorManager first(&display, &resourceProvider);
+        setUp(first);
+
+        HeapSnapshot before{};
+        HeapSnapshot after{};
+        while (state.KeepRunning())
+        {
+            before = GetHeapSnapshot();
+            auto calculatorManager = make_unique<CalculatorManager>(&display, &resourceProvider);
+            setUp(*calculatorManager);
+            after = GetHeapSnapshot();
+            DoNotOptimize(calculatorManager.get());
+        }
+
+        state.SetItemsProcessed(state.Iterations());
+        state.SetCounter("heap_bytes", static_cast<double>(after.liveBytes - before.liveBytes));
+        state.SetCounter("heap_allocations", static_cast<double>(after.liveAllocations - before.liveAllocations));
+    }
+}
+
+// A CalculatorManager creates no engine until a mode is set
+CALC_BENCHMARK(CalculatorManagerStartup_NoMode)
+{
+    MeasureStartup(state, [](CalculatorManager&) {});
+}
+
+CALC_BENCHMARK(CalculatorManagerStartup_StandardMode)
+{
+    MeasureStartup(state, [](CalculatorManager& calculatorManager) { calculatorManager.SetStandardMode(); });
+}
+
+CALC_BENCHMARK(CalculatorManagerStartup_AllModes)
+{
+    MeasureStartup(state, [](CalculatorManager& calculatorManager) {
+        calculatorManager.SetStandardMode();
+        calculatorManager.SetScientificMode();
+        calculatorManager.SetProgrammerMode();
+    });
+}
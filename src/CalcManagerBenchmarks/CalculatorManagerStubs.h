@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include "CalculatorManager.h"
+#include "CalculatorResource.h"
+
+// Minimal implementations of the interfaces CalculatorManager needs from its host, for benchmarks that drive the
+// engine without a UI.
+namespace CalcManagerBenchmarks
+{
+    class NullCalcDisplay final : public ICalcDisplay
+    {
+    public:
+        void SetPrimaryDisplay(const std::wstring& text, bool isError) override
+        {
+            m_primaryDisplay = text;
+            m_isError = isError;
+        }
+        void SetIsInError(bool isInError) override
+        {
+            m_isError = isInError;
+        }
+        void SetExpressionDisplay(
+            _Inout_ std::shared_ptr<std::vector<std::pair<std::wstring, int>>> const& /*tokens*/,
+            _Inout_ std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> const& /*commands*/) override
+        {
+        }
+        void SetParenthesisNumber(_In_ unsigned int /*count*/) override
+        {
+        }
+        void OnNoRightParenAdded() override
+        {
+        }
+        void MaxDigitsReached() override
+        {
+        }
+        void BinaryOperatorReceived() override
+        {
+        }
+        void OnHistoryItemAdded(_In_ unsigned int /*addedItemIndex*/) override
+        {
+        }
+        void SetMemorizedNumbers(const std::vector<std::wstring>& /*memorizedNumbers*/) override
+        {
+        }
+        void InsertMemorizedNumber(unsigned int /*indexOfMemory*/, const std::wstring& /*memorizedNumber*/) override
+        {
+        }
+        void UpdateMemorizedNumber(unsigned int /*indexOfMemory*/, const std::wstring& /*memorizedNumber*/) override
+        {
+        }
+        void RemoveMemorizedNumber(unsigned int /*indexOfMemory*/) override
+        {
+        }
+        void MemoryItemChanged(unsigned int /*indexOfMemory*/) override
+        {
+        }
+        void InputChanged() override
+        {
+        }
+
+        std::wstring const& PrimaryDisplay() const
+        {
+            return m_primaryDisplay;
+        }
+        bool IsError() const
+        {
+            return m_isError;
+        }
+
+    private:
+        std::wstring m_primaryDisplay;
+        bool m_isError = false;
+    };
+
+    // Provides the en-US number format; every other engine string is empty.
+    class EnglishResourceProvider final : public CalculationManager::IResourceProvider
+    {
+    public:
+        std::wstring GetCEngineString(std::wstring_view id) override
+        {
+            if (id == L"sDecimal")
+            {
+                return L".";
+            }
+
+            if (id == L"sThousand")
+            {
+                return L",";
+            }
+
+            if (id == L"sGrouping")
+            {
+                return L"3;0";
+            }
+
+            return std::wstring();
+        }
+    };
+}
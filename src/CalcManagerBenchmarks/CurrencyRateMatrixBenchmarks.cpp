@@ -0,0 +1,342 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AllocationCounter.h"
+#include "Benchmark.h"
+#include "Command.h"
+#include "CurrencyRateMatrix.h"
+#include "UnitConverter.h"
+
+using namespace std;
+using namespace UnitConversionManager;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    constexpr int CURRENCY_CATEGORY_ID = 1;
+    constexpr int STATIC_CATEGORY_ID = 2;
+    constexpr int STATIC_UNIT_ID_START = 1000;
+
+    // A few more currencies than the service gives
+    constexpr size_t CURRENCY_COUNT = 180;
+
+    // Between two refreshes of the rates a few minutes apart, only a few of them move
+    constexpr size_t CHANGED_CURRENCY_COUNT = 5;
+
+    vector<double> MakeRatios()
+    {
+        vector<double> ratios(CURRENCY_COUNT);
+        for (size_t i = 0; i < ratios.size(); i++)
+        {
+            ratios[i] = (1 + i / 7.0) * (i % 3 == 0 ? 0.001 : 1);
+        }
+        return ratios;
+    }
+
+    // Loads the currencies with the ratios between every pair of them, either as a map per currency, as the currency
+    // data loader kept them, or from a rate matrix that fills the converter's table directly. There may also be a
+    // static category, which the converter loads along with the currencies unless they are updated in place.
+    class CurrencyBenchmarkDataLoader : public IConverterDataLoader
+    {
+    public:
+        explicit CurrencyBenchmarkDataLoader(bool isMatrixLoaded, int staticUnitCount = 0)
+            : m_isMatrixLoaded(isMatrixLoaded)
+            , m_currencyRatios(MakeRatios())
+        {
+            for (size_t i = 0; i < CURRENCY_COUNT; i++)
+            {
+                const wstring code = L"C" + to_wstring(i);
+                m_units.emplace_back(static_cast<int>(i + 1), L"Currency" + code, L"Country" + code, code, false, false, false);
+            }
+
+            m_rates.Build(m_currencyRatios);
+            for (size_t from = 0; from < CURRENCY_COUNT; from++)
+            {
+                for (size_t to = 0; to < CURRENCY_COUNT; to++)
+                {
+                    m_ratios[m_units[from]][m_units[to]] = ConversionData(m_rates.GetRate(from, to), 0, false);
+                }
+            }
+
+            for (int i = 0; i < staticUnitCount; i++)
+            {
+                m_staticUnits.emplace_back(STATIC_UNIT_ID_START + i, L"Unit" + to_wstring(i), L"U" + to_wstring(i), false, false, false);
+            }
+            for (int from = 0; from < staticUnitCount; from++)
+            {
+                for (int to = 0; to < staticUnitCount; to++)
+                {
+                    m_ratios[m_staticUnits[from]][m_staticUnits[to]] = ConversionData(pow(1.1, from - to), 0, false);
+                }
+            }
+        }
+
+        // Moves the ratios of CHANGED_CURRENCY_COUNT currencies, a different few each time
+        void Refresh()
+        {
+            for (size_t i = 0; i < CHANGED_CURRENCY_COUNT; i++)
+            {
+                const size_t position = (m_refreshCount * CHANGED_CURRENCY_COUNT + i) * 37 % CURRENCY_COUNT;
+                m_currencyRatios[position] *= m_refreshCount % 2 == 0 ? 1.001 : 1 / 1.001;
+            }
+            m_refreshCount++;
+            m_rates.Update(m_currencyRatios, m_changedPositions);
+        }
+
+        void LoadData() override
+        {
+        }
+
+        vector<Category> LoadOrderedCategories() override
+        {
+            if (m_staticUnits.empty())
+            {
+                return { Category(CURRENCY_CATEGORY_ID, L"Currency", false) };
+            }
+            return { Category(STATIC_CATEGORY_ID, L"Static", false), Category(CURRENCY_CATEGORY_ID, L"Currency", false) };
+        }
+
+        vector<Unit> LoadOrderedUnits(const Category& category) override
+        {
+            return category.id == CURRENCY_CATEGORY_ID ? m_units : m_staticUnits;
+        }
+
+        unordered_map<Unit, ConversionData, UnitHash> LoadOrderedRatios(const Unit& unit) override
+        {
+            return m_ratios.at(unit);
+        }
+
+        bool SupportsCategory(const Category& target) override
+        {
+            return target.id == CURRENCY_CATEGORY_ID;
+        }
+
+        bool LoadConversionTable(_Inout_ CategoryConversionTable& table) override
+        {
+            if (!m_isMatrixLoaded || table.units.front().id >= STATIC_UNIT_ID_START)
+            {
+                return false;
+            }
+
+            for (size_t from = 0; from < table.units.size(); from++)
+            {
+                for (size_t to = 0; to < table.units.size(); to++)
+                {
+                    table.conversionData[table.GetIndex(from, to)] = ConversionData(m_rates.GetRate(from, to), 0, false);
+                    table.hasConversionData[table.GetIndex(from, to)] = true;
+                }
+            }
+            m_changedPositions.clear();
+            return true;
+        }
+
+        bool UpdateConversionTable(_Inout_ CategoryConversionTable& table, _Inout_ vector<size_t>& changedUnits) override
+        {
+            if (!m_isMatrixLoaded)
+            {
+                return false;
+            }
+
+            for (size_t position : m_changedPositions)
+            {
+                for (size_t other = 0; other < table.units.size(); other++)
+                {
+                    table.conversionData[table.GetIndex(position, other)] = ConversionData(m_rates.GetRate(position, other), 0, false);
+                    table.conversionData[table.GetIndex(other, position)] = ConversionData(m_rates.GetRate(other, position), 0, false);
+                }
+                changedUnits.push_back(position);
+            }
+            m_changedPositions.clear();
+            return true;
+        }
+
+        CurrencyRateMatrix& GetRates()
+        {
+            return m_rates;
+        }
+
+        const UnitToUnitToConversionDataMap& GetRatioMaps() const
+        {
+            return m_ratios;
+        }
+
+        const vector<Unit>& GetUnits() const
+        {
+            return m_units;
+        }
+
+    private:
+        bool m_isMatrixLoaded;
+        vector<Unit> m_units;
+        vector<Unit> m_staticUnits;
+        vector<double> m_currencyRatios;
+        CurrencyRateMatrix m_rates;
+        vector<size_t> m_changedPositions;
+        size_t m_refreshCount = 0;
+        UnitToUnitToConversionDataMap m_ratios;
+    };
+
+    class NullUnitConverterVMCallback final : public IUnitConverterVMCallback
+    {
+    public:
+        void DisplayCallback(const wstring& from, const wstring& to) override
+        {
+            DoNotOptimize(from.data());
+            DoNotOptimize(to.data());
+        }
+
+        void SuggestedValueCallback(const vector<tuple<wstring, Unit>>& suggestedValues) override
+        {
+            DoNotOptimize(suggestedValues.data());
+        }
+
+        void MaxDigitsReached() override
+        {
+        }
+    };
+
+    // A refresh of the rates while the user converts between two currencies, with a static category of 200 units also
+    // loaded, as the length and area categories are in the app
+    template <typename ApplyRefresh>
+    void RefreshRates(BenchmarkState& state, ApplyRefresh applyRefresh)
+    {
+        auto dataLoader = make_shared<CurrencyBenchmarkDataLoader>(true, 200);
+        auto converter = make_shared<UnitConverter>(dataLoader, dataLoader);
+        converter->SetViewModelCallback(make_shared<NullUnitConverterVMCallback>());
+
+        Category currency;
+        for (const Category& category : converter->GetCategories())
+        {
+            if (category.id == CURRENCY_CATEGORY_ID)
+            {
+                currency = category;
+            }
+        }
+
+        vector<Unit> units = get<0>(converter->SetCurrentCategory(currency));
+        converter->SetCurrentUnitTypes(units[0], units[37]);
+        converter->SendCommand(Command::Five);
+
+        size_t reloadCount = 0;
+        HeapSnapshot before = GetHeapSnapshot();
+        while (state.KeepRunning())
+        {
+            dataLoader->Refresh();
+            reloadCount += applyRefresh(*converter) ? 0 : 1;
+        }
+
+        HeapSnapshot after = GetHeapSnapshot();
+        state.SetItemsProcessed(state.Iterations());
+        state.SetCounter("allocations_per_refresh", static_cast<double>(after.totalAllocations - before.totalAllocations) / state.Iterations());
+        state.SetCounter("reloads", static_cast<double>(reloadCount));
+    }
+
+    // What the converter does once the currencies are loaded: it builds its table of the ratios between them
+    void LoadConversionTable(BenchmarkState& state, bool isMatrixLoaded)
+    {
+        auto dataLoader = make_shared<CurrencyBenchmarkDataLoader>(isMatrixLoaded);
+        auto converter = make_shared<UnitConverter>(dataLoader, dataLoader);
+
+        HeapSnapshot before = GetHeapSnapshot();
+        while (state.KeepRunning())
+        {
+            converter->ResetCategoriesAndRatios();
+        }
+
+        HeapSnapshot after = GetHeapSnapshot();
+        state.SetItemsProcessed(state.Iterations() * CURRENCY_COUNT * CURRENCY_COUNT);
+        state.SetCounter("currencies", static_cast<double>(CURRENCY_COUNT));
+        state.SetCounter("allocations_per_load", static_cast<double>(after.totalAllocations - before.totalAllocations) / state.Iterations());
+    }
+
+    // The rounded rate of every pair of currencies in turn, as shown when the user selects them
+    template <typename GetDisplayRate>
+    void SelectPairs(BenchmarkState& state, GetDisplayRate getDisplayRate)
+    {
+        size_t from = 0;
+        size_t to = 1;
+        double rateSum = 0;
+        HeapSnapshot before = GetHeapSnapshot();
+        while (state.KeepRunning())
+        {
+            rateSum += getDisplayRate(from, to);
+            to = (to + 1) % CURRENCY_COUNT;
+            from = to == 0 ? (from + 1) % CURRENCY_COUNT : from;
+        }
+
+        HeapSnapshot after = GetHeapSnapshot();
+        DoNotOptimize(&rateSum);
+        state.SetItemsProcessed(state.Iterations());
+        state.SetCounter("allocations_per_pair", static_cast<double>(after.totalAllocations - before.totalAllocations) / state.Iterations());
+    }
+}
+
+// As the view model applied a refresh: every category loaded again, then the conversion recalculated
+CALC_BENCHMARK(CurrencyRefresh_Reload)
+{
+    RefreshRates(state, [](UnitConverter& converter) {
+        converter.ResetCategoriesAndRatios();
+        converter.Calculate();
+        return false;
+    });
+}
+
+CALC_BENCHMARK(CurrencyRefresh_Delta)
+{
+    RefreshRates(state, [](UnitConverter& converter) { return converter.UpdateCurrencyRatios(); });
+}
+
+CALC_BENCHMARK(CurrencyConversionTableLoad_Maps)
+{
+    LoadConversionTable(state, false);
+}
+
+CALC_BENCHMARK(CurrencyConversionTableLoad_Matrix)
+{
+    LoadConversionTable(state, true);
+}
+
+// The ratios of a feed, then the rate of every pair, which the loader copies into the converter's table
+CALC_BENCHMARK(CurrencyRateMatrixBuild)
+{
+    const vector<double> ratios = MakeRatios();
+    CurrencyRateMatrix rates;
+    while (state.KeepRunning())
+    {
+        rates.Build(ratios);
+        double rateSum = 0;
+        for (size_t from = 0; from < CURRENCY_COUNT; from++)
+        {
+            for (size_t to = 0; to < CURRENCY_COUNT; to++)
+            {
+                rateSum += rates.GetRate(from, to);
+            }
+        }
+        DoNotOptimize(&rateSum);
+    }
+
+    state.SetItemsProcessed(state.Iterations() * CURRENCY_COUNT * CURRENCY_COUNT);
+}
+
+// As the loader found a pair: a copy of the map of the source currency, then the rate rounded for display
+CALC_BENCHMARK(CurrencyPairSelection_Map)
+{
+    CurrencyBenchmarkDataLoader dataLoader(false);
+    const UnitToUnitToConversionDataMap& ratioMaps = dataLoader.GetRatioMaps();
+    const vector<Unit>& units = dataLoader.GetUnits();
+    SelectPairs(state, [&](size_t from, size_t to) {
+        unordered_map<Unit, ConversionData, UnitHash> ratios = ratioMaps.find(units[from])->second;
+        return CurrencyRateMatrix::RoundRate(ratios.find(units[to])->second.ratio);
+    });
+}
+
+CALC_BENCHMARK(CurrencyPairSelection_Matrix)
+{
+    CurrencyBenchmarkDataLoader dataLoader(true);
+    CurrencyRateMatrix& rates = dataLoader.GetRates();
+    SelectPairs(state, [&](size_t from, size_t to) { return rates.GetDisplayRate(from, to); });
+}
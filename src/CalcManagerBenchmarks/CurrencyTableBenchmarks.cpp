@@ -0,0 +1,176 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+#include <vector>
+#include "AllocationCounter.h"
+#include "Benchmark.h"
+#include "CurrencyTable.h"
+
+using namespace std;
+using namespace UnitConversionManager;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    constexpr size_t FEED_CURRENCY_COUNT = 10000;
+
+    // Spreads the currencies over the codes, as 7 and CURRENCY_CODE_COUNT have no common factor
+    wstring GetCurrencyCode(size_t i)
+    {
+        return UnpackCurrencyCode(static_cast<uint32_t>(i * 7 % CURRENCY_CODE_COUNT));
+    }
+
+    // A metadata feed laid out as the service writes it, with one escaped name in every ten
+    wstring MakeStaticDataFeed()
+    {
+        wstring json = L"[";
+        for (size_t i = 0; i < FEED_CURRENCY_COUNT; i++)
+        {
+            const wstring number = to_wstring(i);
+            json += i == 0 ? L"" : L",";
+            json += L"{\"CountryCode\":\"C" + number + L"\",\"CountryName\":\"Country " + number + (i % 10 == 0 ? L" \\u00e9" : L"")
+                    + L"\",\"CurrencyCode\":\"" + GetCurrencyCode(i) + L"\",\"CurrencyName\":\"Currency " + number
+                    + L"\",\"CurrencySymbol\":\"$\"}";
+        }
+        return json + L"]";
+    }
+
+    wstring MakeRatiosFeed()
+    {
+        wstring json = L"[";
+        for (size_t i = 0; i < FEED_CURRENCY_COUNT; i++)
+        {
+            json += i == 0 ? L"" : L",";
+            json += L"{\"Rt\":" + to_wstring(1 + i / 7.0) + L",\"An\":\"" + GetCurrencyCode(i) + L"\"}";
+        }
+        return json + L"]";
+    }
+
+    // Parses the feed into a table that is cleared each time, as a refresh reuses the table of the last one
+    template <typename Parse>
+    void ParseFeed(BenchmarkState& state, const wstring& json, Parse parse)
+    {
+        CurrencyTable table;
+        bool isParsed = parse(table, json);
+
+        HeapSnapshot before = GetHeapSnapshot();
+        while (state.KeepRunning())
+        {
+            table.Clear();
+            isParsed = parse(table, json) && isParsed;
+        }
+
+        HeapSnapshot after = GetHeapSnapshot();
+        state.SetItemsProcessed(state.Iterations() * FEED_CURRENCY_COUNT);
+        state.SetBytesProcessed(state.Iterations() * json.size() * sizeof(wchar_t));
+        state.SetCounter("currencies", static_cast<double>(table.GetEntries().size()));
+        state.SetCounter(
+            "allocations_per_currency", static_cast<double>(after.totalAllocations - before.totalAllocations) / (state.Iterations() * FEED_CURRENCY_COUNT));
+        state.SetLabel(isParsed ? "" : "not parsed");
+    }
+}
+
+CALC_BENCHMARK(CurrencyTableParseStaticData)
+{
+    ParseFeed(state, MakeStaticDataFeed(), [](CurrencyTable& table, const wstring& json) { return table.ParseStaticData(json); });
+}
+
+CALC_BENCHMARK(CurrencyTableParseRatios)
+{
+    ParseFeed(state, MakeRatiosFeed(), [](CurrencyTable& table, const wstring& json) { return table.ParseRatios(json); });
+}
+
+// Both feeds, and a lookup of the ratio of every currency, as the loader does to build its units
+CALC_BENCHMARK(CurrencyTableParseAndFind)
+{
+    const wstring staticData = MakeStaticDataFeed();
+    const wstring ratios = MakeRatiosFeed();
+    double ratioSum = 0;
+    ParseFeed(state, ratios, [&](CurrencyTable& table, const wstring& json) {
+        bool isParsed = table.ParseStaticData(staticData) && table.ParseRatios(json);
+        for (size_t i = 0; i < FEED_CURRENCY_COUNT; i++)
+        {
+            const CurrencyTableEntry* entry = table.Find(static_cast<uint32_t>(i * 7 % CURRENCY_CODE_COUNT));
+            ratioSum += entry != nullptr ? entry->ratio : 0;
+        }
+        return isParsed;
+    });
+    DoNotOptimize(&ratioSum);
+}
+
+// What the loader does on a cold start from its cache: from the cached feeds, then from a snapshot of the table that
+// they were parsed into, up to the metadata and ratio of every currency
+CALC_BENCHMARK(CurrencyTableColdStart_Json)
+{
+    const wstring staticData = MakeStaticDataFeed();
+    const wstring ratios = MakeRatiosFeed();
+    double ratioSum = 0;
+    while (state.KeepRunning())
+    {
+        CurrencyTable table;
+        table.ParseStaticData(staticData);
+        table.ParseRatios(ratios);
+        table.RemoveIncomplete();
+        for (const CurrencyTableEntry& entry : table.GetEntries())
+        {
+            CurrencyStaticData currency = table.GetStaticData(entry);
+            DoNotOptimize(currency.countryName.data());
+            ratioSum += entry.ratio;
+        }
+    }
+
+    DoNotOptimize(&ratioSum);
+    state.SetItemsProcessed(state.Iterations() * FEED_CURRENCY_COUNT);
+}
+
+CALC_BENCHMARK(CurrencyTableColdStart_Snapshot)
+{
+    CurrencyTable table;
+    table.ParseStaticData(MakeStaticDataFeed());
+    table.ParseRatios(MakeRatiosFeed());
+    table.RemoveIncomplete();
+    vector<uint8_t> snapshotData(table.SaveSnapshot(nullptr, 0));
+    table.SaveSnapshot(snapshotData.data(), snapshotData.size());
+
+    double ratioSum = 0;
+    bool isOpened = true;
+    while (state.KeepRunning())
+    {
+        CurrencyTableSnapshot snapshot;
+        isOpened = snapshot.Open(snapshotData.data(), snapshotData.size()) && isOpened;
+        for (size_t i = 0; i < snapshot.GetCount(); i++)
+        {
+            CurrencyStaticData currency = snapshot.GetStaticData(i);
+            DoNotOptimize(currency.countryName.data());
+            ratioSum += snapshot.GetRatio(i);
+        }
+    }
+
+    DoNotOptimize(&ratioSum);
+    state.SetItemsProcessed(state.Iterations() * FEED_CURRENCY_COUNT);
+    state.SetCounter("snapshot_bytes", static_cast<double>(snapshotData.size()));
+    state.SetLabel(isOpened ? "" : "not opened");
+}
+
+// Finding a currency by its code in the snapshot, which searches the index in place
+CALC_BENCHMARK(CurrencyTableSnapshotFind)
+{
+    CurrencyTable table;
+    table.ParseRatios(MakeRatiosFeed());
+    vector<uint8_t> snapshotData(table.SaveSnapshot(nullptr, 0));
+    table.SaveSnapshot(snapshotData.data(), snapshotData.size());
+    CurrencyTableSnapshot snapshot;
+    snapshot.Open(snapshotData.data(), snapshotData.size());
+
+    size_t i = 0;
+    size_t positionSum = 0;
+    while (state.KeepRunning())
+    {
+        positionSum += snapshot.Find(static_cast<uint32_t>(i * 7 % CURRENCY_CODE_COUNT));
+        i = (i + 1) % FEED_CURRENCY_COUNT;
+    }
+
+    DoNotOptimize(&positionSum);
+    state.SetItemsProcessed(state.Iterations());
+}
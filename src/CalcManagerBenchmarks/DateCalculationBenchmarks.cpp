@@ -0,0 +1,142 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "Benchmark.h"
+#include "DateCalculation.h"
+
+using namespace std;
+using namespace CalcManager::DateCalculation;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    // Pairs of dates between 1601 and 9999, the range of the date calculator, that the batches are taken from in turn
+    constexpr size_t PAIR_COUNT = 1 << 20;
+    constexpr size_t BATCH_SIZE = 4096;
+    constexpr uint32_t ALL_UNITS = DATE_UNIT_YEAR | DATE_UNIT_MONTH | DATE_UNIT_WEEK | DATE_UNIT_DAY;
+
+    struct DatePairs
+    {
+        vector<int32_t> dates1;
+        vector<int32_t> dates2;
+    };
+
+    const DatePairs& GetDatePairs()
+    {
+        static const DatePairs pairs = [] {
+            DatePairs result;
+            mt19937 random(45);
+            uniform_int_distribution<int32_t> dates(DaysFromCivil({ 1601, 1, 1 }), DaysFromCivil({ MAX_YEAR, 12, 31 }));
+            for (size_t i = 0; i < PAIR_COUNT; i++)
+            {
+                result.dates1.push_back(dates(random));
+                result.dates2.push_back(dates(random));
+            }
+            return result;
+        }();
+        return pairs;
+    }
+
+    // The difference as the Windows date calculator finds it, adding one more of each unit to the date until it would
+    // pass the later one
+    DateDuration GetDateDifferenceByPivot(int32_t date1, int32_t date2, uint32_t units)
+    {
+        const int32_t start = date1 < date2 ? date1 : date2;
+        const int32_t end = date1 < date2 ? date2 : date1;
+
+        DateDuration difference{};
+        int32_t pivot = start;
+        int32_t next;
+        if ((units & DATE_UNIT_YEAR) != 0)
+        {
+            while (TryAddMonths(pivot, (difference.years + 1) * 12LL, next) && next <= end)
+            {
+                difference.years++;
+            }
+            TryAddMonths(pivot, difference.years * 12LL, pivot);
+        }
+        if ((units & DATE_UNIT_MONTH) != 0)
+        {
+            while (TryAddMonths(pivot, difference.months + 1LL, next) && next <= end)
+            {
+                difference.months++;
+            }
+            TryAddMonths(pivot, difference.months, pivot);
+        }
+        if ((units & DATE_UNIT_WEEK) != 0)
+        {
+            while (pivot + 7 <= end)
+            {
+                difference.weeks++;
+                pivot += 7;
+            }
+        }
+
+        difference.days = end - pivot;
+        return difference;
+    }
+
+    template <typename GetBatch>
+    void RunBatches(BenchmarkState& state, uint32_t units, GetBatch getBatch)
+    {
+        const DatePairs& pairs = GetDatePairs();
+        vector<DateDuration> differences(BATCH_SIZE);
+        size_t offset = 0;
+        while (state.KeepRunning())
+        {
+            getBatch(pairs.dates1.data() + offset, pairs.dates2.data() + offset, BATCH_SIZE, units, differences.data());
+            DoNotOptimize(differences.data());
+            offset = (offset + BATCH_SIZE) % PAIR_COUNT;
+        }
+
+        state.SetItemsProcessed(state.Iterations() * BATCH_SIZE);
+    }
+
+    void GetDifferencesByPivot(const int32_t* dates1, const int32_t* dates2, size_t count, uint32_t units, DateDuration* differences)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            differences[i] = GetDateDifferenceByPivot(dates1[i], dates2[i], units);
+        }
+    }
+}
+
+CALC_BENCHMARK(DateDifference_Arithmetic)
+{
+    RunBatches(state, ALL_UNITS, GetDateDifferences);
+}
+
+CALC_BENCHMARK(DateDifference_PivotLoop)
+{
+    RunBatches(state, ALL_UNITS, GetDifferencesByPivot);
+}
+
+// Only days, the first thing that the date calculator shows
+CALC_BENCHMARK(DateDifference_Days)
+{
+    RunBatches(state, DATE_UNIT_DAY, GetDateDifferences);
+}
+
+// A duration added to every date, as the date calculator does when adding to or subtracting from a date
+CALC_BENCHMARK(DateAddDuration)
+{
+    const DatePairs& pairs = GetDatePairs();
+    const DateDuration duration{ 3, 7, 0, 45 };
+    int64_t dateSum = 0;
+    size_t offset = 0;
+    while (state.KeepRunning())
+    {
+        for (size_t i = 0; i < BATCH_SIZE; i++)
+        {
+            int32_t result;
+            dateSum += TryAddDuration(pairs.dates1[offset + i], duration, result) ? result : 0;
+        }
+        offset = (offset + BATCH_SIZE) % PAIR_COUNT;
+    }
+
+    DoNotOptimize(&dateSum);
+    state.SetItemsProcessed(state.Iterations() * BATCH_SIZE);
+}
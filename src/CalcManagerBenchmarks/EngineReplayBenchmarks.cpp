@@ -0,0 +1,293 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <vector>
+#include "AllocationCounter.h"
+#include "Benchmark.h"
+#include "CalculatorManagerStubs.h"
+#include "Command.h"
+
+using namespace std;
+using namespace CalculationManager;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    // Enough latencies for stable percentiles, without the samples growing with the iterations
+    constexpr size_t MAX_LATENCY_SAMPLES = 1 << 20;
+
+    // A session as CalculatorManager records it in its saved commands: one byte per command, with the commands above
+    // UCHAR_MAX stored less UCHAR_MAX, and memory commands that take an index followed by it
+    class SessionRecorder
+    {
+    public:
+        SessionRecorder& Add(Command command)
+        {
+            unsigned int value = static_cast<unsigned int>(command);
+            m_session.push_back(static_cast<unsigned char>(value > UCHAR_MAX ? value - UCHAR_MAX : value));
+            return *this;
+        }
+
+        SessionRecorder& Add(std::initializer_list<Command> commands)
+        {
+            for (Command command : commands)
+            {
+                Add(command);
+            }
+            return *this;
+        }
+
+        SessionRecorder& AddMemory(MemoryCommand command, unsigned char indexOfMemory = 0)
+        {
+            m_session.push_back(static_cast<unsigned char>(static_cast<unsigned int>(command) - UCHAR_MAX));
+            if (command != MemoryCommand::MemorizeNumber && command != MemoryCommand::MemorizedNumberClearAll)
+            {
+                m_session.push_back(indexOfMemory);
+            }
+            return *this;
+        }
+
+        // Types the number digit by digit, as a user or a paste does
+        SessionRecorder& AddNumber(const char* number)
+        {
+            for (const char* digit = number; *digit != '\0'; digit++)
+            {
+                if (*digit == '.')
+                {
+                    Add(Command::CommandPNT);
+                }
+                else if (*digit >= 'A' && *digit <= 'F')
+                {
+                    Add(static_cast<Command>(static_cast<int>(Command::CommandA) + (*digit - 'A')));
+                }
+                else
+                {
+                    Add(static_cast<Command>(static_cast<int>(Command::Command0) + (*digit - '0')));
+                }
+            }
+            return *this;
+        }
+
+        vector<unsigned char> const& Session() const
+        {
+            return m_session;
+        }
+
+    private:
+        vector<unsigned char> m_session;
+    };
+
+    // Sends one recorded command, and returns the position of the next
+    size_t ReplayCommand(CalculatorManager& calculatorManager, vector<unsigned char> const& session, size_t position)
+    {
+        // As CalculatorManager::MapCommandForDeSerialize
+        unsigned int command = session[position];
+        if (command < static_cast<unsigned int>(Command::CommandSIGN))
+        {
+            command += UCHAR_MAX;
+        }
+
+        switch (static_cast<MemoryCommand>(command))
+        {
+        case MemoryCommand::MemorizeNumber:
+            calculatorManager.MemorizeNumber();
+            return position + 1;
+        case MemoryCommand::MemorizedNumberClearAll:
+            calculatorManager.MemorizedNumberClearAll();
+            return position + 1;
+        case MemoryCommand::MemorizedNumberLoad:
+            calculatorManager.MemorizedNumberLoad(session[position + 1]);
+            return position + 2;
+        case MemoryCommand::MemorizedNumberAdd:
+            calculatorManager.MemorizedNumberAdd(session[position + 1]);
+            return position + 2;
+        case MemoryCommand::MemorizedNumberSubtract:
+            calculatorManager.MemorizedNumberSubtract(session[position + 1]);
+            return position + 2;
+        case MemoryCommand::MemorizedNumberClear:
+            calculatorManager.MemorizedNumberClear(session[position + 1]);
+            return position + 2;
+        default:
+            calculatorManager.SendCommand(static_cast<Command>(command));
+            return position + 1;
+        }
+    }
+
+    double GetPercentile(vector<uint32_t>& latencies, double percentile)
+    {
+        if (latencies.empty())
+        {
+            return 0;
+        }
+
+        auto nth = latencies.begin() + static_cast<ptrdiff_t>(percentile * (latencies.size() - 1));
+        nth_element(latencies.begin(), nth, latencies.end());
+        return *nth;
+    }
+
+    // Replays the session through a CalculatorManager once per iteration, timing each command on its own. The session
+    // should end with a clear, so that every replay starts from the same state.
+    //
+    // Ratpack allocates its numbers with calloc, which the operator new of AllocationCounter doesn't see, so they are
+    // counted apart, by the Ratpack counters.
+    void ReplaySession(BenchmarkState& state, vector<unsigned char> const& session)
+    {
+        NullCalcDisplay display;
+        EnglishResourceProvider resourceProvider;
+        CalculatorManager calculatorManager(&display, &resourceProvider);
+
+        vector<uint32_t> latencies;
+        latencies.reserve(MAX_LATENCY_SAMPLES);
+        uint64_t commandCount = 0;
+        CalculatorManager::ResetRatpackCounters();
+        CalculatorManager::EnableRatpackCounters(true);
+        HeapSnapshot before = GetHeapSnapshot();
+        while (state.KeepRunning())
+        {
+            for (size_t position = 0; position < session.size();)
+            {
+                auto start = chrono::steady_clock::now();
+                position = ReplayCommand(calculatorManager, session, position);
+                auto latency = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
+                if (latencies.size() < MAX_LATENCY_SAMPLES)
+                {
+                    latencies.push_back(static_cast<uint32_t>(min<int64_t>(latency.count(), UINT32_MAX)));
+                }
+                commandCount++;
+            }
+        }
+
+        HeapSnapshot after = GetHeapSnapshot();
+        CalculatorManager::EnableRatpackCounters(false);
+        RATPACK_COUNTERS ratpackCounters = CalculatorManager::GetRatpackCounters();
+        state.SetItemsProcessed(commandCount);
+        state.SetCounter("commands_per_session", static_cast<double>(commandCount / state.Iterations()));
+        state.SetCounter("p50_ns", GetPercentile(latencies, 0.5));
+        state.SetCounter("p99_ns", GetPercentile(latencies, 0.99));
+        state.SetCounter("new_calls_per_command", static_cast<double>(after.totalAllocations - before.totalAllocations) / commandCount);
+        state.SetCounter(
+            "ratpack_allocations_per_command", static_cast<double>(ratpackCounters.numberAllocations + ratpackCounters.ratAllocations) / commandCount);
+    }
+
+    // Everyday arithmetic: a bill split, a percentage, and a running total kept in memory
+    vector<unsigned char> MakeStandardSession()
+    {
+        SessionRecorder recorder;
+        recorder.Add(Command::ModeBasic).AddMemory(MemoryCommand::MemorizedNumberClearAll);
+        for (int i = 0; i < 10; i++)
+        {
+            recorder.AddNumber("86.40").Add(Command::CommandADD).AddNumber("12.5").Add(Command::CommandPERCENT);
+            recorder.Add(Command::CommandDIV).AddNumber("3").Add(Command::CommandEQU).AddMemory(MemoryCommand::MemorizeNumber);
+            recorder.AddNumber("1250").Add(Command::CommandMUL).AddNumber("1.0725").Add(Command::CommandEQU);
+            recorder.AddMemory(MemoryCommand::MemorizedNumberAdd, 0).Add({ Command::CommandSQR, Command::CommandREC, Command::CommandBACK });
+            recorder.AddNumber("19").Add({ Command::CommandSIGN, Command::CommandSUB }).AddMemory(MemoryCommand::MemorizedNumberLoad, 0);
+            recorder.Add({ Command::CommandEQU, Command::CommandCENTR });
+        }
+        recorder.AddMemory(MemoryCommand::MemorizedNumberClearAll).Add(Command::CommandCLEAR);
+        return recorder.Session();
+    }
+
+    // Functions, powers and nested parentheses, which keep the engine's operand stacks busy
+    vector<unsigned char> MakeScientificSession()
+    {
+        SessionRecorder recorder;
+        recorder.Add({ Command::ModeScientific, Command::CommandDEG });
+        for (int i = 0; i < 10; i++)
+        {
+            recorder.Add({ Command::CommandOPENP, Command::CommandOPENP }).AddNumber("30").Add({ Command::CommandSIN, Command::CommandADD });
+            recorder.AddNumber("2").Add(Command::CommandPWR).AddNumber("0.5").Add({ Command::CommandCLOSEP, Command::CommandMUL });
+            recorder.AddNumber("1000").Add({ Command::CommandLOG, Command::CommandCLOSEP, Command::CommandDIV, Command::CommandPI });
+            recorder.Add(Command::CommandEQU).AddNumber("12").Add({ Command::CommandFAC, Command::CommandLN, Command::CommandSUB });
+            recorder.AddNumber("2.5").Add({ Command::CommandEXP }).AddNumber("3").Add({ Command::CommandSQRT, Command::CommandEQU });
+            recorder.Add({ Command::CommandRAD }).AddNumber("1.2").Add({ Command::CommandCOS, Command::CommandDEG, Command::CommandCLEAR });
+        }
+        return recorder.Session();
+    }
+
+    // Hexadecimal bit manipulation with radix changes, which reformat the value in every radix
+    vector<unsigned char> MakeProgrammerSession()
+    {
+        SessionRecorder recorder;
+        recorder.Add({ Command::ModeProgrammer, Command::CommandQword, Command::CommandHex });
+        for (int i = 0; i < 10; i++)
+        {
+            recorder.AddNumber("DEADBEEF").Add(Command::CommandAnd).AddNumber("FF00FF").Add(Command::CommandLSHF);
+            recorder.AddNumber("4").Add(Command::CommandXor).AddNumber("1234ABCD").Add({ Command::CommandEQU, Command::CommandCOM });
+            recorder.Add({ Command::CommandDec, Command::CommandADD }).AddNumber("65535").Add(Command::CommandMOD).AddNumber("97");
+            recorder.Add({ Command::CommandEQU, Command::CommandBin, Command::CommandRSHF }).AddNumber("101");
+            recorder.Add({ Command::CommandEQU, Command::CommandOct, Command::CommandHex, Command::CommandCLEAR });
+        }
+        return recorder.Session();
+    }
+
+    // A pasted column of numbers, sent as fast as the paste parser produces them
+    vector<unsigned char> MakePasteBurstSession()
+    {
+        SessionRecorder recorder;
+        recorder.Add(Command::ModeBasic);
+        for (int i = 0; i < 200; i++)
+        {
+            recorder.AddNumber(i % 2 == 0 ? "1234567.89" : "98765.4321").Add(Command::CommandADD);
+        }
+        recorder.AddNumber("1").Add({ Command::CommandEQU, Command::CommandCLEAR });
+        return recorder.Session();
+    }
+
+    // The saved commands of a scientific expression left unfinished, as CalculatorManager records them, finished and
+    // cleared so that each replay starts over
+    vector<unsigned char> MakeSavedCommandsSession()
+    {
+        NullCalcDisplay display;
+        EnglishResourceProvider resourceProvider;
+        CalculatorManager calculatorManager(&display, &resourceProvider);
+        calculatorManager.SetScientificMode();
+
+        vector<unsigned char> scientific = MakeScientificSession();
+        for (size_t position = 0; position < scientific.size();)
+        {
+            position = ReplayCommand(calculatorManager, scientific, position);
+        }
+
+        SessionRecorder expression;
+        expression.Add({ Command::ModeScientific, Command::CommandOPENP }).AddNumber("45").Add({ Command::CommandTAN, Command::CommandADD });
+        expression.AddNumber("6").Add({ Command::CommandCUB, Command::CommandCLOSEP, Command::CommandMUL }).AddNumber("7.25");
+        for (size_t position = 0; position < expression.Session().size();)
+        {
+            position = ReplayCommand(calculatorManager, expression.Session(), position);
+        }
+
+        vector<unsigned char> session = calculatorManager.GetSavedCommands();
+        SessionRecorder ending;
+        ending.Add({ Command::CommandEQU, Command::CommandCLEAR });
+        session.insert(session.end(), ending.Session().begin(), ending.Session().end());
+        return session;
+    }
+}
+
+CALC_BENCHMARK(EngineReplay_Standard)
+{
+    ReplaySession(state, MakeStandardSession());
+}
+
+CALC_BENCHMARK(EngineReplay_Scientific)
+{
+    ReplaySession(state, MakeScientificSession());
+}
+
+CALC_BENCHMARK(EngineReplay_Programmer)
+{
+    ReplaySession(state, MakeProgrammerSession());
+}
+
+CALC_BENCHMARK(EngineReplay_PasteBurst)
+{
+    ReplaySession(state, MakePasteBurstSession());
+}
+
+CALC_BENCHMARK(EngineReplay_SavedCommands)
+{
+    ReplaySession(state, MakeSavedCommandsSession());
+}
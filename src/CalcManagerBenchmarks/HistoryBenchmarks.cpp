@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Benchmark.h"
+#include "CalculatorManagerStubs.h"
+#include "Command.h"
+
+using namespace std;
+using namespace CalculationManager;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    // Enters an expression of operandCount operands like "123456789 + 123456789 + ..." in programmer mode, then
+    // switches the radix back and forth, which reformats every operand of the expression.
+    void SwitchRadixWithLongExpression(BenchmarkState& state, unsigned int operandCount)
+    {
+        constexpr Command digits[] = { Command::Command1, Command::Command2, Command::Command3, Command::Command4, Command::Command5,
+                                       Command::Command6, Command::Command7, Command::Command8, Command::Command9 };
+        constexpr RADIX_TYPE radixes[] = { HEX_RADIX, DEC_RADIX, OCT_RADIX, BIN_RADIX };
+
+        NullCalcDisplay display;
+        EnglishResourceProvider resourceProvider;
+        CalculatorManager calculatorManager(&display, &resourceProvider);
+        calculatorManager.SetProgrammerMode();
+        for (unsigned int i = 0; i < operandCount; i++)
+        {
+            for (Command digit : digits)
+            {
+                calculatorManager.SendCommand(digit);
+            }
+
+            calculatorManager.SendCommand(Command::CommandADD);
+        }
+
+        size_t radixIndex = 0;
+        while (state.KeepRunning())
+        {
+            calculatorManager.SetRadix(radixes[radixIndex]);
+            radixIndex = (radixIndex + 1) % size(radixes);
+        }
+
+        state.SetItemsProcessed(state.Iterations() * operandCount);
+    }
+}
+
+CALC_BENCHMARK(HistoryRadixSwitch_16Operands)
+{
+    SwitchRadixWithLongExpression(state, 16);
+}
+
+CALC_BENCHMARK(HistoryRadixSwitch_256Operands)
+{
+    SwitchRadixWithLongExpression(state, 256);
+}
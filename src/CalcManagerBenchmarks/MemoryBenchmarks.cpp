@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Benchmark.h"
+#include "CalculatorManagerStubs.h"
+#include "Command.h"
+
+using namespace std;
+using namespace CalculationManager;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    // Fills the memory with 100 numbers like 1234.5678 in scientific mode.
+    void FillMemory(CalculatorManager& calculatorManager)
+    {
+        constexpr Command digits[] = { Command::Command1, Command::Command2, Command::Command3, Command::Command4, Command::CommandPNT,
+                                       Command::Command5, Command::Command6, Command::Command7, Command::Command8 };
+
+        calculatorManager.SetScientificMode();
+        for (int i = 0; i < 100; i++)
+        {
+            for (Command digit : digits)
+            {
+                calculatorManager.SendCommand(digit);
+            }
+
+            calculatorManager.MemorizeNumber();
+        }
+    }
+}
+
+// MS with a full memory, which also drops the oldest number.
+CALC_BENCHMARK(MemoryStore_FullMemory)
+{
+    NullCalcDisplay display;
+    EnglishResourceProvider resourceProvider;
+    CalculatorManager calculatorManager(&display, &resourceProvider);
+    FillMemory(calculatorManager);
+
+    while (state.KeepRunning())
+    {
+        calculatorManager.MemorizeNumber();
+    }
+
+    state.SetItemsProcessed(state.Iterations());
+}
+
+// M+ on one number of a full memory.
+CALC_BENCHMARK(MemoryAdd_FullMemory)
+{
+    NullCalcDisplay display;
+    EnglishResourceProvider resourceProvider;
+    CalculatorManager calculatorManager(&display, &resourceProvider);
+    FillMemory(calculatorManager);
+
+    while (state.KeepRunning())
+    {
+        calculatorManager.MemorizedNumberAdd(50);
+    }
+
+    state.SetItemsProcessed(state.Iterations());
+}
@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "AllocationCounter.h"
+#include "Benchmark.h"
+#include "NumberFormattingUtils.h"
+
+using namespace std;
+using namespace CalcManager::NumberFormattingUtils;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    // Values like the ones the unit converter shows, from suggestions of a few digits to 15 digit results
+    vector<double> MakeValues()
+    {
+        vector<double> values;
+        for (int i = 0; i < 64; i++)
+        {
+            values.push_back(pow(-1.7, i % 32) * (1 + i / 7.0) / 3);
+        }
+        return values;
+    }
+
+    // Formats every value with the converter's precisions: 2 decimals for suggestions and 15 for the result
+    template <typename Format>
+    void FormatValues(BenchmarkState& state, Format format)
+    {
+        const vector<double> values = MakeValues();
+        size_t length = 0;
+        HeapSnapshot before = GetHeapSnapshot();
+        while (state.KeepRunning())
+        {
+            for (double value : values)
+            {
+                length += format(value);
+            }
+        }
+
+        HeapSnapshot after = GetHeapSnapshot();
+        DoNotOptimize(&length);
+        state.SetItemsProcessed(state.Iterations() * values.size());
+        state.SetCounter(
+            "allocations_per_value", static_cast<double>(after.totalAllocations - before.totalAllocations) / (state.Iterations() * values.size()));
+    }
+
+    int GetPrecision(double value)
+    {
+        return abs(value) < 100 ? 2 : 15;
+    }
+}
+
+CALC_BENCHMARK(NumberFormattingRoundSignificantDigits_Stream)
+{
+    FormatValues(state, [](double value) {
+        wstring result = RoundSignificantDigits(value, GetPrecision(value));
+        TrimTrailingZeros(result);
+        return result.size();
+    });
+}
+
+CALC_BENCHMARK(NumberFormattingRoundSignificantDigits_Buffer)
+{
+    FormatValues(state, [](double value) {
+        wchar_t buffer[64];
+        size_t length = RoundSignificantDigits(value, GetPrecision(value), buffer, size(buffer));
+        DoNotOptimize(buffer);
+        return GetLengthWithoutTrailingZeros(wstring_view(buffer, length));
+    });
+}
+
+CALC_BENCHMARK(NumberFormattingToScientificNumber_Stream)
+{
+    FormatValues(state, [](double value) {
+        wstring result = ToScientificNumber(value);
+        return result.size();
+    });
+}
+
+CALC_BENCHMARK(NumberFormattingToScientificNumber_Buffer)
+{
+    FormatValues(state, [](double value) {
+        wchar_t buffer[64];
+        size_t length = ToScientificNumber(value, buffer, size(buffer));
+        DoNotOptimize(buffer);
+        return length;
+    });
+}
+
+// The number of digits the user typed, which the converter counts on every keystroke
+CALC_BENCHMARK(NumberFormattingGetNumberDigits)
+{
+    const wstring display = L"1234.567800";
+    unsigned int digits = 0;
+    HeapSnapshot before = GetHeapSnapshot();
+    while (state.KeepRunning())
+    {
+        digits += GetNumberDigits(display);
+    }
+
+    HeapSnapshot after = GetHeapSnapshot();
+    DoNotOptimize(&digits);
+    state.SetItemsProcessed(state.Iterations());
+    state.SetCounter("allocations_per_value", static_cast<double>(after.totalAllocations - before.totalAllocations) / state.Iterations());
+}
@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <sstream>
+#include <string>
+#include "Benchmark.h"
+#include "CalculatorManagerStubs.h"
+#include "Command.h"
+#include "PasteCommandStream.h"
+
+using namespace std;
+using namespace CalculationManager;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    // CopyPasteManager::MaxStandardOperandLength
+    constexpr PasteOperandLimits STANDARD_OPERAND_LIMITS = { 16, 0 };
+
+    // Builds a sum like "1+2+3+...", about the given number of characters long.
+    wstring MakeSumPaste(size_t length)
+    {
+        wstring expression;
+        for (unsigned int i = 1; expression.size() < length; i++)
+        {
+            if (!expression.empty())
+            {
+                expression += L'+';
+            }
+
+            expression += to_wstring(i % 1000);
+        }
+
+        return expression + L'=';
+    }
+
+    void PasteSum(BenchmarkState& state, size_t length)
+    {
+        NullCalcDisplay display;
+        EnglishResourceProvider resourceProvider;
+        CalculatorManager calculatorManager(&display, &resourceProvider);
+        calculatorManager.SetStandardMode();
+        const wstring expression = MakeSumPaste(length);
+
+        while (state.KeepRunning())
+        {
+            state.PauseTiming();
+            calculatorManager.SendCommand(Command::CommandCLEAR);
+            wistringstream input(expression);
+            state.ResumeTiming();
+
+            PasteCommandStream stream(calculatorManager, PasteGrammar::Standard, DEC_RADIX, STANDARD_OPERAND_LIMITS);
+            bool isValid = stream.Paste(input);
+            DoNotOptimize(isValid);
+        }
+
+        state.SetBytesProcessed(state.Iterations() * expression.size() * sizeof(wchar_t));
+        state.SetLabel(string(display.PrimaryDisplay().begin(), display.PrimaryDisplay().end()));
+    }
+}
+
+CALC_BENCHMARK(PasteStreamStandardSum_4KB)
+{
+    PasteSum(state, 4 * 1024);
+}
+
+CALC_BENCHMARK(PasteStreamStandardSum_1MB)
+{
+    PasteSum(state, 1024 * 1024);
+}
@@ -0,0 +1,172 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <regex>
+#include <string>
+#include "Benchmark.h"
+#include "PasteExpressionParser.h"
+
+using namespace std;
+using namespace CalculationManager;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    constexpr size_t c_noOperandLimit = numeric_limits<size_t>::max();
+
+    // Builds an expression of roughly the given length, like "12.5+(3e4*-7)/0.25-...".
+    wstring MakeScientificPaste(size_t length)
+    {
+        constexpr wchar_t operators[] = { L'+', L'-', L'*', L'/' };
+        mt19937 generator(1);
+        uniform_int_distribution<int> digitDistribution(0, 9);
+        uniform_int_distribution<int> shapeDistribution(0, 3);
+
+        wstring expression;
+        while (expression.size() < length)
+        {
+            if (!expression.empty())
+            {
+                expression += operators[shapeDistribution(generator)];
+            }
+
+            int shape = shapeDistribution(generator);
+            if (shape == 0)
+            {
+                expression += L'(';
+            }
+
+            for (int i = 0; i < 6; i++)
+            {
+                expression += static_cast<wchar_t>(L'0' + digitDistribution(generator));
+            }
+
+            if (shape == 1)
+            {
+                expression += L".25";
+            }
+            else if (shape == 2)
+            {
+                expression += L"e12";
+            }
+            else if (shape == 0)
+            {
+                expression += L')';
+            }
+        }
+
+        return expression;
+    }
+
+    // Builds a hexadecimal programmer expression of roughly the given length, like "0xFF_A0ull+1234h*...".
+    wstring MakeProgrammerPaste(size_t length)
+    {
+        constexpr wstring_view operands[] = { L"0xFF_A0ull", L"1234h", L"(DEAD'BEEF)", L"7fu", L"0X1`2`3" };
+        constexpr wchar_t operators[] = { L'+', L'-', L'*', L'/' };
+
+        wstring expression;
+        for (size_t i = 0; expression.size() < length; i++)
+        {
+            if (!expression.empty())
+            {
+                expression += operators[i % size(operators)];
+            }
+
+            expression += operands[i % size(operands)];
+        }
+
+        return expression;
+    }
+
+    void ValidatePaste(BenchmarkState& state, wstring const& expression, PasteGrammar grammar, RADIX_TYPE radix)
+    {
+        vector<wstring_view> operands;
+        while (state.KeepRunning())
+        {
+            auto result = PasteExpressionParser::ExtractOperands(expression, grammar, c_noOperandLimit, c_noOperandLimit, operands);
+            bool isValid = result == ExtractOperandsResult::Success;
+            for (const auto& operand : operands)
+            {
+                isValid = isValid && PasteExpressionParser::IsValidOperand(operand, grammar, radix);
+            }
+
+            DoNotOptimize(isValid);
+        }
+
+        state.SetItemsProcessed(state.Iterations() * operands.size());
+        state.SetBytesProcessed(state.Iterations() * expression.size() * sizeof(wchar_t));
+    }
+
+    // The std::regex based validation that PasteExpressionParser replaced, kept as a baseline.
+    void ValidatePasteWithRegex(BenchmarkState& state, wstring const& expression, PasteGrammar grammar, vector<wregex> const& patterns)
+    {
+        vector<wstring_view> operands;
+        while (state.KeepRunning())
+        {
+            auto result = PasteExpressionParser::ExtractOperands(expression, grammar, c_noOperandLimit, c_noOperandLimit, operands);
+            bool isValid = result == ExtractOperandsResult::Success;
+            for (const auto& operand : operands)
+            {
+                // Each operand only needs to match one of the patterns.
+                isValid = isValid && any_of(patterns.begin(), patterns.end(), [&operand](wregex const& pattern) {
+                              return regex_match(operand.begin(), operand.end(), pattern);
+                          });
+            }
+
+            DoNotOptimize(isValid);
+        }
+
+        state.SetItemsProcessed(state.Iterations() * operands.size());
+        state.SetBytesProcessed(state.Iterations() * expression.size() * sizeof(wchar_t));
+    }
+
+    vector<wregex> const& ScientificRegexes()
+    {
+        static const vector<wregex> s_patterns{ wregex(
+            L"([\\s\\x85]*[-+]?)|([\\s\\x85]*([-+]?[(])*[\\s\\x85]*)(?:[-+]?(?:\\d+(\\.\\d*)?|\\.\\d+))(?:e[+-]?\\d+)?[\\s\\x85]*[)]*[\\s\\x85]*") };
+        return s_patterns;
+    }
+
+    vector<wregex> const& ProgrammerHexRegexes()
+    {
+        static const vector<wregex> s_patterns{
+            wregex(L"[\\s\\x85]*[(]*[\\s\\x85]*(0[xX])?([a-f]|[A-F]|\\d)+((_|'|`)([a-f]|[A-F]|\\d)+)*[uU]?[lL]{0,2}[\\s\\x85]*[)]*[\\s\\x85]*"),
+            wregex(L"[\\s\\x85]*[(]*[\\s\\x85]*([a-f]|[A-F]|\\d)+((_|'|`)([a-f]|[A-F]|\\d)+)*[hH]?[\\s\\x85]*[)]*[\\s\\x85]*")
+        };
+        return s_patterns;
+    }
+}
+
+CALC_BENCHMARK(PasteScientific_4KB)
+{
+    ValidatePaste(state, MakeScientificPaste(4 * 1024), PasteGrammar::Scientific, DEC_RADIX);
+}
+
+CALC_BENCHMARK(PasteScientific_64KB)
+{
+    ValidatePaste(state, MakeScientificPaste(64 * 1024), PasteGrammar::Scientific, DEC_RADIX);
+}
+
+CALC_BENCHMARK(PasteScientificRegexBaseline_4KB)
+{
+    ValidatePasteWithRegex(state, MakeScientificPaste(4 * 1024), PasteGrammar::Scientific, ScientificRegexes());
+}
+
+CALC_BENCHMARK(PasteProgrammerHex_4KB)
+{
+    ValidatePaste(state, MakeProgrammerPaste(4 * 1024), PasteGrammar::Programmer, HEX_RADIX);
+}
+
+CALC_BENCHMARK(PasteProgrammerHex_64KB)
+{
+    ValidatePaste(state, MakeProgrammerPaste(64 * 1024), PasteGrammar::Programmer, HEX_RADIX);
+}
+
+CALC_BENCHMARK(PasteProgrammerHexRegexBaseline_4KB)
+{
+    ValidatePasteWithRegex(state, MakeProgrammerPaste(4 * 1024), PasteGrammar::Programmer, ProgrammerHexRegexes());
+}
@@ -0,0 +1,325 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+#include "Benchmark.h"
+#include "Ratpack/ratpak.h"
+
+using namespace std;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    constexpr uint32_t DECIMAL_RADIX = 10;
+
+    // The precision of the standard and scientific modes, and a much larger one that shows how the costs grow
+    constexpr int32_t CALCULATOR_PRECISION = 32;
+    constexpr int32_t LARGE_PRECISION = 128;
+
+    // A number with the given count of significant digits, half of them after the decimal point, so that its
+    // denominator is a power of 10 as for a number that was typed in
+    PRAT MakeRat(size_t digits, uint32_t seed, int32_t precision)
+    {
+        wstring mantissa;
+        for (size_t i = 0; i < digits; i++)
+        {
+            if (i == (digits + 1) / 2)
+            {
+                mantissa += L'.';
+            }
+            mantissa += static_cast<wchar_t>(L'1' + (i * 7 + seed) % 9);
+        }
+        return StringToRat(false, mantissa, false, L"", DECIMAL_RADIX, precision);
+    }
+
+    // An integer with the given count of digits
+    PRAT MakeIntegerRat(size_t digits, uint32_t seed, int32_t precision)
+    {
+        wstring mantissa;
+        for (size_t i = 0; i < digits; i++)
+        {
+            mantissa += static_cast<wchar_t>(L'1' + (i * 5 + seed) % 9);
+        }
+        return StringToRat(false, mantissa, false, L"", DECIMAL_RADIX, precision);
+    }
+
+    // Runs operation on a copy of x each iteration, as the engine does to keep its operands. The copy is part of the
+    // measurement, and is much cheaper than any of the operations.
+    template <typename Operation>
+    void RunOnCopy(BenchmarkState& state, PRAT x, int32_t precision, Operation operation)
+    {
+        PRAT result = nullptr;
+        while (state.KeepRunning())
+        {
+            DUPRAT(result, x);
+            operation(&result, precision);
+            DoNotOptimize(result);
+        }
+
+        state.SetItemsProcessed(state.Iterations());
+        state.SetCounter("precision", precision);
+        destroyrat(result);
+        destroyrat(x);
+    }
+
+    template <typename Operation>
+    void RunUnary(BenchmarkState& state, size_t digits, int32_t precision, Operation operation)
+    {
+        ChangeConstants(DECIMAL_RADIX, precision);
+        RunOnCopy(state, MakeRat(digits, 1, precision), precision, operation);
+    }
+
+    template <typename Operation>
+    void RunBinary(BenchmarkState& state, size_t digits, int32_t precision, Operation operation)
+    {
+        ChangeConstants(DECIMAL_RADIX, precision);
+        PRAT y = MakeRat(digits, 4, precision);
+        RunOnCopy(state, MakeRat(digits, 1, precision), precision, [&](PRAT* px, int32_t precision) { operation(px, y, precision); });
+        destroyrat(y);
+    }
+
+    void RunAdd(BenchmarkState& state, size_t digits, int32_t precision)
+    {
+        RunBinary(state, digits, precision, [](PRAT* px, PRAT y, int32_t precision) { addrat(px, y, precision); });
+    }
+
+    void RunMultiply(BenchmarkState& state, size_t digits, int32_t precision)
+    {
+        RunBinary(state, digits, precision, [](PRAT* px, PRAT y, int32_t precision) { mulrat(px, y, precision); });
+    }
+
+    void RunDivide(BenchmarkState& state, size_t digits, int32_t precision)
+    {
+        RunBinary(state, digits, precision, [](PRAT* px, PRAT y, int32_t precision) { divrat(px, y, precision); });
+    }
+
+    void RunGcd(BenchmarkState& state, size_t digits, int32_t precision)
+    {
+        ChangeConstants(DECIMAL_RADIX, precision);
+        PRAT a = MakeIntegerRat(digits, 1, precision);
+        PRAT b = MakeIntegerRat(digits, 4, precision);
+        while (state.KeepRunning())
+        {
+            PNUMBER divisor = gcd(a->pp, b->pp);
+            DoNotOptimize(divisor);
+            destroynum(divisor);
+        }
+
+        state.SetItemsProcessed(state.Iterations());
+        destroyrat(b);
+        destroyrat(a);
+    }
+
+    void RunToString(BenchmarkState& state, size_t digits, int32_t precision)
+    {
+        ChangeConstants(DECIMAL_RADIX, precision);
+        PRAT x = MakeRat(digits, 1, precision);
+        size_t length = 0;
+        while (state.KeepRunning())
+        {
+            length += RatToString(x, FMT_FLOAT, DECIMAL_RADIX, precision).size();
+        }
+
+        DoNotOptimize(&length);
+        state.SetItemsProcessed(state.Iterations());
+        destroyrat(x);
+    }
+
+    void RunFromString(BenchmarkState& state, size_t digits, int32_t precision)
+    {
+        ChangeConstants(DECIMAL_RADIX, precision);
+        wstring mantissa;
+        for (size_t i = 0; i < digits; i++)
+        {
+            mantissa += static_cast<wchar_t>(L'1' + i % 9);
+        }
+        mantissa.insert((digits + 1) / 2, 1, L'.');
+
+        while (state.KeepRunning())
+        {
+            PRAT x = StringToRat(false, mantissa, false, L"", DECIMAL_RADIX, precision);
+            DoNotOptimize(x);
+            destroyrat(x);
+        }
+
+        state.SetItemsProcessed(state.Iterations());
+        state.SetBytesProcessed(state.Iterations() * mantissa.size() * sizeof(wchar_t));
+    }
+}
+
+CALC_BENCHMARK(RatpackAddRat_Digits8)
+{
+    RunAdd(state, 8, CALCULATOR_PRECISION);
+}
+
+CALC_BENCHMARK(RatpackAddRat_Digits32)
+{
+    RunAdd(state, 32, CALCULATOR_PRECISION);
+}
+
+CALC_BENCHMARK(RatpackAddRat_Digits128_Precision128)
+{
+    RunAdd(state, 128, LARGE_PRECISION);
+}
+
+CALC_BENCHMARK(RatpackMulRat_Digits8)
+{
+    RunMultiply(state, 8, CALCULATOR_PRECISION);
+}
+
+CALC_BENCHMARK(RatpackMulRat_Digits32)
+{
+    RunMultiply(state, 32, CALCULATOR_PRECISION);
+}
+
+CALC_BENCHMARK(RatpackMulRat_Digits128_Precision128)
+{
+    RunMultiply(state, 128, LARGE_PRECISION);
+}
+
+CALC_BENCHMARK(RatpackDivRat_Digits8)
+{
+    RunDivide(state, 8, CALCULATOR_PRECISION);
+}
+
+CALC_BENCHMARK(RatpackDivRat_Digits32)
+{
+    RunDivide(state, 32, CALCULATOR_PRECISION);
+}
+
+CALC_BENCHMARK(RatpackDivRat_Digits128_Precision128)
+{
+    RunDivide(state, 128, LARGE_PRECISION);
+}
+
+CALC_BENCHMARK(RatpackGcd_Digits8)
+{
+    RunGcd(state, 8, CALCULATOR_PRECISION);
+}
+
+CALC_BENCHMARK(RatpackGcd_Digits32)
+{
+    RunGcd(state, 32, CALCULATOR_PRECISION);
+}
+
+CALC_BENCHMARK(RatpackGcd_Digits128_Precision128)
+{
+    RunGcd(state, 128, LARGE_PRECISION);
+}
+
+CALC_BENCHMARK(RatpackRatToString_Digits8)
+{
+    RunToString(state, 8, CALCULATOR_PRECISION);
+}
+
+CALC_BENCHMARK(RatpackRatToString_Digits32)
+{
+    RunToString(state, 32, CALCULATOR_PRECISION);
+}
+
+CALC_BENCHMARK(RatpackRatToString_Digits128_Precision128)
+{
+    RunToString(state, 128, LARGE_PRECISION);
+}
+
+CALC_BENCHMARK(RatpackStringToRat_Digits8)
+{
+    RunFromString(state, 8, CALCULATOR_PRECISION);
+}
+
+CALC_BENCHMARK(RatpackStringToRat_Digits32)
+{
+    RunFromString(state, 32, CALCULATOR_PRECISION);
+}
+
+CALC_BENCHMARK(RatpackStringToRat_Digits128_Precision128)
+{
+    RunFromString(state, 128, LARGE_PRECISION);
+}
+
+// The transcendental functions of the scientific mode, on a typed-in value of a few digits
+CALC_BENCHMARK(RatpackExpRat)
+{
+    RunUnary(state, 4, CALCULATOR_PRECISION, [](PRAT* px, int32_t precision) { exprat(px, DECIMAL_RADIX, precision); });
+}
+
+CALC_BENCHMARK(RatpackExpRat_Precision128)
+{
+    RunUnary(state, 4, LARGE_PRECISION, [](PRAT* px, int32_t precision) { exprat(px, DECIMAL_RADIX, precision); });
+}
+
+CALC_BENCHMARK(RatpackLogRat)
+{
+    RunUnary(state, 8, CALCULATOR_PRECISION, [](PRAT* px, int32_t precision) { lograt(px, precision); });
+}
+
+CALC_BENCHMARK(RatpackLogRat_Precision128)
+{
+    RunUnary(state, 8, LARGE_PRECISION, [](PRAT* px, int32_t precision) { lograt(px, precision); });
+}
+
+CALC_BENCHMARK(RatpackSinAngleRat_Radians)
+{
+    RunUnary(state, 4, CALCULATOR_PRECISION, [](PRAT* px, int32_t precision) { sinanglerat(px, ANGLE_RAD, DECIMAL_RADIX, precision); });
+}
+
+CALC_BENCHMARK(RatpackSinAngleRat_Degrees)
+{
+    RunUnary(state, 4, CALCULATOR_PRECISION, [](PRAT* px, int32_t precision) { sinanglerat(px, ANGLE_DEG, DECIMAL_RADIX, precision); });
+}
+
+CALC_BENCHMARK(RatpackSinAngleRat_Precision128)
+{
+    RunUnary(state, 4, LARGE_PRECISION, [](PRAT* px, int32_t precision) { sinanglerat(px, ANGLE_RAD, DECIMAL_RADIX, precision); });
+}
+
+// A fractional power, which goes through exp and log, and an integer one, which multiplies
+CALC_BENCHMARK(RatpackPowRat_Fraction)
+{
+    RunBinary(state, 4, CALCULATOR_PRECISION, [](PRAT* px, PRAT y, int32_t precision) { powrat(px, y, DECIMAL_RADIX, precision); });
+}
+
+CALC_BENCHMARK(RatpackPowRat_Integer)
+{
+    ChangeConstants(DECIMAL_RADIX, CALCULATOR_PRECISION);
+    PRAT y = i32torat(17);
+    RunOnCopy(state, MakeRat(4, 1, CALCULATOR_PRECISION), CALCULATOR_PRECISION, [&](PRAT* px, int32_t precision) {
+        powrat(px, y, DECIMAL_RADIX, precision);
+    });
+    destroyrat(y);
+}
+
+CALC_BENCHMARK(RatpackPowRat_Precision128)
+{
+    RunBinary(state, 4, LARGE_PRECISION, [](PRAT* px, PRAT y, int32_t precision) { powrat(px, y, DECIMAL_RADIX, precision); });
+}
+
+// 100!, a product of integers, and the factorial of a fraction, which is a gamma function
+CALC_BENCHMARK(RatpackFactRat_Integer)
+{
+    ChangeConstants(DECIMAL_RADIX, CALCULATOR_PRECISION);
+    RunOnCopy(state, i32torat(100), CALCULATOR_PRECISION, [](PRAT* px, int32_t precision) { factrat(px, DECIMAL_RADIX, precision); });
+}
+
+CALC_BENCHMARK(RatpackFactRat_Fraction)
+{
+    RunUnary(state, 2, CALCULATOR_PRECISION, [](PRAT* px, int32_t precision) { factrat(px, DECIMAL_RADIX, precision); });
+}
+
+CALC_BENCHMARK(RatpackFactRat_Precision128)
+{
+    RunUnary(state, 2, LARGE_PRECISION, [](PRAT* px, int32_t precision) { factrat(px, DECIMAL_RADIX, precision); });
+}
+
+// Switching between the scientific and programmer modes, which only recalculates the constants that depend on the
+// radix once the larger precision has been reached
+CALC_BENCHMARK(RatpackChangeConstants_SwitchMode)
+{
+    while (state.KeepRunning())
+    {
+        ChangeConstants(16, 64);
+        ChangeConstants(DECIMAL_RADIX, CALCULATOR_PRECISION);
+    }
+
+    state.SetItemsProcessed(state.Iterations() * 2);
+}
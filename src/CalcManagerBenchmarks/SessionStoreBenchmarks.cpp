@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AllocationCounter.h"
+#include "Benchmark.h"
+#include "CalculatorManagerStubs.h"
+#include "CalculatorSessionStore.h"
+#include "Command.h"
+
+using namespace std;
+using namespace CalculationManager;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    constexpr int SESSION_COUNT = 1000;
+    constexpr size_t LIVE_SESSION_COUNT = 16;
+
+    // Fewer sessions for measuring the heap, since it makes every CalculatorManager again
+    constexpr int HEAP_SESSION_COUNT = 100;
+
+    filesystem::path GetSessionFilePath(wchar_t const* name)
+    {
+        return filesystem::temp_directory_path() / (wstring(L"CalcManagerBenchmarks-") + name + L".sessions");
+    }
+
+    // A session with a result in history and memory, left in the middle of "9 + 8"
+    void MakeSession(CalculatorManager& calculatorManager)
+    {
+        calculatorManager.SetScientificMode();
+        for (Command command : { Command::Command7, Command::CommandMUL, Command::Command3, Command::CommandEQU })
+        {
+            calculatorManager.SendCommand(command);
+        }
+        calculatorManager.MemorizeNumber();
+        for (Command command : { Command::Command9, Command::CommandADD, Command::Command8 })
+        {
+            calculatorManager.SendCommand(command);
+        }
+    }
+
+    void MakeSessions(CalculatorSessionStore& store, int sessionCount)
+    {
+        for (int i = 0; i < sessionCount; i++)
+        {
+            MakeSession(*store.GetSession(i));
+        }
+    }
+}
+
+// Visits every session in turn, so that each visit restores a session and saves the least recently used one
+CALC_BENCHMARK(SessionStoreSwitch_RoundRobin)
+{
+    NullCalcDisplay display;
+    EnglishResourceProvider resourceProvider;
+    filesystem::path path = GetSessionFilePath(L"RoundRobin");
+    filesystem::remove(path);
+
+    CalculatorSessionStore store(&display, &resourceProvider, LIVE_SESSION_COUNT);
+    store.Open(path);
+    MakeSessions(store, SESSION_COUNT);
+
+    uint64_t sessionId = 0;
+    while (state.KeepRunning())
+    {
+        CalculatorManager* calculatorManager = store.GetSession(sessionId);
+        calculatorManager->SendCommand(Command::Command1);
+        DoNotOptimize(calculatorManager);
+        sessionId = (sessionId + 1) % SESSION_COUNT;
+    }
+
+    state.SetItemsProcessed(state.Iterations());
+    state.SetCounter("sessions", SESSION_COUNT);
+    state.SetCounter("live_sessions", static_cast<double>(LIVE_SESSION_COUNT));
+
+    store.Close();
+    filesystem::remove(path);
+}
+
+// The heap that a session costs when it is idle in the store, against keeping it as a CalculatorManager
+CALC_BENCHMARK(SessionStoreHeap_IdleSession)
+{
+    NullCalcDisplay display;
+    EnglishResourceProvider resourceProvider;
+    filesystem::path path = GetSessionFilePath(L"Heap");
+
+    double storeBytesPerSession = 0;
+    double liveBytesPerSession = 0;
+    while (state.KeepRunning())
+    {
+        filesystem::remove(path);
+        HeapSnapshot before = GetHeapSnapshot();
+        {
+            CalculatorSessionStore store(&display, &resourceProvider, LIVE_SESSION_COUNT);
+            store.Open(path);
+            MakeSessions(store, HEAP_SESSION_COUNT);
+            store.Flush();
+            HeapSnapshot after = GetHeapSnapshot();
+            storeBytesPerSession = static_cast<double>(after.liveBytes - before.liveBytes) / HEAP_SESSION_COUNT;
+        }
+
+        before = GetHeapSnapshot();
+        {
+            vector<unique_ptr<CalculatorManager>> calculatorManagers;
+            calculatorManagers.reserve(HEAP_SESSION_COUNT);
+            for (int i = 0; i < HEAP_SESSION_COUNT; i++)
+            {
+                calculatorManagers.push_back(make_unique<CalculatorManager>(&display, &resourceProvider));
+                MakeSession(*calculatorManagers.back());
+            }
+            HeapSnapshot after = GetHeapSnapshot();
+            liveBytesPerSession = static_cast<double>(after.liveBytes - before.liveBytes) / HEAP_SESSION_COUNT;
+        }
+    }
+
+    filesystem::remove(path);
+    state.SetItemsProcessed(state.Iterations() * HEAP_SESSION_COUNT);
+    state.SetCounter("store_heap_bytes_per_session", storeBytesPerSession);
+    state.SetCounter("calculator_heap_bytes_per_session", liveBytesPerSession);
+}
@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+#include "AllocationCounter.h"
+#include "Benchmark.h"
+#include "CalculatorManagerStubs.h"
+#include "Command.h"
+
+using namespace std;
+using namespace CalculationManager;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    void SendCommands(CalculatorManager& calculatorManager, vector<Command> const& commands)
+    {
+        for (Command command : commands)
+        {
+            calculatorManager.SendCommand(command);
+        }
+    }
+
+    // A scientific session with a few results in history and memory, in the middle of "12.5 + (3 × 4".
+    void MakeTypicalSession(CalculatorManager& calculatorManager, int calculationCount)
+    {
+        calculatorManager.SetScientificMode();
+        for (int i = 0; i < calculationCount; i++)
+        {
+            SendCommands(calculatorManager, { Command::Command7, Command::CommandPNT, Command::Command2, Command::CommandMUL, Command::Command3, Command::CommandEQU });
+            calculatorManager.MemorizeNumber();
+        }
+
+        SendCommands(
+            calculatorManager,
+            { Command::Command1, Command::Command2, Command::CommandPNT, Command::Command5, Command::CommandADD, Command::CommandOPENP, Command::Command3,
+              Command::CommandMUL, Command::Command4 });
+    }
+
+    void SaveSnapshot(BenchmarkState& state, int calculationCount)
+    {
+        NullCalcDisplay display;
+        EnglishResourceProvider resourceProvider;
+        CalculatorManager calculatorManager(&display, &resourceProvider);
+        MakeTypicalSession(calculatorManager, calculationCount);
+
+        vector<uint8_t> buffer(calculatorManager.SaveSnapshot(nullptr, 0));
+        size_t size = 0;
+        while (state.KeepRunning())
+        {
+            size = calculatorManager.SaveSnapshot(buffer.data(), buffer.size());
+            DoNotOptimize(buffer.data());
+        }
+
+        state.SetItemsProcessed(state.Iterations());
+        state.SetBytesProcessed(state.Iterations() * size);
+        state.SetCounter("snapshot_bytes", static_cast<double>(size));
+    }
+
+    void RestoreSnapshot(BenchmarkState& state, int calculationCount)
+    {
+        NullCalcDisplay display;
+        EnglishResourceProvider resourceProvider;
+        CalculatorManager source(&display, &resourceProvider);
+        MakeTypicalSession(source, calculationCount);
+
+        vector<uint8_t> buffer(source.SaveSnapshot(nullptr, 0));
+        source.SaveSnapshot(buffer.data(), buffer.size());
+
+        // Restore into a calculator in another state, which already has its engine, as a pool of sessions would
+        CalculatorManager calculatorManager(&display, &resourceProvider);
+        calculatorManager.SetScientificMode();
+        bool isRestored = true;
+        HeapSnapshot before = GetHeapSnapshot();
+        while (state.KeepRunning())
+        {
+            isRestored = calculatorManager.RestoreSnapshot(buffer.data(), buffer.size()) && isRestored;
+        }
+
+        HeapSnapshot after = GetHeapSnapshot();
+        state.SetItemsProcessed(state.Iterations());
+        state.SetBytesProcessed(state.Iterations() * buffer.size());
+        state.SetCounter("snapshot_bytes", static_cast<double>(buffer.size()));
+        state.SetCounter("allocations_per_restore", static_cast<double>(after.totalAllocations - before.totalAllocations) / state.Iterations());
+        state.SetLabel(isRestored ? "" : "restore failed");
+    }
+}
+
+CALC_BENCHMARK(SnapshotRestore_NoHistory)
+{
+    RestoreSnapshot(state, 0);
+}
+
+CALC_BENCHMARK(SnapshotSave_Typical)
+{
+    SaveSnapshot(state, 3);
+}
+
+CALC_BENCHMARK(SnapshotRestore_Typical)
+{
+    RestoreSnapshot(state, 3);
+}
+
+// 20 history items and 20 memorized numbers
+CALC_BENCHMARK(SnapshotSave_FullHistory)
+{
+    SaveSnapshot(state, 20);
+}
+
+CALC_BENCHMARK(SnapshotRestore_FullHistory)
+{
+    RestoreSnapshot(state, 20);
+}
@@ -0,0 +1,336 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AllocationCounter.h"
+#include "Benchmark.h"
+#include "Command.h"
+#include "ExactUnitConverter.h"
+#include "UnitConversionKernel.h"
+#include "UnitConverter.h"
+
+using namespace std;
+using namespace CalcEngine;
+using namespace UnitConversionManager;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    constexpr int LENGTH_CATEGORY_ID = 1;
+    constexpr int LARGE_CATEGORY_ID = 2;
+    constexpr int CURRENCY_CATEGORY_ID = 3;
+    constexpr int LARGE_CATEGORY_UNIT_COUNT = 200;
+    constexpr int CURRENCY_COUNT = 150;
+
+    // Enough values to be much longer than the setup of a batch, while input and output stay in the L1 cache
+    constexpr size_t BATCH_SIZE = 1024;
+
+    struct UnitFactor
+    {
+        const wchar_t* name;
+        double factor; // In the base unit of the category
+        const wchar_t* exactFactor;
+        bool isWhimsical;
+    };
+
+    // The length units of the app, in metres
+    const UnitFactor LENGTH_UNITS[] = { { L"Nanometers", 1e-9, L"1e-9", false },     { L"Microns", 1e-6, L"1e-6", false },
+                                        { L"Millimeters", 0.001, L"0.001", false },  { L"Centimeters", 0.01, L"0.01", false },
+                                        { L"Meters", 1, L"1", false },               { L"Kilometers", 1000, L"1000", false },
+                                        { L"Inches", 0.0254, L"0.0254", false },     { L"Feet", 0.3048, L"0.3048", false },
+                                        { L"Yards", 0.9144, L"0.9144", false },      { L"Miles", 1609.344, L"1609.344", false },
+                                        { L"NauticalMiles", 1852, L"1852", false },  { L"Paperclips", 0.035052, L"0.035052", true },
+                                        { L"Hands", 0.18669, L"0.18669", true },     { L"JumboJets", 76, L"76", true } };
+
+    // Loads the length units, a category with many units, and currencies, with ratios between every pair of units.
+    // The converter gets suggested values for every category but currencies, and exact factors for the length units.
+    class BenchmarkDataLoader : public IConverterDataLoader
+    {
+    public:
+        BenchmarkDataLoader()
+        {
+            Category length(LENGTH_CATEGORY_ID, L"Length", false);
+            Category large(LARGE_CATEGORY_ID, L"Large", false);
+            Category currency(CURRENCY_CATEGORY_ID, L"Currency", false);
+            m_categories = { length, large, currency };
+
+            int unitId = 1;
+            for (const UnitFactor& unit : LENGTH_UNITS)
+            {
+                m_exactFactors[LENGTH_CATEGORY_ID][unitId] = ExactConversionFactor{ unit.exactFactor, L"" };
+                AddUnit(length, Unit(unitId++, unit.name, unit.name, false, false, unit.isWhimsical), unit.factor);
+            }
+            for (int i = 0; i < LARGE_CATEGORY_UNIT_COUNT; i++)
+            {
+                AddUnit(large, Unit(unitId++, L"Unit" + to_wstring(i), L"U" + to_wstring(i), false, false, false), pow(1.1, i));
+            }
+            for (int i = 0; i < CURRENCY_COUNT; i++)
+            {
+                AddUnit(currency, Unit(unitId++, L"Currency" + to_wstring(i), L"Country" + to_wstring(i), L"C" + to_wstring(i), false, false, false), 1 + i / 7.0);
+            }
+
+            for (auto const& category : m_units)
+            {
+                for (const Unit& from : category.second)
+                {
+                    for (const Unit& to : category.second)
+                    {
+                        m_ratios[from][to] = ConversionData(m_factors[from.id] / m_factors[to.id], 0, false);
+                    }
+                }
+            }
+        }
+
+        void LoadData() override
+        {
+        }
+
+        vector<Category> LoadOrderedCategories() override
+        {
+            return m_categories;
+        }
+
+        vector<Unit> LoadOrderedUnits(const Category& category) override
+        {
+            return m_units[category];
+        }
+
+        unordered_map<Unit, ConversionData, UnitHash> LoadOrderedRatios(const Unit& unit) override
+        {
+            return m_ratios[unit];
+        }
+
+        bool SupportsCategory(const Category& target) override
+        {
+            return target.id == CURRENCY_CATEGORY_ID;
+        }
+
+        unordered_map<int, ExactConversionFactor> LoadExactConversionFactors(const Category& category) override
+        {
+            return m_exactFactors[category.id];
+        }
+
+    private:
+        void AddUnit(const Category& category, const Unit& unit, double factor)
+        {
+            m_units[category].push_back(unit);
+            m_factors[unit.id] = factor;
+        }
+
+        vector<Category> m_categories;
+        CategoryToUnitVectorMap m_units;
+        unordered_map<int, double> m_factors;
+        UnitToUnitToConversionDataMap m_ratios;
+        unordered_map<int, unordered_map<int, ExactConversionFactor>> m_exactFactors;
+    };
+
+    class NullUnitConverterVMCallback final : public IUnitConverterVMCallback
+    {
+    public:
+        void DisplayCallback(const wstring& from, const wstring& to) override
+        {
+            DoNotOptimize(from.data());
+            DoNotOptimize(to.data());
+        }
+
+        void SuggestedValueCallback(const vector<tuple<wstring, Unit>>& suggestedValues) override
+        {
+            DoNotOptimize(suggestedValues.data());
+        }
+
+        void MaxDigitsReached() override
+        {
+        }
+    };
+
+    // Converts 1234.5 from the first unit of the category to the second, as the converter does after every keystroke
+    void Calculate(BenchmarkState& state, int categoryId, bool isExactMode = false)
+    {
+        auto dataLoader = make_shared<BenchmarkDataLoader>();
+        auto converter = make_shared<UnitConverter>(dataLoader, dataLoader);
+        converter->SetExactMode(isExactMode);
+        converter->SetViewModelCallback(make_shared<NullUnitConverterVMCallback>());
+
+        Category category;
+        for (const Category& cur : converter->GetCategories())
+        {
+            if (cur.id == categoryId)
+            {
+                category = cur;
+            }
+        }
+
+        vector<Unit> units = get<0>(converter->SetCurrentCategory(category));
+        converter->SetCurrentUnitTypes(units[4 % units.size()], units[7 % units.size()]);
+        for (Command command : { Command::One, Command::Two, Command::Three, Command::Four, Command::Decimal, Command::Five })
+        {
+            converter->SendCommand(command);
+        }
+
+        HeapSnapshot before = GetHeapSnapshot();
+        while (state.KeepRunning())
+        {
+            converter->Calculate();
+        }
+
+        HeapSnapshot after = GetHeapSnapshot();
+        state.SetItemsProcessed(state.Iterations());
+        state.SetCounter("units", static_cast<double>(units.size()));
+        state.SetCounter("allocations_per_conversion", static_cast<double>(after.totalAllocations - before.totalAllocations) / state.Iterations());
+    }
+
+    // Restores the preferences that the converter saved with units of the large category selected, as the app does
+    // when it starts
+    template <typename Save, typename Restore>
+    void RestoreUserPreferences(BenchmarkState& state, Save save, Restore restore)
+    {
+        auto dataLoader = make_shared<BenchmarkDataLoader>();
+        auto converter = make_shared<UnitConverter>(dataLoader, dataLoader);
+        converter->SetViewModelCallback(make_shared<NullUnitConverterVMCallback>());
+
+        Category category;
+        for (const Category& cur : converter->GetCategories())
+        {
+            if (cur.id == LARGE_CATEGORY_ID)
+            {
+                category = cur;
+            }
+        }
+
+        vector<Unit> units = get<0>(converter->SetCurrentCategory(category));
+        converter->SetCurrentUnitTypes(units[4], units[7]);
+        auto userPreferences = save(*converter);
+
+        HeapSnapshot before = GetHeapSnapshot();
+        while (state.KeepRunning())
+        {
+            restore(*converter, userPreferences);
+        }
+
+        HeapSnapshot after = GetHeapSnapshot();
+        state.SetItemsProcessed(state.Iterations());
+        state.SetCounter("bytes", static_cast<double>(userPreferences.size() * sizeof(userPreferences[0])));
+        state.SetCounter("allocations_per_restore", static_cast<double>(after.totalAllocations - before.totalAllocations) / state.Iterations());
+    }
+
+    template <typename ConvertBatch>
+    void ConvertBatches(BenchmarkState& state, ConvertBatch convertBatch)
+    {
+        vector<double> values(BATCH_SIZE);
+        vector<double> results(BATCH_SIZE);
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            values[i] = 0.25 * i - 100;
+        }
+
+        while (state.KeepRunning())
+        {
+            convertBatch(values.data(), results.data(), values.size());
+            DoNotOptimize(results.data());
+        }
+
+        state.SetItemsProcessed(state.Iterations() * BATCH_SIZE);
+        state.SetBytesProcessed(state.Iterations() * BATCH_SIZE * 2 * sizeof(double));
+    }
+
+    // Fahrenheit to Celsius, which adds the offset first
+    const ConversionData FAHRENHEIT_TO_CELSIUS(5.0 / 9.0, -32, true);
+}
+
+CALC_BENCHMARK(UnitConverterCalculate_Length)
+{
+    Calculate(state, LENGTH_CATEGORY_ID);
+}
+
+CALC_BENCHMARK(UnitConverterCalculate_LargeCategory)
+{
+    Calculate(state, LARGE_CATEGORY_ID);
+}
+
+CALC_BENCHMARK(UnitConverterCalculate_Currency)
+{
+    Calculate(state, CURRENCY_CATEGORY_ID);
+}
+
+CALC_BENCHMARK(UnitConverterCalculate_LengthExact)
+{
+    Calculate(state, LENGTH_CATEGORY_ID, true);
+}
+
+CALC_BENCHMARK(UnitConverterRestoreUserPreferences_String)
+{
+    RestoreUserPreferences(
+        state,
+        [](UnitConverter& converter) { return converter.SaveUserPreferences(); },
+        [](UnitConverter& converter, const wstring& userPreferences) { converter.RestoreUserPreferences(userPreferences); });
+}
+
+CALC_BENCHMARK(UnitConverterRestoreUserPreferences_Binary)
+{
+    RestoreUserPreferences(
+        state,
+        [](UnitConverter& converter) {
+            vector<uint8_t> userPreferences(converter.SaveUserPreferences(nullptr, 0));
+            converter.SaveUserPreferences(userPreferences.data(), userPreferences.size());
+            return userPreferences;
+        },
+        [](UnitConverter& converter, const vector<uint8_t>& userPreferences) {
+            converter.RestoreUserPreferences(userPreferences.data(), userPreferences.size());
+        });
+}
+
+// Metres to feet with the ratio that was composed on the first conversion, which is one Rational multiply
+CALC_BENCHMARK(ExactUnitConverter_Convert)
+{
+    ExactUnitConverter converter;
+    unordered_map<int, ExactConversionFactor> factors;
+    for (size_t i = 0; i < size(LENGTH_UNITS); i++)
+    {
+        factors[static_cast<int>(i) + 1] = ExactConversionFactor{ LENGTH_UNITS[i].exactFactor, L"" };
+    }
+    converter.AddFactors(factors);
+
+    int metersId = 5;
+    int feetId = 8;
+    Rational value;
+    ExactUnitConverter::TryParse(L"1234.5", value);
+    Rational result;
+    bool isConverted = true;
+    while (state.KeepRunning())
+    {
+        isConverted = converter.Convert(metersId, feetId, value, result) && isConverted;
+        DoNotOptimize(&result);
+    }
+
+    state.SetItemsProcessed(state.Iterations());
+    state.SetLabel(isConverted ? "" : "not converted");
+}
+
+// Metres to feet through the converter, which finds the ratio once per batch
+CALC_BENCHMARK(UnitConverterConvertValues_Length)
+{
+    auto dataLoader = make_shared<BenchmarkDataLoader>();
+    auto converter = make_shared<UnitConverter>(dataLoader, dataLoader);
+    int metersId = 5;
+    int feetId = 8;
+    ConvertBatches(state, [&](const double* values, double* results, size_t count) {
+        converter->ConvertValues(metersId, feetId, values, results, count);
+    });
+}
+
+CALC_BENCHMARK(UnitConversionKernel_Scalar)
+{
+    ConvertBatches(state, [](const double* values, double* results, size_t count) {
+        ConvertValuesScalar(FAHRENHEIT_TO_CELSIUS, values, results, count);
+    });
+}
+
+CALC_BENCHMARK(UnitConversionKernel_Vectorized)
+{
+    ConvertBatches(state, [](const double* values, double* results, size_t count) {
+        ConvertValues(FAHRENHEIT_TO_CELSIUS, values, results, count);
+    });
+}
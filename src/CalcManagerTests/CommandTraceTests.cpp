@@ -0,0 +1,202 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include "CalculatorManager.h"
+#include "CommandTraceFile.h"
+#include "Test.h"
+#include "TestStubs.h"
+
+using namespace CalculationManager;
+using namespace CalcManagerTests;
+using namespace std;
+
+namespace CalculatorFunctionalTests
+{
+    namespace
+    {
+        constexpr size_t TRACE_HEADER_SIZE = 12;
+        constexpr size_t TRACE_RECORD_SIZE = 40;
+
+        class RecordingTracer final : public ICalcCommandTracer
+        {
+        public:
+            void OnCommandStarted(_In_ CalcCommandTrace const& trace) override
+            {
+                started.push_back(trace);
+            }
+            void OnCommandEnded(_In_ CalcCommandTrace const& trace) override
+            {
+                ended.push_back(trace);
+            }
+
+            vector<CalcCommandTrace> started;
+            vector<CalcCommandTrace> ended;
+        };
+
+        uint32_t ReadUInt32(vector<uint8_t> const& data, size_t offset)
+        {
+            return data[offset] | data[offset + 1] << 8 | data[offset + 2] << 16 | static_cast<uint32_t>(data[offset + 3]) << 24;
+        }
+
+        uint64_t ReadUInt64(vector<uint8_t> const& data, size_t offset)
+        {
+            return ReadUInt32(data, offset) | static_cast<uint64_t>(ReadUInt32(data, offset + 4)) << 32;
+        }
+    }
+
+    class CommandTraceTests
+    {
+    public:
+        CommandTraceTests()
+            : m_calculatorManager(&m_calculatorDisplay, &m_resourceProvider)
+        {
+            m_calculatorManager.SendCommand(Command::ModeScientific);
+        }
+
+        ~CommandTraceTests()
+        {
+            m_calculatorManager.SetCommandTracer(nullptr);
+        }
+
+        void TestTraceOfCommands()
+        {
+            RecordingTracer tracer;
+            m_calculatorManager.SetCommandTracer(&tracer);
+            SendCommands({ Command::Command1, Command::Command2, Command::Command3, Command::CommandFAC });
+
+            VERIFY_ARE_EQUAL(4u, tracer.started.size());
+            VERIFY_ARE_EQUAL(4u, tracer.ended.size());
+            CalcCommandTrace const& factorial = tracer.ended.back();
+            VERIFY_ARE_EQUAL(static_cast<int>(Command::CommandFAC), factorial.opCode);
+            VERIFY_ARE_EQUAL(10u, factorial.radix);
+            VERIFY_ARE_EQUAL(static_cast<int32_t>(CalculatorPrecision::ScientificModePrecision), factorial.precision);
+            VERIFY_ARE_EQUAL(tracer.started.back().startTime, factorial.startTime);
+
+            // The operand is 123, which is being entered, and is counted rather than converted
+            VERIFY_ARE_EQUAL(3u, factorial.inputDigits);
+            VERIFY_ARE_EQUAL(0u, factorial.numeratorDigits);
+            VERIFY_ARE_EQUAL(0u, factorial.denominatorDigits);
+            VERIFY_ARE_EQUAL(0u, tracer.started.back().elapsedTime);
+            VERIFY_IS_TRUE(factorial.elapsedTime > 0);
+
+            // A tracer set on the calculator is set on the engines created after it
+            m_calculatorManager.SendCommand(Command::ModeProgrammer);
+            m_calculatorManager.SendCommand(Command::CommandHex);
+            VERIFY_ARE_EQUAL(static_cast<int>(Command::CommandHex), tracer.ended.back().opCode);
+            m_calculatorManager.SendCommand(Command::Command1);
+            VERIFY_ARE_EQUAL(16u, tracer.ended.back().radix);
+
+            m_calculatorManager.SetCommandTracer(nullptr);
+            size_t endedCount = tracer.ended.size();
+            SendCommands({ Command::Command1, Command::CommandADD });
+            VERIFY_ARE_EQUAL(endedCount, tracer.ended.size());
+        }
+
+        // = closes the parentheses that are still open, which are commands of their own within it
+        void TestTraceOfNestedCommands()
+        {
+            RecordingTracer tracer;
+            SendCommands({ Command::CommandOPENP, Command::Command2, Command::CommandADD, Command::Command3 });
+            m_calculatorManager.SetCommandTracer(&tracer);
+            m_calculatorManager.SendCommand(Command::CommandEQU);
+
+            VERIFY_ARE_EQUAL(2u, tracer.ended.size());
+            VERIFY_ARE_EQUAL(static_cast<int>(Command::CommandCLOSEP), tracer.ended[0].opCode);
+            VERIFY_ARE_EQUAL(static_cast<int>(Command::CommandEQU), tracer.ended[1].opCode);
+            VERIFY_IS_TRUE(tracer.ended[1].elapsedTime >= tracer.ended[0].elapsedTime);
+        }
+
+        // Tracing doesn't convert the number being entered, so it does no Ratpack work of its own
+        void TestTraceDoesNoRatpackWork()
+        {
+            CalculatorManager::ResetRatpackCounters();
+            CalculatorManager::EnableRatpackCounters(true);
+            SendCommands({ Command::Command1, Command::Command2, Command::CommandPNT, Command::Command5, Command::CommandSIN });
+            RATPACK_COUNTERS untraced = CalculatorManager::GetRatpackCounters();
+
+            RecordingTracer tracer;
+            m_calculatorManager.SetCommandTracer(&tracer);
+            CalculatorManager::ResetRatpackCounters();
+            SendCommands({ Command::Command1, Command::Command2, Command::CommandPNT, Command::Command5, Command::CommandSIN });
+            RATPACK_COUNTERS traced = CalculatorManager::GetRatpackCounters();
+            CalculatorManager::EnableRatpackCounters(false);
+            CalculatorManager::ResetRatpackCounters();
+
+            VERIFY_ARE_EQUAL(untraced.numberAllocations, traced.numberAllocations);
+            VERIFY_ARE_EQUAL(untraced.ratAllocations, traced.ratAllocations);
+            VERIFY_ARE_EQUAL(3u, tracer.ended.back().inputDigits);
+        }
+
+        void TestTraceFile()
+        {
+            filesystem::path path = filesystem::temp_directory_path() / L"CalcManagerTests-CommandTrace.bin";
+            {
+                CommandTraceFile traceFile;
+                VERIFY_IS_TRUE(traceFile.Open(path));
+                m_calculatorManager.SetCommandTracer(&traceFile);
+                SendCommands({ Command::Command7, Command::CommandSIN });
+                m_calculatorManager.SetCommandTracer(nullptr);
+                VERIFY_ARE_EQUAL(2u, traceFile.GetRecordCount());
+            }
+
+            ifstream file(path, ios::binary);
+            vector<uint8_t> data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+            file.close();
+            filesystem::remove(path);
+
+            VERIFY_ARE_EQUAL(TRACE_HEADER_SIZE + 2 * TRACE_RECORD_SIZE, data.size());
+            VERIFY_ARE_EQUAL(0x43525443u, ReadUInt32(data, 0));
+            VERIFY_ARE_EQUAL(1u, ReadUInt32(data, 4));
+            VERIFY_ARE_EQUAL(static_cast<uint32_t>(TRACE_RECORD_SIZE), ReadUInt32(data, 8));
+
+            size_t sine = TRACE_HEADER_SIZE + TRACE_RECORD_SIZE;
+            VERIFY_IS_TRUE(ReadUInt64(data, sine) >= ReadUInt64(data, TRACE_HEADER_SIZE));
+            VERIFY_IS_TRUE(ReadUInt64(data, sine + 8) > 0);
+            VERIFY_ARE_EQUAL(static_cast<uint32_t>(Command::CommandSIN), ReadUInt32(data, sine + 16));
+            VERIFY_ARE_EQUAL(10u, ReadUInt32(data, sine + 20));
+            VERIFY_ARE_EQUAL(static_cast<uint32_t>(CalculatorPrecision::ScientificModePrecision), ReadUInt32(data, sine + 24));
+            VERIFY_ARE_EQUAL(0u, ReadUInt32(data, sine + 28));
+            VERIFY_ARE_EQUAL(0u, ReadUInt32(data, sine + 32));
+            VERIFY_ARE_EQUAL(1u, ReadUInt32(data, sine + 36));
+        }
+
+        // Only the commands that took at least the minimum elapsed time are written
+        void TestTraceFileMinimumElapsedTime()
+        {
+            filesystem::path path = filesystem::temp_directory_path() / L"CalcManagerTests-CommandTraceSlow.bin";
+            CommandTraceFile traceFile;
+            VERIFY_IS_TRUE(traceFile.Open(path, UINT64_MAX));
+            m_calculatorManager.SetCommandTracer(&traceFile);
+            SendCommands({ Command::Command7, Command::CommandSIN });
+            m_calculatorManager.SetCommandTracer(nullptr);
+            VERIFY_ARE_EQUAL(0u, traceFile.GetRecordCount());
+
+            traceFile.Close();
+            VERIFY_ARE_EQUAL(static_cast<uintmax_t>(TRACE_HEADER_SIZE), filesystem::file_size(path));
+            filesystem::remove(path);
+        }
+
+    private:
+        void SendCommands(initializer_list<Command> commands)
+        {
+            for (Command command : commands)
+            {
+                m_calculatorManager.SendCommand(command);
+            }
+        }
+
+        TestCalcDisplay m_calculatorDisplay;
+        EnglishResourceProvider m_resourceProvider;
+        CalculatorManager m_calculatorManager;
+    };
+
+    CALC_TEST_METHOD(CommandTraceTests, TestTraceOfCommands);
+    CALC_TEST_METHOD(CommandTraceTests, TestTraceOfNestedCommands);
+    CALC_TEST_METHOD(CommandTraceTests, TestTraceDoesNoRatpackWork);
+    CALC_TEST_METHOD(CommandTraceTests, TestTraceFile);
+    CALC_TEST_METHOD(CommandTraceTests, TestTraceFileMinimumElapsedTime);
+}
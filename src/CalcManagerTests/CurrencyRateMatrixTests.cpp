@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+#include "CurrencyRateMatrix.h"
+#include "Test.h"
+
+using namespace UnitConversionManager;
+using namespace std;
+
+namespace UnitConverterUnitTests
+{
+    namespace
+    {
+        // The ratios of the default currency, a weak currency and a strong one
+        const vector<double> RATIOS = { 1, 1234.5678, 0.00042 };
+    }
+
+    class CurrencyRateMatrixTests
+    {
+    public:
+        void TestRoundRate()
+        {
+            VERIFY_ARE_EQUAL(0.000000003423, CurrencyRateMatrix::RoundRate(0.00000000342334));
+            VERIFY_ARE_EQUAL(0.000212, CurrencyRateMatrix::RoundRate(0.000212));
+            VERIFY_ARE_EQUAL(0.1235, CurrencyRateMatrix::RoundRate(0.123456));
+            VERIFY_ARE_EQUAL(1234.5679, CurrencyRateMatrix::RoundRate(1234.56789));
+            VERIFY_ARE_EQUAL(0.0, CurrencyRateMatrix::RoundRate(0));
+        }
+
+        void TestRates()
+        {
+            CurrencyRateMatrix rates;
+            VERIFY_ARE_EQUAL(0u, rates.GetCount());
+
+            rates.Build(RATIOS);
+            VERIFY_ARE_EQUAL(RATIOS.size(), rates.GetCount());
+            for (size_t from = 0; from < RATIOS.size(); from++)
+            {
+                for (size_t to = 0; to < RATIOS.size(); to++)
+                {
+                    VERIFY_ARE_EQUAL(RATIOS[to] / RATIOS[from], rates.GetRate(from, to));
+                    VERIFY_ARE_EQUAL(CurrencyRateMatrix::RoundRate(RATIOS[to] / RATIOS[from]), rates.GetDisplayRate(from, to));
+                }
+            }
+            VERIFY_ARE_EQUAL(1.0, rates.GetRate(1, 1));
+            VERIFY_ARE_EQUAL(0.00042, rates.GetDisplayRate(0, 2));
+            VERIFY_ARE_EQUAL(0.0000003402, rates.GetDisplayRate(1, 2));
+
+            rates.Clear();
+            VERIFY_ARE_EQUAL(0u, rates.GetCount());
+        }
+
+        // The rounded rates are asked for in any order of source currencies, and each comes from the current ratios
+        void TestDisplayRatesAfterUpdate()
+        {
+            CurrencyRateMatrix rates;
+            rates.Build(RATIOS);
+            VERIFY_ARE_EQUAL(1234.5678, rates.GetDisplayRate(0, 1));
+            VERIFY_ARE_EQUAL(0.00042, rates.GetDisplayRate(0, 2));
+
+            vector<double> ratios = RATIOS;
+            ratios[2] = 0.0005;
+            vector<size_t> changedPositions;
+            VERIFY_IS_TRUE(rates.Update(ratios, changedPositions));
+            VERIFY_ARE_EQUAL(vector<size_t>{ 2 }, changedPositions);
+            VERIFY_ARE_EQUAL(1234.5678, rates.GetDisplayRate(0, 1));
+            VERIFY_ARE_EQUAL(0.0005, rates.GetDisplayRate(0, 2));
+            VERIFY_ARE_EQUAL(0.0005 / 1234.5678, rates.GetRate(1, 2));
+
+            // A change to the source currency changes every rate from it
+            ratios[0] = 2;
+            changedPositions.clear();
+            VERIFY_IS_TRUE(rates.Update(ratios, changedPositions));
+            VERIFY_ARE_EQUAL(vector<size_t>{ 0 }, changedPositions);
+            VERIFY_ARE_EQUAL(617.2839, rates.GetDisplayRate(0, 1));
+            VERIFY_ARE_EQUAL(0.00025, rates.GetDisplayRate(0, 2));
+            VERIFY_ARE_EQUAL(0.00162, rates.GetDisplayRate(1, 0));
+            VERIFY_ARE_EQUAL(617.2839, rates.GetDisplayRate(0, 1));
+
+            changedPositions.clear();
+            VERIFY_IS_TRUE(rates.Update(ratios, changedPositions));
+            VERIFY_IS_TRUE(changedPositions.empty());
+
+            // Another number of currencies is a new feed
+            ratios.push_back(10);
+            VERIFY_IS_FALSE(rates.Update(ratios, changedPositions));
+            VERIFY_IS_TRUE(changedPositions.empty());
+            VERIFY_ARE_EQUAL(4u, rates.GetCount());
+            VERIFY_ARE_EQUAL(5.0, rates.GetDisplayRate(0, 3));
+        }
+    };
+
+    CALC_TEST_METHOD(CurrencyRateMatrixTests, TestRoundRate);
+    CALC_TEST_METHOD(CurrencyRateMatrixTests, TestRates);
+    CALC_TEST_METHOD(CurrencyRateMatrixTests, TestDisplayRatesAfterUpdate);
+}
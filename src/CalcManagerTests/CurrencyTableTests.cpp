@@ -0,0 +1,298 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+#include "CurrencyTable.h"
+#include "Test.h"
+
+using namespace UnitConversionManager;
+using namespace std;
+
+namespace UnitConverterUnitTests
+{
+    namespace
+    {
+        const wstring STATIC_DATA = LR"([
+            { "CountryCode": "US", "CountryName": "United States", "CurrencyCode": "USD", "CurrencyName": "Dollar", "CurrencySymbol": "$" },
+            { "CountryCode": "JP", "CountryName": "Japan", "CurrencyCode": "JPY", "CurrencyName": "Yen", "CurrencySymbol": "\u00a5" }
+        ])";
+        const wstring RATIOS = LR"([ { "An": "USD", "Rt": 1 }, { "An": "JPY", "Rt": 151.25e0 } ])";
+
+        // A metadata element with the currency code and the country name given
+        wstring MakeStaticDataElement(const wstring& currencyCode, const wstring& countryName)
+        {
+            return LR"({ "CountryCode": "XX", "CountryName": ")" + countryName + LR"(", "CurrencyCode": )" + currencyCode
+                   + LR"(, "CurrencyName": "Name", "CurrencySymbol": "S" })";
+        }
+
+        wstring GetCountryName(const CurrencyTable& table, const wstring& currencyCode)
+        {
+            const CurrencyTableEntry* entry = table.Find(PackCurrencyCode(currencyCode));
+            return entry == nullptr ? L"(none)" : wstring(table.GetText(entry->countryName));
+        }
+
+        // Parses a single ratio, and returns -1 if the feed isn't parsed
+        double ParseRatio(const wstring& ratio)
+        {
+            CurrencyTable table;
+            if (!table.ParseRatios(LR"([{ "An": "EUR", "Rt": )" + ratio + L" }]"))
+            {
+                VERIFY_IS_TRUE(table.GetEntries().empty(), ratio);
+                return -1;
+            }
+
+            VERIFY_ARE_EQUAL(1u, table.GetEntries().size(), ratio);
+            return table.GetEntries()[0].ratio;
+        }
+    }
+
+    class CurrencyTableTests
+    {
+    public:
+        void TestCurrencyCodes()
+        {
+            VERIFY_ARE_EQUAL(0u, PackCurrencyCode(L"AAA"));
+            VERIFY_ARE_EQUAL(CURRENCY_CODE_COUNT - 1, PackCurrencyCode(L"ZZZ"));
+            VERIFY_IS_LESS_THAN(PackCurrencyCode(L"EUR"), PackCurrencyCode(L"USD"));
+            VERIFY_ARE_EQUAL(L"USD", UnpackCurrencyCode(PackCurrencyCode(L"USD")));
+            VERIFY_ARE_EQUAL(L"", UnpackCurrencyCode(INVALID_CURRENCY_CODE));
+
+            for (const wchar_t* code : { L"", L"US", L"USDX", L"usd", L"US1", L"U D", L"\u00C9UR" })
+            {
+                VERIFY_ARE_EQUAL(INVALID_CURRENCY_CODE, PackCurrencyCode(code), code);
+            }
+        }
+
+        void TestParse()
+        {
+            CurrencyTable table;
+            VERIFY_IS_TRUE(table.ParseStaticData(STATIC_DATA));
+            VERIFY_IS_TRUE(table.ParseRatios(RATIOS));
+            VERIFY_ARE_EQUAL(2u, table.GetEntries().size());
+
+            const CurrencyTableEntry* yen = table.Find(PackCurrencyCode(L"JPY"));
+            VERIFY_IS_NOT_NULL(yen);
+            VERIFY_ARE_EQUAL(151.25, yen->ratio);
+            CurrencyStaticData staticData = table.GetStaticData(*yen);
+            VERIFY_ARE_EQUAL(L"JP", staticData.countryCode);
+            VERIFY_ARE_EQUAL(L"Japan", staticData.countryName);
+            VERIFY_ARE_EQUAL(L"JPY", staticData.currencyCode);
+            VERIFY_ARE_EQUAL(L"Yen", staticData.currencyName);
+            VERIFY_ARE_EQUAL(L"\u00A5", staticData.currencySymbol);
+
+            VERIFY_IS_TRUE(table.ParseStaticData(L" [ ] "));
+            VERIFY_IS_TRUE(table.ParseRatios(L"[]"));
+            VERIFY_ARE_EQUAL(2u, table.GetEntries().size());
+        }
+
+        void TestEscapes()
+        {
+            CurrencyTable table;
+            const wstring element = MakeStaticDataElement(L"\"EUR\"", LR"(\"\\\/\b\f\n\r\t\u00e9\u20AC)");
+            VERIFY_IS_TRUE(table.ParseStaticData(L"[" + element + L"]"));
+            VERIFY_ARE_EQUAL(L"\"\\/\b\f\n\r\t\u00E9\u20AC", GetCountryName(table, L"EUR"));
+
+            // An escaped member name and currency code are the name and code they spell
+            VERIFY_IS_TRUE(table.ParseRatios(LR"([{ "\u0041n": "U\u0053D", "Rt": 2 }])"));
+            VERIFY_ARE_EQUAL(2.0, table.Find(PackCurrencyCode(L"USD"))->ratio);
+
+            // A surrogate pair is one character where wchar_t holds any code point
+            VERIFY_IS_TRUE(table.ParseStaticData(L"[" + MakeStaticDataElement(L"\"GBP\"", LR"(\ud83d\ude00)") + L"]"));
+            const wstring surrogatePair =
+                sizeof(wchar_t) == 4 ? wstring(1, static_cast<wchar_t>(0x1F600)) : wstring{ static_cast<wchar_t>(0xD83D), static_cast<wchar_t>(0xDE00) };
+            VERIFY_ARE_EQUAL(surrogatePair, GetCountryName(table, L"GBP"));
+
+            for (const wchar_t* escape : { L"\\x", L"\\u12G4", L"\\u12", L"\\U0041" })
+            {
+                VERIFY_IS_FALSE(table.ParseStaticData(L"[" + MakeStaticDataElement(L"\"CHF\"", escape) + L"]"), escape);
+                VERIFY_IS_TRUE(table.GetEntries().empty(), escape);
+            }
+        }
+
+        // A surrogate that isn't part of a pair is kept as the code unit it escapes, and doesn't take the escape after it
+        void TestInvalidSurrogates()
+        {
+            const wchar_t high = static_cast<wchar_t>(0xD800);
+            const wchar_t low = static_cast<wchar_t>(0xDC00);
+            const wstring highThenPair = sizeof(wchar_t) == 4 ? wstring{ high, static_cast<wchar_t>(0x10000) } : wstring{ high, high, low };
+            const pair<const wchar_t*, wstring> cases[] = { { LR"(\ud800)", wstring{ high } },
+                                                            { LR"(\ud800x)", wstring{ high, L'x' } },
+                                                            { LR"(\udc00\ud800)", wstring{ low, high } },
+                                                            { LR"(\ud800A)", wstring{ high, L'A' } },
+                                                            { LR"(\ud800\u0041)", wstring{ high, L'A' } },
+                                                            { LR"(\ud800\ud800\udc00)", highThenPair },
+                                                            { LR"(\ud800\n)", wstring{ high, L'\n' } } };
+            for (const auto& [escaped, expected] : cases)
+            {
+                CurrencyTable table;
+                VERIFY_IS_TRUE(table.ParseStaticData(L"[" + MakeStaticDataElement(L"\"EUR\"", escaped) + L"]"), escaped);
+                VERIFY_ARE_EQUAL(expected, GetCountryName(table, L"EUR"), escaped);
+            }
+
+            // A high surrogate followed by a broken escape is an error, as that escape is read on its own
+            CurrencyTable table;
+            VERIFY_IS_FALSE(table.ParseStaticData(L"[" + MakeStaticDataElement(L"\"EUR\"", LR"(\ud800\u00)") + L"]"));
+        }
+
+        // Members and elements that aren't read are skipped whatever they hold, as long as they are balanced
+        void TestSkipsNestedValues()
+        {
+            CurrencyTable table;
+            const wstring ratios = LR"([
+                [ { "An": "EUR", "Rt": 3 } ],
+                "text", 12, -1.5e-3, true, null, {},
+                { "Extra": { "a": [ 1, "]}\"{", { "b": null } ], "c": [ [], {} ] }, "An": "USD", "Tags": [ "x", false ], "Rt": 1.5 },
+                { "An": [ "JPY" ], "Rt": 150 },
+                { "An": "CHF", "Rt": 0.9, "An": "GBP" }
+            ])";
+            VERIFY_IS_TRUE(table.ParseRatios(ratios));
+            VERIFY_IS_NULL(table.Find(PackCurrencyCode(L"EUR")));
+            VERIFY_IS_NULL(table.Find(PackCurrencyCode(L"JPY")));
+            VERIFY_IS_NULL(table.Find(PackCurrencyCode(L"CHF")));
+            VERIFY_ARE_EQUAL(1.5, table.Find(PackCurrencyCode(L"USD"))->ratio);
+            VERIFY_ARE_EQUAL(0.9, table.Find(PackCurrencyCode(L"GBP"))->ratio);
+            VERIFY_ARE_EQUAL(2u, table.GetEntries().size());
+
+            // The metadata strings are taken only from strings
+            VERIFY_IS_TRUE(table.ParseStaticData(L"[" + MakeStaticDataElement(L"\"EUR\"", LR"(Europe", "CountryCode": { "x": "y" }, "Other": ")") + L"]"));
+            const CurrencyTableEntry* euro = table.Find(PackCurrencyCode(L"EUR"));
+            VERIFY_IS_NOT_NULL(euro);
+            VERIFY_ARE_EQUAL(L"Europe", table.GetText(euro->countryName));
+            VERIFY_ARE_EQUAL(L"XX", table.GetText(euro->countryCode));
+
+            for (const wchar_t* unbalanced : { LR"([{ "x": [ 1, 2 }, "An": "USD", "Rt": 1 }])",
+                                               LR"([{ "x": { "y": 1 ] }])",
+                                               LR"([{ "x": { "y": 1 }])",
+                                               LR"([[ 1, 2 ])",
+                                               LR"([{ "x": "]" ])",
+                                               LR"([{ "x": [ { ] }])" })
+            {
+                VERIFY_IS_FALSE(table.ParseRatios(unbalanced), unbalanced);
+                VERIFY_IS_TRUE(table.GetEntries().empty(), unbalanced);
+            }
+
+            // A skipped value can be nested up to 64 deep
+            const auto parseNested = [&table](size_t depth) {
+                return table.ParseRatios(LR"([{ "x": )" + wstring(depth, L'[') + wstring(depth, L']') + LR"(, "An": "USD", "Rt": 1 }])");
+            };
+            VERIFY_IS_TRUE(parseNested(64));
+            VERIFY_IS_FALSE(parseNested(65));
+        }
+
+        // Every prefix of a feed, and feeds broken in other ways, are rejected, and leave the table empty
+        void TestRejectsMalformedFeeds()
+        {
+            CurrencyTable table;
+            for (const bool isStaticData : { true, false })
+            {
+                const wstring& feed = isStaticData ? STATIC_DATA : RATIOS;
+                const wstring trimmed = feed.substr(0, feed.find_last_not_of(L" \n") + 1);
+                for (size_t length = 0; length < trimmed.size(); length++)
+                {
+                    VERIFY_IS_TRUE(table.ParseStaticData(STATIC_DATA));
+                    const wstring prefix = trimmed.substr(0, length);
+                    VERIFY_IS_FALSE(isStaticData ? table.ParseStaticData(prefix) : table.ParseRatios(prefix), prefix);
+                    VERIFY_IS_TRUE(table.GetEntries().empty(), prefix);
+                }
+            }
+
+            for (const wchar_t* feed : { L"",
+                                         L"{}",
+                                         L"\"[]\"",
+                                         L"[] []",
+                                         L"[],",
+                                         L"[,]",
+                                         LR"([{ "An": "USD", "Rt": 1 },])",
+                                         LR"([{ "An": "USD", "Rt": 1 } { "An": "EUR", "Rt": 1 }])",
+                                         LR"([{ "An": "USD", "Rt": 1, }])",
+                                         LR"([{ "An" "USD", "Rt": 1 }])",
+                                         LR"([{ An: "USD", "Rt": 1 }])",
+                                         LR"([{ "An": "USD" "Rt": 1 }])",
+                                         LR"([{ "An": "USD", "Rt": "1" }])",
+                                         LR"([{ "An": "USD", "Rt": }])",
+                                         LR"([{ "An": "USD", "Rt": 1 ])",
+                                         LR"([{ "An": "USD", "Rt": 1 }]])",
+                                         L"[\"unterminated]" })
+            {
+                VERIFY_IS_TRUE(table.ParseRatios(RATIOS));
+                VERIFY_IS_FALSE(table.ParseRatios(feed), feed);
+                VERIFY_IS_TRUE(table.GetEntries().empty(), feed);
+                VERIFY_IS_NULL(table.Find(PackCurrencyCode(L"USD")), feed);
+            }
+
+            VERIFY_IS_FALSE(table.ParseStaticData(L"[" + MakeStaticDataElement(L"\"EUR\"", L"Europe") + L"},]"));
+            VERIFY_IS_TRUE(table.GetEntries().empty());
+        }
+
+        void TestNumbers()
+        {
+            VERIFY_ARE_EQUAL(1.7976931348623157e308, ParseRatio(L"1.7976931348623157e308"));
+            VERIFY_ARE_EQUAL(2.2250738585072014e-308, ParseRatio(L"2.2250738585072014e-308"));
+            VERIFY_ARE_EQUAL(123.456, ParseRatio(L"1.23456E+2"));
+            VERIFY_ARE_EQUAL(0.1, ParseRatio(L"0.1"));
+            VERIFY_ARE_EQUAL(-2.5, ParseRatio(L"-2.5"));
+            VERIFY_ARE_EQUAL(0.0, ParseRatio(L"-0"));
+
+            // The longest number that is read is MAX_NUMBER_LENGTH characters
+            const wstring longest = L"1." + wstring(62, L'0');
+            VERIFY_ARE_EQUAL(1.0, ParseRatio(longest));
+            VERIFY_ARE_EQUAL(-1.0, ParseRatio(longest + L"0"));
+
+            for (const wchar_t* ratio : { L"1e309", L"-1e309", L"1e-400", L"+1", L"1e", L"--1", L"1.2.3", L"0x10", L"Infinity", L"NaN", L"null", L"true" })
+            {
+                VERIFY_ARE_EQUAL(-1.0, ParseRatio(ratio), ratio);
+            }
+
+            // A currency with a ratio of 0, or one below, can't be converted
+            CurrencyTable table;
+            VERIFY_IS_TRUE(table.ParseStaticData(STATIC_DATA));
+            VERIFY_IS_TRUE(table.ParseRatios(LR"([{ "An": "USD", "Rt": -0.0 }, { "An": "JPY", "Rt": -1 }])"));
+            table.RemoveIncomplete();
+            VERIFY_IS_TRUE(table.GetEntries().empty());
+        }
+
+        // An element without a valid ISO code is dropped, and so are its strings, and a currency keeps the first metadata
+        // and the first ratio other than 0 that it is given
+        void TestDropsInvalidCurrencies()
+        {
+            CurrencyTable table;
+            wstring staticData = L"[";
+            size_t index = 0;
+            for (const wchar_t* code : { L"\"EU\"", L"\"EURO\"", L"\"eur\"", L"\"E1R\"", L"\"\"", L"978", L"null", L"[\"EUR\"]", L"\"E\\u0055R\"", L"\"CHF\"" })
+            {
+                staticData += MakeStaticDataElement(code, L"Country " + to_wstring(index++)) + L",";
+            }
+            staticData += LR"({ "CountryName": "No code" }, )" + MakeStaticDataElement(L"\"EUR\"", L"Second") + L"]";
+            VERIFY_IS_TRUE(table.ParseStaticData(staticData));
+            VERIFY_ARE_EQUAL(2u, table.GetEntries().size());
+            VERIFY_ARE_EQUAL(L"Country 8", GetCountryName(table, L"EUR"));
+            VERIFY_ARE_EQUAL(L"Country 9", GetCountryName(table, L"CHF"));
+
+            VERIFY_IS_TRUE(table.ParseRatios(LR"([
+                { "An": "usd", "Rt": 1 }, { "An": "US", "Rt": 1 }, { "An": 840, "Rt": 1 }, { "Rt": 1 },
+                { "An": "EUR", "Rt": 0 }, { "Rt": 0.8, "An": "EUR" }, { "An": "EUR", "Rt": 0.7 },
+                { "An": "GBP" }
+            ])"));
+            VERIFY_ARE_EQUAL(3u, table.GetEntries().size());
+            VERIFY_IS_NULL(table.Find(PackCurrencyCode(L"USD")));
+            VERIFY_ARE_EQUAL(0.8, table.Find(PackCurrencyCode(L"EUR"))->ratio);
+            VERIFY_ARE_EQUAL(0.0, table.Find(PackCurrencyCode(L"GBP"))->ratio);
+
+            // Only the currencies with both metadata and a ratio are kept, in the order they first appeared
+            table.RemoveIncomplete();
+            VERIFY_ARE_EQUAL(1u, table.GetEntries().size());
+            VERIFY_ARE_EQUAL(PackCurrencyCode(L"EUR"), table.GetEntries()[0].code);
+            VERIFY_IS_NULL(table.Find(PackCurrencyCode(L"CHF")));
+            VERIFY_ARE_EQUAL(L"Country 8", GetCountryName(table, L"EUR"));
+        }
+    };
+
+    CALC_TEST_METHOD(CurrencyTableTests, TestCurrencyCodes);
+    CALC_TEST_METHOD(CurrencyTableTests, TestParse);
+    CALC_TEST_METHOD(CurrencyTableTests, TestEscapes);
+    CALC_TEST_METHOD(CurrencyTableTests, TestInvalidSurrogates);
+    CALC_TEST_METHOD(CurrencyTableTests, TestSkipsNestedValues);
+    CALC_TEST_METHOD(CurrencyTableTests, TestRejectsMalformedFeeds);
+    CALC_TEST_METHOD(CurrencyTableTests, TestNumbers);
+    CALC_TEST_METHOD(CurrencyTableTests, TestDropsInvalidCurrencies);
+}
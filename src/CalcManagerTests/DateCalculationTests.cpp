@@ -0,0 +1,243 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+#include "DateCalculation.h"
+#include "Test.h"
+
+using namespace CalcManager::DateCalculation;
+using namespace std;
+
+namespace CalculatorFunctionalTests
+{
+    namespace
+    {
+        // The day of UniversalTime 0, which is the first that the date calculator gives to the arithmetic
+        constexpr CivilDate FIRST_DATE = { 1601, 1, 1 };
+        constexpr CivilDate LAST_DATE = { MAX_YEAR, 12, 31 };
+
+        wstring ToString(const CivilDate& date)
+        {
+            return to_wstring(date.year) + L"-" + to_wstring(date.month) + L"-" + to_wstring(date.day);
+        }
+
+        bool AreEqual(const CivilDate& l, const CivilDate& r)
+        {
+            return l.year == r.year && l.month == r.month && l.day == r.day;
+        }
+
+        bool AreEqual(const DateDuration& l, const DateDuration& r)
+        {
+            return l.years == r.years && l.months == r.months && l.weeks == r.weeks && l.days == r.days;
+        }
+
+        CivilDate Add(const CivilDate& date, const DateDuration& duration)
+        {
+            int32_t result = 0;
+            VERIFY_IS_TRUE(TryAddDuration(DaysFromCivil(date), duration, result), ToString(date));
+            return CivilFromDays(result);
+        }
+
+        CivilDate Subtract(const CivilDate& date, const DateDuration& duration)
+        {
+            int32_t result = 0;
+            VERIFY_IS_TRUE(TrySubtractDuration(DaysFromCivil(date), duration, result), ToString(date));
+            return CivilFromDays(result);
+        }
+
+        // The count of a unit between the pivot and the end, found as the pivot loop of the Windows date calculator
+        // did: one more at a time while the pivot plus that many is not after the end
+        int32_t StepUnit(int32_t& pivot, int32_t end, int64_t monthsInUnit)
+        {
+            int32_t count = 0;
+            int32_t next;
+            while (TryAddMonths(pivot, (count + 1) * monthsInUnit, next) && next <= end)
+            {
+                count++;
+            }
+            VERIFY_IS_TRUE(TryAddMonths(pivot, count * monthsInUnit, pivot));
+            return count;
+        }
+
+        DateDuration GetSteppedDifference(int32_t date1, int32_t date2, uint32_t units)
+        {
+            int32_t pivot = date1 < date2 ? date1 : date2;
+            const int32_t end = date1 < date2 ? date2 : date1;
+
+            DateDuration difference{};
+            if ((units & DATE_UNIT_YEAR) != 0)
+            {
+                difference.years = StepUnit(pivot, end, 12);
+            }
+            if ((units & DATE_UNIT_MONTH) != 0)
+            {
+                difference.months = StepUnit(pivot, end, 1);
+            }
+            if ((units & DATE_UNIT_WEEK) != 0)
+            {
+                while (pivot + 7 <= end)
+                {
+                    difference.weeks++;
+                    pivot += 7;
+                }
+            }
+            difference.days = end - pivot;
+            return difference;
+        }
+    }
+
+    class DateCalculationTests
+    {
+    public:
+        // Every day of the date calculator's range converts back to itself and follows the day before it
+        void TestCivilRoundTrip()
+        {
+            VERIFY_ARE_EQUAL(0, DaysFromCivil({ 1970, 1, 1 }));
+            VERIFY_ARE_EQUAL(-134774, DaysFromCivil(FIRST_DATE));
+            VERIFY_ARE_EQUAL(2932896, DaysFromCivil(LAST_DATE));
+
+            CivilDate expected = FIRST_DATE;
+            const int32_t lastDay = DaysFromCivil(LAST_DATE);
+            for (int32_t day = DaysFromCivil(FIRST_DATE); day <= lastDay; day++)
+            {
+                const CivilDate date = CivilFromDays(day);
+                if (!AreEqual(expected, date) || DaysFromCivil(date) != day)
+                {
+                    VERIFY_IS_TRUE(false, ToString(expected) + L" != " + ToString(date));
+                    return;
+                }
+
+                if (expected.day < GetDaysInMonth(expected.year, expected.month))
+                {
+                    expected.day++;
+                }
+                else
+                {
+                    expected.day = 1;
+                    expected.month = expected.month % 12 + 1;
+                    expected.year += expected.month == 1 ? 1 : 0;
+                }
+            }
+            VERIFY_ARE_EQUAL(MAX_YEAR + 1, expected.year);
+        }
+
+        void TestDaysInMonth()
+        {
+            VERIFY_ARE_EQUAL(31u, GetDaysInMonth(2021, 1));
+            VERIFY_ARE_EQUAL(28u, GetDaysInMonth(2021, 2));
+            VERIFY_ARE_EQUAL(29u, GetDaysInMonth(2020, 2));
+            VERIFY_ARE_EQUAL(28u, GetDaysInMonth(1900, 2));
+            VERIFY_ARE_EQUAL(29u, GetDaysInMonth(2000, 2));
+            VERIFY_ARE_EQUAL(30u, GetDaysInMonth(2021, 4));
+            VERIFY_ARE_EQUAL(31u, GetDaysInMonth(2021, 12));
+        }
+
+        // A day past the end of the month is clamped to its last day, after each of the years and the months
+        void TestAddDurationClamping()
+        {
+            VERIFY_IS_TRUE(AreEqual({ 2021, 2, 28 }, Add({ 2021, 1, 31 }, { 0, 1, 0, 0 })));
+            VERIFY_IS_TRUE(AreEqual({ 2020, 2, 29 }, Add({ 2020, 1, 31 }, { 0, 1, 0, 0 })));
+            VERIFY_IS_TRUE(AreEqual({ 2021, 4, 30 }, Add({ 2021, 3, 31 }, { 0, 1, 0, 0 })));
+            VERIFY_IS_TRUE(AreEqual({ 2022, 1, 31 }, Add({ 2021, 12, 31 }, { 0, 1, 0, 0 })));
+            VERIFY_IS_TRUE(AreEqual({ 2021, 2, 28 }, Add({ 2020, 2, 29 }, { 1, 0, 0, 0 })));
+            VERIFY_IS_TRUE(AreEqual({ 2024, 2, 29 }, Add({ 2020, 2, 29 }, { 4, 0, 0, 0 })));
+            VERIFY_IS_TRUE(AreEqual({ 2100, 2, 28 }, Add({ 2096, 2, 29 }, { 4, 0, 0, 0 })));
+
+            // The years come before the months, so the leap day is clamped only where the years land
+            VERIFY_IS_TRUE(AreEqual({ 2021, 3, 28 }, Add({ 2020, 2, 29 }, { 1, 1, 0, 0 })));
+            VERIFY_IS_TRUE(AreEqual({ 2021, 3, 1 }, Add({ 2021, 1, 31 }, { 0, 1, 0, 1 })));
+
+            // The weeks are not added
+            VERIFY_IS_TRUE(AreEqual({ 2021, 1, 1 }, Add({ 2021, 1, 1 }, { 0, 0, 3, 0 })));
+
+            int32_t result = 0;
+            VERIFY_IS_TRUE(TryAddDuration(DaysFromCivil({ 9999, 12, 1 }), { 0, 0, 0, 30 }, result));
+            VERIFY_IS_FALSE(TryAddDuration(DaysFromCivil({ 9999, 12, 1 }), { 0, 0, 0, 31 }, result));
+            VERIFY_IS_FALSE(TryAddDuration(DaysFromCivil({ 9999, 12, 1 }), { 0, 1, 0, 0 }, result));
+            VERIFY_IS_FALSE(TryAddDuration(DaysFromCivil({ 9000, 1, 1 }), { 1000, 0, 0, 0 }, result));
+
+            // A step outside the range fails even if the ones after it would come back
+            VERIFY_IS_FALSE(TryAddDuration(DaysFromCivil({ 9999, 6, 1 }), { 1, -12, 0, 0 }, result));
+        }
+
+        // The days are subtracted before the months and then the years, so the month end is clamped where the days land
+        void TestSubtractDurationClamping()
+        {
+            VERIFY_IS_TRUE(AreEqual({ 2021, 2, 28 }, Subtract({ 2021, 3, 31 }, { 0, 1, 0, 0 })));
+            VERIFY_IS_TRUE(AreEqual({ 2020, 2, 29 }, Subtract({ 2020, 3, 31 }, { 0, 1, 0, 0 })));
+            VERIFY_IS_TRUE(AreEqual({ 2019, 2, 28 }, Subtract({ 2020, 2, 29 }, { 1, 0, 0, 0 })));
+            VERIFY_IS_TRUE(AreEqual({ 2020, 12, 31 }, Subtract({ 2021, 1, 31 }, { 0, 1, 0, 0 })));
+            VERIFY_IS_TRUE(AreEqual({ 2021, 2, 28 }, Subtract({ 2021, 4, 1 }, { 0, 1, 0, 1 })));
+            VERIFY_IS_TRUE(AreEqual({ 2019, 1, 29 }, Subtract({ 2020, 3, 1 }, { 1, 1, 0, 1 })));
+            VERIFY_IS_TRUE(AreEqual({ 2021, 1, 1 }, Subtract({ 2021, 1, 1 }, { 0, 0, 3, 0 })));
+
+            int32_t result = 0;
+            VERIFY_IS_TRUE(TrySubtractDuration(DaysFromCivil({ 1, 1, 31 }), { 0, 0, 0, 30 }, result));
+            VERIFY_ARE_EQUAL(DaysFromCivil({ MIN_YEAR, 1, 1 }), result);
+            VERIFY_IS_FALSE(TrySubtractDuration(DaysFromCivil({ 1, 1, 31 }), { 0, 0, 0, 31 }, result));
+            VERIFY_IS_FALSE(TrySubtractDuration(DaysFromCivil({ 1, 12, 31 }), { 0, 12, 0, 0 }, result));
+            VERIFY_IS_FALSE(TrySubtractDuration(DaysFromCivil({ 1000, 1, 1 }), { 1000, 0, 0, 0 }, result));
+        }
+
+        void TestDateDifference()
+        {
+            const int32_t start = DaysFromCivil({ 2020, 1, 31 });
+            const int32_t end = DaysFromCivil({ 2021, 3, 30 });
+            VERIFY_IS_TRUE(AreEqual({ 1, 1, 0, 30 }, GetDateDifference(start, end, DATE_UNIT_YEAR | DATE_UNIT_MONTH | DATE_UNIT_DAY)));
+            VERIFY_IS_TRUE(AreEqual({ 1, 1, 4, 2 }, GetDateDifference(start, end, DATE_UNIT_YEAR | DATE_UNIT_MONTH | DATE_UNIT_WEEK | DATE_UNIT_DAY)));
+            VERIFY_IS_TRUE(AreEqual({ 0, 13, 0, 30 }, GetDateDifference(start, end, DATE_UNIT_MONTH | DATE_UNIT_DAY)));
+            VERIFY_IS_TRUE(AreEqual({ 0, 0, 60, 4 }, GetDateDifference(start, end, DATE_UNIT_WEEK)));
+            VERIFY_IS_TRUE(AreEqual({ 0, 0, 0, 424 }, GetDateDifference(start, end, DATE_UNIT_DAY)));
+            VERIFY_IS_TRUE(AreEqual({ 0, 0, 0, 424 }, GetDateDifference(end, start, DATE_UNIT_DAY)));
+
+            // From a leap day, a whole year ends on February 28
+            VERIFY_IS_TRUE(AreEqual({ 1, 0, 0, 0 }, GetDateDifference(DaysFromCivil({ 2020, 2, 29 }), DaysFromCivil({ 2021, 2, 28 }), DATE_UNIT_YEAR)));
+            VERIFY_IS_TRUE(AreEqual({ 0, 0, 0, 0 }, GetDateDifference(start, start, DATE_UNIT_YEAR | DATE_UNIT_MONTH | DATE_UNIT_WEEK)));
+        }
+
+        // Every combination of the units, for pairs of dates around the month ends and leap days, against the pivot loop
+        void TestDateDifferenceUnits()
+        {
+            const CivilDate dates[] = { { 1601, 1, 1 }, { 1899, 12, 31 }, { 1900, 2, 28 }, { 1900, 3, 1 }, { 2000, 2, 29 }, { 2019, 1, 30 },
+                                        { 2019, 1, 31 }, { 2020, 1, 31 }, { 2020, 2, 28 }, { 2020, 2, 29 }, { 2020, 3, 1 }, { 2020, 3, 31 },
+                                        { 2020, 12, 31 }, { 2021, 2, 28 }, { 2021, 3, 30 }, { 2024, 2, 29 }, { 9999, 12, 31 } };
+
+            for (uint32_t units = 1; units <= (DATE_UNIT_YEAR | DATE_UNIT_MONTH | DATE_UNIT_WEEK | DATE_UNIT_DAY); units++)
+            {
+                for (const CivilDate& date1 : dates)
+                {
+                    for (const CivilDate& date2 : dates)
+                    {
+                        const int32_t day1 = DaysFromCivil(date1);
+                        const int32_t day2 = DaysFromCivil(date2);
+                        const DateDuration expected = GetSteppedDifference(day1, day2, units);
+                        const DateDuration actual = GetDateDifference(day1, day2, units);
+                        if (!AreEqual(expected, actual))
+                        {
+                            VERIFY_IS_TRUE(false, ToString(date1) + L" to " + ToString(date2) + L" in units " + to_wstring(units));
+                            return;
+                        }
+                    }
+                }
+            }
+        }
+
+        void TestDateDifferences()
+        {
+            const int32_t dates1[] = { DaysFromCivil({ 2020, 2, 29 }), DaysFromCivil({ 2021, 3, 30 }) };
+            const int32_t dates2[] = { DaysFromCivil({ 2021, 2, 28 }), DaysFromCivil({ 2020, 1, 31 }) };
+            DateDuration differences[2];
+            GetDateDifferences(dates1, dates2, 2, DATE_UNIT_YEAR | DATE_UNIT_MONTH | DATE_UNIT_DAY, differences);
+            VERIFY_IS_TRUE(AreEqual({ 1, 0, 0, 0 }, differences[0]));
+            VERIFY_IS_TRUE(AreEqual({ 1, 1, 0, 30 }, differences[1]));
+        }
+    };
+
+    CALC_TEST_METHOD(DateCalculationTests, TestCivilRoundTrip);
+    CALC_TEST_METHOD(DateCalculationTests, TestDaysInMonth);
+    CALC_TEST_METHOD(DateCalculationTests, TestAddDurationClamping);
+    CALC_TEST_METHOD(DateCalculationTests, TestSubtractDurationClamping);
+    CALC_TEST_METHOD(DateCalculationTests, TestDateDifference);
+    CALC_TEST_METHOD(DateCalculationTests, TestDateDifferenceUnits);
+    CALC_TEST_METHOD(DateCalculationTests, TestDateDifferences);
+}
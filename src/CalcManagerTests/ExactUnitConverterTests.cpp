@@ -0,0 +1,249 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include "Command.h"
+#include "ExactUnitConverter.h"
+#include "Test.h"
+
+using namespace CalcEngine;
+using namespace UnitConversionManager;
+using namespace std;
+
+namespace UnitConverterUnitTests
+{
+    namespace
+    {
+        constexpr int SQUARE_METER = 1;
+        constexpr int SQUARE_FOOT = 2;
+        constexpr int PYEONG = 3;
+        constexpr int CELSIUS = 11;
+        constexpr int FAHRENHEIT = 12;
+        constexpr int KELVIN = 13;
+
+        // base = value * ratio + offset, with the factors the app's data loader gives
+        const unordered_map<int, ExactConversionFactor> AREA_FACTORS = { { SQUARE_METER, { L"1", L"" } },
+                                                                         { SQUARE_FOOT, { L"0.09290304", L"" } },
+                                                                         { PYEONG, { L"400/121", L"" } } };
+        const unordered_map<int, ExactConversionFactor> TEMPERATURE_FACTORS = { { CELSIUS, { L"1", L"" } },
+                                                                                { FAHRENHEIT, { L"5/9", L"-160/9" } },
+                                                                                { KELVIN, { L"1", L"-273.15" } } };
+
+        Rational Parse(wstring_view text)
+        {
+            Rational value;
+            VERIFY_IS_TRUE(ExactUnitConverter::TryParse(text, value), wstring(text));
+            return value;
+        }
+
+        bool IsWithinUlps(double expected, double actual, int ulps)
+        {
+            double bound = expected;
+            for (int i = 0; i < ulps; i++)
+            {
+                bound = nextafter(bound, HUGE_VAL);
+            }
+            return abs(actual - expected) <= bound - expected;
+        }
+
+        class ExactTestConfigLoader : public IConverterDataLoader
+        {
+        public:
+            ExactTestConfigLoader()
+                : m_area(1, L"Area", false)
+                , m_squareMeter(SQUARE_METER, L"Square meters", L"m²", true, true, false)
+                , m_squareFoot(SQUARE_FOOT, L"Square feet", L"ft²", false, false, false)
+            {
+            }
+
+            void LoadData() override
+            {
+            }
+
+            vector<Category> LoadOrderedCategories() override
+            {
+                return { m_area };
+            }
+
+            vector<Unit> LoadOrderedUnits(const Category& /*c*/) override
+            {
+                return { m_squareMeter, m_squareFoot };
+            }
+
+            unordered_map<Unit, ConversionData, UnitHash> LoadOrderedRatios(const Unit& unit) override
+            {
+                const double factor = unit == m_squareMeter ? 1 : 0.09290304;
+                return { { m_squareMeter, ConversionData(factor, 0, false) }, { m_squareFoot, ConversionData(factor / 0.09290304, 0, false) } };
+            }
+
+            bool SupportsCategory(const Category& /*target*/) override
+            {
+                return true;
+            }
+
+            unordered_map<int, ExactConversionFactor> LoadExactConversionFactors(const Category& /*c*/) override
+            {
+                return { { SQUARE_METER, AREA_FACTORS.at(SQUARE_METER) }, { SQUARE_FOOT, AREA_FACTORS.at(SQUARE_FOOT) } };
+            }
+
+            Category m_area;
+            Unit m_squareMeter;
+            Unit m_squareFoot;
+        };
+
+        class ExactTestVMCallback : public IUnitConverterVMCallback
+        {
+        public:
+            void DisplayCallback(const wstring& from, const wstring& to) override
+            {
+                lastFrom = from;
+                lastTo = to;
+            }
+
+            void SuggestedValueCallback(const vector<tuple<wstring, Unit>>& /*suggestedValues*/) override
+            {
+            }
+
+            void MaxDigitsReached() override
+            {
+            }
+
+            wstring lastFrom;
+            wstring lastTo;
+        };
+    }
+
+    class ExactUnitConverterTests
+    {
+    public:
+        void TestTryParse()
+        {
+            VERIFY_ARE_EQUAL(L"0.3048", ExactUnitConverter::ToFixedString(Parse(L"0.3048"), 4));
+            VERIFY_ARE_EQUAL(L"-0.3048", ExactUnitConverter::ToFixedString(Parse(L"-0.3048"), 4));
+            VERIFY_ARE_EQUAL(L"2", ExactUnitConverter::ToFixedString(Parse(L"+2"), 0));
+            VERIFY_ARE_EQUAL(L"0.000000001", ExactUnitConverter::ToFixedString(Parse(L"1e-9"), 9));
+            VERIFY_ARE_EQUAL(L"1500", ExactUnitConverter::ToFixedString(Parse(L"1.5e3"), 0));
+            VERIFY_ARE_EQUAL(L"3.305785", ExactUnitConverter::ToFixedString(Parse(L"400/121"), 6));
+            VERIFY_ARE_EQUAL(L"-17.778", ExactUnitConverter::ToFixedString(Parse(L"-160/9"), 3));
+            VERIFY_ARE_EQUAL(L"0.5", ExactUnitConverter::ToFixedString(Parse(L"0.25/0.5"), 1));
+
+            // The fraction is exact, so multiplying it back gives the numerator
+            VERIFY_ARE_EQUAL(L"400.000000000000000000", ExactUnitConverter::ToFixedString(Parse(L"400/121") * 121, 18));
+
+            for (const wchar_t* text : { L"", L"-", L"+", L"abc", L"1x", L"--1", L"+-1", L"1/0", L"1/", L"/2", L"1/2/3", L"0x10", L" 1" })
+            {
+                Rational value{ 7 };
+                VERIFY_IS_FALSE(ExactUnitConverter::TryParse(text, value), text);
+            }
+        }
+
+        void TestToFixedString()
+        {
+            // Rounded half away from zero
+            VERIFY_ARE_EQUAL(L"0.13", ExactUnitConverter::ToFixedString(Parse(L"0.125"), 2));
+            VERIFY_ARE_EQUAL(L"-0.13", ExactUnitConverter::ToFixedString(Parse(L"-0.125"), 2));
+            VERIFY_ARE_EQUAL(L"0.12", ExactUnitConverter::ToFixedString(Parse(L"0.1249999999"), 2));
+            VERIFY_ARE_EQUAL(L"3", ExactUnitConverter::ToFixedString(Parse(L"2.5"), 0));
+            VERIFY_ARE_EQUAL(L"-3", ExactUnitConverter::ToFixedString(Parse(L"-2.5"), 0));
+
+            // Leading zeros are written for values under 1, and trailing ones up to the decimals
+            VERIFY_ARE_EQUAL(L"0.000", ExactUnitConverter::ToFixedString(Rational{}, 3));
+            VERIFY_ARE_EQUAL(L"0.00", ExactUnitConverter::ToFixedString(Parse(L"0.001"), 2));
+            VERIFY_ARE_EQUAL(L"0.01", ExactUnitConverter::ToFixedString(Parse(L"0.005"), 2));
+            VERIFY_ARE_EQUAL(L"1.50000", ExactUnitConverter::ToFixedString(Parse(L"1.5"), 5));
+            VERIFY_ARE_EQUAL(L"0.33333", ExactUnitConverter::ToFixedString(Parse(L"1/3"), 5));
+            VERIFY_ARE_EQUAL(L"0.66667", ExactUnitConverter::ToFixedString(Parse(L"2/3"), 5));
+            VERIFY_ARE_EQUAL(L"123456789012345", ExactUnitConverter::ToFixedString(Parse(L"123456789012345"), 0));
+        }
+
+        void TestToDouble()
+        {
+            VERIFY_ARE_EQUAL(0.0, ExactUnitConverter::ToDouble(Rational{}));
+            for (const wchar_t* text : { L"1", L"0.1", L"-0.3048", L"0.09290304", L"1e-9", L"123456789.123", L"-273.15", L"1e20", L"5e-30" })
+            {
+                VERIFY_IS_TRUE(IsWithinUlps(stod(text), ExactUnitConverter::ToDouble(Parse(text)), 2), text);
+            }
+
+            VERIFY_IS_TRUE(IsWithinUlps(400.0 / 121.0, ExactUnitConverter::ToDouble(Parse(L"400/121")), 2));
+            VERIFY_IS_TRUE(IsWithinUlps(-160.0 / 9.0, ExactUnitConverter::ToDouble(Parse(L"-160/9")), 2));
+        }
+
+        void TestConvert()
+        {
+            ExactUnitConverter converter;
+            VERIFY_IS_TRUE(converter.AddFactors(AREA_FACTORS));
+            VERIFY_IS_TRUE(converter.AddFactors(TEMPERATURE_FACTORS));
+
+            // 1234.5 ft² is 114.68880288 m², which a double can't hold
+            Rational result;
+            VERIFY_IS_TRUE(converter.Convert(SQUARE_FOOT, SQUARE_METER, Parse(L"1234.5"), result));
+            VERIFY_ARE_EQUAL(L"114.6888028800000000", ExactUnitConverter::ToFixedString(result, 16));
+            VERIFY_IS_TRUE(converter.Convert(SQUARE_METER, SQUARE_FOOT, result, result));
+            VERIFY_ARE_EQUAL(L"1234.5000000000000000", ExactUnitConverter::ToFixedString(result, 16));
+
+            VERIFY_IS_TRUE(converter.Convert(PYEONG, SQUARE_METER, Parse(L"121"), result));
+            VERIFY_ARE_EQUAL(L"400.0000000000000000", ExactUnitConverter::ToFixedString(result, 16));
+
+            // The offsets of both units are composed into the pair
+            VERIFY_IS_TRUE(converter.Convert(FAHRENHEIT, CELSIUS, Parse(L"212"), result));
+            VERIFY_ARE_EQUAL(L"100.0000000000000000", ExactUnitConverter::ToFixedString(result, 16));
+            VERIFY_IS_TRUE(converter.Convert(KELVIN, FAHRENHEIT, Rational{}, result));
+            VERIFY_ARE_EQUAL(L"-459.6700000000000000", ExactUnitConverter::ToFixedString(result, 16));
+            VERIFY_IS_TRUE(converter.Convert(FAHRENHEIT, KELVIN, Parse(L"-459.67"), result));
+            VERIFY_ARE_EQUAL(L"0.0000000000000000", ExactUnitConverter::ToFixedString(result, 16));
+
+            // A unit without a factor, or whose factor can't be used, isn't converted
+            Rational unchanged{ 7 };
+            VERIFY_IS_FALSE(converter.Convert(SQUARE_METER, 99, Parse(L"1"), unchanged));
+            VERIFY_IS_FALSE(converter.AddFactors({ { 20, { L"0", L"" } }, { 21, { L"abc", L"" } }, { 22, { L"1", L"1/0" } }, { 23, { L"2", L"" } } }));
+            VERIFY_IS_FALSE(converter.HasFactor(20));
+            VERIFY_IS_FALSE(converter.HasFactor(21));
+            VERIFY_IS_FALSE(converter.HasFactor(22));
+            VERIFY_IS_TRUE(converter.HasFactor(23));
+            VERIFY_ARE_EQUAL(L"7", ExactUnitConverter::ToFixedString(unchanged, 0));
+
+            converter.Clear();
+            VERIFY_IS_FALSE(converter.HasFactor(SQUARE_METER));
+        }
+
+        // In exact mode, the display is rounded from the exact result rather than from the double one
+        void TestUnitConverterExactMode()
+        {
+            auto loader = make_shared<ExactTestConfigLoader>();
+            auto callback = make_shared<ExactTestVMCallback>();
+            UnitConverter unitConverter(loader);
+            unitConverter.SetViewModelCallback(callback);
+            unitConverter.SetCurrentUnitTypes(loader->m_squareFoot, loader->m_squareMeter);
+            VERIFY_IS_FALSE(unitConverter.IsExactMode());
+
+            // 790.721278285288 ft² is 73.46041054538919... m², which the double product rounds up
+            SendDigits(unitConverter, L"790.721278285288");
+            VERIFY_ARE_EQUAL(L"73.4604105453893", callback->lastTo);
+
+            unitConverter.SetExactMode(true);
+            VERIFY_IS_TRUE(unitConverter.IsExactMode());
+            unitConverter.Calculate();
+            VERIFY_ARE_EQUAL(L"790.721278285288", callback->lastFrom);
+            VERIFY_ARE_EQUAL(L"73.4604105453892", callback->lastTo);
+
+            unitConverter.SendCommand(Command::Clear);
+            SendDigits(unitConverter, L"1234.5");
+            VERIFY_ARE_EQUAL(L"114.6888", callback->lastTo);
+        }
+
+    private:
+        static void SendDigits(UnitConverter& unitConverter, wstring_view digits)
+        {
+            for (wchar_t digit : digits)
+            {
+                unitConverter.SendCommand(digit == L'.' ? Command::Decimal : static_cast<Command>(digit - L'0'));
+            }
+        }
+    };
+
+    CALC_TEST_METHOD(ExactUnitConverterTests, TestTryParse);
+    CALC_TEST_METHOD(ExactUnitConverterTests, TestToFixedString);
+    CALC_TEST_METHOD(ExactUnitConverterTests, TestToDouble);
+    CALC_TEST_METHOD(ExactUnitConverterTests, TestConvert);
+    CALC_TEST_METHOD(ExactUnitConverterTests, TestUnitConverterExactMode);
+}
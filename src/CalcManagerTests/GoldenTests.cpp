@@ -0,0 +1,236 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Ratpack/ratpak.h"
+#include "Test.h"
+
+using namespace std;
+using namespace CalcManagerTests;
+
+// The results of Ratpack functions at several precisions, compared with those of Golden/Ratpack.txt, so that a change
+// to Ratpack can be checked to give the same digits as before, and not only the few that the other tests look at.
+//
+// Each line of the corpus is a function, the precision, its operands and the result, separated by tabs, where the
+// result is what the engine would display: RatToString in radix 10 with FMT_FLOAT, or "error" and the calculation
+// error that was thrown. Empty lines and lines that start with '#' are kept as they are.
+namespace CalculatorEngineTests
+{
+    namespace
+    {
+        constexpr uint32_t DECIMAL_RADIX = 10;
+        constexpr const char* RATPACK_CORPUS = "Ratpack.txt";
+
+        using GoldenOperation = void (*)(PRAT* px, PRAT y, int32_t precision);
+
+        struct GoldenFunction
+        {
+            string_view name;
+            size_t operandCount;
+            GoldenOperation operation;
+        };
+
+        const GoldenFunction GOLDEN_FUNCTIONS[] = {
+            { "add", 2, [](PRAT* px, PRAT y, int32_t precision) { addrat(px, y, precision); } },
+            { "sub", 2, [](PRAT* px, PRAT y, int32_t precision) { subrat(px, y, precision); } },
+            { "mul", 2, [](PRAT* px, PRAT y, int32_t precision) { mulrat(px, y, precision); } },
+            { "div", 2, [](PRAT* px, PRAT y, int32_t precision) { divrat(px, y, precision); } },
+            { "mod", 2, [](PRAT* px, PRAT y, int32_t /*precision*/) { modrat(px, y); } },
+            { "pow", 2, [](PRAT* px, PRAT y, int32_t precision) { powrat(px, y, DECIMAL_RADIX, precision); } },
+            { "root", 2, [](PRAT* px, PRAT y, int32_t precision) { rootrat(px, y, DECIMAL_RADIX, precision); } },
+            { "exp", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { exprat(px, DECIMAL_RADIX, precision); } },
+            { "ln", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { lograt(px, precision); } },
+            { "log10", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { log10rat(px, precision); } },
+            { "fact", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { factrat(px, DECIMAL_RADIX, precision); } },
+            { "sin_deg", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { sinanglerat(px, ANGLE_DEG, DECIMAL_RADIX, precision); } },
+            { "sin_rad", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { sinanglerat(px, ANGLE_RAD, DECIMAL_RADIX, precision); } },
+            { "sin_grad", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { sinanglerat(px, ANGLE_GRAD, DECIMAL_RADIX, precision); } },
+            { "cos_deg", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { cosanglerat(px, ANGLE_DEG, DECIMAL_RADIX, precision); } },
+            { "cos_rad", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { cosanglerat(px, ANGLE_RAD, DECIMAL_RADIX, precision); } },
+            { "tan_deg", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { tananglerat(px, ANGLE_DEG, DECIMAL_RADIX, precision); } },
+            { "tan_rad", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { tananglerat(px, ANGLE_RAD, DECIMAL_RADIX, precision); } },
+            { "asin_deg", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { asinanglerat(px, ANGLE_DEG, DECIMAL_RADIX, precision); } },
+            { "acos_rad", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { acosanglerat(px, ANGLE_RAD, DECIMAL_RADIX, precision); } },
+            { "atan_rad", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { atananglerat(px, ANGLE_RAD, DECIMAL_RADIX, precision); } },
+            { "atan_grad", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { atananglerat(px, ANGLE_GRAD, DECIMAL_RADIX, precision); } },
+            { "sinh", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { sinhrat(px, DECIMAL_RADIX, precision); } },
+            { "cosh", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { coshrat(px, DECIMAL_RADIX, precision); } },
+            { "tanh", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { tanhrat(px, DECIMAL_RADIX, precision); } },
+            { "asinh", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { asinhrat(px, DECIMAL_RADIX, precision); } },
+            { "acosh", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { acoshrat(px, DECIMAL_RADIX, precision); } },
+            { "atanh", 1, [](PRAT* px, PRAT /*y*/, int32_t precision) { atanhrat(px, precision); } },
+        };
+
+        vector<string_view> SplitFields(string_view line)
+        {
+            vector<string_view> fields;
+            size_t start = 0;
+            for (size_t tab = line.find('\t'); tab != string_view::npos; tab = line.find('\t', start))
+            {
+                fields.push_back(line.substr(start, tab - start));
+                start = tab + 1;
+            }
+            fields.push_back(line.substr(start));
+            return fields;
+        }
+
+        // The fields are ASCII, so they are widened and narrowed a character at a time
+        wstring ToWide(string_view text)
+        {
+            return wstring(text.begin(), text.end());
+        }
+
+        string ToNarrow(wstring_view text)
+        {
+            string result;
+            result.reserve(text.size());
+            for (wchar_t c : text)
+            {
+                result += static_cast<char>(c);
+            }
+            return result;
+        }
+
+        // An operand is a decimal number, with an optional sign and exponent, e.g. -1.5e-3
+        PRAT ParseOperand(string_view operand, int32_t precision)
+        {
+            bool mantissaIsNegative = !operand.empty() && operand[0] == '-';
+            operand.remove_prefix(mantissaIsNegative ? 1 : 0);
+
+            size_t exponentStart = operand.find('e');
+            string_view mantissa = operand.substr(0, exponentStart);
+            string_view exponent = exponentStart != string_view::npos ? operand.substr(exponentStart + 1) : string_view();
+            bool exponentIsNegative = !exponent.empty() && exponent[0] == '-';
+            exponent.remove_prefix((!exponent.empty() && (exponent[0] == '-' || exponent[0] == '+')) ? 1 : 0);
+
+            return StringToRat(mantissaIsNegative, ToWide(mantissa), exponentIsNegative, ToWide(exponent), DECIMAL_RADIX, precision);
+        }
+
+        string FormatError(uint32_t error)
+        {
+            char text[32];
+            snprintf(text, sizeof(text), "error 0x%08x", error);
+            return text;
+        }
+
+        const GoldenFunction* FindFunction(string_view name)
+        {
+            for (auto const& function : GOLDEN_FUNCTIONS)
+            {
+                if (function.name == name)
+                {
+                    return &function;
+                }
+            }
+
+            return nullptr;
+        }
+
+        // Returns the result of the line, or an empty string if the line isn't valid
+        string Evaluate(vector<string_view> const& fields)
+        {
+            const GoldenFunction* function = fields.size() >= 2 ? FindFunction(fields[0]) : nullptr;
+            int32_t precision = fields.size() >= 2 ? atoi(string(fields[1]).c_str()) : 0;
+            if (function == nullptr || precision <= 0 || fields.size() != function->operandCount + 3)
+            {
+                return string();
+            }
+
+            // As the engine does when its precision changes
+            ChangeConstants(DECIMAL_RADIX, precision);
+
+            PRAT x = nullptr;
+            PRAT y = nullptr;
+            string result;
+            try
+            {
+                x = ParseOperand(fields[2], precision);
+                y = function->operandCount == 2 ? ParseOperand(fields[3], precision) : nullptr;
+                function->operation(&x, y, precision);
+                result = ToNarrow(RatToString(x, FMT_FLOAT, DECIMAL_RADIX, precision));
+            }
+            catch (uint32_t error)
+            {
+                result = FormatError(error);
+            }
+
+            destroyrat(x);
+            destroyrat(y);
+            return result;
+        }
+    }
+
+    class GoldenTests
+    {
+    public:
+        void TestRatpackCorpus()
+        {
+            string path = GetGoldenDirectory() + "/" + RATPACK_CORPUS;
+            ifstream corpus(path);
+            VERIFY_IS_TRUE(corpus.is_open(), ToWide("Can't open " + path + ", see --golden-dir"));
+
+            vector<string> lines;
+            size_t resultCount = 0;
+            size_t mismatchCount = 0;
+            string firstMismatch;
+            for (string line; getline(corpus, line);)
+            {
+                if (line.empty() || line[0] == '#')
+                {
+                    lines.push_back(line);
+                    continue;
+                }
+
+                vector<string_view> fields = SplitFields(line);
+                string result = Evaluate(fields);
+                string location = RATPACK_CORPUS + string("(") + to_string(lines.size() + 1) + ")";
+                VERIFY_IS_FALSE(result.empty(), ToWide(location + ": not a valid line"));
+
+                resultCount++;
+                if (fields.back() != result)
+                {
+                    mismatchCount++;
+                    if (firstMismatch.empty())
+                    {
+                        firstMismatch = location + ": expected " + string(fields.back()) + ", got " + result;
+                    }
+                }
+
+                lines.push_back(line.substr(0, line.size() - fields.back().size()) + result);
+            }
+
+            if (IsUpdatingGolden())
+            {
+                corpus.close();
+                ofstream updatedCorpus(path, ios::trunc);
+                for (auto const& line : lines)
+                {
+                    updatedCorpus << line << '\n';
+                }
+                printf("%s: updated %zu of %zu results\n", path.c_str(), mismatchCount, resultCount);
+                return;
+            }
+
+            VERIFY_IS_TRUE(resultCount > 0, ToWide(path + " has no results"));
+            VERIFY_ARE_EQUAL(0u, mismatchCount, ToWide(to_string(mismatchCount) + " results differ, the first at " + firstMismatch));
+        }
+
+        // A few results that are known independently of Ratpack, so that the corpus can't be updated with wrong ones
+        void TestKnownConstants()
+        {
+            VERIFY_ARE_EQUAL("3.141592653589793238462643383279503", Evaluate({ "acos_rad", "34", "-1", "" }));
+            VERIFY_ARE_EQUAL("2.718281828459045235360287471352662", Evaluate({ "exp", "34", "1", "" }));
+            VERIFY_ARE_EQUAL("1.414213562373095048801688724209698", Evaluate({ "root", "34", "2", "2", "" }));
+            VERIFY_ARE_EQUAL("0.5", Evaluate({ "sin_deg", "32", "30", "" }));
+            VERIFY_ARE_EQUAL("3628800", Evaluate({ "fact", "32", "10", "" }));
+            VERIFY_ARE_EQUAL(FormatError(CALC_E_DIVIDEBYZERO), Evaluate({ "div", "32", "1", "0", "" }));
+        }
+    };
+
+    CALC_TEST_METHOD(GoldenTests, TestRatpackCorpus);
+    CALC_TEST_METHOD(GoldenTests, TestKnownConstants);
+}
@@ -0,0 +1,248 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <memory>
+#include <vector>
+#include "CalculatorManager.h"
+#include "Test.h"
+#include "TestStubs.h"
+
+using namespace CalculationManager;
+using namespace CalcManagerTests;
+using namespace std;
+
+// The history tests of the app, on the calculator manager that its history view model shows. Those that check what
+// the view models display, or how the app stores the history in its settings, stay with the app's tests.
+namespace CalculatorFunctionalTests
+{
+    class HistoryTests
+    {
+    public:
+        HistoryTests()
+            : m_calculatorManager(&m_calculatorDisplay, &m_resourceProvider)
+        {
+            m_calculatorManager.SendCommand(Command::ModeBasic);
+        }
+
+        void TestHistoryItemAddSingleItem()
+        {
+            size_t initialSize = m_calculatorManager.GetHistoryItems().size();
+            SendCommands({ Command::Command1, Command::CommandADD, Command::Command8, Command::CommandEQU });
+            auto historyItem = m_calculatorManager.GetHistoryItem(0);
+            VERIFY_ARE_EQUAL(initialSize + 1, m_calculatorManager.GetHistoryItems().size());
+            VERIFY_ARE_EQUAL(1u, m_calculatorDisplay.HistoryItemAddedCount());
+            VERIFY_ARE_EQUAL(L'\u202d' + wstring(L"1   +   8 =") + L'\u202c', historyItem->historyItemVector.expression);
+            VERIFY_ARE_EQUAL(L"9", historyItem->historyItemVector.result);
+        }
+
+        void TestHistoryItemAddMaxItems()
+        {
+            SendCommands({ Command::Command1, Command::CommandADD, Command::Command1, Command::CommandEQU });
+            for (size_t i = 1; i < m_calculatorManager.MaxHistorySize(); i++)
+            {
+                SendCommands({ Command::Command1, Command::CommandADD, Command::Command2, Command::CommandEQU });
+            }
+            VERIFY_ARE_EQUAL(m_calculatorManager.MaxHistorySize(), m_calculatorManager.GetHistoryItems().size());
+            auto historyItem = m_calculatorManager.GetHistoryItem(0);
+            VERIFY_ARE_EQUAL(L'\u202d' + wstring(L"1   +   1 =") + L'\u202c', historyItem->historyItemVector.expression);
+            VERIFY_ARE_EQUAL(L"2", historyItem->historyItemVector.result);
+
+            // The oldest item makes room for the new one
+            SendCommands({ Command::Command1, Command::CommandADD, Command::Command5, Command::CommandEQU });
+            VERIFY_ARE_EQUAL(m_calculatorManager.MaxHistorySize(), m_calculatorManager.GetHistoryItems().size());
+            historyItem = m_calculatorManager.GetHistoryItem(0);
+            VERIFY_ARE_EQUAL(L'\u202d' + wstring(L"1   +   2 =") + L'\u202c', historyItem->historyItemVector.expression);
+            VERIFY_ARE_EQUAL(L"3", historyItem->historyItemVector.result);
+        }
+
+        // Standard and scientific mode keep their own history
+        void TestReLoadHistory()
+        {
+            const int scientificItems = 5;
+            m_calculatorManager.SendCommand(Command::ModeScientific);
+            for (int i = 0; i < scientificItems; i++)
+            {
+                SendCommands({ Command::Command1, Command::CommandADD, Command(static_cast<int>(Command::Command0) + i), Command::CommandEQU });
+            }
+
+            const int standardItems = 2;
+            m_calculatorManager.SendCommand(Command::ModeBasic);
+            for (int i = 0; i < standardItems; i++)
+            {
+                SendCommands({ Command::Command1, Command::CommandADD, Command(static_cast<int>(Command::Command0) + i), Command::CommandEQU });
+            }
+
+            VerifyAdditionHistory(m_calculatorManager.GetHistoryItems(CM_SCI), scientificItems);
+            VerifyAdditionHistory(m_calculatorManager.GetHistoryItems(CM_STD), standardItems);
+            VerifyAdditionHistory(m_calculatorManager.GetHistoryItems(), standardItems);
+            m_calculatorManager.SendCommand(Command::ModeScientific);
+            VerifyAdditionHistory(m_calculatorManager.GetHistoryItems(), scientificItems);
+        }
+
+        void TestHistoryClearCommand()
+        {
+            m_calculatorManager.SendCommand(Command::ModeScientific);
+            SendCommands({ Command::Command1, Command::CommandADD, Command::Command2, Command::CommandEQU });
+            m_calculatorManager.SendCommand(Command::ModeBasic);
+            SendCommands({ Command::Command1, Command::CommandADD, Command::Command2, Command::CommandEQU });
+
+            // Clears the history of the current mode only
+            m_calculatorManager.ClearHistory();
+            VERIFY_ARE_EQUAL(0u, m_calculatorManager.GetHistoryItems(CM_STD).size());
+            VERIFY_ARE_EQUAL(1u, m_calculatorManager.GetHistoryItems(CM_SCI).size());
+            m_calculatorManager.SendCommand(Command::ModeScientific);
+            m_calculatorManager.ClearHistory();
+            VERIFY_ARE_EQUAL(0u, m_calculatorManager.GetHistoryItems(CM_SCI).size());
+        }
+
+        void TestHistoryClearCommandWithEmptyHistory()
+        {
+            VERIFY_ARE_EQUAL(0u, m_calculatorManager.GetHistoryItems().size());
+            m_calculatorManager.SendCommand(Command::ModeScientific);
+            m_calculatorManager.ClearHistory();
+            VERIFY_ARE_EQUAL(0u, m_calculatorManager.GetHistoryItems().size());
+        }
+
+        void TestRemoveHistoryItem()
+        {
+            for (Command operand : { Command::Command1, Command::Command2, Command::Command3 })
+            {
+                SendCommands({ Command::Command1, Command::CommandADD, operand, Command::CommandEQU });
+            }
+
+            VERIFY_IS_TRUE(m_calculatorManager.RemoveHistoryItem(1));
+            VERIFY_ARE_EQUAL(2u, m_calculatorManager.GetHistoryItems().size());
+            VERIFY_ARE_EQUAL(L"2", m_calculatorManager.GetHistoryItem(0)->historyItemVector.result);
+            VERIFY_ARE_EQUAL(L"4", m_calculatorManager.GetHistoryItem(1)->historyItemVector.result);
+            VERIFY_IS_FALSE(m_calculatorManager.RemoveHistoryItem(2));
+            VERIFY_ARE_EQUAL(2u, m_calculatorManager.GetHistoryItems().size());
+        }
+
+        // The history of both modes survives a snapshot of the calculator, as it does the app being suspended
+        void TestSaveAndReloadHistory()
+        {
+            m_calculatorManager.SendCommand(Command::ModeScientific);
+            SendCommands({ Command::Command1, Command::CommandADD, Command::Command8, Command::CommandEQU });
+            SendCommands({ Command::Command1, Command::CommandADD, Command::Command2, Command::CommandEQU });
+            m_calculatorManager.SendCommand(Command::ModeBasic);
+            SendCommands({ Command::Command1, Command::CommandADD, Command::Command6, Command::CommandEQU });
+            auto itemBeforeSaveAndReload = m_calculatorManager.GetHistoryItems(CM_SCI)[0];
+
+            vector<uint8_t> snapshot(m_calculatorManager.SaveSnapshot(nullptr, 0));
+            m_calculatorManager.SaveSnapshot(snapshot.data(), snapshot.size());
+            TestCalcDisplay calculatorDisplay;
+            CalculatorManager calculatorManager(&calculatorDisplay, &m_resourceProvider);
+            VERIFY_IS_TRUE(calculatorManager.RestoreSnapshot(snapshot.data(), snapshot.size()));
+
+            VERIFY_ARE_EQUAL(1u, calculatorManager.GetHistoryItems(CM_STD).size());
+            VERIFY_ARE_EQUAL(2u, calculatorManager.GetHistoryItems(CM_SCI).size());
+            calculatorManager.SendCommand(Command::ModeScientific);
+            auto historyItem = calculatorManager.GetHistoryItem(0);
+            VERIFY_ARE_EQUAL(L'\u202d' + wstring(L"1   +   8 =") + L'\u202c', historyItem->historyItemVector.expression);
+            VERIFY_ARE_EQUAL(L"9", historyItem->historyItemVector.result);
+            VERIFY_IS_TRUE(itemBeforeSaveAndReload->historyItemVector.spTokens->size() == historyItem->historyItemVector.spTokens->size());
+            VERIFY_IS_TRUE(itemBeforeSaveAndReload->historyItemVector.spCommands->size() == historyItem->historyItemVector.spCommands->size());
+        }
+
+        // An item that is loaded back into the calculator can be continued, and leaves the history as it was
+        void TestHistoryItemLoadAndContinueCalculation()
+        {
+            SendCommands({ Command::Command1, Command::CommandADD, Command::Command5, Command::CommandADD, Command::Command3, Command::CommandEQU });
+            VERIFY_ARE_EQUAL(L"9", m_calculatorDisplay.PrimaryDisplay());
+
+            SendCommands({ Command::CommandADD, Command::Command5, Command::CommandEQU });
+            VERIFY_ARE_EQUAL(L"14", m_calculatorDisplay.PrimaryDisplay());
+            VERIFY_ARE_EQUAL(2u, m_calculatorManager.GetHistoryItems().size());
+            VERIFY_ARE_EQUAL(L"9", m_calculatorManager.GetHistoryItem(0)->historyItemVector.result);
+            VERIFY_ARE_EQUAL(L"14", m_calculatorManager.GetHistoryItem(1)->historyItemVector.result);
+        }
+
+        void TestHistoryEmpty()
+        {
+            VERIFY_ARE_EQUAL(0u, m_calculatorManager.GetHistoryItems().size());
+            m_calculatorManager.SendCommand(Command::ModeScientific);
+            VERIFY_ARE_EQUAL(0u, m_calculatorManager.GetHistoryItems().size());
+            VERIFY_ARE_EQUAL(0u, m_calculatorDisplay.HistoryItemAddedCount());
+        }
+
+        void TestHistoryItemTokensAndCommands()
+        {
+            m_calculatorManager.SendCommand(Command::ModeScientific);
+            SendCommands({ Command::Command1,
+                           Command::CommandPNT,
+                           Command::Command5,
+                           Command::CommandSIGN,
+                           Command::CommandADD,
+                           Command::CommandOPENP,
+                           Command::Command3,
+                           Command::CommandSQR,
+                           Command::CommandCLOSEP,
+                           Command::CommandEQU });
+
+            // The item is stored in a compact form; the tokens and commands rebuilt from it must describe the same expression
+            auto historyItem = m_calculatorManager.GetHistoryItem(0);
+            auto const& tokens = *historyItem->historyItemVector.spTokens;
+            auto const& commands = *historyItem->historyItemVector.spCommands;
+            wstring expression;
+            for (auto const& token : tokens)
+            {
+                expression += (expression.empty() ? L"" : L" ") + token.first;
+                if (token.second != -1)
+                {
+                    VERIFY_IS_TRUE(static_cast<size_t>(token.second) < commands.size());
+                }
+            }
+            VERIFY_ARE_EQUAL(L'\u202d' + expression + L'\u202c', historyItem->historyItemVector.expression);
+
+            VERIFY_IS_TRUE(CommandType::OperandCommand == commands[tokens[0].second]->GetCommandType());
+            auto firstOperand = static_pointer_cast<IOpndCommand>(commands[tokens[0].second]);
+            VERIFY_IS_TRUE(firstOperand->IsNegative());
+            VERIFY_IS_TRUE(firstOperand->IsDecimalPresent());
+            VERIFY_IS_TRUE(
+                (vector<int>{ static_cast<int>(Command::Command1), static_cast<int>(Command::CommandPNT), static_cast<int>(Command::Command5) })
+                == *firstOperand->GetCommands());
+            // Operators are set apart by space tokens, which have no command
+            VERIFY_ARE_EQUAL(-1, tokens[1].second);
+            VERIFY_IS_TRUE(CommandType::BinaryCommand == commands[tokens[2].second]->GetCommandType());
+            VERIFY_ARE_EQUAL(static_cast<int>(Command::CommandADD), static_pointer_cast<IBinaryCommand>(commands[tokens[2].second])->GetCommand());
+
+            // While an item is in use, asking for it again returns the same item
+            VERIFY_IS_TRUE(historyItem == m_calculatorManager.GetHistoryItem(0));
+        }
+
+    private:
+        void SendCommands(initializer_list<Command> commands)
+        {
+            for (Command command : commands)
+            {
+                m_calculatorManager.SendCommand(command);
+            }
+        }
+
+        // The items of 1 + 0, 1 + 1, ..., in that order
+        static void VerifyAdditionHistory(vector<shared_ptr<HISTORYITEM>> const& history, int itemCount)
+        {
+            VERIFY_ARE_EQUAL(static_cast<size_t>(itemCount), history.size());
+            for (int i = 0; i < itemCount; i++)
+            {
+                VERIFY_ARE_EQUAL(L'\u202d' + wstring(L"1   +   ") + to_wstring(i) + L" =" + L'\u202c', history[i]->historyItemVector.expression);
+                VERIFY_ARE_EQUAL(to_wstring(1 + i), history[i]->historyItemVector.result);
+            }
+        }
+
+        TestCalcDisplay m_calculatorDisplay;
+        EnglishResourceProvider m_resourceProvider;
+        CalculatorManager m_calculatorManager;
+    };
+
+    CALC_TEST_METHOD(HistoryTests, TestHistoryItemAddSingleItem);
+    CALC_TEST_METHOD(HistoryTests, TestHistoryItemAddMaxItems);
+    CALC_TEST_METHOD(HistoryTests, TestReLoadHistory);
+    CALC_TEST_METHOD(HistoryTests, TestHistoryClearCommand);
+    CALC_TEST_METHOD(HistoryTests, TestHistoryClearCommandWithEmptyHistory);
+    CALC_TEST_METHOD(HistoryTests, TestRemoveHistoryItem);
+    CALC_TEST_METHOD(HistoryTests, TestSaveAndReloadHistory);
+    CALC_TEST_METHOD(HistoryTests, TestHistoryItemLoadAndContinueCalculation);
+    CALC_TEST_METHOD(HistoryTests, TestHistoryEmpty);
+    CALC_TEST_METHOD(HistoryTests, TestHistoryItemTokensAndCommands);
+}
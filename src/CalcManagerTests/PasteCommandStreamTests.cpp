@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstdint>
+#include <sstream>
+#include "CalculatorManager.h"
+#include "PasteCommandStream.h"
+#include "Test.h"
+#include "TestStubs.h"
+
+using namespace CalculationManager;
+using namespace CalcManagerTests;
+using namespace std;
+
+namespace CalculatorFunctionalTests
+{
+    namespace
+    {
+        // The limits CopyPasteManager::GetMaxOperandLengthAndValue gives each mode
+        constexpr PasteOperandLimits STANDARD_LIMITS = { 16, 0 };
+        constexpr PasteOperandLimits SCIENTIFIC_LIMITS = { 32, 0 };
+        constexpr PasteOperandLimits QWORD_HEX_LIMITS = { 16, UINT64_MAX };
+        constexpr PasteOperandLimits QWORD_DEC_LIMITS = { 19, INT64_MAX };
+        constexpr PasteOperandLimits QWORD_OCT_LIMITS = { 22, UINT64_MAX };
+        constexpr PasteOperandLimits QWORD_BIN_LIMITS = { 64, UINT64_MAX };
+        constexpr PasteOperandLimits BYTE_HEX_LIMITS = { 2, 0xFF };
+        constexpr PasteOperandLimits BYTE_DEC_LIMITS = { 3, 0x7F };
+        constexpr PasteOperandLimits BYTE_OCT_LIMITS = { 3, 0xFF };
+        constexpr PasteOperandLimits BYTE_BIN_LIMITS = { 8, 0xFF };
+    }
+
+    class PasteCommandStreamTests
+    {
+    public:
+        PasteCommandStreamTests()
+            : m_calculatorManager(&m_calculatorDisplay, &m_resourceProvider)
+        {
+        }
+
+        void TestStandardLimits()
+        {
+            m_calculatorManager.SetStandardMode();
+            VERIFY_IS_TRUE(Paste(L"1234567890123456+1=", PasteGrammar::Standard, DEC_RADIX, STANDARD_LIMITS));
+            VERIFY_ARE_EQUAL(L"1,234,567,890,123,457", m_calculatorDisplay.PrimaryDisplay());
+
+            // Neither the leading "0." nor the sign and parentheses count towards the length
+            VERIFY_IS_TRUE(Paste(L"0.1234567890123456", PasteGrammar::Standard, DEC_RADIX, STANDARD_LIMITS));
+            VERIFY_IS_TRUE(Paste(L"-1.234567890123456", PasteGrammar::Standard, DEC_RADIX, STANDARD_LIMITS));
+            VERIFY_IS_TRUE(Paste(L"$1,234,567,890,123,456", PasteGrammar::Standard, DEC_RADIX, STANDARD_LIMITS));
+
+            VERIFY_IS_FALSE(Paste(L"12345678901234567", PasteGrammar::Standard, DEC_RADIX, STANDARD_LIMITS));
+            VERIFY_IS_TRUE(m_calculatorDisplay.IsError());
+            VERIFY_IS_FALSE(Paste(L"1+1.2345678901234567", PasteGrammar::Standard, DEC_RADIX, STANDARD_LIMITS));
+            VERIFY_IS_FALSE(Paste(L"1+12345678901234567=", PasteGrammar::Standard, DEC_RADIX, STANDARD_LIMITS));
+        }
+
+        void TestScientificLimits()
+        {
+            m_calculatorManager.SendCommand(Command::ModeScientific);
+            const wstring digits(32, L'9');
+            VERIFY_IS_TRUE(Paste(L"(" + digits + L")-1=", PasteGrammar::Scientific, DEC_RADIX, SCIENTIFIC_LIMITS));
+            VERIFY_IS_FALSE(m_calculatorDisplay.IsError());
+            VERIFY_IS_FALSE(Paste(L"1+9" + digits, PasteGrammar::Scientific, DEC_RADIX, SCIENTIFIC_LIMITS));
+            VERIFY_IS_TRUE(m_calculatorDisplay.IsError());
+        }
+
+        // Each radix with a quad word, where only the operands of decimal and octal can be too large without being too long
+        void TestProgrammerQwordLimits()
+        {
+            m_calculatorManager.SetProgrammerMode();
+
+            SwitchRadix(Command::CommandHex);
+            VERIFY_IS_TRUE(Paste(L"FFFFFFFFFFFFFFFF", PasteGrammar::Programmer, HEX_RADIX, QWORD_HEX_LIMITS));
+            VERIFY_IS_TRUE(Paste(L"0xFFFFFFFFFFFFFFFFull", PasteGrammar::Programmer, HEX_RADIX, QWORD_HEX_LIMITS));
+            VERIFY_IS_FALSE(Paste(L"1FFFFFFFFFFFFFFFF", PasteGrammar::Programmer, HEX_RADIX, QWORD_HEX_LIMITS));
+
+            SwitchRadix(Command::CommandDec);
+            VERIFY_IS_TRUE(Paste(L"9223372036854775807", PasteGrammar::Programmer, DEC_RADIX, QWORD_DEC_LIMITS));
+            VERIFY_IS_FALSE(m_calculatorDisplay.IsError());
+            VERIFY_IS_FALSE(Paste(L"9223372036854775808", PasteGrammar::Programmer, DEC_RADIX, QWORD_DEC_LIMITS));
+            VERIFY_IS_FALSE(Paste(L"99999999999999999999", PasteGrammar::Programmer, DEC_RADIX, QWORD_DEC_LIMITS));
+
+            SwitchRadix(Command::CommandOct);
+            VERIFY_IS_TRUE(Paste(L"1777777777777777777777", PasteGrammar::Programmer, OCT_RADIX, QWORD_OCT_LIMITS));
+            VERIFY_IS_FALSE(Paste(L"2000000000000000000000", PasteGrammar::Programmer, OCT_RADIX, QWORD_OCT_LIMITS));
+            VERIFY_IS_FALSE(Paste(L"17777777777777777777777", PasteGrammar::Programmer, OCT_RADIX, QWORD_OCT_LIMITS));
+
+            SwitchRadix(Command::CommandBin);
+            const wstring ones(64, L'1');
+            VERIFY_IS_TRUE(Paste(ones, PasteGrammar::Programmer, BIN_RADIX, QWORD_BIN_LIMITS));
+            VERIFY_IS_TRUE(Paste(ones + L"b", PasteGrammar::Programmer, BIN_RADIX, QWORD_BIN_LIMITS));
+            VERIFY_IS_TRUE(Paste(L"0b" + ones + L"ull", PasteGrammar::Programmer, BIN_RADIX, QWORD_BIN_LIMITS));
+            VERIFY_IS_FALSE(Paste(L"1" + ones, PasteGrammar::Programmer, BIN_RADIX, QWORD_BIN_LIMITS));
+        }
+
+        void TestProgrammerByteLimits()
+        {
+            m_calculatorManager.SetProgrammerMode();
+            m_calculatorManager.SendCommand(Command::CommandByte);
+
+            SwitchRadix(Command::CommandHex);
+            VERIFY_IS_TRUE(Paste(L"F+FF-1=", PasteGrammar::Programmer, HEX_RADIX, BYTE_HEX_LIMITS));
+            VERIFY_ARE_EQUAL(L"D", m_calculatorDisplay.PrimaryDisplay());
+            VERIFY_IS_FALSE(Paste(L"F+100", PasteGrammar::Programmer, HEX_RADIX, BYTE_HEX_LIMITS));
+
+            SwitchRadix(Command::CommandDec);
+            VERIFY_IS_TRUE(Paste(L"127", PasteGrammar::Programmer, DEC_RADIX, BYTE_DEC_LIMITS));
+            VERIFY_ARE_EQUAL(L"127", m_calculatorDisplay.PrimaryDisplay());
+            VERIFY_IS_FALSE(Paste(L"128", PasteGrammar::Programmer, DEC_RADIX, BYTE_DEC_LIMITS));
+            VERIFY_IS_FALSE(Paste(L"1000", PasteGrammar::Programmer, DEC_RADIX, BYTE_DEC_LIMITS));
+
+            SwitchRadix(Command::CommandOct);
+            VERIFY_IS_TRUE(Paste(L"377", PasteGrammar::Programmer, OCT_RADIX, BYTE_OCT_LIMITS));
+            VERIFY_IS_FALSE(Paste(L"400", PasteGrammar::Programmer, OCT_RADIX, BYTE_OCT_LIMITS));
+            VERIFY_IS_FALSE(Paste(L"1000", PasteGrammar::Programmer, OCT_RADIX, BYTE_OCT_LIMITS));
+
+            SwitchRadix(Command::CommandBin);
+            VERIFY_IS_TRUE(Paste(L"11111111", PasteGrammar::Programmer, BIN_RADIX, BYTE_BIN_LIMITS));
+            VERIFY_IS_FALSE(Paste(L"111111111", PasteGrammar::Programmer, BIN_RADIX, BYTE_BIN_LIMITS));
+        }
+
+        // An operand can't be longer than the buffer, whatever the limits, so the memory of a paste stays bounded
+        void TestOperandBufferLimit()
+        {
+            m_calculatorManager.SetStandardMode();
+            constexpr PasteOperandLimits unlimited = { SIZE_MAX, 0 };
+            VERIFY_IS_TRUE(Paste(wstring(PasteCommandStream::MaxBufferedOperandLength, L'0'), PasteGrammar::Standard, DEC_RADIX, unlimited));
+            VERIFY_IS_FALSE(Paste(wstring(PasteCommandStream::MaxBufferedOperandLength + 1, L'0'), PasteGrammar::Standard, DEC_RADIX, unlimited));
+        }
+
+    private:
+        // The engine ignores the radix while it shows the error of an invalid paste
+        void SwitchRadix(Command radix)
+        {
+            m_calculatorManager.SendCommand(Command::CommandCLEAR);
+            m_calculatorManager.SendCommand(radix);
+        }
+
+        bool Paste(wstring const& text, PasteGrammar grammar, RADIX_TYPE radix, PasteOperandLimits const& limits)
+        {
+            m_calculatorManager.SendCommand(Command::CommandCLEAR);
+            PasteCommandStream stream(m_calculatorManager, grammar, radix, limits);
+            wistringstream input(text);
+            return stream.Paste(input);
+        }
+
+        TestCalcDisplay m_calculatorDisplay;
+        EnglishResourceProvider m_resourceProvider;
+        CalculatorManager m_calculatorManager;
+    };
+
+    CALC_TEST_METHOD(PasteCommandStreamTests, TestStandardLimits);
+    CALC_TEST_METHOD(PasteCommandStreamTests, TestScientificLimits);
+    CALC_TEST_METHOD(PasteCommandStreamTests, TestProgrammerQwordLimits);
+    CALC_TEST_METHOD(PasteCommandStreamTests, TestProgrammerByteLimits);
+    CALC_TEST_METHOD(PasteCommandStreamTests, TestOperandBufferLimit);
+}
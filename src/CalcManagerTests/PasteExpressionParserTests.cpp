@@ -0,0 +1,240 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+#include "PasteExpressionParser.h"
+#include "Test.h"
+
+using namespace CalculationManager;
+using namespace std;
+
+namespace CalculatorFunctionalTests
+{
+    namespace
+    {
+        // The limits CopyPasteManager gives the parser
+        constexpr size_t MAX_OPERAND_COUNT = 100;
+        constexpr size_t MAX_EXPONENT_LENGTH = 4;
+
+        // The patterns CopyPasteManager matched operands against before the parser replaced them
+        const wstring WSPC = L"[\\s\\x85]*";
+        const wstring WSPC_LPARENS = WSPC + L"[(]*" + WSPC;
+        const wstring WSPC_LPAREN_SIGNED = WSPC + L"([-+]?[(])*" + WSPC;
+        const wstring WSPC_RPARENS = WSPC + L"[)]*" + WSPC;
+        const wstring SIGNED_DEC_FLOAT = L"(?:[-+]?(?:\\d+(\\.\\d*)?|\\.\\d+))";
+        const wstring OPTIONAL_E_NOTATION = L"(?:e[+-]?\\d+)?";
+        const wstring HEX_PROGRAMMER_CHARS = L"([a-f]|[A-F]|\\d)+((_|'|`)([a-f]|[A-F]|\\d)+)*";
+        const wstring DEC_PROGRAMMER_CHARS = L"\\d+((_|'|`)\\d+)*";
+        const wstring OCT_PROGRAMMER_CHARS = L"[0-7]+((_|'|`)[0-7]+)*";
+        const wstring BIN_PROGRAMMER_CHARS = L"[0-1]+((_|'|`)[0-1]+)*";
+        const wstring UINT_SUFFIXES = L"[uU]?[lL]{0,2}";
+
+        struct RegexGrammar
+        {
+            PasteGrammar grammar;
+            RADIX_TYPE radix;
+            vector<wregex> patterns;
+        };
+
+        vector<RegexGrammar> MakeRegexGrammars()
+        {
+            return {
+                { PasteGrammar::Standard, DEC_RADIX, { wregex(WSPC + SIGNED_DEC_FLOAT + OPTIONAL_E_NOTATION + WSPC) } },
+                { PasteGrammar::Scientific,
+                  DEC_RADIX,
+                  { wregex(L"(" + WSPC + L"[-+]?)|(" + WSPC_LPAREN_SIGNED + L")" + SIGNED_DEC_FLOAT + OPTIONAL_E_NOTATION + WSPC_RPARENS) } },
+                { PasteGrammar::Converter, DEC_RADIX, { wregex(WSPC + SIGNED_DEC_FLOAT + WSPC) } },
+                { PasteGrammar::Programmer,
+                  HEX_RADIX,
+                  { wregex(WSPC_LPARENS + L"(0[xX])?" + HEX_PROGRAMMER_CHARS + UINT_SUFFIXES + WSPC_RPARENS),
+                    wregex(WSPC_LPARENS + HEX_PROGRAMMER_CHARS + L"[hH]?" + WSPC_RPARENS) } },
+                { PasteGrammar::Programmer,
+                  DEC_RADIX,
+                  { wregex(WSPC_LPARENS + L"[-+]?" + DEC_PROGRAMMER_CHARS + L"[lL]{0,2}" + WSPC_RPARENS),
+                    wregex(WSPC_LPARENS + L"(0[nN])?" + DEC_PROGRAMMER_CHARS + UINT_SUFFIXES + WSPC_RPARENS) } },
+                { PasteGrammar::Programmer, OCT_RADIX, { wregex(WSPC_LPARENS + L"(0[otOT])?" + OCT_PROGRAMMER_CHARS + UINT_SUFFIXES + WSPC_RPARENS) } },
+                { PasteGrammar::Programmer,
+                  BIN_RADIX,
+                  { wregex(WSPC_LPARENS + L"(0[byBY])?" + BIN_PROGRAMMER_CHARS + UINT_SUFFIXES + WSPC_RPARENS),
+                    wregex(WSPC_LPARENS + BIN_PROGRAMMER_CHARS + L"[bB]?" + WSPC_RPARENS) } },
+            };
+        }
+
+        // The pieces random operands are made of: the characters of every grammar, and the prefixes and suffixes whole,
+        // as they would rarely come up one character at a time
+        const wstring_view OPERAND_PIECES[] = { L" ",  L"\t", L"\x85", L"(",  L")",  L"-",  L"+",   L".",  L"e",  L"E",  L"0",  L"1",  L"5",
+                                                L"7",  L"8",  L"9",    L"a",  L"F",  L"h",  L"H",   L"x",  L"X",  L"n",  L"o",  L"t",  L"b",
+                                                L"B",  L"y",  L"u",    L"U",  L"l",  L"L",  L"_",   L"'",  L"`",  L"0x", L"0n", L"0o", L"0T",
+                                                L"0b", L"0Y", L"ull",  L"UL", L"e+", L"e-", L"-(", L"12", L"01", L"*",  L"%",  L"z" };
+
+        bool IsValidExpression(wstring_view expression, PasteGrammar grammar, RADIX_TYPE radix)
+        {
+            vector<wstring_view> operands;
+            if (PasteExpressionParser::ExtractOperands(expression, grammar, MAX_OPERAND_COUNT, MAX_EXPONENT_LENGTH, operands)
+                    != ExtractOperandsResult::Success
+                || operands.empty())
+            {
+                return false;
+            }
+
+            // The unit converter takes the whole expression as its operand
+            if (grammar == PasteGrammar::Converter)
+            {
+                operands.assign(1, expression);
+            }
+
+            return all_of(operands.begin(), operands.end(), [grammar, radix](wstring_view operand) {
+                return PasteExpressionParser::IsValidOperand(operand, grammar, radix);
+            });
+        }
+    }
+
+    class PasteExpressionParserTests
+    {
+    public:
+        // Random operands, of up to a dozen pieces, are valid for the parser exactly when they matched one of the patterns
+        void TestOperandsMatchRegexes()
+        {
+            mt19937 generator(27);
+            uniform_int_distribution<size_t> pieceCount(0, 12);
+            uniform_int_distribution<size_t> piece(0, size(OPERAND_PIECES) - 1);
+            for (const RegexGrammar& regexGrammar : MakeRegexGrammars())
+            {
+                size_t validCount = 0;
+                for (int i = 0; i < 10000; i++)
+                {
+                    wstring operand;
+                    for (size_t count = pieceCount(generator); count > 0; count--)
+                    {
+                        operand += OPERAND_PIECES[piece(generator)];
+                    }
+
+                    const bool isRegexMatch = any_of(regexGrammar.patterns.begin(), regexGrammar.patterns.end(), [&operand](const wregex& pattern) {
+                        return regex_match(operand, pattern);
+                    });
+                    const bool isValid = PasteExpressionParser::IsValidOperand(operand, regexGrammar.grammar, regexGrammar.radix);
+                    VERIFY_ARE_EQUAL(isRegexMatch, isValid, L"\"" + operand + L"\", radix " + to_wstring(regexGrammar.radix));
+                    validCount += isValid ? 1 : 0;
+                }
+
+                // Enough of them are valid that both answers are compared
+                VERIFY_IS_GREATER_THAN(validCount, 50u, to_wstring(validCount));
+            }
+        }
+
+        void TestStandardExpressions()
+        {
+            VerifyExpressions(
+                PasteGrammar::Standard,
+                DEC_RADIX,
+                { L"1", L"-1", L"+1", L"1.", L".5", L"1.5e10", L"1e-4", L"1e+4", L"2*3/4", L"1+-2", L"1e4-5", L"-1.5e3*2", L"0009.9000" },
+                { L"", L"e5", L"1e", L"1e+", L"1..5", L".", L"-", L"1+", L"(1)", L"1^2", L"5%", L"1E5", L"0x10", L"1e12345", L"1.5.", L"a" });
+        }
+
+        // Parentheses, powers and a lone sign, as in "-(1)", are valid only here, and so is an empty operand, which the
+        // lone sign pattern matched too
+        void TestScientificExpressions()
+        {
+            VerifyExpressions(
+                PasteGrammar::Scientific,
+                DEC_RADIX,
+                { L"(1+2)*3", L"-(1)", L"+(-(2))", L"((1.5e3))", L"2^10", L"5%", L"-", L"", L"2^^3", L"(1)-(2)", L"1e-5^2", L"((1)" },
+                { L"()", L"1(2)", L"(1e)", L"(-)", L"1e12345", L"(1)e5", L"2^.", L"0x1F", L")1(" });
+        }
+
+        void TestConverterExpressions()
+        {
+            VerifyExpressions(
+                PasteGrammar::Converter, DEC_RADIX, { L"1", L"-1.5", L"+.5", L"12.", L"0" }, { L"", L"1e5", L"1+2", L"(1)", L"--1", L"1-", L".", L"1 2" });
+        }
+
+        void TestProgrammerExpressions()
+        {
+            VerifyExpressions(
+                PasteGrammar::Programmer,
+                HEX_RADIX,
+                { L"FF", L"0xFFull", L"0XaBcD", L"47CDh", L"DEAD'BEEF", L"1_2`3", L"(0x1F)+1", L"FFu*2", L"1%3" },
+                { L"", L"0x", L"FFh'0", L"G1", L"0xFFh", L"1__2", L"1_", L"_1", L"FFull h", L"1e5+", L"-1" });
+            VerifyExpressions(
+                PasteGrammar::Programmer,
+                DEC_RADIX,
+                { L"-145", L"145", L"0n145", L"123ull", L"-9ll", L"1'000'000", L"(5)-(3)", L"1+-2" },
+                { L"", L"0n", L"-0n1", L"-1u", L"1.5", L"1e5", L"A", L"0x10", L"1lll" });
+            VerifyExpressions(
+                PasteGrammar::Programmer,
+                OCT_RADIX,
+                { L"06", L"010", L"0t77", L"0o77", L"0O7", L"077ull", L"7_7", L"1+2" },
+                { L"", L"8", L"0o", L"0x7", L"77h", L"-7", L"0o8" });
+            VerifyExpressions(
+                PasteGrammar::Programmer,
+                BIN_RADIX,
+                { L"011010110", L"1001b", L"0b1001", L"0y1001", L"0b1001ull", L"0b", L"1'0", L"10B" },
+                { L"", L"2", L"0b2", L"0b1001b", L"1b1", L"0x1", L"1bull" });
+        }
+
+        // An expression is split into at most 100 operands, and an exponent can't be longer than 4 digits
+        void TestExtractOperandsLimits()
+        {
+            vector<wstring_view> operands;
+            wstring expression = L"1";
+            for (size_t i = 1; i < MAX_OPERAND_COUNT; i++)
+            {
+                expression += L"+1";
+            }
+            VERIFY_ARE_EQUAL(
+                ExtractOperandsResult::Success,
+                PasteExpressionParser::ExtractOperands(expression, PasteGrammar::Standard, MAX_OPERAND_COUNT, MAX_EXPONENT_LENGTH, operands));
+            VERIFY_ARE_EQUAL(MAX_OPERAND_COUNT, operands.size());
+
+            expression += L"+1";
+            VERIFY_ARE_EQUAL(
+                ExtractOperandsResult::TooManyOperands,
+                PasteExpressionParser::ExtractOperands(expression, PasteGrammar::Standard, MAX_OPERAND_COUNT, MAX_EXPONENT_LENGTH, operands));
+            VERIFY_IS_TRUE(operands.empty());
+
+            VERIFY_ARE_EQUAL(
+                ExtractOperandsResult::Success,
+                PasteExpressionParser::ExtractOperands(L"1e+9999*2", PasteGrammar::Scientific, MAX_OPERAND_COUNT, MAX_EXPONENT_LENGTH, operands));
+            VERIFY_ARE_EQUAL(2u, operands.size());
+            VERIFY_ARE_EQUAL(L"1e+9999", operands[0]);
+            VERIFY_ARE_EQUAL(
+                ExtractOperandsResult::ExponentTooLong,
+                PasteExpressionParser::ExtractOperands(L"1e+12345", PasteGrammar::Scientific, MAX_OPERAND_COUNT, MAX_EXPONENT_LENGTH, operands));
+            VERIFY_IS_TRUE(operands.empty());
+
+            // The programmer grammar has no exponent, and e is a hexadecimal digit
+            VERIFY_ARE_EQUAL(
+                ExtractOperandsResult::Success,
+                PasteExpressionParser::ExtractOperands(L"1e12345", PasteGrammar::Programmer, MAX_OPERAND_COUNT, MAX_EXPONENT_LENGTH, operands));
+            VERIFY_ARE_EQUAL(1u, operands.size());
+        }
+
+    private:
+        static void VerifyExpressions(
+            PasteGrammar grammar,
+            RADIX_TYPE radix,
+            initializer_list<const wchar_t*> accepted,
+            initializer_list<const wchar_t*> rejected)
+        {
+            for (const wchar_t* expression : accepted)
+            {
+                VERIFY_IS_TRUE(IsValidExpression(expression, grammar, radix), expression);
+            }
+            for (const wchar_t* expression : rejected)
+            {
+                VERIFY_IS_FALSE(IsValidExpression(expression, grammar, radix), expression);
+            }
+        }
+    };
+
+    CALC_TEST_METHOD(PasteExpressionParserTests, TestOperandsMatchRegexes);
+    CALC_TEST_METHOD(PasteExpressionParserTests, TestStandardExpressions);
+    CALC_TEST_METHOD(PasteExpressionParserTests, TestScientificExpressions);
+    CALC_TEST_METHOD(PasteExpressionParserTests, TestConverterExpressions);
+    CALC_TEST_METHOD(PasteExpressionParserTests, TestProgrammerExpressions);
+    CALC_TEST_METHOD(PasteExpressionParserTests, TestExtractOperandsLimits);
+}
@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "CalculatorManager.h"
+#include "Test.h"
+#include "TestStubs.h"
+
+using namespace CalculationManager;
+using namespace CalcManagerTests;
+using namespace std;
+
+namespace CalculatorFunctionalTests
+{
+    namespace
+    {
+        uint64_t Sum(const uint64_t (&counts)[SIZE_CLASS_COUNT])
+        {
+            uint64_t sum = 0;
+            for (uint64_t count : counts)
+            {
+                sum += count;
+            }
+            return sum;
+        }
+    }
+
+    class RatpackCountersTests
+    {
+    public:
+        RatpackCountersTests()
+            : m_calculatorManager(&m_calculatorDisplay, &m_resourceProvider)
+        {
+            m_calculatorManager.SendCommand(Command::ModeScientific);
+            CalculatorManager::ResetRatpackCounters();
+        }
+
+        ~RatpackCountersTests()
+        {
+            CalculatorManager::EnableRatpackCounters(false);
+            CalculatorManager::ResetRatpackCounters();
+        }
+
+        void TestCountersAreOffByDefault()
+        {
+            SendCommands({ Command::Command2, Command::CommandPOWE });
+            RATPACK_COUNTERS counters = CalculatorManager::GetRatpackCounters();
+            VERIFY_ARE_EQUAL(0u, counters.numberAllocations);
+            VERIFY_ARE_EQUAL(0u, counters.seriesTerms[SERIES_EXP]);
+        }
+
+        // e^2.5 allocates numbers, multiplies and divides them, and sums the terms of the series of exp for its
+        // fractional part
+        void TestCountersOfCommand()
+        {
+            SendCommands({ Command::Command2, Command::CommandPNT, Command::Command5 });
+            CalculatorManager::EnableRatpackCounters(true);
+            m_calculatorManager.SendCommand(Command::CommandPOWE);
+            CalculatorManager::EnableRatpackCounters(false);
+
+            RATPACK_COUNTERS counters = CalculatorManager::GetRatpackCounters();
+            VERIFY_IS_TRUE(counters.numberAllocations > 0);
+            VERIFY_IS_TRUE(counters.numberBytes > counters.numberAllocations);
+            VERIFY_IS_TRUE(counters.ratAllocations > 0);
+            VERIFY_IS_TRUE(Sum(counters.multiplications) > 0);
+            VERIFY_IS_TRUE(counters.digitProducts >= Sum(counters.multiplications));
+            VERIFY_IS_TRUE(Sum(counters.divisions) > 0);
+            VERIFY_IS_TRUE(counters.seriesTerms[SERIES_EXP] > 0);
+            VERIFY_ARE_EQUAL(0u, counters.seriesTerms[SERIES_SIN]);
+
+            // Off, the counters keep their values until they are reset
+            SendCommands({ Command::Command3, Command::CommandSIN });
+            VERIFY_ARE_EQUAL(counters.numberAllocations, CalculatorManager::GetRatpackCounters().numberAllocations);
+            CalculatorManager::ResetRatpackCounters();
+            VERIFY_ARE_EQUAL(0u, CalculatorManager::GetRatpackCounters().numberAllocations);
+            VERIFY_ARE_EQUAL(0u, CalculatorManager::GetRatpackCounters().seriesTerms[SERIES_EXP]);
+        }
+
+        // The counts of each command add up, so a session can be attributed command by command
+        void TestCountersAccumulate()
+        {
+            CalculatorManager::EnableRatpackCounters(true);
+            SendCommands({ Command::Command3, Command::CommandSIN });
+            RATPACK_COUNTERS first = CalculatorManager::GetRatpackCounters();
+            SendCommands({ Command::Command3, Command::CommandSIN });
+            RATPACK_COUNTERS both = CalculatorManager::GetRatpackCounters();
+
+            VERIFY_IS_TRUE(first.seriesTerms[SERIES_SIN] > 0);
+            VERIFY_ARE_EQUAL(2 * first.seriesTerms[SERIES_SIN], both.seriesTerms[SERIES_SIN]);
+            VERIFY_IS_TRUE(both.numberAllocations > first.numberAllocations);
+        }
+
+    private:
+        void SendCommands(initializer_list<Command> commands)
+        {
+            for (Command command : commands)
+            {
+                m_calculatorManager.SendCommand(command);
+            }
+        }
+
+        TestCalcDisplay m_calculatorDisplay;
+        EnglishResourceProvider m_resourceProvider;
+        CalculatorManager m_calculatorManager;
+    };
+
+    CALC_TEST_METHOD(RatpackCountersTests, TestCountersAreOffByDefault);
+    CALC_TEST_METHOD(RatpackCountersTests, TestCountersOfCommand);
+    CALC_TEST_METHOD(RatpackCountersTests, TestCountersAccumulate);
+}
@@ -0,0 +1,325 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "CalculatorSessionStore.h"
+#include "MappedFile.h"
+#include "Test.h"
+#include "TestStubs.h"
+
+using namespace CalculationManager;
+using namespace CalcManagerTests;
+using namespace std;
+
+namespace CalculatorFunctionalTests
+{
+    namespace
+    {
+        // The layout of the file, as CalculatorSessionStore.cpp describes it
+        constexpr size_t SESSION_FILE_HEADER_SIZE = 16;
+        constexpr size_t DATA_END_OFFSET = 8;
+        constexpr size_t RECORD_HEADER_SIZE = 16;
+        constexpr uint32_t REMOVED_RECORD_SIZE = 0xFFFFFFFF;
+
+        struct RecordHeader
+        {
+            size_t offset;
+            uint64_t sessionId;
+            uint32_t capacity;
+            uint32_t size;
+        };
+
+        uint32_t ReadUInt32(vector<uint8_t> const& data, size_t offset)
+        {
+            return data[offset] | data[offset + 1] << 8 | data[offset + 2] << 16 | static_cast<uint32_t>(data[offset + 3]) << 24;
+        }
+
+        uint64_t ReadUInt64(vector<uint8_t> const& data, size_t offset)
+        {
+            return ReadUInt32(data, offset) | static_cast<uint64_t>(ReadUInt32(data, offset + 4)) << 32;
+        }
+
+        void PatchUInt32(vector<uint8_t>& data, size_t offset, uint32_t value)
+        {
+            for (size_t i = 0; i < sizeof(uint32_t); i++)
+            {
+                data[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+            }
+        }
+
+        void PatchUInt64(vector<uint8_t>& data, size_t offset, uint64_t value)
+        {
+            PatchUInt32(data, offset, static_cast<uint32_t>(value));
+            PatchUInt32(data, offset + 4, static_cast<uint32_t>(value >> 32));
+        }
+
+        vector<uint8_t> ReadFile(filesystem::path const& path)
+        {
+            ifstream file(path, ios::binary);
+            return vector<uint8_t>((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+        }
+
+        void WriteFile(filesystem::path const& path, vector<uint8_t> const& data)
+        {
+            ofstream file(path, ios::binary | ios::trunc);
+            file.write(reinterpret_cast<const char*>(data.data()), static_cast<streamsize>(data.size()));
+        }
+
+        vector<RecordHeader> ReadRecordHeaders(vector<uint8_t> const& data)
+        {
+            vector<RecordHeader> records;
+            uint64_t dataEnd = ReadUInt64(data, DATA_END_OFFSET);
+            for (size_t offset = SESSION_FILE_HEADER_SIZE; offset < dataEnd;)
+            {
+                RecordHeader record{ offset, ReadUInt64(data, offset), ReadUInt32(data, offset + 8), ReadUInt32(data, offset + 12) };
+                records.push_back(record);
+                offset += RECORD_HEADER_SIZE + record.capacity;
+            }
+            return records;
+        }
+
+        // A session whose history holds digit * 2, which tells the sessions apart
+        void MakeSession(CalculatorManager& calculatorManager, int digit)
+        {
+            calculatorManager.SetScientificMode();
+            for (Command command : { Command(static_cast<int>(Command::Command0) + digit), Command::CommandMUL, Command::Command2, Command::CommandEQU })
+            {
+                calculatorManager.SendCommand(command);
+            }
+        }
+
+        bool IsSession(CalculatorManager& calculatorManager, int digit)
+        {
+            auto history = calculatorManager.GetHistoryItems(CM_SCI);
+            return history.size() == 1 && history[0]->historyItemVector.result == to_wstring(digit * 2);
+        }
+    }
+
+    class SessionStoreTests
+    {
+    public:
+        SessionStoreTests()
+            : m_path(filesystem::temp_directory_path() / L"CalcManagerTests.sessions")
+        {
+            filesystem::remove(m_path);
+        }
+
+        ~SessionStoreTests()
+        {
+            filesystem::remove(m_path);
+        }
+
+        void TestRoundTrip()
+        {
+            {
+                CalculatorSessionStore store(&m_calculatorDisplay, &m_resourceProvider, 2);
+                VERIFY_IS_TRUE(store.Open(m_path));
+                MakeSessions(store, { 1, 2, 3 });
+                VERIFY_ARE_EQUAL(3u, store.GetSessionCount());
+            }
+
+            CalculatorSessionStore store(&m_calculatorDisplay, &m_resourceProvider, 2);
+            VERIFY_IS_TRUE(store.Open(m_path));
+            VERIFY_ARE_EQUAL(3u, store.GetSessionCount());
+            VERIFY_ARE_EQUAL(0u, store.GetLiveSessionCount());
+            for (int digit : { 3, 1, 2 })
+            {
+                VERIFY_IS_TRUE(IsSession(*store.GetSession(digit), digit));
+            }
+
+            // A session that was never saved starts as a new calculator, even in a calculator that is reused
+            CalculatorManager* newSession = store.GetSession(4);
+            VERIFY_IS_NOT_NULL(newSession);
+            VERIFY_ARE_EQUAL(0u, newSession->GetHistoryItems(CM_SCI).size());
+            VERIFY_ARE_EQUAL(4u, store.GetSessionCount());
+        }
+
+        // The least recently used live session is saved, and its calculator restores the session that is asked for
+        void TestEviction()
+        {
+            CalculatorSessionStore store(&m_calculatorDisplay, &m_resourceProvider, 2);
+            VERIFY_IS_TRUE(store.Open(m_path));
+            CalculatorManager* session1 = store.GetSession(1);
+            MakeSession(*session1, 1);
+            CalculatorManager* session2 = store.GetSession(2);
+            MakeSession(*session2, 2);
+            VERIFY_ARE_EQUAL(session1, store.GetSession(1));
+            VERIFY_ARE_EQUAL(2u, store.GetLiveSessionCount());
+
+            // Session 2 is now the least recently used one
+            CalculatorManager* session3 = store.GetSession(3);
+            VERIFY_ARE_EQUAL(session2, session3);
+            VERIFY_ARE_EQUAL(2u, store.GetLiveSessionCount());
+            VERIFY_ARE_EQUAL(0u, session3->GetHistoryItems(CM_SCI).size());
+            MakeSession(*session3, 3);
+
+            CalculatorManager* restored2 = store.GetSession(2);
+            VERIFY_ARE_EQUAL(session1, restored2);
+            VERIFY_IS_TRUE(IsSession(*restored2, 2));
+            VERIFY_IS_TRUE(IsSession(*store.GetSession(1), 1));
+            VERIFY_IS_TRUE(IsSession(*store.GetSession(3), 3));
+            VERIFY_ARE_EQUAL(3u, store.GetSessionCount());
+        }
+
+        // A removed record is reused by the next snapshot that fits in it
+        void TestRecordReuse()
+        {
+            {
+                CalculatorSessionStore store(&m_calculatorDisplay, &m_resourceProvider, 4);
+                VERIFY_IS_TRUE(store.Open(m_path));
+                MakeSessions(store, { 1, 2 });
+                VERIFY_IS_TRUE(store.Flush());
+                VERIFY_IS_TRUE(store.RemoveSession(1));
+                VERIFY_IS_FALSE(store.RemoveSession(1));
+            }
+
+            // The removed record keeps its session id, and is found by it
+            vector<RecordHeader> records = ReadRecordHeaders(ReadFile(m_path));
+            VERIFY_ARE_EQUAL(2u, records.size());
+            size_t removed = records[0].sessionId == 1 ? 0 : 1;
+            VERIFY_ARE_EQUAL(1u, records[removed].sessionId);
+            VERIFY_ARE_EQUAL(REMOVED_RECORD_SIZE, records[removed].size);
+            VERIFY_ARE_EQUAL(2u, records[1 - removed].sessionId);
+
+            {
+                CalculatorSessionStore store(&m_calculatorDisplay, &m_resourceProvider, 4);
+                VERIFY_IS_TRUE(store.Open(m_path));
+                VERIFY_ARE_EQUAL(1u, store.GetSessionCount());
+                MakeSessions(store, { 5 });
+            }
+
+            vector<RecordHeader> reusedRecords = ReadRecordHeaders(ReadFile(m_path));
+            VERIFY_ARE_EQUAL(2u, reusedRecords.size());
+            VERIFY_ARE_EQUAL(5u, reusedRecords[removed].sessionId);
+            VERIFY_ARE_EQUAL(records[removed].capacity, reusedRecords[removed].capacity);
+            VERIFY_IS_TRUE(reusedRecords[removed].size <= reusedRecords[removed].capacity);
+
+            CalculatorSessionStore store(&m_calculatorDisplay, &m_resourceProvider, 4);
+            VERIFY_IS_TRUE(store.Open(m_path));
+            VERIFY_IS_TRUE(IsSession(*store.GetSession(5), 5));
+            VERIFY_IS_TRUE(IsSession(*store.GetSession(2), 2));
+        }
+
+        void TestRejectsCorruptFile()
+        {
+            {
+                CalculatorSessionStore store(&m_calculatorDisplay, &m_resourceProvider, 4);
+                VERIFY_IS_TRUE(store.Open(m_path));
+                MakeSessions(store, { 1, 2 });
+            }
+
+            const vector<uint8_t> data = ReadFile(m_path);
+            vector<RecordHeader> records = ReadRecordHeaders(data);
+            VERIFY_ARE_EQUAL(2u, records.size());
+            const uint64_t dataEnd = ReadUInt64(data, DATA_END_OFFSET);
+
+            auto verifyRejected = [&](vector<uint8_t> const& corrupted, wchar_t const* message) {
+                WriteFile(m_path, corrupted);
+                CalculatorSessionStore store(&m_calculatorDisplay, &m_resourceProvider, 4);
+                VERIFY_IS_FALSE(store.Open(m_path), message);
+                VERIFY_IS_NULL(store.GetSession(1), message);
+            };
+
+            vector<uint8_t> corrupted = data;
+            PatchUInt32(corrupted, 0, 0x12345678);
+            verifyRejected(corrupted, L"magic");
+
+            corrupted = data;
+            PatchUInt32(corrupted, 4, 2);
+            verifyRejected(corrupted, L"version");
+
+            corrupted = data;
+            PatchUInt64(corrupted, DATA_END_OFFSET, data.size() + 1);
+            verifyRejected(corrupted, L"end of the records past the end of the file");
+
+            corrupted = data;
+            PatchUInt64(corrupted, DATA_END_OFFSET, SESSION_FILE_HEADER_SIZE - 1);
+            verifyRejected(corrupted, L"end of the records in the header");
+
+            corrupted = data;
+            PatchUInt64(corrupted, DATA_END_OFFSET, dataEnd - 1);
+            verifyRejected(corrupted, L"last record past the end of the records");
+
+            corrupted = data;
+            PatchUInt64(corrupted, DATA_END_OFFSET, dataEnd + RECORD_HEADER_SIZE / 2);
+            verifyRejected(corrupted, L"partial record header");
+
+            corrupted = data;
+            PatchUInt32(corrupted, records[0].offset + 8, 0);
+            verifyRejected(corrupted, L"record without capacity");
+
+            corrupted = data;
+            PatchUInt32(corrupted, records[0].offset + 12, records[0].capacity + 1);
+            verifyRejected(corrupted, L"snapshot larger than its record");
+
+            corrupted = data;
+            PatchUInt64(corrupted, records[1].offset, records[0].sessionId);
+            verifyRejected(corrupted, L"two records of a session");
+
+            verifyRejected(vector<uint8_t>(data.begin(), data.begin() + SESSION_FILE_HEADER_SIZE - 1), L"truncated header");
+            verifyRejected(vector<uint8_t>(data.begin(), data.begin() + static_cast<ptrdiff_t>(dataEnd - 1)), L"truncated records");
+
+            // A snapshot that isn't valid only loses its own session, which starts again as a new one
+            corrupted = data;
+            corrupted[records[0].offset + RECORD_HEADER_SIZE] ^= 0xFF;
+            WriteFile(m_path, corrupted);
+            CalculatorSessionStore store(&m_calculatorDisplay, &m_resourceProvider, 4);
+            VERIFY_IS_TRUE(store.Open(m_path));
+            CalculatorManager* session = store.GetSession(records[0].sessionId);
+            VERIFY_IS_NOT_NULL(session);
+            VERIFY_ARE_EQUAL(0u, session->GetHistoryItems(CM_SCI).size());
+            VERIFY_IS_TRUE(IsSession(*store.GetSession(records[1].sessionId), static_cast<int>(records[1].sessionId)));
+        }
+
+        void TestMappedFile()
+        {
+            {
+                MappedFile file;
+                VERIFY_IS_TRUE(file.Open(m_path));
+                VERIFY_ARE_EQUAL(0u, file.Size());
+                VERIFY_IS_NULL(file.Data());
+                VERIFY_IS_TRUE(file.Resize(100));
+                file.Data()[99] = 42;
+                VERIFY_IS_TRUE(file.Resize(10000));
+                VERIFY_ARE_EQUAL(42, file.Data()[99]);
+                file.Data()[9999] = 7;
+
+                // The file never shrinks
+                VERIFY_IS_TRUE(file.Resize(10));
+                VERIFY_ARE_EQUAL(10000u, file.Size());
+                VERIFY_IS_TRUE(file.Flush());
+            }
+
+            MappedFile file;
+            VERIFY_IS_TRUE(file.Open(m_path));
+            VERIFY_ARE_EQUAL(10000u, file.Size());
+            VERIFY_ARE_EQUAL(42, file.Data()[99]);
+            VERIFY_ARE_EQUAL(7, file.Data()[9999]);
+            file.Close();
+            VERIFY_IS_FALSE(file.IsOpen());
+        }
+
+    private:
+        static void MakeSessions(CalculatorSessionStore& store, initializer_list<int> digits)
+        {
+            for (int digit : digits)
+            {
+                MakeSession(*store.GetSession(digit), digit);
+            }
+        }
+
+        filesystem::path m_path;
+        TestCalcDisplay m_calculatorDisplay;
+        EnglishResourceProvider m_resourceProvider;
+    };
+
+    CALC_TEST_METHOD(SessionStoreTests, TestRoundTrip);
+    CALC_TEST_METHOD(SessionStoreTests, TestEviction);
+    CALC_TEST_METHOD(SessionStoreTests, TestRecordReuse);
+    CALC_TEST_METHOD(SessionStoreTests, TestRejectsCorruptFile);
+    CALC_TEST_METHOD(SessionStoreTests, TestMappedFile);
+}
@@ -0,0 +1,178 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+#include "CalculatorManager.h"
+#include "Header Files/CCommand.h"
+#include "Header Files/History.h"
+#include "Test.h"
+#include "TestStubs.h"
+
+using namespace CalcEngine;
+using namespace CalculationManager;
+using namespace CalcManagerTests;
+using namespace std;
+
+namespace CalculatorFunctionalTests
+{
+    namespace
+    {
+        // Where the degree modes are in a snapshot: after the header, the current history and two flags
+        constexpr size_t CURRENT_DEGREE_MODE_OFFSET = 3 * sizeof(uint32_t) + 3;
+        constexpr size_t SAVED_DEGREE_MODE_OFFSET = CURRENT_DEGREE_MODE_OFFSET + sizeof(int32_t);
+
+        // Where the indices into the tokens are in a snapshot of a history collector: the start of the line, of the last
+        // operand and of the last binary operator, then the count of operand starts and the first of them
+        constexpr size_t HISTORY_TOKEN_INDEX_OFFSETS[] = { 0, sizeof(int32_t), 2 * sizeof(int32_t), 4 * sizeof(int32_t) };
+
+        void PatchInt32(vector<uint8_t>& snapshot, size_t offset, int32_t value)
+        {
+            for (size_t i = 0; i < sizeof(int32_t); i++)
+            {
+                snapshot[offset + i] = static_cast<uint8_t>(static_cast<uint32_t>(value) >> (8 * i));
+            }
+        }
+    }
+
+    class SnapshotTests
+    {
+    public:
+        SnapshotTests()
+            : m_calculatorManager(&m_calculatorDisplay, &m_resourceProvider)
+        {
+            m_calculatorManager.SendCommand(Command::ModeScientific);
+            SendCommands({ Command::CommandRAD, Command::Command7, Command::CommandMUL, Command::Command6 });
+        }
+
+        void TestRoundTrip()
+        {
+            vector<uint8_t> snapshot = SaveSnapshot();
+            TestCalcDisplay calculatorDisplay;
+            CalculatorManager calculatorManager(&calculatorDisplay, &m_resourceProvider);
+            VERIFY_IS_TRUE(calculatorManager.RestoreSnapshot(snapshot.data(), snapshot.size()));
+            VERIFY_ARE_EQUAL(Command::CommandRAD, calculatorManager.GetCurrentDegreeMode());
+
+            calculatorManager.SendCommand(Command::CommandEQU);
+            VERIFY_ARE_EQUAL(L"42", calculatorDisplay.PrimaryDisplay());
+        }
+
+        void TestRejectsTruncatedSnapshot()
+        {
+            vector<uint8_t> snapshot = SaveSnapshot();
+            VERIFY_IS_FALSE(RestoresInNewCalculator(vector<uint8_t>(snapshot.begin(), snapshot.end() - 1)));
+            VERIFY_IS_FALSE(RestoresInNewCalculator(vector<uint8_t>(snapshot.begin(), snapshot.begin() + 8)));
+        }
+
+        // Only the degree modes that the calculator can be in are restored
+        void TestRejectsInvalidDegreeMode()
+        {
+            vector<uint8_t> snapshot = SaveSnapshot();
+            for (int32_t degreeMode : { static_cast<int32_t>(Command::CommandNULL), static_cast<int32_t>(Command::CommandGRAD) })
+            {
+                PatchInt32(snapshot, CURRENT_DEGREE_MODE_OFFSET, degreeMode);
+                VERIFY_IS_TRUE(RestoresInNewCalculator(snapshot));
+            }
+
+            for (int32_t degreeMode : { static_cast<int32_t>(Command::Command1), static_cast<int32_t>(Command::CommandSIN), -1, 0x7FFFFFFF })
+            {
+                vector<uint8_t> corrupted = snapshot;
+                PatchInt32(corrupted, CURRENT_DEGREE_MODE_OFFSET, degreeMode);
+                VERIFY_IS_FALSE(RestoresInNewCalculator(corrupted));
+
+                corrupted = snapshot;
+                PatchInt32(corrupted, SAVED_DEGREE_MODE_OFFSET, degreeMode);
+                VERIFY_IS_FALSE(RestoresInNewCalculator(corrupted));
+            }
+
+            // The calculator is reset, and still works
+            PatchInt32(snapshot, SAVED_DEGREE_MODE_OFFSET, -1);
+            VERIFY_IS_FALSE(m_calculatorManager.RestoreSnapshot(snapshot.data(), snapshot.size()));
+            VERIFY_ARE_EQUAL(Command::CommandDEG, m_calculatorManager.GetCurrentDegreeMode());
+            SendCommands({ Command::Command2, Command::CommandADD, Command::Command3, Command::CommandEQU });
+            VERIFY_ARE_EQUAL(L"5", m_calculatorDisplay.PrimaryDisplay());
+        }
+
+        // The history's indices into its tokens are offsets that tokens are inserted at and truncated from, so each
+        // must be -1 or at most the count of tokens
+        void TestRejectsInvalidHistoryTokenIndex()
+        {
+            // "7 x (" has five tokens, and the parenthesis is the start of an operand
+            CHistoryCollector history(nullptr, nullptr, L'.');
+            history.AddOpndToHistory(L"7", Rational(7));
+            history.AddBinOpToHistory(IDC_MUL, false);
+            history.AddOpenBraceToHistory();
+            vector<uint8_t> snapshot = SaveHistorySnapshot(history);
+
+            for (size_t offset : HISTORY_TOKEN_INDEX_OFFSETS)
+            {
+                vector<uint8_t> corrupted = snapshot;
+                PatchInt32(corrupted, offset, 5);
+                VERIFY_IS_TRUE(RestoresInNewHistory(corrupted));
+
+                for (int32_t index : { 6, -2, 0x7FFFFFFF })
+                {
+                    PatchInt32(corrupted, offset, index);
+                    VERIFY_IS_FALSE(RestoresInNewHistory(corrupted));
+                }
+            }
+
+            // Without tokens, an index can only be -1 or 0
+            CHistoryCollector emptyHistory(nullptr, nullptr, L'.');
+            snapshot = SaveHistorySnapshot(emptyHistory);
+            PatchInt32(snapshot, HISTORY_TOKEN_INDEX_OFFSETS[0], 0);
+            VERIFY_IS_TRUE(RestoresInNewHistory(snapshot));
+            PatchInt32(snapshot, HISTORY_TOKEN_INDEX_OFFSETS[0], 1);
+            VERIFY_IS_FALSE(RestoresInNewHistory(snapshot));
+        }
+
+    private:
+        void SendCommands(initializer_list<Command> commands)
+        {
+            for (Command command : commands)
+            {
+                m_calculatorManager.SendCommand(command);
+            }
+        }
+
+        vector<uint8_t> SaveSnapshot()
+        {
+            vector<uint8_t> snapshot(m_calculatorManager.SaveSnapshot(nullptr, 0));
+            m_calculatorManager.SaveSnapshot(snapshot.data(), snapshot.size());
+            return snapshot;
+        }
+
+        vector<uint8_t> SaveHistorySnapshot(CHistoryCollector const& history)
+        {
+            SnapshotWriter sizeWriter(nullptr, 0);
+            history.SaveSnapshot(sizeWriter);
+            vector<uint8_t> snapshot(sizeWriter.Size());
+            SnapshotWriter writer(snapshot.data(), snapshot.size());
+            history.SaveSnapshot(writer);
+            return snapshot;
+        }
+
+        bool RestoresInNewHistory(vector<uint8_t> const& snapshot)
+        {
+            CHistoryCollector history(nullptr, nullptr, L'.');
+            SnapshotReader reader(snapshot.data(), snapshot.size());
+            history.RestoreSnapshot(reader);
+            return reader.IsValid() && reader.IsAtEnd();
+        }
+
+        bool RestoresInNewCalculator(vector<uint8_t> const& snapshot)
+        {
+            TestCalcDisplay calculatorDisplay;
+            CalculatorManager calculatorManager(&calculatorDisplay, &m_resourceProvider);
+            return calculatorManager.RestoreSnapshot(snapshot.data(), snapshot.size());
+        }
+
+        TestCalcDisplay m_calculatorDisplay;
+        EnglishResourceProvider m_resourceProvider;
+        CalculatorManager m_calculatorManager;
+    };
+
+    CALC_TEST_METHOD(SnapshotTests, TestRoundTrip);
+    CALC_TEST_METHOD(SnapshotTests, TestRejectsTruncatedSnapshot);
+    CALC_TEST_METHOD(SnapshotTests, TestRejectsInvalidDegreeMode);
+    CALC_TEST_METHOD(SnapshotTests, TestRejectsInvalidHistoryTokenIndex);
+}
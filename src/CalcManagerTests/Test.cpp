@@ -0,0 +1,195 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string_view>
+#include <vector>
+#include "Test.h"
+
+using namespace std;
+using namespace CalcManagerTests;
+
+namespace
+{
+    struct RegisteredTest
+    {
+        const char* className;
+        const char* methodName;
+        TestFunction function;
+    };
+
+    vector<RegisteredTest>& GetRegisteredTests()
+    {
+        static vector<RegisteredTest> s_tests;
+        return s_tests;
+    }
+
+    string& GetGoldenDirectoryStorage()
+    {
+        static string s_goldenDirectory;
+        return s_goldenDirectory;
+    }
+
+    bool& GetIsUpdatingGoldenStorage()
+    {
+        static bool s_isUpdatingGolden = false;
+        return s_isUpdatingGolden;
+    }
+
+    void PrintUsage(const char* program)
+    {
+        printf(
+            "Usage: %s [--filter=<substring>] [--golden-dir=<directory>] [--update-golden] [--list]\n"
+            "\n"
+            "Runs every registered test whose Class.Method name contains the filter, and prints the failures.\n"
+            "Returns 0 if every test passed. With --update-golden, the golden tests rewrite the corpus in the\n"
+            "golden directory with their results instead of comparing them.\n",
+            program);
+    }
+
+    bool TryParseArgument(string_view argument, string_view name, string_view& value)
+    {
+        if (argument.substr(0, name.size()) != name)
+        {
+            return false;
+        }
+
+        value = argument.substr(name.size());
+        return true;
+    }
+
+    // The messages are the ASCII text of the ported tests, so anything else is only shown as '?'
+    string ToNarrow(const wstring& text)
+    {
+        string result;
+        result.reserve(text.size());
+        for (wchar_t c : text)
+        {
+            result += (c >= 0x20 && c < 0x7f) ? static_cast<char>(c) : '?';
+        }
+        return result;
+    }
+
+    bool RunTest(RegisteredTest const& test)
+    {
+        try
+        {
+            test.function();
+            return true;
+        }
+        catch (TestFailure const& failure)
+        {
+            printf("FAILED %s.%s\n  %s(%d): %s", test.className, test.methodName, failure.file, failure.line, failure.condition.c_str());
+            if (!failure.message.empty())
+            {
+                printf(": %s", ToNarrow(failure.message).c_str());
+            }
+            printf("\n");
+        }
+        catch (exception const& e)
+        {
+            printf("FAILED %s.%s\n  unexpected exception: %s\n", test.className, test.methodName, e.what());
+        }
+        catch (uint32_t error)
+        {
+            printf("FAILED %s.%s\n  unexpected calculation error 0x%08x\n", test.className, test.methodName, error);
+        }
+        catch (...)
+        {
+            printf("FAILED %s.%s\n  unexpected exception\n", test.className, test.methodName);
+        }
+
+        return false;
+    }
+}
+
+namespace CalcManagerTests
+{
+    TestRegistration::TestRegistration(const char* className, const char* methodName, TestFunction function)
+    {
+        GetRegisteredTests().push_back({ className, methodName, function });
+    }
+
+    void Fail(const char* file, int line, const char* condition, const wchar_t* message)
+    {
+        throw TestFailure{ file, line, condition, message != nullptr ? message : L"" };
+    }
+
+    void Fail(const char* file, int line, const char* condition, const wstring& message)
+    {
+        throw TestFailure{ file, line, condition, message };
+    }
+
+    const string& GetGoldenDirectory()
+    {
+        return GetGoldenDirectoryStorage();
+    }
+
+    bool IsUpdatingGolden()
+    {
+        return GetIsUpdatingGoldenStorage();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    string_view filter;
+    bool listOnly = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string_view argument = argv[i];
+        string_view value;
+        if (TryParseArgument(argument, "--filter=", value))
+        {
+            filter = value;
+        }
+        else if (TryParseArgument(argument, "--golden-dir=", value))
+        {
+            GetGoldenDirectoryStorage() = value;
+        }
+        else if (argument == "--update-golden")
+        {
+            GetIsUpdatingGoldenStorage() = true;
+        }
+        else if (argument == "--list")
+        {
+            listOnly = true;
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return argument == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    size_t testCount = 0;
+    size_t failureCount = 0;
+    for (auto const& test : GetRegisteredTests())
+    {
+        string name = string(test.className) + "." + test.methodName;
+        if (name.find(filter) == string::npos)
+        {
+            continue;
+        }
+
+        if (listOnly)
+        {
+            printf("%s\n", name.c_str());
+            continue;
+        }
+
+        testCount++;
+        failureCount += RunTest(test) ? 0 : 1;
+        fflush(stdout);
+    }
+
+    if (!listOnly)
+    {
+        printf("%zu tests, %zu failed\n", testCount, failureCount);
+    }
+
+    return failureCount == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+// A minimal unit test harness for CalcManager, that runs the engine tests headless wherever CalcManager builds. A test
+// is a method of a test class, like the MSTest tests of CalculatorUnitTests: each one runs on a new instance of its
+// class, so the constructor and destructor take the place of TEST_METHOD_INITIALIZE and TEST_METHOD_CLEANUP.
+namespace CalcManagerTests
+{
+    using TestFunction = void (*)();
+
+    class TestRegistration
+    {
+    public:
+        TestRegistration(const char* className, const char* methodName, TestFunction function);
+    };
+
+    // What a failed VERIFY_ macro throws, for the runner to report with the test that threw it
+    struct TestFailure
+    {
+        const char* file;
+        int line;
+        std::string condition;
+        std::wstring message;
+    };
+
+    [[noreturn]] void Fail(const char* file, int line, const char* condition, const wchar_t* message = nullptr);
+    [[noreturn]] void Fail(const char* file, int line, const char* condition, const std::wstring& message);
+
+    // The directory of the golden corpus, which is given to the executable with --golden-dir
+    const std::string& GetGoldenDirectory();
+
+    // Whether the golden tests should rewrite the corpus with the results they get, rather than compare them, as asked
+    // with --update-golden
+    bool IsUpdatingGolden();
+}
+
+// Runs className::methodName on a new instance of the class. Use it in the namespace of the class.
+#define CALC_TEST_METHOD(className, methodName)                                                                                                                \
+    static void className##_##methodName()                                                                                                                     \
+    {                                                                                                                                                          \
+        className test;                                                                                                                                        \
+        test.methodName();                                                                                                                                     \
+    }                                                                                                                                                          \
+    static CalcManagerTests::TestRegistration className##_##methodName##Registration(#className, #methodName, className##_##methodName)
+
+// The assertions of CalculatorUnitTests/Helpers.h, with an optional message
+#define VERIFY_IS_TRUE(condition, ...)                                                                                                                         \
+    do                                                                                                                                                         \
+    {                                                                                                                                                          \
+        if (!(condition))                                                                                                                                      \
+        {                                                                                                                                                      \
+            CalcManagerTests::Fail(__FILE__, __LINE__, #condition, ##__VA_ARGS__);                                                                             \
+        }                                                                                                                                                      \
+    } while (false)
+
+#define VERIFY_IS_FALSE(condition, ...) VERIFY_IS_TRUE(!(condition), ##__VA_ARGS__)
+#define VERIFY_ARE_EQUAL(expected, actual, ...) VERIFY_IS_TRUE((expected) == (actual), ##__VA_ARGS__)
+#define VERIFY_ARE_NOT_EQUAL(expected, actual, ...) VERIFY_IS_TRUE((expected) != (actual), ##__VA_ARGS__)
+#define VERIFY_IS_NULL(value, ...) VERIFY_IS_TRUE(nullptr == (value), ##__VA_ARGS__)
+#define VERIFY_IS_NOT_NULL(value, ...) VERIFY_IS_TRUE(nullptr != (value), ##__VA_ARGS__)
+#define VERIFY_IS_LESS_THAN(expectedLess, expectedGreater, ...) VERIFY_IS_TRUE((expectedLess) < (expectedGreater), ##__VA_ARGS__)
+#define VERIFY_IS_GREATER_THAN(expectedGreater, expectedLess, ...) VERIFY_IS_TRUE((expectedGreater) > (expectedLess), ##__VA_ARGS__)
+#define VERIFY_FAIL(...) CalcManagerTests::Fail(__FILE__, __LINE__, "VERIFY_FAIL", ##__VA_ARGS__)
+
+#define VERIFY_THROWS_EXPECTEDEXCEPTION(operation, exception)                                                                                                  \
+    {                                                                                                                                                          \
+        bool isExceptionHit = false;                                                                                                                           \
+        try                                                                                                                                                    \
+        {                                                                                                                                                      \
+            operation;                                                                                                                                         \
+        }                                                                                                                                                      \
+        catch (exception)                                                                                                                                      \
+        {                                                                                                                                                      \
+            isExceptionHit = true;                                                                                                                             \
+        }                                                                                                                                                      \
+                                                                                                                                                               \
+        if (!isExceptionHit)                                                                                                                                   \
+        {                                                                                                                                                      \
+            CalcManagerTests::Fail(__FILE__, __LINE__, #operation, L"Expected exception was not caught");                                                      \
+        }                                                                                                                                                      \
+    }
@@ -0,0 +1,119 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CalculatorManager.h"
+#include "CalculatorResource.h"
+
+// The host of CalculatorManager for tests that drive the engine without a UI: a display that keeps what it was last
+// told, and the en-US strings that the tests compare with.
+namespace CalcManagerTests
+{
+    class TestCalcDisplay final : public ICalcDisplay
+    {
+    public:
+        void SetPrimaryDisplay(const std::wstring& text, bool isError) override
+        {
+            m_primaryDisplay = text;
+            m_isError = isError;
+        }
+        void SetIsInError(bool isInError) override
+        {
+            m_isError = isInError;
+        }
+        void SetExpressionDisplay(
+            _Inout_ std::shared_ptr<std::vector<std::pair<std::wstring, int>>> const& /*tokens*/,
+            _Inout_ std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> const& /*commands*/) override
+        {
+        }
+        void SetParenthesisNumber(_In_ unsigned int /*count*/) override
+        {
+        }
+        void OnNoRightParenAdded() override
+        {
+        }
+        void MaxDigitsReached() override
+        {
+        }
+        void BinaryOperatorReceived() override
+        {
+        }
+        void OnHistoryItemAdded(_In_ unsigned int /*addedItemIndex*/) override
+        {
+            m_historyItemAddedCount++;
+        }
+        void SetMemorizedNumbers(const std::vector<std::wstring>& memorizedNumbers) override
+        {
+            m_memorizedNumbers = memorizedNumbers;
+        }
+        void InsertMemorizedNumber(unsigned int indexOfMemory, const std::wstring& memorizedNumber) override
+        {
+            m_memorizedNumbers.insert(m_memorizedNumbers.begin() + indexOfMemory, memorizedNumber);
+        }
+        void UpdateMemorizedNumber(unsigned int indexOfMemory, const std::wstring& memorizedNumber) override
+        {
+            m_memorizedNumbers[indexOfMemory] = memorizedNumber;
+        }
+        void RemoveMemorizedNumber(unsigned int indexOfMemory) override
+        {
+            m_memorizedNumbers.erase(m_memorizedNumbers.begin() + indexOfMemory);
+        }
+        void MemoryItemChanged(unsigned int /*indexOfMemory*/) override
+        {
+        }
+        void InputChanged() override
+        {
+        }
+
+        std::wstring const& PrimaryDisplay() const
+        {
+            return m_primaryDisplay;
+        }
+        bool IsError() const
+        {
+            return m_isError;
+        }
+        unsigned int HistoryItemAddedCount() const
+        {
+            return m_historyItemAddedCount;
+        }
+        std::vector<std::wstring> const& MemorizedNumbers() const
+        {
+            return m_memorizedNumbers;
+        }
+
+    private:
+        std::wstring m_primaryDisplay;
+        bool m_isError = false;
+        unsigned int m_historyItemAddedCount = 0;
+        std::vector<std::wstring> m_memorizedNumbers;
+    };
+
+    // The en-US number format, and the strings of CEngineStrings.resw that the tests use; every other engine string is
+    // empty.
+    class EnglishResourceProvider final : public CalculationManager::IResourceProvider
+    {
+    public:
+        std::wstring GetCEngineString(std::wstring_view id) override
+        {
+            static constexpr std::pair<std::wstring_view, std::wstring_view> ENGINE_STRINGS[] = {
+                { L"sDecimal", L"." }, { L"sThousand", L"," }, { L"sGrouping", L"3;0" }, { L"11", L"÷" }, { L"12", L"×" },
+                { L"13", L"+" },       { L"14", L"-" },        { L"41", L"=" },         { L"101", L"Result is undefined" }
+            };
+
+            for (auto const& engineString : ENGINE_STRINGS)
+            {
+                if (engineString.first == id)
+                {
+                    return std::wstring(engineString.second);
+                }
+            }
+
+            return std::wstring();
+        }
+    };
+}
@@ -0,0 +1,1182 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include "Command.h"
+#include "CurrencyRateMatrix.h"
+#include "NumberFormattingUtils.h"
+#include "Test.h"
+#include "UnitConversionKernel.h"
+#include "UnitConverter.h"
+
+using namespace CalcManager::NumberFormattingUtils;
+using namespace UnitConversionManager;
+using namespace std;
+
+namespace UnitConverterUnitTests
+{
+    void SetUnitParams(Unit* type, int id, wstring name, wstring abbreviation, bool conversionSource, bool conversionTarget, bool isWhimsical)
+    {
+        type->id = id;
+        type->name = name;
+        type->abbreviation = abbreviation;
+        type->isConversionSource = conversionSource;
+        type->isConversionTarget = conversionTarget;
+        type->isWhimsical = isWhimsical;
+    }
+
+    void SetCategoryParams(Category* type, int id, wstring name, bool supportsNegative)
+    {
+        type->id = id;
+        type->name = name;
+        type->supportsNegative = supportsNegative;
+    }
+
+    void SetConversionDataParams(ConversionData* type, double ratio, double offset, bool offsetFirst)
+    {
+        type->ratio = ratio;
+        type->offset = offset;
+        type->offsetFirst = offsetFirst;
+    }
+
+    class TestUnitConverterConfigLoader : public IConverterDataLoader
+    {
+    public:
+        TestUnitConverterConfigLoader()
+            : m_loadDataCallCount(0)
+        {
+            Category c1, c2;
+            SetCategoryParams(&c1, 1, L"Length", true);
+            SetCategoryParams(&c2, 2, L"Weight", false);
+            m_categories.push_back(c1);
+            m_categories.push_back(c2);
+
+            Unit u1, u2, u3, u4;
+            SetUnitParams(&u1, 1, L"Inches", L"In", true, true, false);
+            SetUnitParams(&u2, 2, L"Feet", L"Ft", false, false, false);
+            SetUnitParams(&u3, 3, L"Pounds", L"Lb", true, true, false);
+            SetUnitParams(&u4, 4, L"Kilograms", L"Kg", false, false, false);
+
+            vector<Unit> c1units = vector<Unit>();
+            vector<Unit> c2units = vector<Unit>();
+            c1units.push_back(u1);
+            c1units.push_back(u2);
+            c2units.push_back(u3);
+            c2units.push_back(u4);
+
+            m_units[c1] = c1units;
+            m_units[c2] = c2units;
+
+            unordered_map<Unit, ConversionData, UnitHash> unit1Map = unordered_map<Unit, ConversionData, UnitHash>();
+            unordered_map<Unit, ConversionData, UnitHash> unit2Map = unordered_map<Unit, ConversionData, UnitHash>();
+            unordered_map<Unit, ConversionData, UnitHash> unit3Map = unordered_map<Unit, ConversionData, UnitHash>();
+            unordered_map<Unit, ConversionData, UnitHash> unit4Map = unordered_map<Unit, ConversionData, UnitHash>();
+
+            ConversionData conversion1, conversion2, conversion3, conversion4, conversion5;
+            SetConversionDataParams(&conversion1, 1.0, 0, false);
+            SetConversionDataParams(&conversion2, 0.08333333333333333333333333333333, 0, false);
+            SetConversionDataParams(&conversion3, 12.0, 0, false);
+            SetConversionDataParams(&conversion4, 0.453592, 0, false);
+            SetConversionDataParams(&conversion5, 2.20462, 0, false);
+
+            // Setting the conversion ratios for testing
+            unit1Map[u1] = conversion1;
+            unit1Map[u2] = conversion2;
+
+            unit2Map[u1] = conversion3;
+            unit2Map[u2] = conversion1;
+
+            unit3Map[u3] = conversion1;
+            unit3Map[u4] = conversion4;
+
+            unit4Map[u3] = conversion5;
+            unit4Map[u4] = conversion1;
+
+            m_ratioMaps[u1] = unit1Map;
+            m_ratioMaps[u2] = unit2Map;
+            m_ratioMaps[u3] = unit3Map;
+            m_ratioMaps[u4] = unit4Map;
+        }
+
+        void LoadData()
+        {
+            m_loadDataCallCount++;
+        }
+
+        vector<Category> LoadOrderedCategories()
+        {
+            return m_categories;
+        }
+
+        vector<Unit> LoadOrderedUnits(const Category& c)
+        {
+            return m_units[c];
+        }
+
+        unordered_map<Unit, ConversionData, UnitHash> LoadOrderedRatios(const Unit& u)
+        {
+            return m_ratioMaps[u];
+        }
+
+        bool SupportsCategory(const Category& /*target*/)
+        {
+            return true;
+        }
+
+        unsigned int m_loadDataCallCount;
+
+    private:
+        vector<Category> m_categories;
+        CategoryToUnitVectorMap m_units;
+        UnitToUnitToConversionDataMap m_ratioMaps;
+    };
+
+    class TestUnitConverterVMCallback : public IUnitConverterVMCallback
+    {
+    public:
+        void Reset()
+        {
+            m_maxDigitsReachedCallCount = 0;
+        }
+
+        void DisplayCallback(const wstring& from, const wstring& to) override
+        {
+            m_lastFrom = from;
+            m_lastTo = to;
+        }
+
+        void SuggestedValueCallback(const vector<tuple<wstring, Unit>>& suggestedValues) override
+        {
+            m_lastSuggested = suggestedValues;
+        }
+
+        void MaxDigitsReached() override
+        {
+            m_maxDigitsReachedCallCount++;
+        }
+
+        int GetMaxDigitsReachedCallCount()
+        {
+            return m_maxDigitsReachedCallCount;
+        }
+
+        bool CheckDisplayValues(wstring from, wstring to)
+        {
+            return (from == m_lastFrom && to == m_lastTo);
+        }
+
+        const wstring& GetLastFrom() const
+        {
+            return m_lastFrom;
+        }
+
+        const wstring& GetLastTo() const
+        {
+            return m_lastTo;
+        }
+
+        const vector<tuple<wstring, Unit>>& GetLastSuggested() const
+        {
+            return m_lastSuggested;
+        }
+
+        bool CheckSuggestedValues(vector<tuple<wstring, Unit>> suggested)
+        {
+            if (suggested.size() != m_lastSuggested.size())
+            {
+                return false;
+            }
+            bool returnValue = true;
+            for (unsigned int i = 0; i < suggested.size(); i++)
+            {
+                if (suggested[i] != m_lastSuggested[i])
+                {
+                    returnValue = false;
+                    break;
+                }
+            }
+            return returnValue;
+        }
+
+    private:
+        wstring m_lastFrom;
+        wstring m_lastTo;
+        vector<tuple<wstring, Unit>> m_lastSuggested;
+        int m_maxDigitsReachedCallCount = 0;
+    };
+
+    class UnitConverterTest
+    {
+    public:
+        UnitConverterTest()
+        {
+            CommonSetup();
+        }
+        ~UnitConverterTest()
+        {
+            Cleanup();
+        }
+
+        void UnitConverterTestInit();
+        void UnitConverterTestBasic();
+        void UnitConverterTestGetters();
+        void UnitConverterTestGetCategory();
+        void UnitConverterTestUnitTypeSwitching();
+        void UnitConverterTestQuote();
+        void UnitConverterTestUnquote();
+        void UnitConverterTestBackspace();
+        void UnitConverterTestScientificInputs();
+        void UnitConverterTestSupplementaryResultRounding();
+        void UnitConverterTestMaxDigitsReached();
+        void UnitConverterTestMaxDigitsReached_LeadingDecimal();
+        void UnitConverterTestMaxDigitsReached_TrailingDecimal();
+        void UnitConverterTestMaxDigitsReached_MultipleTimes();
+        void UnitConverterTestBinaryUserPreferences();
+        void UnitConverterTestUpdateCurrencyRatiosWithoutCurrencies();
+
+    private:
+        static void CommonSetup();
+        static void Cleanup();
+        static void ExecuteCommands(vector<Command> commands);
+
+        static shared_ptr<UnitConverter> s_unitConverter;
+        static shared_ptr<TestUnitConverterConfigLoader> s_xmlLoader;
+        static shared_ptr<TestUnitConverterVMCallback> s_testVMCallback;
+        static Category s_testLength;
+        static Category s_testWeight;
+        static Unit s_testInches;
+        static Unit s_testFeet;
+        static Unit s_testPounds;
+        static Unit s_testKilograms;
+    };
+
+    shared_ptr<UnitConverter> UnitConverterTest::s_unitConverter;
+    shared_ptr<TestUnitConverterConfigLoader> UnitConverterTest::s_xmlLoader;
+    shared_ptr<TestUnitConverterVMCallback> UnitConverterTest::s_testVMCallback;
+    Category UnitConverterTest::s_testLength;
+    Category UnitConverterTest::s_testWeight;
+    Unit UnitConverterTest::s_testInches;
+    Unit UnitConverterTest::s_testFeet;
+    Unit UnitConverterTest::s_testPounds;
+    Unit UnitConverterTest::s_testKilograms;
+
+    // Creates instance of UnitConverter before each test
+    void UnitConverterTest::CommonSetup()
+    {
+        s_testVMCallback = make_shared<TestUnitConverterVMCallback>();
+        s_xmlLoader = make_shared<TestUnitConverterConfigLoader>();
+        s_unitConverter = make_shared<UnitConverter>(s_xmlLoader);
+        s_unitConverter->SetViewModelCallback(s_testVMCallback);
+        SetCategoryParams(&s_testLength, 1, L"Length", true);
+        SetCategoryParams(&s_testWeight, 2, L"Weight", false);
+        SetUnitParams(&s_testInches, 1, L"Inches", L"In", true, true, false);
+        SetUnitParams(&s_testFeet, 2, L"Feet", L"Ft", false, false, false);
+        SetUnitParams(&s_testPounds, 3, L"Pounds", L"Lb", true, true, false);
+        SetUnitParams(&s_testKilograms, 4, L"Kilograms", L"Kg", false, false, false);
+    }
+
+    // Resets calculator state to start state after each test
+    void UnitConverterTest::Cleanup()
+    {
+        s_unitConverter->SendCommand(Command::Reset);
+        s_testVMCallback->Reset();
+    }
+
+    void UnitConverterTest::ExecuteCommands(vector<Command> commands)
+    {
+        for (size_t i = 0; i < commands.size() && commands[i] != Command::None; i++)
+        {
+            s_unitConverter->SendCommand(commands[i]);
+        }
+    }
+
+    // Test ctor/initialization states
+    void UnitConverterTest::UnitConverterTestInit()
+    {
+        VERIFY_ARE_EQUAL((unsigned int)0, s_xmlLoader->m_loadDataCallCount); // shouldn't have initialized the loader yet
+        s_unitConverter->Initialize();
+        VERIFY_ARE_EQUAL((unsigned int)1, s_xmlLoader->m_loadDataCallCount); // now we should have loaded
+    }
+
+    // Verify a basic input command stream.'3', '2', '.', '0'
+    void UnitConverterTest::UnitConverterTestBasic()
+    {
+        tuple<wstring, Unit> test1[] = { tuple<wstring, Unit>(wstring(L"0.25"), s_testFeet) };
+        tuple<wstring, Unit> test2[] = { tuple<wstring, Unit>(wstring(L"2.5"), s_testFeet) };
+
+        s_unitConverter->SendCommand(Command::Three);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"3"), wstring(L"3")));
+        VERIFY_IS_TRUE(s_testVMCallback->CheckSuggestedValues(vector<tuple<wstring, Unit>>(begin(test1), end(test1))));
+        s_unitConverter->SendCommand(Command::Zero);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"30"), wstring(L"30")));
+        VERIFY_IS_TRUE(s_testVMCallback->CheckSuggestedValues(vector<tuple<wstring, Unit>>(begin(test2), end(test2))));
+        s_unitConverter->SendCommand(Command::Decimal);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"30."), wstring(L"30")));
+        VERIFY_IS_TRUE(s_testVMCallback->CheckSuggestedValues(vector<tuple<wstring, Unit>>(begin(test2), end(test2))));
+        s_unitConverter->SendCommand(Command::Zero);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"30.0"), wstring(L"30")));
+        VERIFY_IS_TRUE(s_testVMCallback->CheckSuggestedValues(vector<tuple<wstring, Unit>>(begin(test2), end(test2))));
+    }
+
+    // Check the getter functions
+    void UnitConverterTest::UnitConverterTestGetters()
+    {
+        Category test1[] = { s_testLength, s_testWeight };
+        Unit test2[] = { s_testInches, s_testFeet };
+
+        VERIFY_IS_TRUE(s_unitConverter->GetCategories() == vector<Category>(begin(test1), end(test1)));
+        VERIFY_IS_TRUE(get<0>(s_unitConverter->SetCurrentCategory(test1[0])) == vector<Unit>(begin(test2), end(test2)));
+    }
+
+    // Test getting category after it has been set.
+    void UnitConverterTest::UnitConverterTestGetCategory()
+    {
+        s_unitConverter->SetCurrentCategory(s_testWeight);
+        VERIFY_IS_TRUE(s_unitConverter->GetCurrentCategory() == s_testWeight);
+    }
+
+    // Test switching of unit types
+    void UnitConverterTest::UnitConverterTestUnitTypeSwitching()
+    {
+        // Enter 57 into the from field, then switch focus to the to field (making it the new from field)
+        s_unitConverter->SendCommand(Command::Five);
+        s_unitConverter->SendCommand(Command::Seven);
+        s_unitConverter->SwitchActive(wstring(L"57"));
+        // Now set unit conversion to go from kilograms to pounds
+        s_unitConverter->SetCurrentCategory(s_testWeight);
+        s_unitConverter->SetCurrentUnitTypes(s_testKilograms, s_testPounds);
+        s_unitConverter->SendCommand(Command::Five);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"5"), wstring(L"11.0231")));
+        VERIFY_IS_TRUE(s_testVMCallback->CheckSuggestedValues(vector<tuple<wstring, Unit>>()));
+    }
+
+
+    // Test input escaping
+    void UnitConverterTest::UnitConverterTestQuote()
+    {
+        wstring input1 = L"Weight";
+        wstring output1 = L"Weight";
+        wstring input2 = L"{p}Weig;[ht|";
+        wstring output2 = L"{lb}p{rb}Weig{sc}{lc}ht{p}";
+        wstring input3 = L"{{{t;s}}},:]";
+        wstring output3 = L"{lb}{lb}{lb}t{sc}s{rb}{rb}{rb}{cm}{co}{rc}";
+        VERIFY_IS_TRUE(UnitConverter::Quote(input1) == output1);
+        VERIFY_IS_TRUE(UnitConverter::Quote(input2) == output2);
+        VERIFY_IS_TRUE(UnitConverter::Quote(input3) == output3);
+    }
+
+    // Test output unescaping
+    void UnitConverterTest::UnitConverterTestUnquote()
+    {
+        wstring input1 = L"Weight";
+        wstring input2 = L"{p}Weig;[ht|";
+        wstring input3 = L"{{{t;s}}},:]";
+        VERIFY_IS_TRUE(UnitConverter::Unquote(input1) == input1);
+        VERIFY_IS_TRUE(UnitConverter::Unquote(UnitConverter::Quote(input1)) == input1);
+        VERIFY_IS_TRUE(UnitConverter::Unquote(UnitConverter::Quote(input2)) == input2);
+        VERIFY_IS_TRUE(UnitConverter::Unquote(UnitConverter::Quote(input3)) == input3);
+    }
+
+    // Test backspace commands
+    void UnitConverterTest::UnitConverterTestBackspace()
+    {
+        tuple<wstring, Unit> test1[] = { tuple<wstring, Unit>(wstring(L"13.66"), s_testKilograms) };
+        tuple<wstring, Unit> test2[] = { tuple<wstring, Unit>(wstring(L"13.65"), s_testKilograms) };
+        tuple<wstring, Unit> test3[] = { tuple<wstring, Unit>(wstring(L"13.61"), s_testKilograms) };
+        tuple<wstring, Unit> test4[] = { tuple<wstring, Unit>(wstring(L"1.36"), s_testKilograms) };
+
+        s_unitConverter->SetCurrentCategory(s_testWeight);
+        s_unitConverter->SetCurrentUnitTypes(s_testPounds, s_testPounds);
+        s_unitConverter->SendCommand(Command::Three);
+        s_unitConverter->SendCommand(Command::Zero);
+        s_unitConverter->SendCommand(Command::Decimal);
+        s_unitConverter->SendCommand(Command::One);
+        s_unitConverter->SendCommand(Command::Two);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"30.12"), wstring(L"30.12")));
+        VERIFY_IS_TRUE(s_testVMCallback->CheckSuggestedValues(vector<tuple<wstring, Unit>>(begin(test1), end(test1))));
+        s_unitConverter->SendCommand(Command::Backspace);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"30.1"), wstring(L"30.1")));
+        VERIFY_IS_TRUE(s_testVMCallback->CheckSuggestedValues(vector<tuple<wstring, Unit>>(begin(test2), end(test2))));
+        s_unitConverter->SendCommand(Command::Backspace);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"30."), wstring(L"30")));
+        VERIFY_IS_TRUE(s_testVMCallback->CheckSuggestedValues(vector<tuple<wstring, Unit>>(begin(test3), end(test3))));
+        s_unitConverter->SendCommand(Command::Backspace);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"30"), wstring(L"30")));
+        VERIFY_IS_TRUE(s_testVMCallback->CheckSuggestedValues(vector<tuple<wstring, Unit>>(begin(test3), end(test3))));
+        s_unitConverter->SendCommand(Command::Backspace);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"3"), wstring(L"3")));
+        VERIFY_IS_TRUE(s_testVMCallback->CheckSuggestedValues(vector<tuple<wstring, Unit>>(begin(test4), end(test4))));
+        s_unitConverter->SendCommand(Command::Backspace);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"0"), wstring(L"0")));
+        VERIFY_IS_TRUE(s_testVMCallback->CheckSuggestedValues(vector<tuple<wstring, Unit>>()));
+    }
+
+    // Test large values
+    void UnitConverterTest::UnitConverterTestScientificInputs()
+    {
+        s_unitConverter->SetCurrentCategory(s_testWeight);
+        s_unitConverter->SetCurrentUnitTypes(s_testPounds, s_testKilograms);
+        s_unitConverter->SendCommand(Command::Decimal);
+        s_unitConverter->SendCommand(Command::Zero);
+        s_unitConverter->SendCommand(Command::Zero);
+        s_unitConverter->SendCommand(Command::Zero);
+        s_unitConverter->SendCommand(Command::Zero);
+        s_unitConverter->SendCommand(Command::Zero);
+        s_unitConverter->SendCommand(Command::Zero);
+        s_unitConverter->SendCommand(Command::Zero);
+        s_unitConverter->SendCommand(Command::Zero);
+        s_unitConverter->SendCommand(Command::Zero);
+        s_unitConverter->SendCommand(Command::Zero);
+        s_unitConverter->SendCommand(Command::Zero);
+        s_unitConverter->SendCommand(Command::Zero);
+        s_unitConverter->SendCommand(Command::Zero);
+        s_unitConverter->SendCommand(Command::One);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"0.00000000000001"), wstring(L"4.535920e-15")));
+        s_unitConverter->SwitchActive(wstring(L"4.535920e-15"));
+        s_unitConverter->SendCommand(Command::Nine);
+        s_unitConverter->SendCommand(Command::Nine);
+        s_unitConverter->SendCommand(Command::Nine);
+        s_unitConverter->SendCommand(Command::Nine);
+        s_unitConverter->SendCommand(Command::Nine);
+        s_unitConverter->SendCommand(Command::Nine);
+        s_unitConverter->SendCommand(Command::Nine);
+        s_unitConverter->SendCommand(Command::Nine);
+        s_unitConverter->SendCommand(Command::Nine);
+        s_unitConverter->SendCommand(Command::Nine);
+        s_unitConverter->SendCommand(Command::Nine);
+        s_unitConverter->SendCommand(Command::Nine);
+        s_unitConverter->SendCommand(Command::Nine);
+        s_unitConverter->SendCommand(Command::Nine);
+        s_unitConverter->SendCommand(Command::Nine);
+        s_unitConverter->SendCommand(Command::Nine);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"999999999999999"), wstring(L"2.204620e+15")));
+        s_unitConverter->SwitchActive(wstring(L"2.20463e+15"));
+        s_unitConverter->SendCommand(Command::One);
+        s_unitConverter->SendCommand(Command::Two);
+        s_unitConverter->SendCommand(Command::Three);
+        s_unitConverter->SendCommand(Command::Four);
+        s_unitConverter->SendCommand(Command::Five);
+        s_unitConverter->SendCommand(Command::Six);
+        s_unitConverter->SendCommand(Command::Seven);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"1234567"), wstring(L"559989.7")));
+        s_unitConverter->SwitchActive(wstring(L"559989.7"));
+        s_unitConverter->SendCommand(Command::One);
+        s_unitConverter->SendCommand(Command::Two);
+        s_unitConverter->SendCommand(Command::Three);
+        s_unitConverter->SendCommand(Command::Four);
+        s_unitConverter->SendCommand(Command::Five);
+        s_unitConverter->SendCommand(Command::Six);
+        s_unitConverter->SendCommand(Command::Seven);
+        s_unitConverter->SendCommand(Command::Eight);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"12345678"), wstring(L"27217529")));
+    }
+
+    // Test large values
+    void UnitConverterTest::UnitConverterTestSupplementaryResultRounding()
+    {
+        tuple<wstring, Unit> test1[] = { tuple<wstring, Unit>(wstring(L"27.75"), s_testFeet) };
+        tuple<wstring, Unit> test2[] = { tuple<wstring, Unit>(wstring(L"277.8"), s_testFeet) };
+        tuple<wstring, Unit> test3[] = { tuple<wstring, Unit>(wstring(L"2778"), s_testFeet) };
+        s_unitConverter->SendCommand(Command::Three);
+        s_unitConverter->SendCommand(Command::Three);
+        s_unitConverter->SendCommand(Command::Three);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckSuggestedValues(vector<tuple<wstring, Unit>>(begin(test1), end(test1))));
+        s_unitConverter->SendCommand(Command::Three);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckSuggestedValues(vector<tuple<wstring, Unit>>(begin(test2), end(test2))));
+        s_unitConverter->SendCommand(Command::Three);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckSuggestedValues(vector<tuple<wstring, Unit>>(begin(test3), end(test3))));
+    }
+
+    void UnitConverterTest::UnitConverterTestMaxDigitsReached()
+    {
+        ExecuteCommands({ Command::One,
+                          Command::Two,
+                          Command::Three,
+                          Command::Four,
+                          Command::Five,
+                          Command::Six,
+                          Command::Seven,
+                          Command::Eight,
+                          Command::Nine,
+                          Command::One,
+                          Command::Zero,
+                          Command::One,
+                          Command::One,
+                          Command::One,
+                          Command::Two });
+
+        VERIFY_ARE_EQUAL(0, s_testVMCallback->GetMaxDigitsReachedCallCount());
+
+        ExecuteCommands({ Command::One });
+
+        VERIFY_ARE_EQUAL(1, s_testVMCallback->GetMaxDigitsReachedCallCount());
+    }
+
+    void UnitConverterTest::UnitConverterTestMaxDigitsReached_LeadingDecimal()
+    {
+        ExecuteCommands({ Command::Zero,
+                          Command::Decimal,
+                          Command::One,
+                          Command::Two,
+                          Command::Three,
+                          Command::Four,
+                          Command::Five,
+                          Command::Six,
+                          Command::Seven,
+                          Command::Eight,
+                          Command::Nine,
+                          Command::One,
+                          Command::Zero,
+                          Command::One,
+                          Command::One,
+                          Command::One });
+
+        VERIFY_ARE_EQUAL(0, s_testVMCallback->GetMaxDigitsReachedCallCount());
+
+        ExecuteCommands({ Command::Two });
+
+        VERIFY_ARE_EQUAL(1, s_testVMCallback->GetMaxDigitsReachedCallCount());
+    }
+
+    void UnitConverterTest::UnitConverterTestMaxDigitsReached_TrailingDecimal()
+    {
+        ExecuteCommands({ Command::One,
+                          Command::Two,
+                          Command::Three,
+                          Command::Four,
+                          Command::Five,
+                          Command::Six,
+                          Command::Seven,
+                          Command::Eight,
+                          Command::Nine,
+                          Command::One,
+                          Command::Zero,
+                          Command::One,
+                          Command::One,
+                          Command::One,
+                          Command::Two,
+                          Command::Decimal });
+
+        VERIFY_ARE_EQUAL(0, s_testVMCallback->GetMaxDigitsReachedCallCount());
+
+        ExecuteCommands({ Command::One });
+
+        VERIFY_ARE_EQUAL(1, s_testVMCallback->GetMaxDigitsReachedCallCount());
+    }
+
+    void UnitConverterTest::UnitConverterTestMaxDigitsReached_MultipleTimes()
+    {
+        ExecuteCommands({ Command::One,
+                          Command::Two,
+                          Command::Three,
+                          Command::Four,
+                          Command::Five,
+                          Command::Six,
+                          Command::Seven,
+                          Command::Eight,
+                          Command::Nine,
+                          Command::One,
+                          Command::Zero,
+                          Command::One,
+                          Command::One,
+                          Command::One,
+                          Command::Two });
+
+        VERIFY_ARE_EQUAL(0, s_testVMCallback->GetMaxDigitsReachedCallCount());
+
+        for (auto count = 1; count <= 10; count++)
+        {
+            ExecuteCommands({ Command::Three });
+
+            VERIFY_ARE_EQUAL(count, s_testVMCallback->GetMaxDigitsReachedCallCount(), to_wstring(count).c_str());
+        }
+    }
+
+    // Test restoring the binary preferences, which leave the state as the string ones do, through the interface that
+    // the view model uses
+    void UnitConverterTest::UnitConverterTestBinaryUserPreferences()
+    {
+        IUnitConverter& unitConverter = *s_unitConverter;
+        unitConverter.SetCurrentCategory(s_testWeight);
+        unitConverter.SetCurrentUnitTypes(s_testKilograms, s_testPounds);
+        wstring userPreferences = unitConverter.SaveUserPreferences();
+        vector<uint8_t> binaryUserPreferences(unitConverter.SaveUserPreferences(nullptr, 0));
+        VERIFY_ARE_EQUAL(binaryUserPreferences.size(), unitConverter.SaveUserPreferences(binaryUserPreferences.data(), binaryUserPreferences.size()));
+
+        unitConverter.SetCurrentCategory(s_testLength);
+        unitConverter.SetCurrentUnitTypes(s_testFeet, s_testInches);
+        VERIFY_IS_FALSE(unitConverter.RestoreUserPreferences(binaryUserPreferences.data(), binaryUserPreferences.size() - 1));
+        VERIFY_IS_TRUE(unitConverter.GetCurrentCategory() == s_testLength);
+
+        VERIFY_IS_TRUE(unitConverter.RestoreUserPreferences(binaryUserPreferences.data(), binaryUserPreferences.size()));
+        VERIFY_IS_TRUE(unitConverter.GetCurrentCategory() == s_testWeight);
+        VERIFY_ARE_EQUAL(userPreferences, unitConverter.SaveUserPreferences());
+    }
+
+    // Without a currency data loader there is nothing to update in place, and the static categories are left as they are
+    void UnitConverterTest::UnitConverterTestUpdateCurrencyRatiosWithoutCurrencies()
+    {
+        s_unitConverter->SetCurrentCategory(s_testWeight);
+        s_unitConverter->SetCurrentUnitTypes(s_testKilograms, s_testPounds);
+        wstring userPreferences = s_unitConverter->SaveUserPreferences();
+
+        VERIFY_IS_FALSE(s_unitConverter->UpdateCurrencyRatios());
+        VERIFY_ARE_EQUAL(userPreferences, s_unitConverter->SaveUserPreferences());
+    }
+
+    // A category that allows negative values, with offsets, and one that doesn't, with ratios over many magnitudes and
+    // whimsical units. The conversion data is random rather than consistent, as the suggestions only depend on it pair
+    // by pair.
+    class TestSuggestedValuesConfigLoader : public IConverterDataLoader
+    {
+    public:
+        TestSuggestedValuesConfigLoader()
+        {
+            mt19937 generator(38);
+            uniform_real_distribution<double> exponent(-7.0, 7.0);
+            uniform_real_distribution<double> offset(-300.0, 300.0);
+
+            Category temperature, volume;
+            SetCategoryParams(&temperature, 10, L"Temperature", true);
+            SetCategoryParams(&volume, 11, L"Volume", false);
+            m_categories = { temperature, volume };
+
+            int unitId = 100;
+            for (const Category& category : m_categories)
+            {
+                const int unitCount = category.supportsNegative ? 6 : 16;
+                vector<Unit>& units = m_units[category];
+                for (int i = 0; i < unitCount; i++)
+                {
+                    Unit unit;
+                    wstring name = category.name + to_wstring(i);
+                    SetUnitParams(&unit, unitId++, name, name, true, true, !category.supportsNegative && i % 5 == 4);
+                    units.push_back(unit);
+                }
+
+                for (const Unit& from : units)
+                {
+                    for (const Unit& to : units)
+                    {
+                        ConversionData conversionData;
+                        if (from == to)
+                        {
+                            SetConversionDataParams(&conversionData, 1.0, 0, false);
+                        }
+                        else
+                        {
+                            SetConversionDataParams(
+                                &conversionData, pow(10, exponent(generator)), category.supportsNegative ? offset(generator) : 0, generator() % 2 == 0);
+                        }
+                        m_ratioMaps[from][to] = conversionData;
+                    }
+                }
+            }
+        }
+
+        void LoadData()
+        {
+        }
+
+        vector<Category> LoadOrderedCategories()
+        {
+            return m_categories;
+        }
+
+        vector<Unit> LoadOrderedUnits(const Category& c)
+        {
+            return m_units[c];
+        }
+
+        unordered_map<Unit, ConversionData, UnitHash> LoadOrderedRatios(const Unit& u)
+        {
+            return m_ratioMaps[u];
+        }
+
+        bool SupportsCategory(const Category& /*target*/)
+        {
+            return true;
+        }
+
+    private:
+        vector<Category> m_categories;
+        CategoryToUnitVectorMap m_units;
+        UnitToUnitToConversionDataMap m_ratioMaps;
+    };
+
+    class UnitConverterSuggestedValuesTest
+    {
+    public:
+        // A randomized session, checking the suggested values after each step against the way they were calculated
+        // before the intermediate values held unit indices and only the best whimsical value was kept
+        void TestSuggestedValuesMatchFullSort()
+        {
+            auto loader = make_shared<TestSuggestedValuesConfigLoader>();
+            auto callback = make_shared<TestUnitConverterVMCallback>();
+            UnitConverter unitConverter(loader);
+            unitConverter.SetViewModelCallback(callback);
+
+            vector<Category> categories = loader->LoadOrderedCategories();
+            Category category = unitConverter.GetCurrentCategory();
+            vector<Unit> units = loader->LoadOrderedUnits(category);
+            Unit fromType = units[0];
+            Unit toType = units[1];
+            unitConverter.SetCurrentUnitTypes(fromType, toType);
+
+            mt19937 generator(3000);
+            for (int step = 0; step < 3000; step++)
+            {
+                const unsigned int action = generator() % 100;
+                if (action < 55)
+                {
+                    unitConverter.SendCommand(static_cast<Command>(generator() % 10));
+                }
+                else if (action < 60)
+                {
+                    unitConverter.SendCommand(Command::Decimal);
+                }
+                else if (action < 66)
+                {
+                    unitConverter.SendCommand(Command::Negate);
+                }
+                else if (action < 76)
+                {
+                    unitConverter.SendCommand(Command::Backspace);
+                }
+                else if (action < 79)
+                {
+                    unitConverter.SendCommand(Command::Clear);
+                }
+                else if (action < 91)
+                {
+                    fromType = units[generator() % units.size()];
+                    toType = units[generator() % units.size()];
+                    unitConverter.SetCurrentUnitTypes(fromType, toType);
+                }
+                else if (action < 95)
+                {
+                    // The view model switches with the value that was shown, and the view is updated on the next command
+                    swap(fromType, toType);
+                    unitConverter.SwitchActive(callback->GetLastTo());
+                    unitConverter.SendCommand(static_cast<Command>(generator() % 10));
+                }
+                else
+                {
+                    category = categories[generator() % categories.size()];
+                    unitConverter.SetCurrentCategory(category);
+                    units = loader->LoadOrderedUnits(category);
+                    fromType = units[0];
+                    toType = units[1];
+                    unitConverter.SetCurrentUnitTypes(fromType, toType);
+                }
+
+                auto expected = CalculateSuggestedWithFullSort(*loader, category, fromType, toType, stod(callback->GetLastFrom()));
+                VERIFY_IS_TRUE(expected == callback->GetLastSuggested(), L"Step " + to_wstring(step) + L", value " + callback->GetLastFrom());
+            }
+        }
+
+    private:
+        // The suggested values as they were calculated before: every value is formatted with a stream and parsed back to
+        // tell whether it is shown as zero, and the whimsical values are sorted too, to suggest the first one
+        static vector<tuple<wstring, Unit>> CalculateSuggestedWithFullSort(
+            TestSuggestedValuesConfigLoader& loader,
+            const Category& category,
+            const Unit& fromType,
+            const Unit& toType,
+            double currentValue)
+        {
+            struct Intermediate
+            {
+                double magnitude;
+                double value;
+                Unit type;
+            };
+
+            unordered_map<Unit, ConversionData, UnitHash> ratios = loader.LoadOrderedRatios(fromType);
+            vector<Intermediate> intermediateVector;
+            vector<Intermediate> intermediateWhimsicalVector;
+            for (const Unit& cur : loader.LoadOrderedUnits(category))
+            {
+                auto conversionData = ratios.find(cur);
+                if (conversionData != ratios.end() && cur != fromType && cur != toType)
+                {
+                    const ConversionData& data = conversionData->second;
+                    double convertedValue = data.offsetFirst ? (currentValue + data.offset) * data.ratio : (currentValue * data.ratio) + data.offset;
+                    Intermediate newEntry{ log10(convertedValue), convertedValue, cur };
+                    (cur.isWhimsical ? intermediateWhimsicalVector : intermediateVector).push_back(newEntry);
+                }
+            }
+
+            auto compare = [](Intermediate first, Intermediate second) {
+                if (abs(first.magnitude) == abs(second.magnitude))
+                {
+                    return first.magnitude > second.magnitude;
+                }
+                else
+                {
+                    return abs(first.magnitude) < abs(second.magnitude);
+                }
+            };
+            sort(intermediateVector.begin(), intermediateVector.end(), compare);
+            sort(intermediateWhimsicalVector.begin(), intermediateWhimsicalVector.end(), compare);
+
+            auto round = [](double value) {
+                return RoundSignificantDigits(value, abs(value) < 100 ? 2 : abs(value) < 1000 ? 1 : 0);
+            };
+
+            vector<tuple<wstring, Unit>> returnVector;
+            for (const auto& entry : intermediateVector)
+            {
+                wstring roundedString = round(entry.value);
+                if (stod(roundedString) != 0.0 || category.supportsNegative)
+                {
+                    TrimTrailingZeros(roundedString);
+                    returnVector.push_back(make_tuple(roundedString, entry.type));
+                }
+            }
+
+            for (const auto& entry : intermediateWhimsicalVector)
+            {
+                wstring roundedString = round(entry.value);
+                if (stod(roundedString) != 0.0)
+                {
+                    TrimTrailingZeros(roundedString);
+                    returnVector.push_back(make_tuple(roundedString, entry.type));
+                    break;
+                }
+            }
+
+            return returnVector;
+        }
+    };
+
+    class UnitConversionKernelTest
+    {
+    public:
+        // Every unit pair of the test data loaders, converted in batches, gives the doubles that converting each value on
+        // its own gives
+        void TestBatchMatchesConvert()
+        {
+            // An odd count, so that the batches end with values the vectorized kernel converts one at a time
+            vector<double> values;
+            mt19937 generator(36);
+            uniform_real_distribution<double> exponent(-12.0, 12.0);
+            for (int i = 0; i < 37; i++)
+            {
+                double value = pow(10, exponent(generator));
+                values.push_back(i % 3 == 0 ? -value : value);
+            }
+            values.insert(values.end(), { 0.0, -0.0, 1.0, 0.1, 123456789012345.0, 1e-300, 1e300 });
+
+            VerifyBatchMatchesConvert(make_shared<TestUnitConverterConfigLoader>(), values);
+            VerifyBatchMatchesConvert(make_shared<TestSuggestedValuesConfigLoader>(), values);
+        }
+
+    private:
+        static void VerifyBatchMatchesConvert(const shared_ptr<IConverterDataLoader>& loader, const vector<double>& values)
+        {
+            UnitConverter unitConverter(loader);
+            unitConverter.Initialize();
+
+            vector<double> batch(values.size());
+            vector<double> vectorized(values.size());
+            vector<double> scalar(values.size());
+            for (const Category& category : loader->LoadOrderedCategories())
+            {
+                for (const Unit& from : loader->LoadOrderedUnits(category))
+                {
+                    unordered_map<Unit, ConversionData, UnitHash> ratios = loader->LoadOrderedRatios(from);
+                    for (const Unit& to : loader->LoadOrderedUnits(category))
+                    {
+                        auto conversionData = ratios.find(to);
+                        if (conversionData == ratios.end())
+                        {
+                            continue;
+                        }
+
+                        VERIFY_IS_TRUE(unitConverter.ConvertValues(from.id, to.id, values.data(), batch.data(), values.size()));
+                        ConvertValues(conversionData->second, values.data(), vectorized.data(), values.size());
+                        ConvertValuesScalar(conversionData->second, values.data(), scalar.data(), values.size());
+                        for (size_t i = 0; i < values.size(); i++)
+                        {
+                            const double expected = UnitConverter::Convert(values[i], conversionData->second);
+                            const wstring message = from.name + L" to " + to.name + L", value " + to_wstring(i);
+                            VERIFY_ARE_EQUAL(expected, batch[i], message);
+                            VERIFY_ARE_EQUAL(expected, vectorized[i], message);
+                            VERIFY_ARE_EQUAL(expected, scalar[i], message);
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    // Gives a static category and the currencies, with the rates between them worked out from their ratios to the first
+    // currency as the app's currency data loader does, so that a refresh can change some of them
+    class TestCurrencyConfigLoader : public IConverterDataLoader, public ICurrencyConverterDataLoader
+    {
+    public:
+        TestCurrencyConfigLoader()
+            : m_loadOrderedRatiosCallCount(0)
+        {
+            SetCategoryParams(&m_length, 1, L"Length", true);
+            SetCategoryParams(&m_currency, 3, L"Currency", false);
+
+            Unit inches, feet;
+            SetUnitParams(&inches, 1, L"Inches", L"In", true, true, false);
+            SetUnitParams(&feet, 2, L"Feet", L"Ft", false, false, false);
+            m_lengthUnits = { inches, feet };
+
+            Unit dollar, euro, yen;
+            SetUnitParams(&dollar, 10, L"Dollar", L"USD", true, false, false);
+            SetUnitParams(&euro, 11, L"Euro", L"EUR", false, true, false);
+            SetUnitParams(&yen, 12, L"Yen", L"JPY", false, false, false);
+            m_currencyUnits = { dollar, euro, yen };
+            m_rates.Build({ 1, 0.5, 150 });
+        }
+
+        // As a refresh of the feed, which gives the ratios of every currency again
+        void SetRatios(const vector<double>& ratios)
+        {
+            if (!m_rates.Update(ratios, m_changedPositions))
+            {
+                m_changedPositions.clear();
+                m_isConversionTableCurrent = false;
+            }
+        }
+
+        unsigned int GetLoadOrderedRatiosCallCount() const
+        {
+            return m_loadOrderedRatiosCallCount;
+        }
+
+        const Category& GetCurrency() const
+        {
+            return m_currency;
+        }
+
+        const vector<Unit>& GetCurrencyUnits() const
+        {
+            return m_currencyUnits;
+        }
+
+        void LoadData() override
+        {
+        }
+
+        vector<Category> LoadOrderedCategories() override
+        {
+            return { m_length, m_currency };
+        }
+
+        vector<Unit> LoadOrderedUnits(const Category& category) override
+        {
+            return category == m_currency ? m_currencyUnits : m_lengthUnits;
+        }
+
+        unordered_map<Unit, ConversionData, UnitHash> LoadOrderedRatios(const Unit& /*unit*/) override
+        {
+            m_loadOrderedRatiosCallCount++;
+            return { { m_lengthUnits[0], ConversionData{ 1.0, 0, false } }, { m_lengthUnits[1], ConversionData{ 1.0 / 12, 0, false } } };
+        }
+
+        bool SupportsCategory(const Category& target) override
+        {
+            return target == m_currency;
+        }
+
+        bool LoadConversionTable(_Inout_ CategoryConversionTable& table) override
+        {
+            if (table.units != m_currencyUnits)
+            {
+                return false;
+            }
+
+            for (size_t from = 0; from < table.units.size(); from++)
+            {
+                for (size_t to = 0; to < table.units.size(); to++)
+                {
+                    table.conversionData[table.GetIndex(from, to)] = ConversionData{ m_rates.GetRate(from, to), 0, false };
+                    table.hasConversionData[table.GetIndex(from, to)] = true;
+                }
+            }
+            m_changedPositions.clear();
+            m_isConversionTableCurrent = true;
+            return true;
+        }
+
+        bool UpdateConversionTable(_Inout_ CategoryConversionTable& table, _Inout_ vector<size_t>& changedUnits) override
+        {
+            if (!m_isConversionTableCurrent || table.units.size() != m_rates.GetCount())
+            {
+                return false;
+            }
+
+            for (size_t position : m_changedPositions)
+            {
+                for (size_t other = 0; other < table.units.size(); other++)
+                {
+                    table.conversionData[table.GetIndex(position, other)] = ConversionData{ m_rates.GetRate(position, other), 0, false };
+                    table.conversionData[table.GetIndex(other, position)] = ConversionData{ m_rates.GetRate(other, position), 0, false };
+                }
+                changedUnits.push_back(position);
+            }
+            m_changedPositions.clear();
+            return true;
+        }
+
+        void SetViewModelCallback(const shared_ptr<IViewModelCurrencyCallback>& /*callback*/) override
+        {
+        }
+
+        pair<wstring, wstring> GetCurrencySymbols(_In_ const Unit& unit1, _In_ const Unit& unit2) override
+        {
+            return { unit1.abbreviation, unit2.abbreviation };
+        }
+
+        pair<wstring, wstring> GetCurrencyRatioEquality(_In_ const Unit& unit1, _In_ const Unit& unit2) override
+        {
+            wostringstream ratio;
+            ratio << L"1 " << unit1.abbreviation << L" = " << m_rates.GetDisplayRate(GetPosition(unit1), GetPosition(unit2)) << L" " << unit2.abbreviation;
+            return { ratio.str(), ratio.str() };
+        }
+
+        wstring GetCurrencyTimestamp() override
+        {
+            return L"";
+        }
+
+        future<bool> TryLoadDataFromCacheAsync() override
+        {
+            return MakeReadyFuture();
+        }
+
+        future<bool> TryLoadDataFromWebAsync() override
+        {
+            return MakeReadyFuture();
+        }
+
+        future<bool> TryLoadDataFromWebOverrideAsync() override
+        {
+            return MakeReadyFuture();
+        }
+
+    private:
+        static future<bool> MakeReadyFuture()
+        {
+            promise<bool> loaded;
+            loaded.set_value(true);
+            return loaded.get_future();
+        }
+
+        size_t GetPosition(const Unit& unit) const
+        {
+            return static_cast<size_t>(find(m_currencyUnits.begin(), m_currencyUnits.end(), unit) - m_currencyUnits.begin());
+        }
+
+        Category m_length;
+        Category m_currency;
+        vector<Unit> m_lengthUnits;
+        vector<Unit> m_currencyUnits;
+        CurrencyRateMatrix m_rates;
+        vector<size_t> m_changedPositions;
+        bool m_isConversionTableCurrent = false;
+        unsigned int m_loadOrderedRatiosCallCount;
+    };
+
+    class TestViewModelCurrencyCallback : public IViewModelCurrencyCallback
+    {
+    public:
+        void CurrencyDataLoadFinished(bool /*didLoad*/) override
+        {
+        }
+
+        void CurrencySymbolsCallback(_In_ const wstring& /*fromSymbol*/, _In_ const wstring& /*toSymbol*/) override
+        {
+        }
+
+        void CurrencyRatiosCallback(_In_ const wstring& ratioEquality, _In_ const wstring& /*accRatioEquality*/) override
+        {
+            m_lastRatioEquality = ratioEquality;
+        }
+
+        void CurrencyTimestampCallback(_In_ const wstring& /*timestamp*/, bool /*isWeekOldData*/) override
+        {
+        }
+
+        void NetworkBehaviorChanged(_In_ int /*newBehavior*/) override
+        {
+        }
+
+        wstring m_lastRatioEquality;
+    };
+
+    class UnitConverterCurrencyRefreshTest
+    {
+    public:
+        // A refresh changes the rates of the loaded currencies in place: the value and the rate shown for the selected
+        // pair follow it, and the static category isn't loaded again
+        void TestUpdateCurrencyRatios()
+        {
+            auto loader = make_shared<TestCurrencyConfigLoader>();
+            auto callback = make_shared<TestUnitConverterVMCallback>();
+            auto currencyCallback = make_shared<TestViewModelCurrencyCallback>();
+            UnitConverter unitConverter(loader, loader);
+            unitConverter.SetViewModelCallback(callback);
+            unitConverter.SetViewModelCurrencyCallback(currencyCallback);
+
+            const vector<Unit>& currencies = loader->GetCurrencyUnits();
+            unitConverter.SetCurrentCategory(loader->GetCurrency());
+            unitConverter.SetCurrentUnitTypes(currencies[0], currencies[1]);
+            unitConverter.SendCommand(Command::One);
+            unitConverter.SendCommand(Command::Zero);
+            VERIFY_IS_TRUE(callback->CheckDisplayValues(L"10", L"5"));
+            VERIFY_ARE_EQUAL(L"1 USD = 0.5 EUR", currencyCallback->m_lastRatioEquality);
+            const unsigned int loadOrderedRatiosCallCount = loader->GetLoadOrderedRatiosCallCount();
+
+            loader->SetRatios({ 1, 0.25, 150 });
+            VERIFY_IS_TRUE(unitConverter.UpdateCurrencyRatios());
+            VERIFY_IS_TRUE(callback->CheckDisplayValues(L"10", L"2.5"));
+            VERIFY_ARE_EQUAL(L"1 USD = 0.25 EUR", currencyCallback->m_lastRatioEquality);
+
+            // A change to a currency that isn't selected shows nothing new, but is used once it is
+            currencyCallback->m_lastRatioEquality.clear();
+            loader->SetRatios({ 1, 0.25, 155 });
+            VERIFY_IS_TRUE(unitConverter.UpdateCurrencyRatios());
+            VERIFY_IS_TRUE(callback->CheckDisplayValues(L"10", L"2.5"));
+            VERIFY_IS_TRUE(currencyCallback->m_lastRatioEquality.empty());
+
+            unitConverter.SetCurrentUnitTypes(currencies[1], currencies[2]);
+            VERIFY_IS_TRUE(callback->CheckDisplayValues(L"10", L"6200"));
+            VERIFY_ARE_EQUAL(L"1 EUR = 620 JPY", currencyCallback->m_lastRatioEquality);
+            VERIFY_ARE_EQUAL(loadOrderedRatiosCallCount, loader->GetLoadOrderedRatiosCallCount());
+
+            // Another number of currencies can't be applied in place
+            loader->SetRatios({ 1, 0.25, 155, 7 });
+            VERIFY_IS_FALSE(unitConverter.UpdateCurrencyRatios());
+        }
+    };
+
+    CALC_TEST_METHOD(UnitConverterTest, UnitConverterTestInit);
+    CALC_TEST_METHOD(UnitConverterTest, UnitConverterTestBasic);
+    CALC_TEST_METHOD(UnitConverterTest, UnitConverterTestGetters);
+    CALC_TEST_METHOD(UnitConverterTest, UnitConverterTestGetCategory);
+    CALC_TEST_METHOD(UnitConverterTest, UnitConverterTestUnitTypeSwitching);
+    CALC_TEST_METHOD(UnitConverterTest, UnitConverterTestQuote);
+    CALC_TEST_METHOD(UnitConverterTest, UnitConverterTestUnquote);
+    CALC_TEST_METHOD(UnitConverterTest, UnitConverterTestBackspace);
+    CALC_TEST_METHOD(UnitConverterTest, UnitConverterTestScientificInputs);
+    CALC_TEST_METHOD(UnitConverterTest, UnitConverterTestSupplementaryResultRounding);
+    CALC_TEST_METHOD(UnitConverterTest, UnitConverterTestMaxDigitsReached);
+    CALC_TEST_METHOD(UnitConverterTest, UnitConverterTestMaxDigitsReached_LeadingDecimal);
+    CALC_TEST_METHOD(UnitConverterTest, UnitConverterTestMaxDigitsReached_TrailingDecimal);
+    CALC_TEST_METHOD(UnitConverterTest, UnitConverterTestMaxDigitsReached_MultipleTimes);
+    CALC_TEST_METHOD(UnitConverterTest, UnitConverterTestBinaryUserPreferences);
+    CALC_TEST_METHOD(UnitConverterTest, UnitConverterTestUpdateCurrencyRatiosWithoutCurrencies);
+    CALC_TEST_METHOD(UnitConverterSuggestedValuesTest, TestSuggestedValuesMatchFullSort);
+    CALC_TEST_METHOD(UnitConverterCurrencyRefreshTest, TestUpdateCurrencyRatios);
+    CALC_TEST_METHOD(UnitConversionKernelTest, TestBatchMatchesConvert);
+}
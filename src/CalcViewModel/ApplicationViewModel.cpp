@@ -145,7 +145,11 @@ void ApplicationViewModel::OnModeChanged()
         {
             auto dataLoader = make_shared<UnitConverterDataLoader>(ref new GeographicRegion());
             auto currencyDataLoader = make_shared<CurrencyDataLoader>(make_unique<CurrencyHttpClient>());
-            m_ConverterViewModel = ref new UnitConverterViewModel(make_shared<UnitConversionManager::UnitConverter>(dataLoader, currencyDataLoader));
+            auto unitConverter = make_shared<UnitConversionManager::UnitConverter>(dataLoader, currencyDataLoader);
+
+            // The units with exact factors are converted without rounding anything but the result
+            unitConverter->SetExactMode(true);
+            m_ConverterViewModel = ref new UnitConverterViewModel(unitConverter);
         }
 
         m_ConverterViewModel->Mode = m_mode;
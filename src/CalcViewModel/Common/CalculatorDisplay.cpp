@@ -94,6 +94,39 @@ void CalculatorDisplay::SetMemorizedNumbers(_In_ const vector<std::wstring>& new
     }
 }
 
+void CalculatorDisplay::InsertMemorizedNumber(unsigned int indexOfMemory, const std::wstring& memorizedNumber)
+{
+    if (m_callbackReference != nullptr)
+    {
+        if (auto calcVM = m_callbackReference.Resolve<ViewModel::StandardCalculatorViewModel>())
+        {
+            calcVM->InsertMemorizedNumber(indexOfMemory, memorizedNumber);
+        }
+    }
+}
+
+void CalculatorDisplay::UpdateMemorizedNumber(unsigned int indexOfMemory, const std::wstring& memorizedNumber)
+{
+    if (m_callbackReference != nullptr)
+    {
+        if (auto calcVM = m_callbackReference.Resolve<ViewModel::StandardCalculatorViewModel>())
+        {
+            calcVM->UpdateMemorizedNumber(indexOfMemory, memorizedNumber);
+        }
+    }
+}
+
+void CalculatorDisplay::RemoveMemorizedNumber(unsigned int indexOfMemory)
+{
+    if (m_callbackReference != nullptr)
+    {
+        if (auto calcVM = m_callbackReference.Resolve<ViewModel::StandardCalculatorViewModel>())
+        {
+            calcVM->RemoveMemorizedNumber(indexOfMemory);
+        }
+    }
+}
+
 void CalculatorDisplay::OnHistoryItemAdded(_In_ unsigned int addedItemIndex)
 {
     if (m_historyCallbackReference != nullptr)
@@ -22,6 +22,9 @@ namespace CalculatorApp
             _Inout_ std::shared_ptr<std::vector<std::pair<std::wstring, int>>> const& tokens,
             _Inout_ std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> const& commands) override;
         void SetMemorizedNumbers(_In_ const std::vector<std::wstring>& memorizedNumbers) override;
+        void InsertMemorizedNumber(unsigned int indexOfMemory, const std::wstring& memorizedNumber) override;
+        void UpdateMemorizedNumber(unsigned int indexOfMemory, const std::wstring& memorizedNumber) override;
+        void RemoveMemorizedNumber(unsigned int indexOfMemory) override;
         void OnHistoryItemAdded(_In_ unsigned int addedItemIndex) override;
         void SetParenthesisNumber(_In_ unsigned int parenthesisCount) override;
         void OnNoRightParenAdded() override;
@@ -5,11 +5,13 @@
 #include "CopyPasteManager.h"
 #include "Common/TraceLogger.h"
 #include "Common/LocalizationSettings.h"
+#include "CalcManager/PasteExpressionParser.h"
 
 using namespace std;
 using namespace concurrency;
 using namespace CalculatorApp;
 using namespace CalculatorApp::Common;
+using namespace CalculationManager;
 using namespace Platform;
 using namespace Platform::Collections;
 using namespace Windows::Foundation;
@@ -19,47 +21,23 @@ using namespace Windows::Foundation::Collections;
 
 StringReference PasteErrorString(L"NoOp");
 
-static const wstring c_validBasicCharacterSet = L"0123456789+-.e";
-static const wstring c_validStandardCharacterSet = c_validBasicCharacterSet + L"*/";
-static const wstring c_validScientificCharacterSet = c_validStandardCharacterSet + L"()^%";
-static const wstring c_validProgrammerCharacterSet = c_validStandardCharacterSet + L"()%abcdfABCDEF";
-
-// The below values can not be "constexpr"-ed,
-// as both wstring_view and wchar[] can not be concatenated
-// [\s\x85] means white-space characters
-static const wstring c_wspc = L"[\\s\\x85]*";
-static const wstring c_wspcLParens = c_wspc + L"[(]*" + c_wspc;
-static const wstring c_wspcLParenSigned = c_wspc + L"([-+]?[(])*" + c_wspc;
-static const wstring c_wspcRParens = c_wspc + L"[)]*" + c_wspc;
-static const wstring c_signedDecFloat = L"(?:[-+]?(?:\\d+(\\.\\d*)?|\\.\\d+))";
-static const wstring c_optionalENotation = L"(?:e[+-]?\\d+)?";
-
-// Programmer Mode Integer patterns
-// Support digit separators ` (WinDbg/MASM), ' (C++), and _ (C# and other languages)
-static const wstring c_hexProgrammerChars = L"([a-f]|[A-F]|\\d)+((_|'|`)([a-f]|[A-F]|\\d)+)*";
-static const wstring c_decProgrammerChars = L"\\d+((_|'|`)\\d+)*";
-static const wstring c_octProgrammerChars = L"[0-7]+((_|'|`)[0-7]+)*";
-static const wstring c_binProgrammerChars = L"[0-1]+((_|'|`)[0-1]+)*";
-static const wstring c_uIntSuffixes = L"[uU]?[lL]{0,2}";
-
-// RegEx Patterns used by various modes
-static const array<wregex, 1> standardModePatterns = { wregex(c_wspc + c_signedDecFloat + c_optionalENotation + c_wspc) };
-static const array<wregex, 1> scientificModePatterns = { wregex(
-    L"(" + c_wspc + L"[-+]?)|(" + c_wspcLParenSigned + L")" + c_signedDecFloat + c_optionalENotation + c_wspcRParens) };
-static const array<array<wregex, 5>, 4> programmerModePatterns = {
-    { // Hex numbers like 5F, 4A0C, 0xa9, 0xFFull, 47CDh
-      { wregex(c_wspcLParens + L"(0[xX])?" + c_hexProgrammerChars + c_uIntSuffixes + c_wspcRParens),
-        wregex(c_wspcLParens + c_hexProgrammerChars + L"[hH]?" + c_wspcRParens) },
-      // Decimal numbers like -145, 145, 0n145, 123ull etc
-      { wregex(c_wspcLParens + L"[-+]?" + c_decProgrammerChars + L"[lL]{0,2}" + c_wspcRParens),
-        wregex(c_wspcLParens + L"(0[nN])?" + c_decProgrammerChars + c_uIntSuffixes + c_wspcRParens) },
-      // Octal numbers like 06, 010, 0t77, 0o77, 077ull etc
-      { wregex(c_wspcLParens + L"(0[otOT])?" + c_octProgrammerChars + c_uIntSuffixes + c_wspcRParens) },
-      // Binary numbers like 011010110, 0010110, 10101001, 1001b, 0b1001, 0y1001, 0b1001ull
-      { wregex(c_wspcLParens + L"(0[byBY])?" + c_binProgrammerChars + c_uIntSuffixes + c_wspcRParens),
-        wregex(c_wspcLParens + c_binProgrammerChars + L"[bB]?" + c_wspcRParens) } }
-};
-static const array<wregex, 1> unitConverterPatterns = { wregex(c_wspc + c_signedDecFloat + c_wspc) };
+namespace
+{
+    PasteGrammar GetPasteGrammar(ViewMode mode)
+    {
+        switch (mode)
+        {
+        case ViewMode::Standard:
+            return PasteGrammar::Standard;
+        case ViewMode::Scientific:
+            return PasteGrammar::Scientific;
+        case ViewMode::Programmer:
+            return PasteGrammar::Programmer;
+        default:
+            return PasteGrammar::Converter;
+        }
+    }
+}
 
 void CopyPasteManager::CopyToClipboard(String ^ stringToCopy)
 {
@@ -155,109 +133,26 @@ String
 IVector<Platform::String ^> ^ CopyPasteManager::ExtractOperands(Platform::String ^ pasteExpression, ViewMode mode)
 {
     auto operands = ref new Vector<Platform::String ^>();
-    size_t lastIndex = 0;
-    bool haveOperator = false;
-    bool startExpCounting = false;
-    bool startOfExpression = true;
-    bool isPreviousOpenParen = false;
-    bool isPreviousOperator = false;
-
-    wstring validCharacterSet;
-    switch (mode)
-    {
-    case ViewMode::Standard:
-        validCharacterSet = c_validStandardCharacterSet;
-        break;
-    case ViewMode::Scientific:
-        validCharacterSet = c_validScientificCharacterSet;
-        break;
-    case ViewMode::Programmer:
-        validCharacterSet = c_validProgrammerCharacterSet;
-        break;
-    default:
-        validCharacterSet = c_validBasicCharacterSet;
-    }
 
-    // This will have the exponent length
-    size_t expLength = 0;
-    int i = -1;
-    for (auto currentChar : pasteExpression)
-    {
-        ++i;
-        // if the current character is not a valid one don't process it
-        if (validCharacterSet.find(currentChar) == wstring_view::npos)
-        {
-            continue;
-        }
-
-        if (operands->Size >= MaxOperandCount)
-        {
-            TraceLogger::GetInstance()->LogError(mode, L"CopyPasteManager::ExtractOperands", L"OperandCountGreaterThanMaxCount");
-            operands->Clear();
-            return operands;
-        }
-
-        if (currentChar >= L'0' && currentChar <= L'9')
-        {
-            if (startExpCounting)
-            {
-                expLength++;
+    vector<wstring_view> operandViews;
+    auto result = PasteExpressionParser::ExtractOperands(
+        wstring_view(pasteExpression->Data(), pasteExpression->Length()), GetPasteGrammar(mode), MaxOperandCount, MaxExponentLength, operandViews);
 
-                // to disallow pasting of 1e+12345 as 1e+1234, max exponent that can be pasted is 9999.
-                if (expLength > MaxExponentLength)
-                {
-                    TraceLogger::GetInstance()->LogError(mode, L"CopyPasteManager::ExtractOperands", L"ExponentLengthGreaterThanMaxLength");
-                    operands->Clear();
-                    return operands;
-                }
-            }
-            isPreviousOperator = false;
-        }
-        else if (currentChar == L'e')
-        {
-            if (mode != ViewMode::Programmer)
-            {
-                startExpCounting = true;
-            }
-            isPreviousOperator = false;
-        }
-        else if (currentChar == L'+' || currentChar == L'-' || currentChar == L'*' || currentChar == L'/' || currentChar == L'^' || currentChar == L'%')
-        {
-            if (currentChar == L'+' || currentChar == L'-')
-            {
-                // don't break the expression into operands if the encountered character corresponds to sign command(+-)
-                if (isPreviousOpenParen || startOfExpression || isPreviousOperator
-                    || ((mode != ViewMode::Programmer) && !((i != 0) && pasteExpression->Data()[i - 1] != L'e')))
-                {
-                    isPreviousOperator = false;
-                    continue;
-                }
-            }
-
-            startExpCounting = false;
-            expLength = 0;
-            haveOperator = true;
-            isPreviousOperator = true;
-            operands->Append(ref new String(wstring(pasteExpression->Data()).substr(lastIndex, i - lastIndex).c_str()));
-            lastIndex = i + 1;
-        }
-        else
-        {
-            isPreviousOperator = false;
-        }
-
-        isPreviousOpenParen = (currentChar == L'(');
-        startOfExpression = false;
-    }
-
-    if (!haveOperator)
+    switch (result)
     {
-        operands->Clear();
-        operands->Append(pasteExpression);
+    case ExtractOperandsResult::Success:
+        break;
+    case ExtractOperandsResult::TooManyOperands:
+        TraceLogger::GetInstance()->LogError(mode, L"CopyPasteManager::ExtractOperands", L"OperandCountGreaterThanMaxCount");
+        return operands;
+    case ExtractOperandsResult::ExponentTooLong:
+        TraceLogger::GetInstance()->LogError(mode, L"CopyPasteManager::ExtractOperands", L"ExponentLengthGreaterThanMaxLength");
+        return operands;
     }
-    else
+
+    for (const auto& operand : operandViews)
     {
-        operands->Append(ref new String(wstring(pasteExpression->Data()).substr(lastIndex, pasteExpression->Length() - 1).c_str()));
+        operands->Append(ref new String(operand.data(), static_cast<unsigned int>(operand.length())));
     }
 
     return operands;
@@ -275,38 +170,29 @@ bool CopyPasteManager::ExpressionRegExMatch(
         return false;
     }
 
-    vector<wregex> patterns{};
-
-    if (mode == ViewMode::Standard)
+    PasteGrammar grammar;
+    if (mode == ViewMode::Standard || mode == ViewMode::Scientific || mode == ViewMode::Programmer)
     {
-        patterns.assign(standardModePatterns.begin(), standardModePatterns.end());
+        grammar = GetPasteGrammar(mode);
     }
-    else if (mode == ViewMode::Scientific)
-    {
-        patterns.assign(scientificModePatterns.begin(), scientificModePatterns.end());
-    }
-    else if (mode == ViewMode::Programmer)
+    else if (modeType == CategoryGroupType::Converter)
     {
-        patterns.assign(
-            programmerModePatterns[(int)programmerNumberBase - (int)NumberBase::HexBase].begin(),
-            programmerModePatterns[(int)programmerNumberBase - (int)NumberBase::HexBase].end());
+        grammar = PasteGrammar::Converter;
     }
-    else if (modeType == CategoryGroupType::Converter)
+    else
     {
-        patterns.assign(unitConverterPatterns.begin(), unitConverterPatterns.end());
+        return false;
     }
 
+    auto radix = (mode == ViewMode::Programmer) ? static_cast<RADIX_TYPE>((int)programmerNumberBase - (int)NumberBase::HexBase) : DEC_RADIX;
+
     auto maxOperandLengthAndValue = GetMaxOperandLengthAndValue(mode, modeType, programmerNumberBase, bitLengthType);
     bool expMatched = true;
 
     for (const auto& operand : operands)
     {
-        // Each operand only needs to match one of the available patterns.
-        bool operandMatched = false;
-        for (const auto& pattern : patterns)
-        {
-            operandMatched = operandMatched || regex_match(operand->Data(), pattern);
-        }
+        // Each operand only needs to match one of the operand patterns of the grammar.
+        bool operandMatched = PasteExpressionParser::IsValidOperand(wstring_view(operand->Data(), operand->Length()), grammar, radix);
 
         if (operandMatched)
         {
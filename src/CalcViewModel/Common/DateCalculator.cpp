@@ -3,12 +3,50 @@
 
 #include "pch.h"
 #include "DateCalculator.h"
+#include "CalcManager/DateCalculation.h"
 
 using namespace Platform;
 using namespace Windows::Foundation;
 using namespace Windows::Globalization;
 using namespace CalculatorApp::Common::DateCalculation;
 
+namespace GregorianDates = CalcManager::DateCalculation;
+
+namespace
+{
+    // The day of UniversalTime 0, which counts from 1601-01-01
+    const int32_t c_firstDay = GregorianDates::DaysFromCivil({ 1601, 1, 1 });
+    const int32_t c_lastDay = GregorianDates::DaysFromCivil({ GregorianDates::MAX_YEAR, 12, 31 });
+
+    // The first day of the Meiji era, before which the Japanese calendar has no dates
+    const int32_t c_firstJapaneseDay = GregorianDates::DaysFromCivil({ 1868, 9, 8 });
+
+    int32_t GetDay(DateTime date, _Out_ int64_t& timeOfDay)
+    {
+        const int64_t dayLength = static_cast<int64_t>(c_day);
+        int64_t days = date.UniversalTime / dayLength;
+        timeOfDay = date.UniversalTime % dayLength;
+        if (timeOfDay < 0)
+        {
+            days--;
+            timeOfDay += dayLength;
+        }
+        return static_cast<int32_t>(days + c_firstDay);
+    }
+
+    DateTime GetDateTime(int32_t day, int64_t timeOfDay)
+    {
+        DateTime date;
+        date.UniversalTime = static_cast<int64_t>(day - c_firstDay) * static_cast<int64_t>(c_day) + timeOfDay;
+        return date;
+    }
+
+    GregorianDates::DateDuration GetDuration(const DateDifference& difference)
+    {
+        return GregorianDates::DateDuration{ difference.year, difference.month, difference.week, difference.day };
+    }
+}
+
 bool operator==(const DateDifference& l, const DateDifference& r)
 {
     return l.year == r.year && l.month == r.month && l.week == r.week && l.day == r.day;
@@ -19,12 +57,28 @@ DateCalculationEngine::DateCalculationEngine(_In_ String ^ calendarIdentifier)
     m_calendar = ref new Calendar();
     m_calendar->ChangeTimeZone("UTC");
     m_calendar->ChangeCalendarSystem(calendarIdentifier);
+
+    // The Japanese calendar has the months and days of the Gregorian one, as the comments below explain
+    m_isGregorian = calendarIdentifier == CalendarIdentifiers::Gregorian || calendarIdentifier == CalendarIdentifiers::Japanese;
+    m_firstDay = calendarIdentifier == CalendarIdentifiers::Japanese ? c_firstJapaneseDay : GregorianDates::DaysFromCivil({ GregorianDates::MIN_YEAR, 1, 1 });
 }
 
 // Adding Duration to a Date
 // Returns: True if function succeeds to calculate the date else returns False
 IBox<DateTime> ^ DateCalculationEngine::AddDuration(DateTime startDate, DateDifference duration)
 {
+    if (m_isGregorian)
+    {
+        int64_t timeOfDay;
+        const int32_t startDay = GetDay(startDate, timeOfDay);
+        int32_t day;
+        if (startDay >= m_firstDay && GregorianDates::TryAddDuration(startDay, GetDuration(duration), day) && day >= m_firstDay)
+        {
+            return GetDateTime(day, timeOfDay);
+        }
+        return nullptr;
+    }
+
     auto currentCalendarSystem = m_calendar->GetCalendarSystem();
     try
     {
@@ -71,10 +125,22 @@ IBox<DateTime> ^ DateCalculationEngine::AddDuration(DateTime startDate, DateDiff
 // Returns: True if function succeeds to calculate the date else returns False
 IBox<DateTime> ^ DateCalculationEngine::SubtractDuration(_In_ DateTime startDate, _In_ DateDifference duration)
 {
-    auto currentCalendarSystem = m_calendar->GetCalendarSystem();
-
     // For Subtract the Algorithm is different than Add. Here the smaller units are subtracted first
     // and then the larger units.
+    if (m_isGregorian)
+    {
+        int64_t timeOfDay;
+        const int32_t startDay = GetDay(startDate, timeOfDay);
+        int32_t day;
+        if (startDay >= m_firstDay && GregorianDates::TrySubtractDuration(startDay, GetDuration(duration), day) && day >= c_firstDay
+            && day >= m_firstDay)
+        {
+            return GetDateTime(day, timeOfDay);
+        }
+        return nullptr;
+    }
+
+    auto currentCalendarSystem = m_calendar->GetCalendarSystem();
     try
     {
         m_calendar->SetDateTime(startDate);
@@ -128,6 +194,24 @@ IBox<DateTime> ^ DateCalculationEngine::SubtractDuration(_In_ DateTime startDate
 // Calculate the difference between two dates
 IBox<DateDifference> ^ DateCalculationEngine::TryGetDateDifference(_In_ DateTime date1, _In_ DateTime date2, _In_ DateUnit outputFormat)
 {
+    // Dates at the same time of day, as the view model gives them, are whole days apart, which is all that the
+    // arithmetic counts. Anything else is left to the pivot loop below.
+    int64_t timeOfDay;
+    const int32_t day1 = GetDay(date1, timeOfDay);
+    const int32_t day2 = GetDay(date2, timeOfDay);
+    const int32_t firstDay = m_firstDay > c_firstDay ? m_firstDay : c_firstDay;
+    if (m_isGregorian && (date2.UniversalTime - date1.UniversalTime) % static_cast<int64_t>(c_day) == 0 && day1 >= firstDay && day2 >= firstDay
+        && day1 <= c_lastDay && day2 <= c_lastDay)
+    {
+        const GregorianDates::DateDuration difference = GregorianDates::GetDateDifference(day1, day2, static_cast<uint32_t>(outputFormat));
+        DateDifference result;
+        result.year = difference.years;
+        result.month = difference.months;
+        result.week = difference.weeks;
+        result.day = difference.days;
+        return result;
+    }
+
     DateTime startDate;
     DateTime endDate;
     DateTime pivotDate;
@@ -57,6 +57,8 @@ namespace CalculatorApp
             private:
                 // Private Variables
                 Windows::Globalization::Calendar ^ m_calendar;
+                bool m_isGregorian; // Date math is done with CalcManager::DateCalculation, without the calendar
+                int32_t m_firstDay; // The first day, counted as CalcManager::DateCalculation does, that the calendar has
 
                 // Private Methods
                 int GetDifferenceInDays(Windows::Foundation::DateTime date1, Windows::Foundation::DateTime date2);
@@ -2,7 +2,10 @@
 // Licensed under the MIT License.
 
 #include "pch.h"
+#include <filesystem>
+#include <fstream>
 #include "CurrencyDataLoader.h"
+#include "CalcManager/CurrencyTable.h"
 #include "Common/AppResourceProvider.h"
 #include "Common/LocalizationStringUtil.h"
 #include "Common/LocalizationService.h"
@@ -40,24 +43,19 @@ static constexpr long long DAY_DURATION = 1LL * 60 * 60 * 24 * 10000000;
 static constexpr long long WEEK_DURATION = DAY_DURATION * 7;
 
 static constexpr int FORMATTER_RATE_FRACTION_PADDING = 2;
-static constexpr int FORMATTER_RATE_MIN_DECIMALS = 4;
-static constexpr int FORMATTER_RATE_MIN_SIGNIFICANT_DECIMALS = 4;
 
 static constexpr auto CACHE_TIMESTAMP_KEY = L"CURRENCY_CONVERTER_TIMESTAMP";
 static constexpr auto CACHE_LANGCODE_KEY = L"CURRENCY_CONVERTER_LANGCODE";
 static constexpr auto CACHE_DELIMITER = L"%";
 
 static constexpr auto STATIC_DATA_FILENAME = L"CURRENCY_CONVERTER_STATIC_DATA.txt";
-static constexpr array<wstring_view, 5> STATIC_DATA_PROPERTIES = { wstring_view{ L"CountryCode", 11 },
-                                                                   wstring_view{ L"CountryName", 11 },
-                                                                   wstring_view{ L"CurrencyCode", 12 },
-                                                                   wstring_view{ L"CurrencyName", 12 },
-                                                                   wstring_view{ L"CurrencySymbol", 14 } };
 
 static constexpr auto ALL_RATIOS_DATA_FILENAME = L"CURRENCY_CONVERTER_ALL_RATIOS_DATA.txt";
-static constexpr auto RATIO_KEY = L"Rt";
-static constexpr auto CURRENCY_CODE_KEY = L"An";
-static constexpr array<wstring_view, 2> ALL_RATIOS_DATA_PROPERTIES = { wstring_view{ RATIO_KEY, 2 }, wstring_view{ CURRENCY_CODE_KEY, 2 } };
+
+// The parsed currencies, which are read on the next start instead of the JSON files above. The snapshot is written to
+// the temporary file and then renamed, so that a write that doesn't finish leaves the old snapshot.
+static constexpr auto SNAPSHOT_FILENAME = L"CURRENCY_CONVERTER_SNAPSHOT.bin";
+static constexpr auto SNAPSHOT_TEMPORARY_FILENAME = L"CURRENCY_CONVERTER_SNAPSHOT.tmp";
 
 static constexpr auto DEFAULT_FROM_TO_CURRENCY_FILE_URI = L"ms-appx:///DataLoaders/DefaultFromToCurrency.json";
 static constexpr auto FROM_KEY = L"from";
@@ -84,6 +82,7 @@ namespace CalculatorApp
             StringReference CacheDelimiter(CACHE_DELIMITER);
             StringReference StaticDataFilename(STATIC_DATA_FILENAME);
             StringReference AllRatiosDataFilename(ALL_RATIOS_DATA_FILENAME);
+            StringReference SnapshotFilename(SNAPSHOT_FILENAME);
             long long DayDuration = DAY_DURATION;
         }
     }
@@ -97,6 +96,7 @@ CurrencyDataLoader::CurrencyDataLoader(_In_ unique_ptr<ICurrencyHttpClient> clie
     , m_timestampFormat(L"")
     , m_networkManager(ref new NetworkManager())
     , m_meteredOverrideSet(false)
+    , m_isConversionTableCurrent(false)
 {
     if (forcedResponseLanguage != nullptr)
     {
@@ -236,7 +236,96 @@ vector<UCM::Unit> CurrencyDataLoader::LoadOrderedUnits(const UCM::Category& /*ca
 unordered_map<UCM::Unit, UCM::ConversionData, UCM::UnitHash> CurrencyDataLoader::LoadOrderedRatios(const UCM::Unit& unit)
 {
     lock_guard<mutex> lock(m_currencyUnitsMutex);
-    return m_currencyRatioMap.at(unit);
+
+    const size_t position = GetCurrencyPosition(unit);
+    if (position >= m_currencyRates.GetCount())
+    {
+        throw out_of_range("The unit is not a loaded currency");
+    }
+
+    unordered_map<UCM::Unit, UCM::ConversionData, UCM::UnitHash> conversions;
+    conversions.reserve(m_currencyUnits.size());
+    for (const UCM::Unit& targetUnit : m_currencyUnits)
+    {
+        conversions.emplace(targetUnit, UCM::ConversionData{ m_currencyRates.GetRate(position, GetCurrencyPosition(targetUnit)), 0.0, false });
+    }
+
+    return conversions;
+}
+
+// Copies the rates straight from the matrix, so that the converter doesn't build a map per currency
+bool CurrencyDataLoader::LoadConversionTable(_Inout_ UCM::CategoryConversionTable& table)
+{
+    lock_guard<mutex> lock(m_currencyUnitsMutex);
+
+    vector<size_t> positions;
+    positions.reserve(table.units.size());
+    for (const UCM::Unit& unit : table.units)
+    {
+        positions.push_back(GetCurrencyPosition(unit));
+    }
+
+    for (size_t fromIndex = 0; fromIndex < positions.size(); fromIndex++)
+    {
+        for (size_t toIndex = 0; toIndex < positions.size(); toIndex++)
+        {
+            if (positions[fromIndex] < m_currencyRates.GetCount() && positions[toIndex] < m_currencyRates.GetCount())
+            {
+                const size_t index = table.GetIndex(fromIndex, toIndex);
+                table.conversionData[index] = UCM::ConversionData{ m_currencyRates.GetRate(positions[fromIndex], positions[toIndex]), 0.0, false };
+                table.hasConversionData[index] = true;
+            }
+        }
+    }
+
+    m_changedCurrencyPositions.clear();
+    m_isConversionTableCurrent = true;
+    return true;
+}
+
+// Copies only the rows and columns of the currencies whose ratios changed since the table was filled
+bool CurrencyDataLoader::UpdateConversionTable(_Inout_ UCM::CategoryConversionTable& table, _Inout_ vector<size_t>& changedUnits)
+{
+    lock_guard<mutex> lock(m_currencyUnitsMutex);
+
+    if (!m_isConversionTableCurrent || table.units.size() != m_currencyUnits.size())
+    {
+        return false;
+    }
+
+    const size_t count = m_currencyRates.GetCount();
+    vector<size_t> positions(table.units.size());
+    vector<size_t> tableIndices(count, table.units.size());
+    for (size_t index = 0; index < table.units.size(); index++)
+    {
+        positions[index] = GetCurrencyPosition(table.units[index]);
+        if (positions[index] < count)
+        {
+            tableIndices[positions[index]] = index;
+        }
+    }
+
+    for (size_t position : m_changedCurrencyPositions)
+    {
+        const size_t changedIndex = position < count ? tableIndices[position] : table.units.size();
+        if (changedIndex == table.units.size())
+        {
+            continue;
+        }
+
+        for (size_t index = 0; index < table.units.size(); index++)
+        {
+            if (positions[index] < count)
+            {
+                table.conversionData[table.GetIndex(changedIndex, index)] = UCM::ConversionData{ m_currencyRates.GetRate(position, positions[index]), 0.0, false };
+                table.conversionData[table.GetIndex(index, changedIndex)] = UCM::ConversionData{ m_currencyRates.GetRate(positions[index], position), 0.0, false };
+            }
+        }
+        changedUnits.push_back(changedIndex);
+    }
+
+    m_changedCurrencyPositions.clear();
+    return true;
 }
 
 bool CurrencyDataLoader::SupportsCategory(const UCM::Category& target)
@@ -271,48 +360,41 @@ pair<wstring, wstring> CurrencyDataLoader::GetCurrencySymbols(const UCM::Unit& u
 
 double CurrencyDataLoader::RoundCurrencyRatio(double ratio)
 {
-    // Compute how many decimals we need to display two meaningful digits at minimum
-    // For example: 0.00000000342334 -> 0.000000003423, 0.000212 -> 0.000212
-    int numberDecimals = FORMATTER_RATE_MIN_DECIMALS;
-    if (ratio < 1)
-    {
-        numberDecimals = max(
-            FORMATTER_RATE_MIN_DECIMALS,
-            (int)(-log10(ratio)) + FORMATTER_RATE_MIN_SIGNIFICANT_DECIMALS);
-    }
-
-    unsigned long long scale = (unsigned long long)powl(10l, numberDecimals);
-
-    return (double)(round(ratio * scale) / scale);
+    return CurrencyRateMatrix::RoundRate(ratio);
 }
 
 pair<wstring, wstring> CurrencyDataLoader::GetCurrencyRatioEquality(_In_ const UCM::Unit& unit1, _In_ const UCM::Unit& unit2)
 {
     try
     {
-        auto iter = m_currencyRatioMap.find(unit1);
-        if (iter != m_currencyRatioMap.end())
+        // The matrix rounds the rates from the source currency once, so only the formatting is left
+        bool hasRate = false;
+        double rounded = 0;
         {
-            unordered_map<UCM::Unit, UCM::ConversionData, UCM::UnitHash> ratioMap = iter->second;
-            auto iter2 = ratioMap.find(unit2);
-            if (iter2 != ratioMap.end())
+            lock_guard<mutex> lock(m_currencyUnitsMutex);
+            const size_t position1 = GetCurrencyPosition(unit1);
+            const size_t position2 = GetCurrencyPosition(unit2);
+            if (position1 < m_currencyRates.GetCount() && position2 < m_currencyRates.GetCount())
             {
-                double ratio = (iter2->second).ratio;
-                double rounded = RoundCurrencyRatio(ratio);
+                rounded = m_currencyRates.GetDisplayRate(position1, position2);
+                hasRate = true;
+            }
+        }
 
-                auto digit = LocalizationSettings::GetInstance().GetDigitSymbolFromEnUsDigit(L'1');
-                auto digitSymbol = ref new String(&digit, 1);
-                auto roundedFormat = m_ratioFormatter->Format(rounded);
+        if (hasRate)
+        {
+            auto digit = LocalizationSettings::GetInstance().GetDigitSymbolFromEnUsDigit(L'1');
+            auto digitSymbol = ref new String(&digit, 1);
+            auto roundedFormat = m_ratioFormatter->Format(rounded);
 
-                auto ratioString = LocalizationStringUtil::GetLocalizedString(
-                    m_ratioFormat, digitSymbol, StringReference(unit1.abbreviation.c_str()), roundedFormat, StringReference(unit2.abbreviation.c_str()));
+            auto ratioString = LocalizationStringUtil::GetLocalizedString(
+                m_ratioFormat, digitSymbol, StringReference(unit1.abbreviation.c_str()), roundedFormat, StringReference(unit2.abbreviation.c_str()));
 
-                auto accessibleRatioString =
-                    LocalizationStringUtil::GetLocalizedString(
-                    m_ratioFormat, digitSymbol, StringReference(unit1.accessibleName.c_str()), roundedFormat, StringReference(unit2.accessibleName.c_str()));
+            auto accessibleRatioString =
+                LocalizationStringUtil::GetLocalizedString(
+                m_ratioFormat, digitSymbol, StringReference(unit1.accessibleName.c_str()), roundedFormat, StringReference(unit2.accessibleName.c_str()));
 
-                return make_pair(ratioString->Data(), accessibleRatioString->Data());
-            }
+            return make_pair(ratioString->Data(), accessibleRatioString->Data());
         }
     }
     catch (...)
@@ -384,20 +466,25 @@ future<bool> CurrencyDataLoader::TryFinishLoadFromCacheAsync()
         co_return false;
     }
 
-    String ^ staticDataResponse = co_await Utils::ReadFileFromFolder(localCacheFolder, StaticDataFilename);
-    String ^ allRatiosResponse = co_await Utils::ReadFileFromFolder(localCacheFolder, AllRatiosDataFilename);
+    if (!TryOpenCurrencySnapshot())
+    {
+        // A cache written before the snapshot existed, or whose snapshot couldn't be written, only has the JSON
+        // responses, which are parsed and saved as a snapshot again
+        String ^ staticDataResponse = co_await Utils::ReadFileFromFolder(localCacheFolder, StaticDataFilename);
+        String ^ allRatiosResponse = co_await Utils::ReadFileFromFolder(localCacheFolder, AllRatiosDataFilename);
 
-    vector<UCM::CurrencyStaticData> staticData{};
-    CurrencyRatioMap ratioMap{};
+        CurrencyTable table;
+        bool didParse = TryParseWebResponses(staticDataResponse, allRatiosResponse, table);
+        if (!didParse)
+        {
+            co_return false;
+        }
 
-    bool didParse = TryParseWebResponses(staticDataResponse, allRatiosResponse, staticData, ratioMap);
-    if (!didParse)
-    {
-        co_return false;
+        TrySaveCurrencySnapshot(table);
     }
 
     m_loadStatus = CurrencyLoadStatus::LoadedFromCache;
-    co_await FinalizeUnits(staticData, ratioMap);
+    co_await FinalizeUnits();
 
     co_return true;
 }
@@ -425,10 +512,8 @@ future<bool> CurrencyDataLoader::TryLoadDataFromWebAsync()
             co_return false;
         }
 
-        vector<UCM::CurrencyStaticData> staticData{};
-        CurrencyRatioMap ratioMap{};
-
-        bool didParse = TryParseWebResponses(staticDataResponse, allRatiosResponse, staticData, ratioMap);
+        CurrencyTable table;
+        bool didParse = TryParseWebResponses(staticDataResponse, allRatiosResponse, table);
         if (!didParse)
         {
             co_return false;
@@ -437,6 +522,9 @@ future<bool> CurrencyDataLoader::TryLoadDataFromWebAsync()
         // Set the timestamp before saving it below.
         m_cacheTimestamp = Utils::GetUniversalSystemTime();
 
+        // The units are read from the snapshot, which is kept in memory whether or not its file can be written. The
+        // JSON responses are cached as well, for a start that can't read the snapshot.
+        TrySaveCurrencySnapshot(table);
         try
         {
             const vector<pair<String ^, String ^>> cachedFiles = { { StaticDataFilename, staticDataResponse }, { AllRatiosDataFilename, allRatiosResponse } };
@@ -455,7 +543,7 @@ future<bool> CurrencyDataLoader::TryLoadDataFromWebAsync()
         }
 
         m_loadStatus = CurrencyLoadStatus::LoadedFromWeb;
-        co_await FinalizeUnits(staticData, ratioMap);
+        co_await FinalizeUnits();
 
         co_return true;
     }
@@ -489,104 +577,96 @@ future<bool> CurrencyDataLoader::TryLoadDataFromWebOverrideAsync()
 };
 #pragma optimize("", on)
 
-bool CurrencyDataLoader::TryParseWebResponses(
-    _In_ String ^ staticDataJson,
-    _In_ String ^ allRatiosJson,
-    _Inout_ vector<UCM::CurrencyStaticData>& staticData,
-    _Inout_ CurrencyRatioMap& allRatiosData)
-{
-    return TryParseStaticData(staticDataJson, staticData) && TryParseAllRatiosData(allRatiosJson, allRatiosData);
-}
-
-bool CurrencyDataLoader::TryParseStaticData(_In_ String ^ rawJson, _Inout_ vector<UCM::CurrencyStaticData>& staticData)
+bool CurrencyDataLoader::TryParseWebResponses(_In_ String ^ staticDataJson, _In_ String ^ allRatiosJson, _Inout_ CurrencyTable& table)
 {
-    JsonArray ^ data = nullptr;
-    if (!JsonArray::TryParse(rawJson, &data))
+    if (staticDataJson == nullptr || allRatiosJson == nullptr
+        || !table.ParseStaticData(wstring_view(staticDataJson->Data(), staticDataJson->Length()))
+        || !table.ParseRatios(wstring_view(allRatiosJson->Data(), allRatiosJson->Length())))
     {
         return false;
     }
 
-    wstring countryCode{ L"" };
-    wstring countryName{ L"" };
-    wstring currencyCode{ L"" };
-    wstring currencyName{ L"" };
-    wstring currencySymbol{ L"" };
+    // Only the currencies that can be converted become units, in the order of their country names
+    table.RemoveIncomplete();
+    table.Sort([&table](vector<CurrencyTableEntry>& entries) {
+        auto sortCountryNames = [&table](const CurrencyTableEntry& entry) {
+            wstring_view countryName = table.GetText(entry.countryName);
+            return ref new String(countryName.data(), static_cast<unsigned int>(countryName.size()));
+        };
 
-    vector<wstring*> values = { &countryCode, &countryName, &currencyCode, &currencyName, &currencySymbol };
+        LocalizationService::GetInstance()->Sort<CurrencyTableEntry>(entries, sortCountryNames);
+    });
 
-    assert(values.size() == STATIC_DATA_PROPERTIES.size());
-    staticData.resize(size_t{ data->Size });
-    for (unsigned int i = 0; i < data->Size; i++)
+    return true;
+}
+
+// Reads the snapshot from its file in the cache folder into memory, so that the file is only open while it is read
+bool CurrencyDataLoader::TryOpenCurrencySnapshot()
+{
+    lock_guard<mutex> lock(m_currencyUnitsMutex);
+
+    m_currencySnapshot.Close();
+    m_currencySnapshotBuffer.clear();
+    try
     {
-        JsonObject ^ obj;
-        try
-        {
-            obj = data->GetAt(i)->GetObject();
-        }
-        catch (COMException ^ e)
+        filesystem::path path = filesystem::path(ApplicationData::Current->LocalCacheFolder->Path->Data()) / SNAPSHOT_FILENAME;
+        ifstream file(path, ios::binary | ios::ate);
+        if (!file)
         {
-            if (e->HResult == E_ILLEGAL_METHOD_CALL)
-            {
-                continue;
-            }
-            else
-            {
-                throw;
-            }
+            return false;
         }
 
-        for (size_t j = 0; j < values.size(); j++)
+        m_currencySnapshotBuffer.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(m_currencySnapshotBuffer.data()), static_cast<streamsize>(m_currencySnapshotBuffer.size())))
         {
-            (*values[j]) = obj->GetNamedString(StringReference(STATIC_DATA_PROPERTIES[j].data()))->Data();
+            m_currencySnapshotBuffer.clear();
+            return false;
         }
-
-        staticData[i] = CurrencyStaticData{ countryCode, countryName, currencyCode, currencyName, currencySymbol };
+    }
+    catch (...)
+    {
+        m_currencySnapshotBuffer.clear();
+        return false;
     }
 
-    auto sortCountryNames = [](const UCM::CurrencyStaticData & s) {
-        return ref new String(s.countryName.c_str());
-    };
-
-    LocalizationService::GetInstance()->Sort<UCM::CurrencyStaticData>(staticData, sortCountryNames);
-
-    return true;
+    return m_currencySnapshot.Open(m_currencySnapshotBuffer.data(), m_currencySnapshotBuffer.size());
 }
 
-bool CurrencyDataLoader::TryParseAllRatiosData(_In_ String ^ rawJson, _Inout_ CurrencyRatioMap& allRatios)
+// Opens the snapshot of the table from memory, and writes it to its file in the cache folder. Returns false if the file
+// can't be written, in which case an older snapshot is removed so that the next start reads the JSON responses instead.
+bool CurrencyDataLoader::TrySaveCurrencySnapshot(_In_ const CurrencyTable& table)
 {
-    JsonArray ^ data = nullptr;
-    if (!JsonArray::TryParse(rawJson, &data))
-    {
-        return false;
-    }
+    lock_guard<mutex> lock(m_currencyUnitsMutex);
 
-    wstring sourceCurrencyCode{ DefaultCurrencyCode };
+    m_currencySnapshot.Close();
+    m_currencySnapshotBuffer.resize(table.SaveSnapshot(nullptr, 0));
+    table.SaveSnapshot(m_currencySnapshotBuffer.data(), m_currencySnapshotBuffer.size());
+    m_currencySnapshot.Open(m_currencySnapshotBuffer.data(), m_currencySnapshotBuffer.size());
 
-    allRatios.clear();
-    for (unsigned int i = 0; i < data->Size; i++)
+    try
     {
-        JsonObject ^ obj;
-        try
+        filesystem::path folder = filesystem::path(ApplicationData::Current->LocalCacheFolder->Path->Data());
+        filesystem::path temporaryPath = folder / SNAPSHOT_TEMPORARY_FILENAME;
+        ofstream file(temporaryPath, ios::binary | ios::trunc);
+        file.write(reinterpret_cast<const char*>(m_currencySnapshotBuffer.data()), static_cast<streamsize>(m_currencySnapshotBuffer.size()));
+        file.close();
+
+        error_code error;
+        if (file)
         {
-            obj = data->GetAt(i)->GetObject();
+            filesystem::rename(temporaryPath, folder / SNAPSHOT_FILENAME, error);
         }
-        catch (COMException^ e)
+        if (!file || error)
         {
-            if (e->HResult == E_ILLEGAL_METHOD_CALL)
-            {
-                continue;
-            }
-            else
-            {
-                throw;
-            }
+            filesystem::remove(temporaryPath, error);
+            filesystem::remove(folder / SNAPSHOT_FILENAME, error);
+            return false;
         }
-
-        // Rt is ratio, An is target currency ISO code.
-        double relativeRatio = obj->GetNamedNumber(StringReference(RATIO_KEY));
-        wstring targetCurrencyCode = obj->GetNamedString(StringReference(CURRENCY_CODE_KEY))->Data();
-
-        allRatios.emplace(targetCurrencyCode, CurrencyRatio{ relativeRatio, sourceCurrencyCode, targetCurrencyCode });
+    }
+    catch (...)
+    {
+        return false;
     }
 
     return true;
@@ -595,13 +675,11 @@ bool CurrencyDataLoader::TryParseAllRatiosData(_In_ String ^ rawJson, _Inout_ Cu
 // FinalizeUnits
 //
 // There are a few ways we can get the data needed for Currency Converter, including from cache or from web.
-// This function accepts the data from any source, and acts as a 'last-steps' for the converter to be ready.
-// This includes identifying which units will be selected and building the map of currency ratios.
+// This function builds the units from the currency snapshot, whichever source it was made from, and acts as a
+// 'last-steps' for the converter to be ready. This includes identifying which units will be selected.
 #pragma optimize("", off) // Turn off optimizations to work around DevDiv 393321
-task<void> CurrencyDataLoader::FinalizeUnits(_In_ const vector<UCM::CurrencyStaticData>& staticData, _In_ const CurrencyRatioMap& ratioMap)
+task<void> CurrencyDataLoader::FinalizeUnits()
 {
-    unordered_map<int, pair<UCM::Unit, double>> idToUnit{};
-
     SelectedUnits defaultCurrencies = co_await GetDefaultFromToCurrency();
     wstring fromCurrency = defaultCurrencies.first;
     wstring toCurrency = defaultCurrencies.second;
@@ -609,17 +687,17 @@ task<void> CurrencyDataLoader::FinalizeUnits(_In_ const vector<UCM::CurrencyStat
     {
         lock_guard<mutex> lock(m_currencyUnitsMutex);
 
-        int i = 1;
+        vector<UCM::Unit> previousUnits = move(m_currencyUnits);
         m_currencyUnits.clear();
         m_currencyMetadata.clear();
         bool isConversionSourceSet = false;
         bool isConversionTargetSet = false;
-        for (const UCM::CurrencyStaticData& currencyUnit : staticData)
+        for (size_t position = 0; position < m_currencySnapshot.GetCount(); position++)
         {
-            auto itr = ratioMap.find(currencyUnit.currencyCode);
-            if (itr != ratioMap.end() && (itr->second).ratio > 0)
+            UCM::CurrencyStaticData currencyUnit = m_currencySnapshot.GetStaticData(position);
+            if (m_currencySnapshot.GetRatio(position) > 0)
             {
-                int id = static_cast<int>(UnitConverterUnits::UnitEnd + i);
+                int id = static_cast<int>(UnitConverterUnits::UnitEnd + 1 + position);
 
                 bool isConversionSource = (fromCurrency == currencyUnit.currencyCode);
                 isConversionSourceSet = isConversionSourceSet || isConversionSource;
@@ -639,8 +717,6 @@ task<void> CurrencyDataLoader::FinalizeUnits(_In_ const vector<UCM::CurrencyStat
 
                 m_currencyUnits.push_back(unit);
                 m_currencyMetadata.emplace(unit, CurrencyUnitMetadata{ currencyUnit.currencySymbol });
-                idToUnit.insert(pair<int, pair<UCM::Unit, double>>(unit.id, pair<UCM::Unit, double>(unit, (itr->second).ratio)));
-                i++;
             }
         }
 
@@ -650,22 +726,29 @@ task<void> CurrencyDataLoader::FinalizeUnits(_In_ const vector<UCM::CurrencyStat
             defaultCurrencies = { DEFAULT_FROM_CURRENCY, DEFAULT_TO_CURRENCY };
         }
 
-        m_currencyRatioMap.clear();
-        for (const auto& unit : m_currencyUnits)
+        vector<double> ratios(m_currencySnapshot.GetCount());
+        for (size_t position = 0; position < ratios.size(); position++)
         {
-            unordered_map<UCM::Unit, UCM::ConversionData, UCM::UnitHash> conversions;
-            double unitFactor = idToUnit[unit.id].second;
-            for (auto itr = idToUnit.begin(); itr != idToUnit.end(); itr++)
-            {
-                UCM::Unit targetUnit = (itr->second).first;
-                double conversionRatio = (itr->second).second;
-                UCM::ConversionData parsedData = { 1.0, 0.0, false };
-                assert(unitFactor > 0); // divide by zero assert
-                parsedData.ratio = conversionRatio / unitFactor;
-                conversions.insert(make_pair(targetUnit, parsedData));
-            }
+            ratios[position] = m_currencySnapshot.GetRatio(position);
+        }
 
-            m_currencyRatioMap.insert(make_pair(unit, conversions));
+        // The converter's table is updated in place on a refresh that has the same currencies, at the same positions
+        auto isSameCurrency = [](const UCM::Unit& unit, const UCM::Unit& previousUnit) {
+            return unit.id == previousUnit.id && unit.abbreviation == previousUnit.abbreviation;
+        };
+        m_isConversionTableCurrent =
+            m_isConversionTableCurrent && equal(m_currencyUnits.begin(), m_currencyUnits.end(), previousUnits.begin(), previousUnits.end(), isSameCurrency);
+        if (m_isConversionTableCurrent)
+        {
+            m_isConversionTableCurrent = m_currencyRates.Update(ratios, m_changedCurrencyPositions);
+        }
+        else
+        {
+            m_currencyRates.Build(ratios);
+        }
+        if (!m_isConversionTableCurrent)
+        {
+            m_changedCurrencyPositions.clear();
         }
     } // unlocked m_currencyUnitsMutex
 
@@ -712,6 +795,12 @@ void CurrencyDataLoader::GuaranteeSelectedUnits()
     }
 }
 
+// The position of the currency in the snapshot and the rate matrix, or a position past their end if it isn't one
+size_t CurrencyDataLoader::GetCurrencyPosition(const UCM::Unit& unit) const
+{
+    return unit.id > UnitConverterUnits::UnitEnd ? static_cast<size_t>(unit.id - UnitConverterUnits::UnitEnd - 1) : m_currencyRates.GetCount();
+}
+
 void CurrencyDataLoader::NotifyDataLoadFinished(bool didLoad)
 {
     if (!didLoad)
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "CalcManager/CurrencyRateMatrix.h"
+#include "CalcManager/CurrencyTable.h"
 #include "CalcManager/UnitConverter.h"
 #include "Common/NetworkManager.h"
 #include "ICurrencyHttpClient.h"
@@ -33,12 +35,12 @@ namespace CalculatorApp
             extern Platform::StringReference CacheDelimiter;
             extern Platform::StringReference StaticDataFilename;
             extern Platform::StringReference AllRatiosDataFilename;
+            extern Platform::StringReference SnapshotFilename;
             extern long long DayDuration;
         }
 
         namespace UCM = UnitConversionManager;
 
-        typedef std::unordered_map<std::wstring, UCM::CurrencyRatio> CurrencyRatioMap;
         typedef std::pair<std::wstring, std::wstring> SelectedUnits;
 
         struct CurrencyUnitMetadata
@@ -67,6 +69,8 @@ namespace CalculatorApp
             std::vector<UCM::Unit> LoadOrderedUnits(const UCM::Category& category) override;
             std::unordered_map<UCM::Unit, UCM::ConversionData, UCM::UnitHash> LoadOrderedRatios(const UCM::Unit& unit) override;
             bool SupportsCategory(const UnitConversionManager::Category& target) override;
+            bool LoadConversionTable(_Inout_ UCM::CategoryConversionTable& table) override;
+            bool UpdateConversionTable(_Inout_ UCM::CategoryConversionTable& table, _Inout_ std::vector<size_t>& changedUnits) override;
             // IConverterDataLoader
 
             // ICurrencyConverterDataLoader
@@ -90,15 +94,12 @@ namespace CalculatorApp
 
             std::future<bool> TryFinishLoadFromCacheAsync();
 
-            bool TryParseWebResponses(
-                _In_ Platform::String ^ staticDataJson,
-                _In_ Platform::String ^ allRatiosJson,
-                _Inout_ std::vector<UCM::CurrencyStaticData>& staticData,
-                _Inout_ CurrencyRatioMap& allRatiosData);
-            bool TryParseStaticData(_In_ Platform::String ^ rawJson, _Inout_ std::vector<UCM::CurrencyStaticData>& staticData);
-            bool TryParseAllRatiosData(_In_ Platform::String ^ rawJson, _Inout_ CurrencyRatioMap& allRatiosData);
-            concurrency::task<void> FinalizeUnits(_In_ const std::vector<UCM::CurrencyStaticData>& staticData, _In_ const CurrencyRatioMap& ratioMap);
+            bool TryParseWebResponses(_In_ Platform::String ^ staticDataJson, _In_ Platform::String ^ allRatiosJson, _Inout_ UCM::CurrencyTable& table);
+            bool TryOpenCurrencySnapshot();
+            bool TrySaveCurrencySnapshot(_In_ const UCM::CurrencyTable& table);
+            concurrency::task<void> FinalizeUnits();
             void GuaranteeSelectedUnits();
+            size_t GetCurrencyPosition(const UCM::Unit& unit) const;
 
             void SaveLangCodeAndTimestamp();
             void UpdateDisplayedTimestamp();
@@ -118,7 +119,11 @@ namespace CalculatorApp
 
             std::mutex m_currencyUnitsMutex;
             std::vector<UCM::Unit> m_currencyUnits;
-            UCM::UnitToUnitToConversionDataMap m_currencyRatioMap;
+            std::vector<uint8_t> m_currencySnapshotBuffer; // Holds the snapshot, which is read from or written to its file
+            UCM::CurrencyTableSnapshot m_currencySnapshot; // The units are at the positions of their id - UnitEnd - 1
+            UCM::CurrencyRateMatrix m_currencyRates;       // Between the currencies of the snapshot, at the same positions
+            std::vector<size_t> m_changedCurrencyPositions; // Whose ratios changed since the converter's table was filled
+            bool m_isConversionTableCurrent;                // Whether the converter's table has the current units
             std::unordered_map<UCM::Unit, CurrencyUnitMetadata, UCM::UnitHash> m_currencyMetadata;
 
             std::shared_ptr<UCM::IViewModelCurrencyCallback> m_vmCallback;
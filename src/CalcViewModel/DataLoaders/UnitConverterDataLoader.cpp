@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "pch.h"
+#include <charconv>
 #include "Common/AppResourceProvider.h"
 #include "UnitConverterDataLoader.h"
 #include "UnitConverterDataConstants.h"
@@ -18,6 +19,20 @@ using namespace Windows::Globalization;
 
 static constexpr bool CONVERT_WITH_OFFSET_FIRST = true;
 
+// The exact factor of a unit, which is the decimal its factor is written as, unless it is given as a fraction
+static wstring GetExactFactor(const UnitData& unitData)
+{
+    if (unitData.exactFactor != nullptr)
+    {
+        return unitData.exactFactor;
+    }
+
+    // The shortest decimal that reads back as the factor is the literal in the table
+    char buffer[32];
+    auto result = to_chars(begin(buffer), end(buffer), unitData.factor);
+    return wstring(begin(buffer), result.ptr);
+}
+
 UnitConverterDataLoader::UnitConverterDataLoader(GeographicRegion ^ region)
     : m_currentRegionCode(region->CodeTwoLetter)
 {
@@ -41,6 +56,17 @@ unordered_map<UCM::Unit, UCM::ConversionData, UCM::UnitHash> UnitConverterDataLo
     return m_ratioMap->at(unit);
 }
 
+unordered_map<int, UCM::ExactConversionFactor> UnitConverterDataLoader::LoadExactConversionFactors(const UCM::Category& category)
+{
+    auto exactFactors = m_exactFactorMap.find(category.id);
+    if (exactFactors == m_exactFactorMap.end())
+    {
+        return {};
+    }
+
+    return exactFactors->second;
+}
+
 bool UnitConverterDataLoader::SupportsCategory(const UCM::Category& target)
 {
     shared_ptr<vector<UCM::Category>> supportedCategories = nullptr;
@@ -68,15 +94,18 @@ void UnitConverterDataLoader::LoadData()
     unordered_map<ViewMode, vector<OrderedUnit>> orderedUnitMap{};
     unordered_map<ViewMode, unordered_map<int, double>> categoryToUnitConversionDataMap{};
     unordered_map<int, unordered_map<int, UCM::ConversionData>> explicitConversionData{};
+    unordered_map<int, UCM::ExactConversionFactor> exactFactorMap{};
 
     // Load categories, units and conversion data into data structures. This will be then used to populate hashmaps used by CalcEngine and UI layer
     GetCategories(m_categoryList);
     GetUnits(orderedUnitMap);
-    GetConversionData(categoryToUnitConversionDataMap);
+    GetConversionData(categoryToUnitConversionDataMap, exactFactorMap);
     GetExplicitConversionData(explicitConversionData); // This is needed for temperature conversions
+    GetExplicitExactConversionFactors(exactFactorMap);
 
     m_categoryToUnits->clear();
     m_ratioMap->clear();
+    m_exactFactorMap.clear();
     for (UCM::Category objectCategory : *m_categoryList)
     {
         ViewMode categoryViewMode = NavCategory::Deserialize(objectCategory.id);
@@ -105,6 +134,17 @@ void UnitConverterDataLoader::LoadData()
         // Save units per category
         m_categoryToUnits->insert(pair<UCM::Category, std::vector<UCM::Unit>>(objectCategory, unitList));
 
+        // Save the exact factors of the units that have one, which the converter uses in exact mode
+        unordered_map<int, UCM::ExactConversionFactor>& exactFactors = m_exactFactorMap[objectCategory.id];
+        for (const UCM::Unit& unit : unitList)
+        {
+            auto exactFactor = exactFactorMap.find(unit.id);
+            if (exactFactor != exactFactorMap.end())
+            {
+                exactFactors.insert(*exactFactor);
+            }
+        }
+
         // For each unit, populate the conversion data
         for (UCM::Unit unit : unitList)
         {
@@ -769,7 +809,9 @@ void UnitConverterDataLoader::GetUnits(_In_ unordered_map<ViewMode, vector<Order
     unitMap.emplace(ViewMode::Angle, angleUnits);
 }
 
-void UnitConverterDataLoader::GetConversionData(_In_ unordered_map<ViewMode, unordered_map<int, double>>& categoryToUnitConversionMap)
+void UnitConverterDataLoader::GetConversionData(
+    _In_ unordered_map<ViewMode, unordered_map<int, double>>& categoryToUnitConversionMap,
+    _In_ unordered_map<int, UCM::ExactConversionFactor>& unitToExactFactorMap)
 {
     /*categoryId, UnitId, factor*/
     static const vector<UnitData> unitDataList = { { ViewMode::Area, UnitConverterUnits::Area_Acre, 4046.8564224 },
@@ -786,7 +828,7 @@ void UnitConverterDataLoader::GetConversionData(_In_ unordered_map<ViewMode, uno
                                                    { ViewMode::Area, UnitConverterUnits::Area_Paper, 0.06032246 },
                                                    { ViewMode::Area, UnitConverterUnits::Area_SoccerField, 10869.66 },
                                                    { ViewMode::Area, UnitConverterUnits::Area_Castle, 100000 },
-                                                   { ViewMode::Area, UnitConverterUnits::Area_Pyeong, 400.0 / 121.0 },
+                                                   { ViewMode::Area, UnitConverterUnits::Area_Pyeong, 400.0 / 121.0, L"400/121" },
 
                                                    { ViewMode::Data, UnitConverterUnits::Data_Bit, 0.000000125 },
                                                    { ViewMode::Data, UnitConverterUnits::Data_Byte, 0.000001 },
@@ -948,6 +990,8 @@ void UnitConverterDataLoader::GetConversionData(_In_ unordered_map<ViewMode, uno
         {
             categoryToUnitConversionMap.at(unitdata.categoryId).insert(pair<int, double>(unitdata.unitId, unitdata.factor));
         }
+
+        unitToExactFactorMap[unitdata.unitId] = UCM::ExactConversionFactor{ GetExactFactor(unitdata), L"" };
     }
 }
 
@@ -1001,3 +1045,11 @@ void UnitConverterDataLoader::GetExplicitConversionData(_In_ unordered_map<int,
         }
     }
 }
+
+void UnitConverterDataLoader::GetExplicitExactConversionFactors(_In_ unordered_map<int, UCM::ExactConversionFactor>& unitToExactFactorMap)
+{
+    // The temperatures relative to degrees Celsius: base = value * ratio + offset
+    unitToExactFactorMap[UnitConverterUnits::Temperature_DegreesCelsius] = UCM::ExactConversionFactor{ L"1", L"" };
+    unitToExactFactorMap[UnitConverterUnits::Temperature_DegreesFahrenheit] = UCM::ExactConversionFactor{ L"5/9", L"-160/9" };
+    unitToExactFactorMap[UnitConverterUnits::Temperature_Kelvin] = UCM::ExactConversionFactor{ L"1", L"-273.15" };
+}
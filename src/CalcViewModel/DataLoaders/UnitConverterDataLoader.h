@@ -37,6 +37,10 @@ namespace CalculatorApp
             CalculatorApp::Common::ViewMode categoryId;
             int unitId;
             double factor;
+
+            // The factor as a fraction, for a factor that isn't a decimal, such as 400/121. Otherwise the exact factor is
+            // the decimal that factor is written as.
+            const wchar_t* exactFactor = nullptr;
         };
 
         struct ExplicitUnitConversionData : UnitConversionManager::ConversionData
@@ -76,19 +80,25 @@ namespace CalculatorApp
             std::unordered_map<UnitConversionManager::Unit, UnitConversionManager::ConversionData, UnitConversionManager::UnitHash>
             LoadOrderedRatios(const UnitConversionManager::Unit& unit) override;
             bool SupportsCategory(const UnitConversionManager::Category& target) override;
+            std::unordered_map<int, UnitConversionManager::ExactConversionFactor>
+            LoadExactConversionFactors(const UnitConversionManager::Category& category) override;
             // IConverterDataLoader
 
             void GetCategories(_In_ std::shared_ptr<std::vector<UnitConversionManager::Category>> categoriesList);
             void GetUnits(_In_ std::unordered_map<CalculatorApp::Common::ViewMode, std::vector<CalculatorApp::ViewModel::OrderedUnit>>& unitMap);
-            void GetConversionData(_In_ std::unordered_map<CalculatorApp::Common::ViewMode, std::unordered_map<int, double>>& categoryToUnitConversionMap);
+            void GetConversionData(
+                _In_ std::unordered_map<CalculatorApp::Common::ViewMode, std::unordered_map<int, double>>& categoryToUnitConversionMap,
+                _In_ std::unordered_map<int, UnitConversionManager::ExactConversionFactor>& unitToExactFactorMap);
             void
             GetExplicitConversionData(_In_ std::unordered_map<int, std::unordered_map<int, UnitConversionManager::ConversionData>>& unitToUnitConversionList);
+            void GetExplicitExactConversionFactors(_In_ std::unordered_map<int, UnitConversionManager::ExactConversionFactor>& unitToExactFactorMap);
 
             std::wstring GetLocalizedStringName(_In_ Platform::String ^ stringId);
 
             std::shared_ptr<std::vector<UnitConversionManager::Category>> m_categoryList;
             std::shared_ptr<UnitConversionManager::CategoryToUnitVectorMap> m_categoryToUnits;
             std::shared_ptr<UnitConversionManager::UnitToUnitToConversionDataMap> m_ratioMap;
+            std::unordered_map<int, std::unordered_map<int, UnitConversionManager::ExactConversionFactor>> m_exactFactorMap; // By category id
             Platform::String ^ m_currentRegionCode;
         };
     }
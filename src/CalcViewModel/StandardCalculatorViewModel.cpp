@@ -447,6 +447,58 @@ void StandardCalculatorViewModel::SetMemorizedNumbers(const vector<wstring>& new
     }
 }
 
+void StandardCalculatorViewModel::InsertMemorizedNumber(unsigned int indexOfMemory, const wstring& memorizedNumber)
+{
+    auto stringValue = memorizedNumber;
+    LocalizationSettings::GetInstance().LocalizeDisplayValue(&stringValue);
+
+    MemoryItemViewModel ^ memorySlot = ref new MemoryItemViewModel(this);
+    memorySlot->Position = indexOfMemory;
+    memorySlot->Value = Utils::LRO + ref new String(stringValue.c_str()) + Utils::PDF;
+
+    MemorizedNumbers->InsertAt(indexOfMemory, memorySlot);
+    IsMemoryEmpty = IsAlwaysOnTop;
+
+    // Update the slot position for the rest of the slots
+    for (unsigned int i = indexOfMemory + 1; i < MemorizedNumbers->Size; i++)
+    {
+        MemorizedNumbers->GetAt(i)->Position++;
+    }
+}
+
+void StandardCalculatorViewModel::UpdateMemorizedNumber(unsigned int indexOfMemory, const wstring& memorizedNumber)
+{
+    if (indexOfMemory >= MemorizedNumbers->Size)
+    {
+        return;
+    }
+
+    auto stringValue = memorizedNumber;
+    LocalizationSettings::GetInstance().LocalizeDisplayValue(&stringValue);
+    MemorizedNumbers->GetAt(indexOfMemory)->Value = Utils::LRO + ref new String(stringValue.c_str()) + Utils::PDF;
+}
+
+void StandardCalculatorViewModel::RemoveMemorizedNumber(unsigned int indexOfMemory)
+{
+    if (indexOfMemory >= MemorizedNumbers->Size)
+    {
+        return;
+    }
+
+    MemorizedNumbers->RemoveAt(indexOfMemory);
+
+    // Update the slot position for the rest of the slots
+    for (unsigned int i = indexOfMemory; i < MemorizedNumbers->Size; i++)
+    {
+        MemorizedNumbers->GetAt(i)->Position--;
+    }
+
+    if (MemorizedNumbers->Size == 0)
+    {
+        IsMemoryEmpty = true;
+    }
+}
+
 void StandardCalculatorViewModel::FtoEButtonToggled()
 {
     OnButtonPressed(NumbersAndOperatorsEnum::FToE);
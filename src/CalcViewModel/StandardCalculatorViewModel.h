@@ -300,6 +300,9 @@ namespace CalculatorApp
             void SelectHistoryItem(HistoryItemViewModel ^ item);
         private:
             void SetMemorizedNumbers(const std::vector<std::wstring>& memorizedNumbers);
+            void InsertMemorizedNumber(unsigned int indexOfMemory, const std::wstring& memorizedNumber);
+            void UpdateMemorizedNumber(unsigned int indexOfMemory, const std::wstring& memorizedNumber);
+            void RemoveMemorizedNumber(unsigned int indexOfMemory);
             void UpdateProgrammerPanelDisplay();
             void HandleUpdatedOperandData(CalculationManager::Command cmdenum);
             void SetPrimaryDisplay(_In_ Platform::String ^ displayStringValue, _In_ bool isError);
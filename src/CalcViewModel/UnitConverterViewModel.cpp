@@ -73,6 +73,11 @@ namespace
     StringReference CurrencySymbol2PropertyName(L"CurrencySymbol2");
     StringReference CurrencySymbolVisibilityPropertyName(L"CurrencySymbolVisibility");
     StringReference SupplementaryVisibilityPropertyName(L"SupplementaryVisibility");
+
+    // The user preferences are saved in the binary form of the converter, which is faster to restore. The string form,
+    // that earlier versions saved, is still restored when there are no binary preferences.
+    StringReference UserPreferencesKey(L"UnitConverterPreferences");
+    StringReference BinaryUserPreferencesKey(L"UnitConverterBinaryPreferences");
 }
 
 namespace CalculatorApp::ViewModel::UnitConverterResourceKeys
@@ -616,8 +621,14 @@ void UnitConverterViewModel::SaveUserPreferences()
         ApplicationDataContainer ^ localSettings = ApplicationData::Current->LocalSettings;
         if (!m_IsCurrencyCurrentCategory)
         {
-            auto userPreferences = m_model->SaveUserPreferences();
-            localSettings->Values->Insert(ref new String(L"UnitConverterPreferences"), ref new String(userPreferences.c_str()));
+            vector<uint8_t> userPreferences(m_model->SaveUserPreferences(nullptr, 0));
+            m_model->SaveUserPreferences(userPreferences.data(), userPreferences.size());
+            localSettings->Values->Insert(
+                BinaryUserPreferencesKey,
+                PropertyValue::CreateUInt8Array(ArrayReference<uint8_t>(userPreferences.data(), static_cast<unsigned int>(userPreferences.size()))));
+
+            // The string form would only be out of date
+            localSettings->Values->Remove(UserPreferencesKey);
         }
         else
         {
@@ -635,9 +646,23 @@ void UnitConverterViewModel::RestoreUserPreferences()
     if (!IsCurrencyCurrentCategory)
     {
         ApplicationDataContainer ^ localSettings = ApplicationData::Current->LocalSettings;
-        if (localSettings->Values->HasKey(ref new String(L"UnitConverterPreferences")))
+        if (localSettings->Values->HasKey(BinaryUserPreferencesKey))
+        {
+            auto binaryUserPreferences = dynamic_cast<IPropertyValue ^>(localSettings->Values->Lookup(BinaryUserPreferencesKey));
+            if (binaryUserPreferences != nullptr && binaryUserPreferences->Type == PropertyType::UInt8Array)
+            {
+                Array<uint8_t> ^ userPreferences;
+                binaryUserPreferences->GetUInt8Array(&userPreferences);
+                if (m_model->RestoreUserPreferences(userPreferences->Data, userPreferences->Length))
+                {
+                    return;
+                }
+            }
+        }
+
+        if (localSettings->Values->HasKey(UserPreferencesKey))
         {
-            String ^ userPreferences = safe_cast<String ^>(localSettings->Values->Lookup(ref new String(L"UnitConverterPreferences")));
+            String ^ userPreferences = safe_cast<String ^>(localSettings->Values->Lookup(UserPreferencesKey));
             m_model->RestoreUserPreferences(userPreferences->Data());
         }
     }
@@ -647,9 +672,14 @@ void UnitConverterViewModel::OnCurrencyDataLoadFinished(bool didLoad)
 {
     m_isCurrencyDataLoaded = true;
     CurrencyDataLoadFailed = !didLoad;
-    m_model->ResetCategoriesAndRatios();
-    m_model->Calculate();
-    ResetCategory();
+
+    // A refresh that only changed ratios is applied in place, which keeps the units and the other categories as they are
+    if (!didLoad || !m_model->UpdateCurrencyRatios())
+    {
+        m_model->ResetCategoriesAndRatios();
+        m_model->Calculate();
+        ResetCategory();
+    }
 
     StringReference key = didLoad ? UnitConverterResourceKeys::CurrencyRatesUpdated : UnitConverterResourceKeys::CurrencyRatesUpdateFailed;
     String ^ announcement = AppResourceProvider::GetInstance()->GetResourceString(key);
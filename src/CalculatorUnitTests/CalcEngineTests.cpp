@@ -155,6 +155,60 @@ namespace CalculatorEngineTests
             }
         }
 
+        TEST_METHOD(TestIsNumberInvalidMatchesRegex)
+        {
+            // IsNumberInvalid used to validate decimal numbers with the regex below. Compare the scanner that replaced it
+            // against the regex on random strings built from the characters that matter to the grammar.
+            auto regexIsNumberInvalid = [](wstring const& numberString, int iMaxExp, int iMaxMantissa, wchar_t decimalSeparator) {
+                wregex rx(wstring{ L"[+-]?(\\d*)[" } + decimalSeparator + wstring{ L"]?(\\d*)(?:e[+-]?(\\d*))?$" });
+                wsmatch matches;
+                if (!regex_match(numberString, matches, rx))
+                {
+                    return IDS_ERR_UNK_CH;
+                }
+
+                if (matches.length(3) > iMaxExp)
+                {
+                    return IDS_ERR_INPUT_OVERFLOW;
+                }
+
+                wstring integer = matches.str(1);
+                auto intItr = find_if(integer.begin(), integer.end(), [](wchar_t c) { return c != L'0'; });
+                if (distance(intItr, integer.end()) + matches.length(2) > iMaxMantissa)
+                {
+                    return IDS_ERR_INPUT_OVERFLOW;
+                }
+
+                return 0;
+            };
+
+            constexpr wstring_view alphabet = L"0123456789+-e.,E x";
+            mt19937 generator(20190301);
+            uniform_int_distribution<size_t> lengthDistribution(0, 12);
+            uniform_int_distribution<size_t> charDistribution(0, alphabet.size() - 1);
+            uniform_int_distribution<int> limitDistribution(0, 8);
+
+            for (wchar_t decimalSeparator : { L'.', L',' })
+            {
+                m_calcEngine->m_decimalSeparator = decimalSeparator;
+                for (int i = 0; i < 20000; i++)
+                {
+                    wstring str(lengthDistribution(generator), L'0');
+                    for (wchar_t& c : str)
+                    {
+                        c = alphabet[charDistribution(generator)];
+                    }
+
+                    int maxExp = limitDistribution(generator);
+                    int maxMantissa = limitDistribution(generator);
+                    VERIFY_ARE_EQUAL(
+                        regexIsNumberInvalid(str, maxExp, maxMantissa, decimalSeparator),
+                        m_calcEngine->IsNumberInvalid(str, maxExp, maxMantissa, 10 /* Dec */),
+                        str.c_str());
+                }
+            }
+        }
+
         TEST_METHOD(TestDigitGroupingStringToGroupingVector)
         {
             vector<uint32_t> groupingVector{};
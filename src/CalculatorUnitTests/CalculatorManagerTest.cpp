@@ -57,6 +57,18 @@ namespace CalculatorManagerTest
         {
             m_memorizedNumberStrings = numbers;
         }
+        void InsertMemorizedNumber(unsigned int indexOfMemory, const wstring& number) override
+        {
+            m_memorizedNumberStrings.insert(m_memorizedNumberStrings.begin() + indexOfMemory, number);
+        }
+        void UpdateMemorizedNumber(unsigned int indexOfMemory, const wstring& number) override
+        {
+            m_memorizedNumberStrings.at(indexOfMemory) = number;
+        }
+        void RemoveMemorizedNumber(unsigned int indexOfMemory) override
+        {
+            m_memorizedNumberStrings.erase(m_memorizedNumberStrings.begin() + indexOfMemory);
+        }
 
         void SetParenthesisNumber(unsigned int parenthesisCount) override
         {
@@ -186,6 +198,8 @@ namespace CalculatorManagerTest
 
         TEST_METHOD(CalculatorManagerTestMemory);
 
+        TEST_METHOD(CalculatorManagerTestSnapshot);
+
         TEST_METHOD(CalculatorManagerTestMaxDigitsReached);
         TEST_METHOD(CalculatorManagerTestMaxDigitsReached_LeadingDecimal);
         TEST_METHOD(CalculatorManagerTestMaxDigitsReached_TrailingDecimal);
@@ -195,6 +209,9 @@ namespace CalculatorManagerTest
         TEST_METHOD(CalculatorManagerNumberFormattingUtils_GetNumberDigitsWholeNumberPart);
         TEST_METHOD(CalculatorManagerNumberFormattingUtils_RoundSignificantDigits);
         TEST_METHOD(CalculatorManagerNumberFormattingUtils_ToScientificNumber);
+        TEST_METHOD(CalculatorManagerNumberFormattingUtils_GetLengthWithoutTrailingZeros);
+        TEST_METHOD(CalculatorManagerNumberFormattingUtils_RoundSignificantDigitsToBuffer);
+        TEST_METHOD(CalculatorManagerNumberFormattingUtils_ToScientificNumberToBuffer);
         // TODO re-enable when cause of failure is determined. Bug 20226670
         // TEST_METHOD(CalculatorManagerTestBinaryOperatorReceived);
         // TEST_METHOD(CalculatorManagerTestBinaryOperatorReceived_Multiple);
@@ -896,6 +913,45 @@ namespace CalculatorManagerTest
         m_calculatorManager->MemorizeNumber();
     }
 
+    void CalculatorManagerTest::CalculatorManagerTestSnapshot()
+    {
+        // 1 + 2 = in history, 3 in memory, and 2 * (3 + entered
+        Cleanup();
+        m_calculatorManager->SetScientificMode();
+        ExecuteCommands({ Command::Command1, Command::CommandADD, Command::Command2, Command::CommandEQU });
+        m_calculatorManager->MemorizeNumber();
+        ExecuteCommands({ Command::Command2, Command::CommandMUL, Command::CommandOPENP, Command::Command3, Command::CommandADD });
+
+        size_t snapshotSize = m_calculatorManager->SaveSnapshot(nullptr, 0);
+        vector<uint8_t> snapshot(snapshotSize);
+        VERIFY_ARE_EQUAL(snapshotSize, m_calculatorManager->SaveSnapshot(snapshot.data(), snapshot.size()));
+
+        // A truncated snapshot is rejected
+        auto restoredDisplay = std::make_shared<CalculatorManagerDisplayTester>();
+        CalculatorManager restoredManager(restoredDisplay.get(), m_resourceProvider.get());
+        VERIFY_IS_FALSE(restoredManager.RestoreSnapshot(snapshot.data(), snapshot.size() - 1));
+
+        VERIFY_IS_TRUE(restoredManager.RestoreSnapshot(snapshot.data(), snapshot.size()));
+
+        // Saving the restored calculator gives the same snapshot
+        vector<uint8_t> resavedSnapshot(snapshotSize);
+        VERIFY_ARE_EQUAL(snapshotSize, restoredManager.SaveSnapshot(resavedSnapshot.data(), resavedSnapshot.size()));
+        VERIFY_IS_TRUE(snapshot == resavedSnapshot);
+
+        // Both calculators continue the same way
+        ExecuteCommands({ Command::Command4, Command::CommandCLOSEP, Command::CommandEQU });
+        for (Command command : { Command::Command4, Command::CommandCLOSEP, Command::CommandEQU })
+        {
+            restoredManager.SendCommand(command);
+        }
+        VERIFY_ARE_EQUAL(wstring(L"14"), m_calculatorDisplayTester->GetPrimaryDisplay());
+        VERIFY_ARE_EQUAL(wstring(L"14"), restoredDisplay->GetPrimaryDisplay());
+        VERIFY_ARE_EQUAL(m_calculatorManager->GetHistoryItems().size(), restoredManager.GetHistoryItems().size());
+
+        restoredManager.MemorizedNumberLoad(0);
+        VERIFY_ARE_EQUAL(wstring(L"3"), restoredDisplay->GetPrimaryDisplay());
+    }
+
     // Send 12345678910111213 and verify MaxDigitsReached
     void CalculatorManagerTest::CalculatorManagerTestMaxDigitsReached()
     {
@@ -1008,6 +1064,47 @@ namespace CalculatorManagerTest
         VERIFY_ARE_EQUAL(result, L"-3.432432e-09");
     }
 
+    void CalculatorManagerTest::CalculatorManagerNumberFormattingUtils_GetLengthWithoutTrailingZeros()
+    {
+        VERIFY_ARE_EQUAL(GetLengthWithoutTrailingZeros(L"2.1032100000000"), (size_t)7);
+        VERIFY_ARE_EQUAL(GetLengthWithoutTrailingZeros(L"-122.123200"), (size_t)9);
+        VERIFY_ARE_EQUAL(GetLengthWithoutTrailingZeros(L"12.000"), (size_t)2);
+        VERIFY_ARE_EQUAL(GetLengthWithoutTrailingZeros(L"0.000"), (size_t)1);
+        VERIFY_ARE_EQUAL(GetLengthWithoutTrailingZeros(L"322400"), (size_t)6);
+    }
+
+    void CalculatorManagerTest::CalculatorManagerNumberFormattingUtils_RoundSignificantDigitsToBuffer()
+    {
+        wchar_t buffer[16];
+        size_t length = RoundSignificantDigits(12.342343242, 3, buffer, 16);
+        VERIFY_ARE_EQUAL(wstring(buffer, length), L"12.342");
+        length = RoundSignificantDigits(12.342500001, 3, buffer, 16);
+        VERIFY_ARE_EQUAL(wstring(buffer, length), L"12.343");
+        length = RoundSignificantDigits(-2312.1244243346454345, 5, buffer, 16);
+        VERIFY_ARE_EQUAL(wstring(buffer, length), L"-2312.12442");
+        length = RoundSignificantDigits(0.3423, 7, buffer, 16);
+        VERIFY_ARE_EQUAL(wstring(buffer, length), L"0.3423000");
+
+        // The length is returned even when the number doesn't fit, and nothing is written
+        buffer[0] = L'x';
+        length = RoundSignificantDigits(123456789.123, 10, buffer, 16);
+        VERIFY_ARE_EQUAL(length, (size_t)20);
+        VERIFY_ARE_EQUAL(buffer[0], L'x');
+    }
+
+    void CalculatorManagerTest::CalculatorManagerNumberFormattingUtils_ToScientificNumberToBuffer()
+    {
+        wchar_t buffer[16];
+        size_t length = ToScientificNumber(3423, buffer, 16);
+        VERIFY_ARE_EQUAL(wstring(buffer, length), L"3.423000e+03");
+        length = ToScientificNumber(-0.00921, buffer, 16);
+        VERIFY_ARE_EQUAL(wstring(buffer, length), L"-9.210000e-03");
+        length = ToScientificNumber(-3432474247332942, buffer, 16);
+        VERIFY_ARE_EQUAL(wstring(buffer, length), L"-3.432474e+15");
+        length = ToScientificNumber(0.000000003432432, buffer, 16);
+        VERIFY_ARE_EQUAL(wstring(buffer, length), L"3.432432e-09");
+    }
+
     // TODO re-enable when cause of failure is determined. Bug 20226670
     // void CalculatorManagerTest::CalculatorManagerTestBinaryOperatorReceived()
     // {
@@ -166,8 +166,9 @@ namespace CalculatorUnitTests
         {
             bool deletedStaticData = DeleteFileFromLocalCacheFolder(CurrencyDataLoaderConstants::StaticDataFilename);
             bool deletedAllRatiosData = DeleteFileFromLocalCacheFolder(CurrencyDataLoaderConstants::AllRatiosDataFilename);
+            bool deletedSnapshot = DeleteFileFromLocalCacheFolder(CurrencyDataLoaderConstants::SnapshotFilename);
 
-            return deletedStaticData && deletedAllRatiosData;
+            return deletedStaticData && deletedAllRatiosData && deletedSnapshot;
         }
         catch (...)
         {
@@ -303,6 +304,60 @@ TEST_METHOD(LoadFromCache_Success)
     VERIFY_IS_TRUE(loader.LoadedFromCache());
 }
 
+TEST_METHOD(LoadFromCache_Success_SnapshotWithoutJsonFiles)
+{
+    // A load from the web writes the snapshot, which the next load reads without the JSON responses.
+    unique_ptr<CurrencyDataLoader> webLoader =
+        MakeLoaderWithResults(CurrencyHttpClient::GetRawStaticDataResponse(), CurrencyHttpClient::GetRawAllRatiosDataResponse());
+    VERIFY_IS_TRUE(webLoader->TryLoadDataFromWebAsync().get());
+    webLoader.reset();
+
+    VERIFY_IS_TRUE(DeleteFileFromLocalCacheFolder(CurrencyDataLoaderConstants::StaticDataFilename));
+    VERIFY_IS_TRUE(DeleteFileFromLocalCacheFolder(CurrencyDataLoaderConstants::AllRatiosDataFilename));
+
+    CurrencyDataLoader loader(nullptr, L"en-US");
+
+    bool didLoad = loader.TryLoadDataFromCacheAsync().get();
+
+    VERIFY_IS_TRUE(didLoad);
+    VERIFY_IS_TRUE(loader.LoadedFromCache());
+    VERIFY_ARE_EQUAL(size_t{ 2 }, loader.LoadOrderedUnits(CURRENCY_CATEGORY).size());
+}
+
+TEST_METHOD(LoadFromCache_Success_JsonFilesWithoutSnapshot)
+{
+    // A load from the web still writes the JSON responses, which are read if the snapshot can't be.
+    unique_ptr<CurrencyDataLoader> webLoader =
+        MakeLoaderWithResults(CurrencyHttpClient::GetRawStaticDataResponse(), CurrencyHttpClient::GetRawAllRatiosDataResponse());
+    VERIFY_IS_TRUE(webLoader->TryLoadDataFromWebAsync().get());
+
+    VERIFY_IS_TRUE(DeleteFileFromLocalCacheFolder(CurrencyDataLoaderConstants::SnapshotFilename));
+
+    CurrencyDataLoader loader(nullptr, L"en-US");
+
+    bool didLoad = loader.TryLoadDataFromCacheAsync().get();
+
+    VERIFY_IS_TRUE(didLoad);
+    VERIFY_IS_TRUE(loader.LoadedFromCache());
+    VERIFY_ARE_EQUAL(size_t{ 2 }, loader.LoadOrderedUnits(CURRENCY_CATEGORY).size());
+}
+
+TEST_METHOD(LoadFromCache_Success_WhileAnotherLoaderIsOpen)
+{
+    // The snapshot file is only open while it is read, so other windows can load from it and refresh it.
+    unique_ptr<CurrencyDataLoader> webLoader =
+        MakeLoaderWithResults(CurrencyHttpClient::GetRawStaticDataResponse(), CurrencyHttpClient::GetRawAllRatiosDataResponse());
+    VERIFY_IS_TRUE(webLoader->TryLoadDataFromWebAsync().get());
+
+    CurrencyDataLoader loader(nullptr, L"en-US");
+    VERIFY_IS_TRUE(loader.TryLoadDataFromCacheAsync().get());
+    VERIFY_IS_TRUE(webLoader->TryLoadDataFromWebAsync().get());
+
+    CurrencyDataLoader otherLoader(nullptr, L"en-US");
+    VERIFY_IS_TRUE(otherLoader.TryLoadDataFromCacheAsync().get());
+    VERIFY_ARE_EQUAL(size_t{ 2 }, otherLoader.LoadOrderedUnits(CURRENCY_CATEGORY).size());
+}
+
 TEST_METHOD(LoadFromWeb_Fail_ClientIsNullptr)
 {
     CurrencyDataLoader loader(nullptr, L"en-US");
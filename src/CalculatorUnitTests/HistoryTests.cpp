@@ -37,6 +37,7 @@ namespace CalculatorFunctionalTests
         TEST_METHOD(TestDisplayValueAutomationNames);
         TEST_METHOD(TestRadixAutomationName);
         TEST_METHOD(TestHistoryEmpty);
+        TEST_METHOD(TestHistoryItemTokensAndCommands);
 
     private:
         HistoryViewModel ^ m_historyViewModel;
@@ -453,6 +454,51 @@ namespace CalculatorFunctionalTests
             Cleanup();
         }
 
+        void HistoryItemTokensAndCommands()
+        {
+            Initialize();
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::ModeScientific);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::Command1);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::CommandPNT);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::Command5);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::CommandSIGN);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::CommandADD);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::CommandOPENP);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::Command3);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::CommandSQR);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::CommandCLOSEP);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::CommandEQU);
+
+            // The item is stored in a compact form; the tokens and commands rebuilt from it must describe the same expression
+            auto historyItem = m_standardViewModel->m_standardCalculatorManager.GetHistoryItem(0);
+            auto const& tokens = *historyItem->historyItemVector.spTokens;
+            auto const& commands = *historyItem->historyItemVector.spCommands;
+            wstring expression;
+            for (auto const& token : tokens)
+            {
+                expression += (expression.empty() ? L"" : L" ") + token.first;
+                if (token.second != -1)
+                {
+                    VERIFY_IS_TRUE(static_cast<size_t>(token.second) < commands.size());
+                }
+            }
+            VERIFY_ARE_EQUAL(L'\u202d' + expression + L'\u202c', historyItem->historyItemVector.expression);
+
+            VERIFY_IS_TRUE(CommandType::OperandCommand == commands[tokens[0].second]->GetCommandType());
+            auto firstOperand = static_pointer_cast<IOpndCommand>(commands[tokens[0].second]);
+            VERIFY_IS_TRUE(firstOperand->IsNegative());
+            VERIFY_IS_TRUE(firstOperand->IsDecimalPresent());
+            VERIFY_IS_TRUE(
+                (vector<int>{ static_cast<int>(Command::Command1), static_cast<int>(Command::CommandPNT), static_cast<int>(Command::Command5) })
+                == *firstOperand->GetCommands());
+            VERIFY_IS_TRUE(CommandType::BinaryCommand == commands[tokens[1].second]->GetCommandType());
+            VERIFY_ARE_EQUAL(static_cast<int>(Command::CommandADD), static_pointer_cast<IBinaryCommand>(commands[tokens[1].second])->GetCommand());
+
+            // While an item is in use, asking for it again returns the same item
+            VERIFY_IS_TRUE(historyItem == m_standardViewModel->m_standardCalculatorManager.GetHistoryItem(0));
+            Cleanup();
+        }
+
         void HistoryClearCommandWithEmptyHistory()
         {
             Initialize();
@@ -529,6 +575,11 @@ namespace CalculatorFunctionalTests
         HistoryEmpty();
     }
 
+    void HistoryTests::TestHistoryItemTokensAndCommands()
+    {
+        HistoryItemTokensAndCommands();
+    }
+
     void HistoryTests::TestHistoryClearCommandWithEmptyHistory()
     {
         HistoryClearCommandWithEmptyHistory();
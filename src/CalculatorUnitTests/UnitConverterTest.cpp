@@ -208,6 +208,8 @@ namespace UnitConverterUnitTests
         TEST_METHOD(UnitConverterTestMaxDigitsReached_LeadingDecimal);
         TEST_METHOD(UnitConverterTestMaxDigitsReached_TrailingDecimal);
         TEST_METHOD(UnitConverterTestMaxDigitsReached_MultipleTimes);
+        TEST_METHOD(UnitConverterTestBinaryUserPreferences);
+        TEST_METHOD(UnitConverterTestUpdateCurrencyRatiosWithoutCurrencies);
 
     private:
         static void ExecuteCommands(vector<Command> commands);
@@ -564,4 +566,36 @@ namespace UnitConverterUnitTests
             VERIFY_ARE_EQUAL(count, s_testVMCallback->GetMaxDigitsReachedCallCount(), to_wstring(count).c_str());
         }
     }
+
+    // Test restoring the binary preferences, which leave the state as the string ones do, through the interface that
+    // the view model uses
+    void UnitConverterTest::UnitConverterTestBinaryUserPreferences()
+    {
+        IUnitConverter& unitConverter = *s_unitConverter;
+        unitConverter.SetCurrentCategory(s_testWeight);
+        unitConverter.SetCurrentUnitTypes(s_testKilograms, s_testPounds);
+        wstring userPreferences = unitConverter.SaveUserPreferences();
+        vector<uint8_t> binaryUserPreferences(unitConverter.SaveUserPreferences(nullptr, 0));
+        VERIFY_ARE_EQUAL(binaryUserPreferences.size(), unitConverter.SaveUserPreferences(binaryUserPreferences.data(), binaryUserPreferences.size()));
+
+        unitConverter.SetCurrentCategory(s_testLength);
+        unitConverter.SetCurrentUnitTypes(s_testFeet, s_testInches);
+        VERIFY_IS_FALSE(unitConverter.RestoreUserPreferences(binaryUserPreferences.data(), binaryUserPreferences.size() - 1));
+        VERIFY_IS_TRUE(unitConverter.GetCurrentCategory() == s_testLength);
+
+        VERIFY_IS_TRUE(unitConverter.RestoreUserPreferences(binaryUserPreferences.data(), binaryUserPreferences.size()));
+        VERIFY_IS_TRUE(unitConverter.GetCurrentCategory() == s_testWeight);
+        VERIFY_ARE_EQUAL(userPreferences, unitConverter.SaveUserPreferences());
+    }
+
+    // Without a currency data loader there is nothing to update in place, and the static categories are left as they are
+    void UnitConverterTest::UnitConverterTestUpdateCurrencyRatiosWithoutCurrencies()
+    {
+        s_unitConverter->SetCurrentCategory(s_testWeight);
+        s_unitConverter->SetCurrentUnitTypes(s_testKilograms, s_testPounds);
+        wstring userPreferences = s_unitConverter->SaveUserPreferences();
+
+        VERIFY_IS_FALSE(s_unitConverter->UpdateCurrencyRatios());
+        VERIFY_ARE_EQUAL(userPreferences, s_unitConverter->SaveUserPreferences());
+    }
 }
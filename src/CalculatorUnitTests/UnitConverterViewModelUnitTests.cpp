@@ -229,6 +229,21 @@ void UnitConverterMock::SwitchActive(const std::wstring& newValue)
 
 void UnitConverterMock::RestoreUserPreferences(_In_ const std::wstring& /*userPreferences*/){};
 
+size_t UnitConverterMock::SaveUserPreferences(_Out_ uint8_t* buffer, size_t bufferSize) const
+{
+    constexpr uint8_t userPreferences[] = { 'T', 'E', 'S', 'T' };
+    if (bufferSize >= sizeof(userPreferences))
+    {
+        memcpy(buffer, userPreferences, sizeof(userPreferences));
+    }
+    return sizeof(userPreferences);
+}
+
+bool UnitConverterMock::RestoreUserPreferences(_In_ const uint8_t* /*userPreferences*/, size_t /*size*/)
+{
+    return false;
+}
+
 void UnitConverterMock::SendCommand(UCM::Command command)
 {
     m_sendCommandCallCount++;
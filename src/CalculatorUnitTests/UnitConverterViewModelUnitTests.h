@@ -36,6 +36,8 @@ namespace CalculatorUnitTests
         void SwitchActive(const std::wstring& newValue);
         std::wstring SaveUserPreferences() override;
         void RestoreUserPreferences(_In_ const std::wstring& userPreferences) override;
+        size_t SaveUserPreferences(_Out_ uint8_t* buffer, size_t bufferSize) const override;
+        bool RestoreUserPreferences(_In_ const uint8_t* userPreferences, size_t size) override;
         void SendCommand(UCM::Command command) override;
         void SetViewModelCallback(const std::shared_ptr<UCM::IUnitConverterVMCallback>& newCallback) override;
         void SetViewModelCurrencyCallback(_In_ const std::shared_ptr<UCM::IViewModelCurrencyCallback>& /*newCallback*/) override
@@ -47,6 +49,10 @@ namespace CalculatorUnitTests
         void ResetCategoriesAndRatios() override
         {
         }
+        bool UpdateCurrencyRatios() override
+        {
+            return false;
+        }
         std::future<std::pair<bool, std::wstring>> RefreshCurrencyRatios() override
         {
             co_return std::make_pair(true, L"");